@@ -0,0 +1,190 @@
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <ucontext.h>
+
+#include "Log.h"
+#include "Platform.h"
+#include "Tests.h"
+
+// Runs the tests as a static powerpc-linux program, e.g. under qemu-ppc, so they can run
+// without a Wii or Dolphin. The log is identical to the one the Wii build writes.
+
+static ssize_t stdout_write(void*, const char* buffer, size_t size)
+{
+    // Same as the Wii build's devoptab, which drops writes of a single character.
+    if (size > 1)
+        LogText(buffer, size);
+
+    return size;
+}
+
+void* PlatformAllocateCode(size_t size)
+{
+    // Static data isn't executable here, so the buffer gets its own mapping.
+    void* const memory = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+        fprintf(stderr, "Unable to map memory for generated code\n");
+        exit(1);
+    }
+
+    return memory;
+}
+
+void PlatformSyncCode(void* start, size_t size)
+{
+    char* const begin = static_cast<char*>(start);
+    __builtin___clear_cache(begin, begin + size);
+}
+
+uint32_t PlatformCyclesPerTimebaseTick()
+{
+    // Under qemu the timebase follows the host's clock rather than emulated cycles,
+    // so benchmark results are in ticks and only comparable with each other.
+    return 1;
+}
+
+size_t PlatformGetMemoryRegions(const PlatformMemoryRegion** regions)
+{
+    // There's only the one kind of memory here.
+    alignas(32) static uint8_t buffer[1024 * 1024];
+    static const PlatformMemoryRegion memory_region = {"MEMORY", buffer, sizeof(buffer)};
+
+    *regions = &memory_region;
+    return 1;
+}
+
+// There's nothing to gain from writing in the background here, so each block is written as
+// soon as it's full.
+static FILE* log_writer_file = nullptr;
+
+void PlatformStartLogWriter(FILE* file)
+{
+    log_writer_file = file;
+}
+
+uint8_t* PlatformGetLogBlock()
+{
+    alignas(32) static uint8_t block[PLATFORM_LOG_BLOCK_SIZE];
+    return block;
+}
+
+void PlatformWriteLogBlock(uint8_t* block, size_t size)
+{
+    fwrite(block, 1, size, log_writer_file);
+}
+
+void PlatformStopLogWriter()
+{
+    log_writer_file = nullptr;
+}
+
+// Exceptions come through as signals here, with the registers in the signal context. The
+// kernel handles floating-point unavailable exceptions itself, and keeps SRR1 to itself, so
+// the handler only reports the program exception cause the signal stands for.
+constexpr uint32_t SRR1_FP_ENABLED = 0x00100000;
+constexpr uint32_t SRR1_ILLEGAL = 0x00080000;
+constexpr uint32_t SRR1_PRIVILEGED = 0x00040000;
+constexpr uint32_t SRR1_TRAP = 0x00020000;
+
+// Indices of the NIP and MSR in the saved registers (PT_NIP and PT_MSR in asm/ptrace.h).
+constexpr size_t REGISTER_NIP = 32;
+constexpr size_t REGISTER_MSR = 33;
+
+static PlatformExceptionState caught_state;
+static bool caught = false;
+
+static void ExceptionHandler(int signal, siginfo_t* info, void* context)
+{
+    caught_state.timebase = GetTimebase();
+
+    mcontext_t* const registers = static_cast<ucontext_t*>(context)->uc_mcontext.uc_regs;
+
+    uint64_t fpscr = 0;
+    std::memcpy(&fpscr, &registers->fpregs.fpscr, sizeof(fpscr));
+
+    uint32_t cause = 0;
+    if (signal == SIGFPE)
+        cause = SRR1_FP_ENABLED;
+    else if (signal == SIGILL)
+        cause = info->si_code == ILL_PRVOPC ? SRR1_PRIVILEGED : SRR1_ILLEGAL;
+    else if (signal == SIGTRAP)
+        cause = SRR1_TRAP;
+
+    caught_state.srr0 = registers->gregs[REGISTER_NIP];
+    caught_state.srr1 = cause | (registers->gregs[REGISTER_MSR] & 0xFFFF);
+    caught_state.fpscr = static_cast<uint32_t>(fpscr);
+    caught = true;
+
+    registers->gregs[REGISTER_NIP] += 4;
+
+    // FEX is still set, so in precise mode the exception would be raised again on return.
+    if (signal == SIGFPE)
+        std::memset(&registers->fpregs.fpscr, 0, sizeof(registers->fpregs.fpscr));
+}
+
+bool PlatformCatchException(PlatformException exception, PlatformRaiseFunc raise, PlatformExceptionSite* site,
+                            PlatformExceptionState* state)
+{
+    if (exception == PlatformException::FloatingPointUnavailable)
+        return false;
+
+    static constexpr int signals[] = {SIGILL, SIGTRAP, SIGFPE, SIGBUS};
+    struct sigaction action{};
+    struct sigaction previous[std::size(signals)];
+    action.sa_sigaction = ExceptionHandler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+
+    for (size_t i = 0; i < std::size(signals); i++)
+        sigaction(signals[i], &action, &previous[i]);
+
+    caught = false;
+    const bool fp_enabled = exception == PlatformException::FloatingPointEnabled;
+    if (!fp_enabled || prctl(PR_SET_FPEXC, PR_FP_EXC_PRECISE) == 0)
+    {
+        raise(site);
+
+        if (fp_enabled)
+            prctl(PR_SET_FPEXC, PR_FP_EXC_DISABLED);
+    }
+
+    for (size_t i = 0; i < std::size(signals); i++)
+        sigaction(signals[i], &previous[i], nullptr);
+
+    *state = caught_state;
+    return caught;
+}
+
+int main(int argc, char** argv)
+{
+    // The log is written to LOG_FILE_NAME unless another path is given. "-" writes it to stdout.
+    const char* path = argc > 1 ? argv[1] : LOG_FILE_NAME;
+    if (std::strcmp(path, "-") == 0)
+        path = "/dev/stdout";
+
+    if (!LogOpen(path))
+    {
+        fprintf(stderr, "Unable to open: %s\n", path);
+        return 1;
+    }
+
+    // Everything printed from here on goes into the log, like on the Wii.
+    cookie_io_functions_t functions{};
+    functions.write = stdout_write;
+    stdout = fopencookie(nullptr, "w", functions);
+
+    // Line buffered
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    RunAllTests();
+
+    fflush(stdout);
+    LogClose();
+    return 0;
+}
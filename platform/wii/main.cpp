@@ -0,0 +1,345 @@
+#include <cstdio>
+#include <fat.h>
+#include <malloc.h>
+#include <gccore.h>
+#include <ogc/cache.h>
+#include <ogc/context.h>
+#include <ogc/lwp.h>
+#include <ogc/lwp_watchdog.h>
+#include <ogc/machine/processor.h>
+#include <ogc/semaphore.h>
+#include <sys/iosupport.h>
+#include <unistd.h>
+
+#include "Log.h"
+#include "Platform.h"
+#include "Tests.h"
+#include "Utils.h"
+
+static void* xfb = nullptr;
+static GXRModeObj* rmode = nullptr;
+
+static ssize_t file_write(_reent*, void*, const char* ptr, size_t len)
+{
+    if (len > 1)
+        LogText(ptr, len);
+
+    return len;
+}
+
+static const devoptab_t dotab_file = {
+    "file",
+    0,
+    nullptr,
+    nullptr,
+    file_write,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    0,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr
+};
+
+void* PlatformAllocateCode(size_t size)
+{
+    return memalign(32, size);
+}
+
+void PlatformSyncCode(void* start, size_t size)
+{
+    DCFlushRange(start, size);
+    ICInvalidateRange(start, size);
+}
+
+uint32_t PlatformCyclesPerTimebaseTick()
+{
+    // The timebase runs at a quarter of the bus clock.
+    return TB_CORE_CLOCK / (TB_BUS_CLOCK / 4);
+}
+
+size_t PlatformGetMemoryRegions(const PlatformMemoryRegion** regions)
+{
+    // Four times the size of the L2 cache.
+    constexpr size_t size = 1024 * 1024;
+    static PlatformMemoryRegion memory_regions[4];
+
+    if (memory_regions[0].memory == nullptr)
+    {
+        // The heap is in MEM1. The MEM2 buffer is taken off the bottom of its arena.
+        void* const mem1 = memalign(32, size);
+        void* const mem2 = reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(SYS_GetArena2Lo()) + 31) & ~uintptr_t{31});
+        SYS_SetArena2Lo(static_cast<u8*>(mem2) + size);
+
+        memory_regions[0] = {"MEM1", mem1, size};
+        memory_regions[1] = {"MEM1-UC", MEM_K0_TO_K1(mem1), size};
+        memory_regions[2] = {"MEM2", mem2, size};
+        memory_regions[3] = {"MEM2-UC", MEM_K0_TO_K1(mem2), size};
+    }
+
+    *regions = memory_regions;
+    return 4;
+}
+
+// The log is collected in a ring of blocks in MEM2, and a thread writes out each one that
+// fills up while the tests carry on. It only waits on the SD card, so it runs above the
+// main thread (at 64) and gets the CPU back to the tests as soon as each write is issued.
+constexpr size_t LOG_BLOCK_COUNT = 8;
+constexpr u8 LOG_WRITER_PRIORITY = 80;
+
+static uint8_t* log_blocks[LOG_BLOCK_COUNT];
+static size_t log_block_sizes[LOG_BLOCK_COUNT];
+static size_t log_blocks_queued = 0;
+static size_t log_blocks_written = 0;
+static sem_t log_blocks_free;
+static sem_t log_blocks_full;
+static FILE* log_writer_file = nullptr;
+static lwp_t log_writer_thread = LWP_THREAD_NULL;
+alignas(8) static uint8_t log_writer_stack[16 * 1024];
+
+// Time spent writing the log, and the part of it the tests spent waiting, for the report
+// at the end. Without the writer thread, the tests would wait for all of it.
+static uint64_t log_bytes = 0;
+static uint64_t log_write_ticks = 0;
+static uint64_t log_wait_ticks = 0;
+
+static void* LogWriter(void*)
+{
+    while (true)
+    {
+        LWP_SemWait(log_blocks_full);
+
+        const size_t index = log_blocks_written % LOG_BLOCK_COUNT;
+        const size_t size = log_block_sizes[index];
+
+        // An empty block marks the end of the log.
+        if (size == 0)
+            return nullptr;
+
+        const u64 start = gettime();
+        fwrite(log_blocks[index], 1, size, log_writer_file);
+        log_write_ticks += gettime() - start;
+        log_bytes += size;
+
+        log_blocks_written++;
+        LWP_SemPost(log_blocks_free);
+    }
+}
+
+void PlatformStartLogWriter(FILE* file)
+{
+    if (log_blocks[0] == nullptr)
+    {
+        // Taken off the bottom of the MEM2 arena, like the benchmark memory. The blocks are
+        // a multiple of the sector size, so every write but the last is of whole sectors.
+        uint8_t* const memory = reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(SYS_GetArena2Lo()) + 31) & ~uintptr_t{31});
+        SYS_SetArena2Lo(memory + LOG_BLOCK_COUNT * PLATFORM_LOG_BLOCK_SIZE);
+
+        for (size_t i = 0; i < LOG_BLOCK_COUNT; i++)
+            log_blocks[i] = memory + i * PLATFORM_LOG_BLOCK_SIZE;
+    }
+
+    log_writer_file = file;
+    log_blocks_queued = 0;
+    log_blocks_written = 0;
+    LWP_SemInit(&log_blocks_free, LOG_BLOCK_COUNT, LOG_BLOCK_COUNT);
+    LWP_SemInit(&log_blocks_full, 0, LOG_BLOCK_COUNT);
+    LWP_CreateThread(&log_writer_thread, LogWriter, nullptr, log_writer_stack, sizeof(log_writer_stack), LOG_WRITER_PRIORITY);
+}
+
+uint8_t* PlatformGetLogBlock()
+{
+    const u64 start = gettime();
+    LWP_SemWait(log_blocks_free);
+    log_wait_ticks += gettime() - start;
+
+    return log_blocks[log_blocks_queued % LOG_BLOCK_COUNT];
+}
+
+// Blocks are handed out and written in the same order, so only the size needs passing on.
+void PlatformWriteLogBlock(uint8_t*, size_t size)
+{
+    log_block_sizes[log_blocks_queued % LOG_BLOCK_COUNT] = size;
+    log_blocks_queued++;
+    LWP_SemPost(log_blocks_full);
+}
+
+void PlatformStopLogWriter()
+{
+    PlatformWriteLogBlock(PlatformGetLogBlock(), 0);
+
+    const u64 start = gettime();
+    LWP_JoinThread(log_writer_thread, nullptr);
+    log_wait_ticks += gettime() - start;
+
+    LWP_SemDestroy(log_blocks_free);
+    LWP_SemDestroy(log_blocks_full);
+    log_writer_thread = LWP_THREAD_NULL;
+}
+
+// Exception handlers go in libogc's table, which holds a C function for each exception after
+// the registers are saved to a frame_context, and restores them from it once it returns.
+// Neither the table nor the function that sets it are in libogc's headers.
+extern "C" {
+extern void (*_exceptionhandlertable[])(frame_context*);
+void __exception_sethandler(u32 nExcept, void (*pHndl)(frame_context*));
+}
+
+constexpr uint32_t MSR_FLOATING_POINT = 0x00002000;
+constexpr uint32_t MSR_FP_EXCEPTION_MODE = 0x00000900; // FE0 and FE1: precise
+
+static uint32_t GetMSR()
+{
+    uint32_t msr;
+    asm volatile ("mfmsr %[out]" : [out]"=r"(msr));
+    return msr;
+}
+
+static void SetMSR(uint32_t msr)
+{
+    asm volatile ("mtmsr %[val]\nisync" : : [val]"r"(msr));
+}
+
+static PlatformException catching_exception;
+static PlatformExceptionState caught_state;
+static bool caught = false;
+
+static void ExceptionHandler(frame_context* context)
+{
+    caught_state.timebase = GetTimebase();
+
+    // Delivery clears MSR[FP], so it's set just long enough to read the FPSCR.
+    const uint32_t msr = GetMSR();
+    SetMSR(msr | MSR_FLOATING_POINT);
+    caught_state.fpscr = GetFPSCR();
+    SetMSR(msr);
+
+    caught_state.srr0 = context->SRR0;
+    caught_state.srr1 = context->SRR1;
+    caught = true;
+
+    if (catching_exception == PlatformException::FloatingPointUnavailable)
+        context->SRR1 |= MSR_FLOATING_POINT;
+    else
+        context->SRR0 += 4;
+
+    // FEX is still set, so in precise mode the exception would be raised again on return.
+    context->SRR1 &= ~MSR_FP_EXCEPTION_MODE;
+}
+
+bool PlatformCatchException(PlatformException exception, PlatformRaiseFunc raise, PlatformExceptionSite* site,
+                            PlatformExceptionState* state)
+{
+    static constexpr u32 vectors[] = {EX_PRG, EX_PRG, EX_FP, EX_ALIGN};
+    const u32 vector = vectors[static_cast<size_t>(exception)];
+    void (*const previous)(frame_context*) = _exceptionhandlertable[vector];
+
+    catching_exception = exception;
+    caught = false;
+    __exception_sethandler(vector, ExceptionHandler);
+
+    // With interrupts off, nothing else (libogc's lazy switching of FP contexts, for one) can
+    // run while the handler is in place or MSR[FP] is clear.
+    u32 level;
+    _CPU_ISR_Disable(level);
+
+    const uint32_t msr = GetMSR();
+    if (exception == PlatformException::FloatingPointEnabled)
+        SetMSR(msr | MSR_FP_EXCEPTION_MODE);
+    else if (exception == PlatformException::FloatingPointUnavailable)
+        SetMSR(msr & ~MSR_FLOATING_POINT);
+
+    raise(site);
+
+    SetMSR(msr);
+    _CPU_ISR_Restore(level);
+    __exception_sethandler(vector, previous);
+
+    *state = caught_state;
+    return caught;
+}
+
+// Initializes various system devices/capabilities.
+static void Initialize()
+{
+    VIDEO_Init();
+
+    if (!fatInitDefault())
+    {
+        printf("Unable to initialize FAT subsystem. Exiting...\n");
+        exit(0);
+    }
+
+    // Initialize the XFB
+    rmode = VIDEO_GetPreferredMode(nullptr);
+    void* framebuffer = MEM_K0_TO_K1(SYS_AllocateFramebuffer(rmode));
+    console_init(framebuffer, 20, 20, rmode->fbWidth, rmode->xfbHeight, rmode->fbWidth * VI_DISPLAY_PIX_SZ);
+
+    VIDEO_Configure(rmode);
+    VIDEO_SetNextFramebuffer(framebuffer);
+    VIDEO_SetBlack(false);
+    VIDEO_Flush();
+    VIDEO_WaitVSync();
+    if (rmode->viTVMode&VI_NON_INTERLACE)
+        VIDEO_WaitVSync();
+
+    xfb = framebuffer;
+}
+
+static bool TryOpenFile(const char* path)
+{
+    if (!LogOpen(path))
+    {
+        printf("Unable to open: %s\n", path);
+        return false;
+    }
+
+    return true;
+}
+
+int main()
+{
+    Initialize();
+    printf("Dolphin PPC Instruction Tests\n");
+    printf("Will exit when done.\n");
+
+    if (TryOpenFile(LOG_FILE_NAME))
+    {
+        const devoptab_t* const console = devoptab_list[STD_OUT];
+        devoptab_list[STD_OUT] = &dotab_file;
+
+        // Line buffered
+        setvbuf(stdout, nullptr, _IOLBF, 0);
+
+        RunAllTests();
+        fflush(stdout);
+        LogClose();
+
+        // Back on the screen, for how long writing the log held the tests up.
+        devoptab_list[STD_OUT] = console;
+        printf("Log: %llu KiB, written in %llu ms, of which the tests waited %llu ms\n",
+               static_cast<unsigned long long>(log_bytes / 1024),
+               static_cast<unsigned long long>(ticks_to_millisecs(log_write_ticks)),
+               static_cast<unsigned long long>(ticks_to_millisecs(log_wait_ticks)));
+        sleep(5);
+    }
+
+    // Exit is required.
+    exit(0);
+    return 0;
+}
@@ -0,0 +1,752 @@
+#ifdef BENCHMARKS
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "Exceptions.h"
+#include "IntegerChain.h"
+#include "Log.h"
+#include "Platform.h"
+#include "Tests.h"
+
+// Latency and throughput of every instruction the tests cover, measured with the timebase.
+//
+// Latency runs a chain of the instruction where each one depends on the result of the last.
+// Throughput runs eight independent streams of it, interleaved. Both are unrolled 32 times
+// per loop iteration, and the time of an empty loop is subtracted. Results are logged in
+// cycles per instruction, as the best of several runs.
+
+// Executes iterations of an unrolled sequence and returns the elapsed timebase ticks.
+using BenchmarkFunc = uint32_t (*)(uint32_t iterations);
+
+struct Benchmark
+{
+    const char* inst;
+    BenchmarkFunc latency;    // Null for compares, whose results can't feed the next one.
+    BenchmarkFunc throughput;
+};
+
+// Instructions per loop iteration. This has to match the .rept counts below.
+constexpr uint32_t BENCHMARK_UNROLL = 32;
+#define LATENCY_REPT    ".rept 32\n"
+#define THROUGHPUT_REPT ".rept 4\n" // Of eight instructions each
+#define END_REPT        ".endr\n"
+
+constexpr uint32_t BENCHMARK_ITERATIONS = 2048;
+constexpr uint32_t BENCHMARK_RUNS = 5;
+
+#define BENCHMARK_FUNC(setup, statement)          \
+    [](uint32_t iterations) {                     \
+        setup                                     \
+        const uint32_t start = GetTimebase();     \
+        for (uint32_t i = 0; i < iterations; i++) \
+            statement;                            \
+        return GetTimebase() - start;             \
+    }
+
+// Eight independent instructions writing d0-d7 from the same operands.
+#define STREAMS(inst, operands)          \
+    inst " %[d0], " operands "\n"        \
+    inst " %[d1], " operands "\n"        \
+    inst " %[d2], " operands "\n"        \
+    inst " %[d3], " operands "\n"        \
+    inst " %[d4], " operands "\n"        \
+    inst " %[d5], " operands "\n"        \
+    inst " %[d6], " operands "\n"        \
+    inst " %[d7], " operands "\n"
+
+// Compares rotate through the volatile CR fields instead.
+#define CR_FIELD_STREAMS(inst, operands) \
+    inst " cr0, " operands "\n"          \
+    inst " cr1, " operands "\n"          \
+    inst " cr6, " operands "\n"          \
+    inst " cr7, " operands "\n"          \
+    inst " cr0, " operands "\n"          \
+    inst " cr1, " operands "\n"          \
+    inst " cr6, " operands "\n"          \
+    inst " cr7, " operands "\n"
+
+#define STREAM_OUTPUTS(constraint)                                        \
+    [d0]constraint(d[0]), [d1]constraint(d[1]), [d2]constraint(d[2]),     \
+    [d3]constraint(d[3]), [d4]constraint(d[4]), [d5]constraint(d[5]),     \
+    [d6]constraint(d[6]), [d7]constraint(d[7])
+
+//
+// Integer
+//
+
+// rA is never r0 ("b"), which ADDI and ADDIS would read as zero.
+#define INTEGER_SETUP uint32_t a = 0x12345678; uint32_t b = 3;
+
+#define INTEGER_BENCHMARK(inst, latency_operands, stream_operands)                                                    \
+    {inst,                                                                                                            \
+     BENCHMARK_FUNC(INTEGER_SETUP,                                                                                    \
+         asm volatile (LATENCY_REPT inst " %[a], " latency_operands "\n" END_REPT                                     \
+             : [a]"+b"(a) : [b]"r"(b) : "cr0", "xer")),                                                               \
+     BENCHMARK_FUNC(INTEGER_SETUP uint32_t d[8];,                                                                     \
+         asm volatile (THROUGHPUT_REPT STREAMS(inst, stream_operands) END_REPT                                        \
+             : STREAM_OUTPUTS("=&r") : [a]"b"(a), [b]"r"(b) : "cr0", "xer"))}
+
+#define INTEGER_COMPARE_BENCHMARK_OPERANDS(inst, operands)                                                            \
+    {inst,                                                                                                            \
+     nullptr,                                                                                                         \
+     BENCHMARK_FUNC(INTEGER_SETUP,                                                                                    \
+         asm volatile (THROUGHPUT_REPT CR_FIELD_STREAMS(inst, operands) END_REPT                                      \
+             : : [a]"r"(a), [b]"r"(b) : "cr0", "cr1", "cr6", "cr7"))}
+
+#define INTEGER_BINARY_BENCHMARK(inst)                 INTEGER_BENCHMARK(inst, "%[a], %[b]", "%[a], %[b]")
+#define INTEGER_UNARY_BENCHMARK(inst)                  INTEGER_BENCHMARK(inst, "%[a]", "%[a]")
+#define INTEGER_IMMEDIATE_BENCHMARK(inst, imm)         INTEGER_BENCHMARK(inst, "%[a], " imm, "%[a], " imm)
+#define INTEGER_ROTATE_BENCHMARK(inst)                 INTEGER_BENCHMARK(inst, "%[a], 1, 0, 31", "%[a], 1, 0, 31")
+#define INTEGER_COMPARE_BENCHMARK(inst)                INTEGER_COMPARE_BENCHMARK_OPERANDS(inst, "%[a], %[b]")
+#define INTEGER_COMPARE_IMMEDIATE_BENCHMARK(inst, imm) INTEGER_COMPARE_BENCHMARK_OPERANDS(inst, "%[a], " imm)
+
+static constexpr Benchmark integer_benchmarks[] = {
+    INTEGER_BINARY_BENCHMARK("ADD"),
+    INTEGER_BINARY_BENCHMARK("ADD."),
+    INTEGER_BINARY_BENCHMARK("ADDC"),
+    INTEGER_BINARY_BENCHMARK("ADDC."),
+    INTEGER_BINARY_BENCHMARK("ADDCO"),
+    INTEGER_BINARY_BENCHMARK("ADDCO."),
+    INTEGER_BINARY_BENCHMARK("ADDO"),
+    INTEGER_BINARY_BENCHMARK("ADDO."),
+    INTEGER_BINARY_BENCHMARK("ADDE"),
+    INTEGER_BINARY_BENCHMARK("ADDE."),
+    INTEGER_BINARY_BENCHMARK("ADDEO"),
+    INTEGER_BINARY_BENCHMARK("ADDEO."),
+    INTEGER_IMMEDIATE_BENCHMARK("ADDI", "1"),
+    INTEGER_IMMEDIATE_BENCHMARK("ADDIC", "1"),
+    INTEGER_IMMEDIATE_BENCHMARK("ADDIC.", "1"),
+    INTEGER_IMMEDIATE_BENCHMARK("ADDIS", "1"),
+    INTEGER_UNARY_BENCHMARK("ADDME"),
+    INTEGER_UNARY_BENCHMARK("ADDME."),
+    INTEGER_UNARY_BENCHMARK("ADDMEO"),
+    INTEGER_UNARY_BENCHMARK("ADDMEO."),
+    INTEGER_UNARY_BENCHMARK("ADDZE"),
+    INTEGER_UNARY_BENCHMARK("ADDZE."),
+    INTEGER_UNARY_BENCHMARK("ADDZEO"),
+    INTEGER_UNARY_BENCHMARK("ADDZEO."),
+    INTEGER_BINARY_BENCHMARK("AND"),
+    INTEGER_BINARY_BENCHMARK("AND."),
+    INTEGER_BINARY_BENCHMARK("ANDC"),
+    INTEGER_BINARY_BENCHMARK("ANDC."),
+    INTEGER_IMMEDIATE_BENCHMARK("ANDI.", "0x7FFF"),
+    INTEGER_IMMEDIATE_BENCHMARK("ANDIS.", "0x7FFF"),
+    INTEGER_COMPARE_BENCHMARK("CMP"),
+    INTEGER_COMPARE_IMMEDIATE_BENCHMARK("CMPI", "1"),
+    INTEGER_COMPARE_BENCHMARK("CMPL"),
+    INTEGER_COMPARE_IMMEDIATE_BENCHMARK("CMPLI", "1"),
+    INTEGER_UNARY_BENCHMARK("CNTLZW"),
+    INTEGER_UNARY_BENCHMARK("CNTLZW."),
+    INTEGER_BINARY_BENCHMARK("DIVW"),
+    INTEGER_BINARY_BENCHMARK("DIVW."),
+    INTEGER_BINARY_BENCHMARK("DIVWO"),
+    INTEGER_BINARY_BENCHMARK("DIVWO."),
+    INTEGER_BINARY_BENCHMARK("DIVWU"),
+    INTEGER_BINARY_BENCHMARK("DIVWU."),
+    INTEGER_BINARY_BENCHMARK("DIVWUO"),
+    INTEGER_BINARY_BENCHMARK("DIVWUO."),
+    INTEGER_BINARY_BENCHMARK("EQV"),
+    INTEGER_BINARY_BENCHMARK("EQV."),
+    INTEGER_UNARY_BENCHMARK("EXTSB"),
+    INTEGER_UNARY_BENCHMARK("EXTSB."),
+    INTEGER_UNARY_BENCHMARK("EXTSH"),
+    INTEGER_UNARY_BENCHMARK("EXTSH."),
+    INTEGER_BINARY_BENCHMARK("MULHW"),
+    INTEGER_BINARY_BENCHMARK("MULHW."),
+    INTEGER_BINARY_BENCHMARK("MULHWU"),
+    INTEGER_BINARY_BENCHMARK("MULHWU."),
+    INTEGER_IMMEDIATE_BENCHMARK("MULLI", "3"),
+    INTEGER_BINARY_BENCHMARK("MULLW"),
+    INTEGER_BINARY_BENCHMARK("MULLW."),
+    INTEGER_BINARY_BENCHMARK("MULLWO"),
+    INTEGER_BINARY_BENCHMARK("MULLWO."),
+    INTEGER_BINARY_BENCHMARK("NAND"),
+    INTEGER_BINARY_BENCHMARK("NAND."),
+    INTEGER_UNARY_BENCHMARK("NEG"),
+    INTEGER_UNARY_BENCHMARK("NEG."),
+    INTEGER_UNARY_BENCHMARK("NEGO"),
+    INTEGER_UNARY_BENCHMARK("NEGO."),
+    INTEGER_BINARY_BENCHMARK("NOR"),
+    INTEGER_BINARY_BENCHMARK("NOR."),
+    INTEGER_BINARY_BENCHMARK("OR"),
+    INTEGER_BINARY_BENCHMARK("OR."),
+    INTEGER_BINARY_BENCHMARK("ORC"),
+    INTEGER_BINARY_BENCHMARK("ORC."),
+    INTEGER_IMMEDIATE_BENCHMARK("ORI", "1"),
+    INTEGER_IMMEDIATE_BENCHMARK("ORIS", "1"),
+    INTEGER_ROTATE_BENCHMARK("RLWIMI"),
+    INTEGER_ROTATE_BENCHMARK("RLWIMI."),
+    INTEGER_ROTATE_BENCHMARK("RLWINM"),
+    INTEGER_ROTATE_BENCHMARK("RLWINM."),
+    INTEGER_BINARY_BENCHMARK("SLW"),
+    INTEGER_BINARY_BENCHMARK("SLW."),
+    INTEGER_BINARY_BENCHMARK("SRAW"),
+    INTEGER_BINARY_BENCHMARK("SRAW."),
+    INTEGER_IMMEDIATE_BENCHMARK("SRAWI", "1"),
+    INTEGER_IMMEDIATE_BENCHMARK("SRAWI.", "1"),
+    INTEGER_BINARY_BENCHMARK("SRW"),
+    INTEGER_BINARY_BENCHMARK("SRW."),
+    INTEGER_BINARY_BENCHMARK("SUBF"),
+    INTEGER_BINARY_BENCHMARK("SUBF."),
+    INTEGER_BINARY_BENCHMARK("SUBFO"),
+    INTEGER_BINARY_BENCHMARK("SUBFO."),
+    INTEGER_BINARY_BENCHMARK("SUBFC"),
+    INTEGER_BINARY_BENCHMARK("SUBFC."),
+    INTEGER_BINARY_BENCHMARK("SUBFCO"),
+    INTEGER_BINARY_BENCHMARK("SUBFCO."),
+    INTEGER_BINARY_BENCHMARK("SUBFE"),
+    INTEGER_BINARY_BENCHMARK("SUBFE."),
+    INTEGER_BINARY_BENCHMARK("SUBFEO"),
+    INTEGER_BINARY_BENCHMARK("SUBFEO."),
+    INTEGER_IMMEDIATE_BENCHMARK("SUBFIC", "1"),
+    INTEGER_UNARY_BENCHMARK("SUBFME"),
+    INTEGER_UNARY_BENCHMARK("SUBFME."),
+    INTEGER_UNARY_BENCHMARK("SUBFMEO"),
+    INTEGER_UNARY_BENCHMARK("SUBFMEO."),
+    INTEGER_UNARY_BENCHMARK("SUBFZE"),
+    INTEGER_UNARY_BENCHMARK("SUBFZE."),
+    INTEGER_UNARY_BENCHMARK("SUBFZEO"),
+    INTEGER_UNARY_BENCHMARK("SUBFZEO."),
+    INTEGER_BINARY_BENCHMARK("XOR"),
+    INTEGER_BINARY_BENCHMARK("XOR."),
+    INTEGER_IMMEDIATE_BENCHMARK("XORI", "1"),
+    INTEGER_IMMEDIATE_BENCHMARK("XORIS", "1"),
+};
+
+//
+// Floating-point
+//
+
+#define FLOAT_SETUP double a = 1.0; double b = 1.0;
+
+#define FLOAT_BENCHMARK(inst, operands)                                                                               \
+    {inst,                                                                                                            \
+     BENCHMARK_FUNC(FLOAT_SETUP,                                                                                      \
+         asm volatile (LATENCY_REPT inst " %[a], " operands "\n" END_REPT                                             \
+             : [a]"+f"(a) : [b]"f"(b) : "cr1")),                                                                      \
+     BENCHMARK_FUNC(FLOAT_SETUP double d[8];,                                                                         \
+         asm volatile (THROUGHPUT_REPT STREAMS(inst, operands) END_REPT                                               \
+             : STREAM_OUTPUTS("=&f") : [a]"f"(a), [b]"f"(b) : "cr1"))}
+
+#define FLOAT_UNARY_BENCHMARK(inst)  FLOAT_BENCHMARK(inst, "%[a]")
+#define FLOAT_BINARY_BENCHMARK(inst) FLOAT_BENCHMARK(inst, "%[a], %[b]")
+#define FLOAT_FUSED_BENCHMARK(inst)  FLOAT_BENCHMARK(inst, "%[a], %[b], %[b]")
+#define FLOAT_SELECT_BENCHMARK(inst) FLOAT_BENCHMARK(inst, "%[a], %[b], %[b]")
+
+#define FLOAT_COMPARE_BENCHMARK(inst)                                                                                 \
+    {inst,                                                                                                            \
+     nullptr,                                                                                                         \
+     BENCHMARK_FUNC(FLOAT_SETUP,                                                                                      \
+         asm volatile (THROUGHPUT_REPT CR_FIELD_STREAMS(inst, "%[a], %[b]") END_REPT                                  \
+             : : [a]"f"(a), [b]"f"(b) : "cr0", "cr1", "cr6", "cr7"))}
+
+static constexpr Benchmark float_benchmarks[] = {
+    FLOAT_UNARY_BENCHMARK("FABS"),
+    FLOAT_UNARY_BENCHMARK("FABS."),
+    FLOAT_BINARY_BENCHMARK("FADD"),
+    FLOAT_BINARY_BENCHMARK("FADD."),
+    FLOAT_BINARY_BENCHMARK("FADDS"),
+    FLOAT_BINARY_BENCHMARK("FADDS."),
+    FLOAT_COMPARE_BENCHMARK("FCMPO"),
+    FLOAT_COMPARE_BENCHMARK("FCMPU"),
+    FLOAT_UNARY_BENCHMARK("FCTIW"),
+    FLOAT_UNARY_BENCHMARK("FCTIW."),
+    FLOAT_UNARY_BENCHMARK("FCTIWZ"),
+    FLOAT_UNARY_BENCHMARK("FCTIWZ."),
+    FLOAT_BINARY_BENCHMARK("FDIV"),
+    FLOAT_BINARY_BENCHMARK("FDIV."),
+    FLOAT_BINARY_BENCHMARK("FDIVS"),
+    FLOAT_BINARY_BENCHMARK("FDIVS."),
+    FLOAT_FUSED_BENCHMARK("FMADD"),
+    FLOAT_FUSED_BENCHMARK("FMADD."),
+    FLOAT_FUSED_BENCHMARK("FMADDS"),
+    FLOAT_FUSED_BENCHMARK("FMADDS."),
+    FLOAT_FUSED_BENCHMARK("FMSUB"),
+    FLOAT_FUSED_BENCHMARK("FMSUB."),
+    FLOAT_FUSED_BENCHMARK("FMSUBS"),
+    FLOAT_FUSED_BENCHMARK("FMSUBS."),
+    FLOAT_BINARY_BENCHMARK("FMUL"),
+    FLOAT_BINARY_BENCHMARK("FMUL."),
+    FLOAT_BINARY_BENCHMARK("FMULS"),
+    FLOAT_BINARY_BENCHMARK("FMULS."),
+    FLOAT_UNARY_BENCHMARK("FNABS"),
+    FLOAT_UNARY_BENCHMARK("FNABS."),
+    FLOAT_UNARY_BENCHMARK("FNEG"),
+    FLOAT_UNARY_BENCHMARK("FNEG."),
+    FLOAT_FUSED_BENCHMARK("FNMADD"),
+    FLOAT_FUSED_BENCHMARK("FNMADD."),
+    FLOAT_FUSED_BENCHMARK("FNMADDS"),
+    FLOAT_FUSED_BENCHMARK("FNMADDS."),
+    FLOAT_FUSED_BENCHMARK("FNMSUB"),
+    FLOAT_FUSED_BENCHMARK("FNMSUB."),
+    FLOAT_FUSED_BENCHMARK("FNMSUBS"),
+    FLOAT_FUSED_BENCHMARK("FNMSUBS."),
+    FLOAT_UNARY_BENCHMARK("FRES"),
+    FLOAT_UNARY_BENCHMARK("FRES."),
+    FLOAT_UNARY_BENCHMARK("FRSP"),
+    FLOAT_UNARY_BENCHMARK("FRSP."),
+    FLOAT_UNARY_BENCHMARK("FRSQRTE"),
+    FLOAT_UNARY_BENCHMARK("FRSQRTE."),
+    FLOAT_SELECT_BENCHMARK("FSEL"),
+    FLOAT_SELECT_BENCHMARK("FSEL."),
+    FLOAT_BINARY_BENCHMARK("FSUB"),
+    FLOAT_BINARY_BENCHMARK("FSUB."),
+    FLOAT_BINARY_BENCHMARK("FSUBS"),
+    FLOAT_BINARY_BENCHMARK("FSUBS."),
+};
+
+//
+// Condition register
+//
+
+// The chain reads the bit each instruction writes. The streams write eight different
+// bits of cr0 and cr1 from the same two bits of cr6.
+#define CR_BENCHMARK(inst)                                                                                            \
+    {inst,                                                                                                            \
+     BENCHMARK_FUNC(,                                                                                                 \
+         asm volatile (LATENCY_REPT inst " 0, 0, 1\n" END_REPT : : : "cr0")),                                         \
+     BENCHMARK_FUNC(,                                                                                                 \
+         asm volatile (THROUGHPUT_REPT                                                                                \
+             inst " 0, 24, 25\n" inst " 1, 24, 25\n" inst " 2, 24, 25\n" inst " 3, 24, 25\n"                          \
+             inst " 4, 24, 25\n" inst " 5, 24, 25\n" inst " 6, 24, 25\n" inst " 7, 24, 25\n"                          \
+             END_REPT : : : "cr0", "cr1"))}
+
+static constexpr Benchmark cr_benchmarks[] = {
+    CR_BENCHMARK("CRAND"),
+    CR_BENCHMARK("CRANDC"),
+    CR_BENCHMARK("CREQV"),
+    CR_BENCHMARK("CRNAND"),
+    CR_BENCHMARK("CRNOR"),
+    CR_BENCHMARK("CROR"),
+    CR_BENCHMARK("CRORC"),
+    CR_BENCHMARK("CRXOR"),
+};
+
+//
+// Loads and stores
+//
+
+// The streams all access the same cached 8 bytes, so these measure the load/store unit rather
+// than memory (see the bandwidth benchmark below). The update forms use an offset of 0 (or an
+// index of 0), so the address stays the same. Latency is only measured for the word loads, by
+// chasing a pointer that points to itself.
+alignas(32) static void* load_store_buffer[2];
+
+#define LOAD_STORE_SETUP void* p = load_store_buffer; uint32_t x = 0; load_store_buffer[0] = load_store_buffer;
+
+#define LOAD_LATENCY(inst, operands)                                                                                  \
+    BENCHMARK_FUNC(LOAD_STORE_SETUP,                                                                                  \
+        asm volatile (LATENCY_REPT inst " %[p], " operands "\n" END_REPT : [p]"+b"(p) : [x]"r"(x) : "memory"))
+
+#define LOAD_BENCHMARK(inst, operands, latency, type, constraint)                                                     \
+    {inst,                                                                                                            \
+     latency,                                                                                                         \
+     BENCHMARK_FUNC(LOAD_STORE_SETUP type d[8];,                                                                      \
+         asm volatile (THROUGHPUT_REPT STREAMS(inst, operands) END_REPT                                               \
+             : STREAM_OUTPUTS(constraint), [p]"+b"(p) : [x]"r"(x) : "memory"))}
+
+#define STORE_BENCHMARK(inst, operands, type, constraint)                                                             \
+    {inst,                                                                                                            \
+     nullptr,                                                                                                         \
+     BENCHMARK_FUNC(LOAD_STORE_SETUP type d[8] = {};,                                                                 \
+         asm volatile (THROUGHPUT_REPT STREAMS(inst, operands) END_REPT                                               \
+             : [p]"+b"(p) : STREAM_OUTPUTS(constraint), [x]"r"(x) : "memory"))}
+
+#define INTEGER_LOAD_BENCHMARK(inst, operands)  LOAD_BENCHMARK(inst, operands, nullptr, uint32_t, "=&r")
+#define FLOAT_LOAD_BENCHMARK(inst, operands)    LOAD_BENCHMARK(inst, operands, nullptr, double, "=&f")
+#define INTEGER_STORE_BENCHMARK(inst, operands) STORE_BENCHMARK(inst, operands, uint32_t, "r")
+#define FLOAT_STORE_BENCHMARK(inst, operands)   STORE_BENCHMARK(inst, operands, double, "f")
+
+static constexpr Benchmark load_store_benchmarks[] = {
+    INTEGER_LOAD_BENCHMARK("LBZ", "0(%[p])"),
+    INTEGER_LOAD_BENCHMARK("LBZU", "0(%[p])"),
+    INTEGER_LOAD_BENCHMARK("LBZX", "%[p], %[x]"),
+    INTEGER_LOAD_BENCHMARK("LHA", "0(%[p])"),
+    INTEGER_LOAD_BENCHMARK("LHAX", "%[p], %[x]"),
+    INTEGER_LOAD_BENCHMARK("LHBRX", "%[p], %[x]"),
+    INTEGER_LOAD_BENCHMARK("LHZ", "0(%[p])"),
+    INTEGER_LOAD_BENCHMARK("LHZX", "%[p], %[x]"),
+    INTEGER_LOAD_BENCHMARK("LWBRX", "%[p], %[x]"),
+    LOAD_BENCHMARK("LWZ", "0(%[p])", LOAD_LATENCY("LWZ", "0(%[p])"), uint32_t, "=&r"),
+    INTEGER_LOAD_BENCHMARK("LWZU", "0(%[p])"),
+    LOAD_BENCHMARK("LWZX", "%[p], %[x]", LOAD_LATENCY("LWZX", "%[p], %[x]"), uint32_t, "=&r"),
+    INTEGER_LOAD_BENCHMARK("LWZUX", "%[p], %[x]"),
+    FLOAT_LOAD_BENCHMARK("LFD", "0(%[p])"),
+    FLOAT_LOAD_BENCHMARK("LFDU", "0(%[p])"),
+    FLOAT_LOAD_BENCHMARK("LFDX", "%[p], %[x]"),
+    FLOAT_LOAD_BENCHMARK("LFS", "0(%[p])"),
+    FLOAT_LOAD_BENCHMARK("LFSU", "0(%[p])"),
+    FLOAT_LOAD_BENCHMARK("LFSX", "%[p], %[x]"),
+    INTEGER_STORE_BENCHMARK("STB", "0(%[p])"),
+    INTEGER_STORE_BENCHMARK("STBX", "%[p], %[x]"),
+    INTEGER_STORE_BENCHMARK("STH", "0(%[p])"),
+    INTEGER_STORE_BENCHMARK("STHBRX", "%[p], %[x]"),
+    INTEGER_STORE_BENCHMARK("STHX", "%[p], %[x]"),
+    INTEGER_STORE_BENCHMARK("STW", "0(%[p])"),
+    INTEGER_STORE_BENCHMARK("STWBRX", "%[p], %[x]"),
+    INTEGER_STORE_BENCHMARK("STWU", "0(%[p])"),
+    INTEGER_STORE_BENCHMARK("STWX", "%[p], %[x]"),
+    INTEGER_STORE_BENCHMARK("STWUX", "%[p], %[x]"),
+    FLOAT_STORE_BENCHMARK("STFD", "0(%[p])"),
+    FLOAT_STORE_BENCHMARK("STFDU", "0(%[p])"),
+    FLOAT_STORE_BENCHMARK("STFDX", "%[p], %[x]"),
+    FLOAT_STORE_BENCHMARK("STFIWX", "%[p], %[x]"),
+    FLOAT_STORE_BENCHMARK("STFS", "0(%[p])"),
+    FLOAT_STORE_BENCHMARK("STFSU", "0(%[p])"),
+    FLOAT_STORE_BENCHMARK("STFSX", "%[p], %[x]"),
+};
+
+//
+// Memory bandwidth
+//
+
+// Each platform's memory regions (see Platform.h) are read and written from start to end with
+// eight LFD or STFD per 64 bytes, the widest accesses the tests use everywhere. The regions are
+// larger than the L2 cache, so the cached ones measure the memory behind it. The result is the
+// best of several passes, and loop overhead isn't subtracted since the accesses dominate.
+constexpr size_t BANDWIDTH_BLOCK_SIZE = 64;
+
+#define BLOCK_ACCESSES(inst)          \
+    inst " %[d0], 0(%[p])\n"          \
+    inst " %[d1], 8(%[p])\n"          \
+    inst " %[d2], 16(%[p])\n"         \
+    inst " %[d3], 24(%[p])\n"         \
+    inst " %[d4], 32(%[p])\n"         \
+    inst " %[d5], 40(%[p])\n"         \
+    inst " %[d6], 48(%[p])\n"         \
+    inst " %[d7], 56(%[p])\n"
+
+static uint32_t ReadTime(const PlatformMemoryRegion& region)
+{
+    const uint8_t* const begin = static_cast<const uint8_t*>(region.memory);
+    double d[8];
+
+    const uint32_t start = GetTimebase();
+    for (const uint8_t* p = begin; p != begin + region.size; p += BANDWIDTH_BLOCK_SIZE)
+        asm volatile (BLOCK_ACCESSES("lfd") : STREAM_OUTPUTS("=&f") : [p]"b"(p) : "memory");
+    return GetTimebase() - start;
+}
+
+static uint32_t WriteTime(const PlatformMemoryRegion& region)
+{
+    uint8_t* const begin = static_cast<uint8_t*>(region.memory);
+    const double d[8] = {};
+
+    const uint32_t start = GetTimebase();
+    for (uint8_t* p = begin; p != begin + region.size; p += BANDWIDTH_BLOCK_SIZE)
+        asm volatile (BLOCK_ACCESSES("stfd") : : STREAM_OUTPUTS("f"), [p]"b"(p) : "memory");
+    return GetTimebase() - start;
+}
+
+#ifdef GEKKO
+//
+// Paired singles
+//
+
+// Both halves of every operand are 1.0, loaded through GQR0 like the tests do (see PairedSingle.cpp).
+alignas(8) static const float ps_ones[2] = {1.0f, 1.0f};
+
+#define PS_LOAD_ONES(value) \
+    asm volatile ("psq_l %[v], 0(%[p]), 0, 0" : [v]"=f"(value) : [p]"b"(ps_ones) : "memory");
+
+#define PS_SETUP double a; double b; PS_LOAD_ONES(a) PS_LOAD_ONES(b)
+
+// Log names are shortened like the tests' (PS_ADD logs as PADD).
+#define PS_BENCHMARK(name, inst, operands)                                                                            \
+    {name,                                                                                                            \
+     BENCHMARK_FUNC(PS_SETUP,                                                                                         \
+         asm volatile (LATENCY_REPT inst " %[a], " operands "\n" END_REPT                                             \
+             : [a]"+f"(a) : [b]"f"(b) : "cr1")),                                                                      \
+     BENCHMARK_FUNC(PS_SETUP double d[8];,                                                                            \
+         asm volatile (THROUGHPUT_REPT STREAMS(inst, operands) END_REPT                                               \
+             : STREAM_OUTPUTS("=&f") : [a]"f"(a), [b]"f"(b) : "cr1"))}
+
+#define PS_UNARY_BENCHMARK(name, inst)  PS_BENCHMARK(name, inst, "%[a]")
+#define PS_BINARY_BENCHMARK(name, inst) PS_BENCHMARK(name, inst, "%[a], %[b]")
+#define PS_FUSED_BENCHMARK(name, inst)  PS_BENCHMARK(name, inst, "%[a], %[b], %[b]")
+
+#define PS_COMPARE_BENCHMARK(name, inst)                                                                              \
+    {name,                                                                                                            \
+     nullptr,                                                                                                         \
+     BENCHMARK_FUNC(PS_SETUP,                                                                                         \
+         asm volatile (THROUGHPUT_REPT CR_FIELD_STREAMS(inst, "%[a], %[b]") END_REPT                                  \
+             : : [a]"f"(a), [b]"f"(b) : "cr0", "cr1", "cr6", "cr7"))}
+
+static constexpr Benchmark ps_benchmarks[] = {
+    PS_UNARY_BENCHMARK("PABS", "ps_abs"),
+    PS_BINARY_BENCHMARK("PADD", "ps_add"),
+    PS_COMPARE_BENCHMARK("PCMPO0", "ps_cmpo0"),
+    PS_COMPARE_BENCHMARK("PCMPU0", "ps_cmpu0"),
+    PS_BINARY_BENCHMARK("PDIV", "ps_div"),
+    PS_FUSED_BENCHMARK("PMADD", "ps_madd"),
+    PS_FUSED_BENCHMARK("PMADDS0", "ps_madds0"),
+    PS_FUSED_BENCHMARK("PMADDS1", "ps_madds1"),
+    PS_BINARY_BENCHMARK("PMERGE00", "ps_merge00"),
+    PS_BINARY_BENCHMARK("PMERGE01", "ps_merge01"),
+    PS_BINARY_BENCHMARK("PMERGE10", "ps_merge10"),
+    PS_BINARY_BENCHMARK("PMERGE11", "ps_merge11"),
+    PS_UNARY_BENCHMARK("PMR", "ps_mr"),
+    PS_FUSED_BENCHMARK("PMSUB", "ps_msub"),
+    PS_BINARY_BENCHMARK("PMUL", "ps_mul"),
+    PS_BINARY_BENCHMARK("PMULS0", "ps_muls0"),
+    PS_BINARY_BENCHMARK("PMULS1", "ps_muls1"),
+    PS_UNARY_BENCHMARK("PNABS", "ps_nabs"),
+    PS_UNARY_BENCHMARK("PNEG", "ps_neg"),
+    PS_FUSED_BENCHMARK("PNMADD", "ps_nmadd"),
+    PS_FUSED_BENCHMARK("PNMSUB", "ps_nmsub"),
+    PS_UNARY_BENCHMARK("PRES", "ps_res"),
+    PS_UNARY_BENCHMARK("PRSQRTE", "ps_rsqrte"),
+    PS_FUSED_BENCHMARK("PSEL", "ps_sel"),
+    PS_BINARY_BENCHMARK("PSUB", "ps_sub"),
+    PS_FUSED_BENCHMARK("PSUM0", "ps_sum0"),
+    PS_FUSED_BENCHMARK("PSUM1", "ps_sum1"),
+};
+
+//
+// Quantized loads and stores
+//
+
+// The streams all load from or store to the same 8 bytes, converted through GQR1, which
+// the driver sets to each type in turn. The update forms use an offset of 0 (or an index
+// of 0), so the address stays the same, but each still waits on the last one's update.
+alignas(32) static float quantized_buffer[2] = {1.0f, 1.0f};
+
+#define QUANTIZED_SETUP float* p = quantized_buffer; uint32_t x = 0;
+
+#define QUANTIZED_LOAD_BENCHMARK(inst, operands)                                                                      \
+    {inst,                                                                                                            \
+     nullptr,                                                                                                         \
+     BENCHMARK_FUNC(QUANTIZED_SETUP double d[8];,                                                                     \
+         asm volatile (THROUGHPUT_REPT STREAMS(inst, operands) END_REPT                                               \
+             : STREAM_OUTPUTS("=&f"), [p]"+b"(p) : [x]"r"(x) : "memory"))}
+
+#define QUANTIZED_STORE_BENCHMARK(inst, operands)                                                                     \
+    {inst,                                                                                                            \
+     nullptr,                                                                                                         \
+     BENCHMARK_FUNC(QUANTIZED_SETUP double d[8]; for (double& value : d) PS_LOAD_ONES(value),                         \
+         asm volatile (THROUGHPUT_REPT STREAMS(inst, operands) END_REPT                                               \
+             : [p]"+b"(p) : STREAM_OUTPUTS("f"), [x]"r"(x) : "memory"))}
+
+static constexpr Benchmark quantized_benchmarks[] = {
+    QUANTIZED_LOAD_BENCHMARK("PSQ_L", "0(%[p]), 0, 1"),
+    QUANTIZED_LOAD_BENCHMARK("PSQ_LU", "0(%[p]), 0, 1"),
+    QUANTIZED_LOAD_BENCHMARK("PSQ_LX", "%[p], %[x], 0, 1"),
+    QUANTIZED_LOAD_BENCHMARK("PSQ_LUX", "%[p], %[x], 0, 1"),
+    QUANTIZED_STORE_BENCHMARK("PSQ_ST", "0(%[p]), 0, 1"),
+    QUANTIZED_STORE_BENCHMARK("PSQ_STU", "0(%[p]), 0, 1"),
+    QUANTIZED_STORE_BENCHMARK("PSQ_STX", "%[p], %[x], 0, 1"),
+    QUANTIZED_STORE_BENCHMARK("PSQ_STUX", "%[p], %[x], 0, 1"),
+};
+
+struct QuantizedType
+{
+    const char* name;
+    uint32_t type;
+};
+
+static constexpr QuantizedType quantized_types[] = {
+    {"single", 0},
+    {"u8", 4},
+    {"u16", 5},
+    {"s8", 6},
+    {"s16", 7},
+};
+#endif
+
+//
+// Carry and overflow chains (see IntegerChain.h)
+//
+
+// Each iteration repeats the chain up to 32 instructions. Latency feeds the chain's result
+// back in as a, and throughput writes it elsewhere, which still leaves the dependencies
+// through XER and between the chain's own instructions. Timings are per instruction.
+#define CHAIN_REPT_2 ".rept 16\n"
+#define CHAIN_REPT_4 ".rept 8\n"
+
+#define CHAIN_SETUP uint32_t a_lo = 0x9ABCDEF0; uint32_t a_hi = 0x12345678; uint32_t b_lo = 0xFFFFFFFF; uint32_t b_hi = 3;
+
+#define CHAIN_BENCHMARK(name, chain, rept)                                                                            \
+    {name,                                                                                                            \
+     BENCHMARK_FUNC(CHAIN_SETUP,                                                                                      \
+         asm volatile (rept chain("%[a_lo]", "%[a_hi]", "%[a_lo]", "%[a_hi]", "%[b_lo]", "%[b_hi]") END_REPT          \
+             : [a_lo]"+r"(a_lo), [a_hi]"+r"(a_hi) : [b_lo]"r"(b_lo), [b_hi]"r"(b_hi) : "cr0", "xer")),               \
+     BENCHMARK_FUNC(CHAIN_SETUP uint32_t d[2];,                                                                       \
+         asm volatile (rept chain("%[d0]", "%[d1]", "%[a_lo]", "%[a_hi]", "%[b_lo]", "%[b_hi]") END_REPT              \
+             : [d0]"=&r"(d[0]), [d1]"=&r"(d[1])                                                                       \
+             : [a_lo]"r"(a_lo), [a_hi]"r"(a_hi), [b_lo]"r"(b_lo), [b_hi]"r"(b_hi) : "cr0", "xer"))}
+
+static constexpr Benchmark chain_benchmarks[] = {
+    CHAIN_BENCHMARK("ADD64", CHAIN_ADD64, CHAIN_REPT_2),
+    CHAIN_BENCHMARK("ADD64O.", CHAIN_ADD64O, CHAIN_REPT_2),
+    CHAIN_BENCHMARK("SUB64", CHAIN_SUB64, CHAIN_REPT_2),
+    CHAIN_BENCHMARK("SUB64O.", CHAIN_SUB64O, CHAIN_REPT_2),
+    CHAIN_BENCHMARK("NEG64", CHAIN_NEG64, CHAIN_REPT_2),
+    CHAIN_BENCHMARK("INC64", CHAIN_INC64, CHAIN_REPT_2),
+    CHAIN_BENCHMARK("DEC64", CHAIN_DEC64, CHAIN_REPT_2),
+    CHAIN_BENCHMARK("CSUM", CHAIN_CSUM, CHAIN_REPT_4),
+    CHAIN_BENCHMARK("SRAWIZE", CHAIN_SRAWIZE, CHAIN_REPT_4),
+    CHAIN_BENCHMARK("CMPCARRY", CHAIN_CMPCARRY, CHAIN_REPT_4),
+    CHAIN_BENCHMARK("CAKEEP.", CHAIN_CAKEEP, CHAIN_REPT_4),
+    CHAIN_BENCHMARK("SOSTICK.", CHAIN_SOSTICK, CHAIN_REPT_2),
+    CHAIN_BENCHMARK("OVCLEAR.", CHAIN_OVCLEAR, CHAIN_REPT_2),
+    CHAIN_BENCHMARK("MULSUBO.", CHAIN_MULSUBO, CHAIN_REPT_2),
+};
+
+//
+// Driver
+//
+
+static uint32_t BestTime(BenchmarkFunc func)
+{
+    uint32_t best = UINT32_MAX;
+    for (uint32_t run = 0; run < BENCHMARK_RUNS; run++)
+    {
+        const uint32_t ticks = func(BENCHMARK_ITERATIONS);
+        if (ticks < best)
+            best = ticks;
+    }
+    return best;
+}
+
+// Converts a time to hundredths of a cycle per instruction, rounded to nearest.
+static uint64_t CyclesPerInstruction(uint32_t ticks, uint32_t loop_ticks)
+{
+    const uint64_t instructions = uint64_t{BENCHMARK_UNROLL} * BENCHMARK_ITERATIONS;
+    const uint64_t cycles = static_cast<uint64_t>(ticks > loop_ticks ? ticks - loop_ticks : 0) * PlatformCyclesPerTimebaseTick();
+    return (cycles * 100 + instructions / 2) / instructions;
+}
+
+// Converts a time to hundredths of a byte per cycle, rounded to nearest.
+static uint64_t BytesPerCycle(uint32_t ticks, size_t bytes)
+{
+    const uint64_t cycles = uint64_t{ticks} * PlatformCyclesPerTimebaseTick();
+    return cycles != 0 ? (uint64_t{bytes} * 100 + cycles / 2) / cycles : 0;
+}
+
+static void RunBandwidthBenchmarks()
+{
+    const PlatformMemoryRegion* regions = nullptr;
+    const size_t region_count = PlatformGetMemoryRegions(&regions);
+
+    for (size_t i = 0; i < region_count; i++)
+    {
+        uint32_t read_ticks = UINT32_MAX;
+        uint32_t write_ticks = UINT32_MAX;
+        for (uint32_t run = 0; run < BENCHMARK_RUNS; run++)
+        {
+            const uint32_t read = ReadTime(regions[i]);
+            const uint32_t write = WriteTime(regions[i]);
+            if (read < read_ticks)
+                read_ticks = read;
+            if (write < write_ticks)
+                write_ticks = write;
+        }
+
+        LogRecord record = MakeLogRecord(LogForm::MemoryBandwidth, regions[i].name);
+        record.result = BytesPerCycle(read_ticks, regions[i].size);
+        record.operands[0] = BytesPerCycle(write_ticks, regions[i].size);
+        record.operands[1] = regions[i].size;
+        LogResult(record);
+    }
+}
+
+// Times each exception from the instruction that raises it to the handler, as the latency, and
+// to the instruction after it once the handler returns, as the throughput of raising them back
+// to back. Each is only one event, so these are whole timebase ticks.
+static void RunExceptionBenchmarks()
+{
+    for (const ExceptionTest& test : exception_tests)
+    {
+        uint32_t delivery_ticks = UINT32_MAX;
+        uint32_t return_ticks = UINT32_MAX;
+        for (uint32_t run = 0; run < BENCHMARK_RUNS; run++)
+        {
+            PlatformExceptionSite site{};
+            PlatformExceptionState state{};
+
+            ClearFPSCR();
+            if (!PlatformCatchException(test.exception, test.raise, &site, &state))
+                continue;
+
+            if (state.timebase - site.before < delivery_ticks)
+                delivery_ticks = state.timebase - site.before;
+            if (site.after - site.before < return_ticks)
+                return_ticks = site.after - site.before;
+        }
+        ClearFPSCR();
+
+        const uint64_t hundredths_per_tick = uint64_t{PlatformCyclesPerTimebaseTick()} * 100;
+        LogRecord record = MakeLogRecord(LogForm::InstructionTiming, test.name);
+        record.result = delivery_ticks != UINT32_MAX ? delivery_ticks * hundredths_per_tick : TIMING_NOT_MEASURED;
+        record.operands[0] = return_ticks != UINT32_MAX ? return_ticks * hundredths_per_tick : 0;
+        record.operands[1] = 1;
+        LogResult(record);
+    }
+}
+
+template <size_t N>
+static void RunBenchmarks(const Benchmark (&benchmarks)[N], uint32_t loop_ticks)
+{
+    for (const Benchmark& benchmark : benchmarks)
+    {
+        LogRecord record = MakeLogRecord(LogForm::InstructionTiming, benchmark.inst);
+        record.result = benchmark.latency != nullptr ? CyclesPerInstruction(BestTime(benchmark.latency), loop_ticks)
+                                                     : TIMING_NOT_MEASURED;
+        record.operands[0] = CyclesPerInstruction(BestTime(benchmark.throughput), loop_ticks);
+        record.operands[1] = uint64_t{BENCHMARK_UNROLL} * BENCHMARK_ITERATIONS;
+        LogResult(record);
+    }
+}
+
+void PPCBenchmarks()
+{
+    // The same loop as the benchmarks, without anything in it.
+    const uint32_t loop_ticks = BestTime(BENCHMARK_FUNC(, asm volatile ("")));
+
+    printf("Instruction Benchmarks (cycles per instruction, %" PRIu32 " cycles per timebase tick, loop overhead %" PRIu32 " ticks)\n\n",
+           PlatformCyclesPerTimebaseTick(), loop_ticks);
+
+    printf("Integer\n");
+    RunBenchmarks(integer_benchmarks, loop_ticks);
+
+    printf("\nFloating-Point\n");
+    RunBenchmarks(float_benchmarks, loop_ticks);
+
+    printf("\nCondition Register\n");
+    RunBenchmarks(cr_benchmarks, loop_ticks);
+
+#ifdef GEKKO
+    // The GQRs belong to whatever else runs, so they're put back afterwards.
+    const uint32_t saved_gqr0 = GetGQR0();
+    const uint32_t saved_gqr1 = GetGQR1();
+    SetGQR0(0);
+
+    printf("\nPaired Single\n");
+    RunBenchmarks(ps_benchmarks, loop_ticks);
+
+    for (const QuantizedType& type : quantized_types)
+    {
+        SetGQR1(MakeGQR(type.type, 0, type.type, 0));
+        printf("\nQuantized Load/Store (%s)\n", type.name);
+        RunBenchmarks(quantized_benchmarks, loop_ticks);
+    }
+
+    SetGQR1(saved_gqr1);
+    SetGQR0(saved_gqr0);
+#endif
+
+    printf("\nLoad/Store\n");
+    RunBenchmarks(load_store_benchmarks, loop_ticks);
+
+    printf("\nMemory Bandwidth (bytes per cycle)\n");
+    RunBandwidthBenchmarks();
+
+    printf("\nCarry Chains\n");
+    RunBenchmarks(chain_benchmarks, loop_ticks);
+
+    printf("\nExceptions (cycles to the handler, and back to the next instruction)\n");
+    RunExceptionBenchmarks();
+}
+#endif
@@ -0,0 +1,182 @@
+#ifdef FUZZ_TESTS
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstdio>
+
+#include "BlockFuzz.h"
+#include "CodeBuffer.h"
+#include "Encoding.h"
+#include "Log.h"
+#include "Tests.h"
+
+static_assert(FUZZ_BLOCK_SIZE >= 1 && FUZZ_BLOCK_SIZE <= BLOCK_MAX_INSTRUCTIONS, "FUZZ_BLOCK_SIZE is out of range");
+
+// The registers the pool's GPRs live in. r5 points to the frame, and r12 is used to move the
+// CR and XER in and out. All of them are volatile, so the generated code doesn't save them.
+static constexpr uint32_t block_gprs[BLOCK_GPR_COUNT] = {3, 4, 6, 7, 8, 9, 10, 11};
+constexpr uint32_t BLOCK_FRAME_REGISTER = 5;
+constexpr uint32_t BLOCK_SCRATCH_GPR = 12;
+
+// f0-f7 hold the pool's FPRs, and f8 moves the FPSCR.
+constexpr uint32_t BLOCK_SCRATCH_FPR = 8;
+
+// The state as the generated code loads and stores it, through r5.
+struct BlockFrame
+{
+    uint64_t fpr[BLOCK_FPR_COUNT];
+    uint64_t fpscr; // As mtfsf takes it and mffs stores it, with the FPSCR in the lower word.
+    uint32_t gpr[BLOCK_GPR_COUNT];
+    uint32_t cr;
+    uint32_t xer;
+    uint32_t saved_cr; // The caller's CR. cr2-cr4 are nonvolatile, and blocks write any field.
+};
+
+static uint32_t EncodeBlockInstruction(const BlockInstruction& inst)
+{
+    const BlockOpcode& opcode = *inst.opcode;
+    const bool oe = inst.inst.oe;
+    const bool rc = inst.inst.rc;
+    const uint32_t d = block_gprs[inst.d];
+    const uint32_t a = block_gprs[inst.a];
+    const uint32_t b = block_gprs[inst.b];
+
+    switch (opcode.form)
+    {
+    case BlockForm::IntegerBinary:
+        return EncodeXForm(opcode.opcode, d, a, b, opcode.xo | (oe ? 0x200 : 0), rc);
+    case BlockForm::IntegerUnary:
+        return EncodeXForm(opcode.opcode, d, a, 0, opcode.xo | (oe ? 0x200 : 0), rc);
+    case BlockForm::LogicalBinary:
+        return EncodeXForm(opcode.opcode, a, d, b, opcode.xo, rc);
+    case BlockForm::LogicalUnary:
+        return EncodeXForm(opcode.opcode, a, d, 0, opcode.xo, rc);
+    case BlockForm::Compare:
+        return EncodeXForm(opcode.opcode, 0, a, b, opcode.xo, false);
+    case BlockForm::Immediate:
+        return EncodeDForm(opcode.opcode, d, a, inst.imm);
+    case BlockForm::LogicalImmediate:
+        return EncodeDForm(opcode.opcode, a, d, inst.imm);
+    case BlockForm::CompareImmediate:
+        return EncodeDForm(opcode.opcode, 0, a, inst.imm);
+    case BlockForm::ShiftImmediate:
+        return EncodeXForm(opcode.opcode, a, d, inst.imm, opcode.xo, rc);
+    case BlockForm::Rotate:
+        return EncodeMForm(opcode.opcode, a, d, inst.imm, inst.mb, inst.me, rc);
+    case BlockForm::ConditionRegister:
+        return EncodeCRLogical(opcode.xo, inst.d, inst.a, inst.b);
+
+    // The FPRs are numbered like the pool. The X-form unary instructions and compares are
+    // encoded as A-form ones without frC, whose field their longer extended opcodes extend into.
+    case BlockForm::FloatUnary:
+        return EncodeAForm(opcode.opcode, inst.d, 0, inst.b, 0, opcode.xo, rc);
+    case BlockForm::FloatBinary:
+        return EncodeAForm(opcode.opcode, inst.d, inst.a, inst.b, 0, opcode.xo, rc);
+    case BlockForm::FloatMultiply:
+        return EncodeAForm(opcode.opcode, inst.d, inst.a, 0, inst.c, opcode.xo, rc);
+    case BlockForm::FloatTernary:
+        return EncodeAForm(opcode.opcode, inst.d, inst.a, inst.b, inst.c, opcode.xo, rc);
+    case BlockForm::FloatCompare:
+        return EncodeAForm(opcode.opcode, inst.d << 2, inst.a, inst.b, 0, opcode.xo, false);
+    }
+
+    return 0;
+}
+
+// Runs a block from the given state, and leaves the state at the end of it there.
+static void RunBlock(const BlockInstruction* block, size_t count, BlockState& state)
+{
+    BlockFrame frame{};
+    for (size_t i = 0; i < BLOCK_FPR_COUNT; i++)
+        frame.fpr[i] = state.fpr[i];
+    for (size_t i = 0; i < BLOCK_GPR_COUNT; i++)
+        frame.gpr[i] = state.gpr[i];
+    frame.fpscr = state.fpscr;
+    frame.cr = state.cr;
+    frame.xer = state.xer;
+
+    constexpr uint32_t frame_register = BLOCK_FRAME_REGISTER;
+    constexpr uint32_t scratch = BLOCK_SCRATCH_GPR;
+    const auto lwz = [](uint32_t rD, size_t offset) { return EncodeDForm(32, rD, frame_register, static_cast<uint32_t>(offset)); };
+    const auto stw = [](uint32_t rS, size_t offset) { return EncodeDForm(36, rS, frame_register, static_cast<uint32_t>(offset)); };
+    const auto lfd = [](uint32_t frD, size_t offset) { return EncodeDForm(50, frD, frame_register, static_cast<uint32_t>(offset)); };
+    const auto stfd = [](uint32_t frS, size_t offset) { return EncodeDForm(54, frS, frame_register, static_cast<uint32_t>(offset)); };
+
+    uint32_t code[BLOCK_MAX_INSTRUCTIONS + 64];
+    size_t length = 0;
+
+    code[length++] = EncodeMFCR(scratch);
+    code[length++] = stw(scratch, offsetof(BlockFrame, saved_cr));
+    code[length++] = lwz(scratch, offsetof(BlockFrame, cr));
+    code[length++] = EncodeMTCRF(0xFF, scratch);
+    code[length++] = lwz(scratch, offsetof(BlockFrame, xer));
+    code[length++] = EncodeMTSPR(SPR_XER, scratch);
+    code[length++] = lfd(BLOCK_SCRATCH_FPR, offsetof(BlockFrame, fpscr));
+    code[length++] = EncodeMTFSF(0xFF, BLOCK_SCRATCH_FPR);
+    for (size_t i = 0; i < BLOCK_GPR_COUNT; i++)
+        code[length++] = lwz(block_gprs[i], offsetof(BlockFrame, gpr) + i * sizeof(uint32_t));
+    for (uint32_t i = 0; i < BLOCK_FPR_COUNT; i++)
+        code[length++] = lfd(i, offsetof(BlockFrame, fpr) + i * sizeof(uint64_t));
+
+    for (size_t i = 0; i < count; i++)
+        code[length++] = EncodeBlockInstruction(block[i]);
+
+    for (size_t i = 0; i < BLOCK_GPR_COUNT; i++)
+        code[length++] = stw(block_gprs[i], offsetof(BlockFrame, gpr) + i * sizeof(uint32_t));
+    for (uint32_t i = 0; i < BLOCK_FPR_COUNT; i++)
+        code[length++] = stfd(i, offsetof(BlockFrame, fpr) + i * sizeof(uint64_t));
+    code[length++] = EncodeMFCR(scratch);
+    code[length++] = stw(scratch, offsetof(BlockFrame, cr));
+    code[length++] = EncodeMFSPR(scratch, SPR_XER);
+    code[length++] = stw(scratch, offsetof(BlockFrame, xer));
+    code[length++] = EncodeMFFS(BLOCK_SCRATCH_FPR);
+    code[length++] = stfd(BLOCK_SCRATCH_FPR, offsetof(BlockFrame, fpscr));
+    code[length++] = lwz(scratch, offsetof(BlockFrame, saved_cr));
+    code[length++] = EncodeMTCRF(0xFF, scratch);
+
+    const GeneratedFunction function = EmitCode(code, length);
+    function(0, 0, &frame);
+
+    // The FPSCR the block left is the caller's now.
+    ClearFPSCR();
+
+    for (size_t i = 0; i < BLOCK_FPR_COUNT; i++)
+        state.fpr[i] = frame.fpr[i];
+    for (size_t i = 0; i < BLOCK_GPR_COUNT; i++)
+        state.gpr[i] = frame.gpr[i];
+    state.fpscr = static_cast<uint32_t>(frame.fpscr);
+    state.cr = frame.cr;
+    state.xer = frame.xer;
+}
+
+void PPCBlockFuzzTests()
+{
+    printf("\n\nBlock Fuzz Tests (seed 0x%016" PRIX64 ", %" PRIu32 " blocks of %" PRIu32 " instructions)\n\n",
+           static_cast<uint64_t>(FUZZ_SEED), static_cast<uint32_t>(FUZZ_BLOCKS), static_cast<uint32_t>(FUZZ_BLOCK_SIZE));
+
+    // Offset from the other fuzz tests' seeds, so none of them share a sequence.
+    uint64_t seed = static_cast<uint64_t>(FUZZ_SEED) * 0xBF58476D1CE4E5B9;
+
+    for (uint32_t i = 0; i < FUZZ_BLOCKS; i++)
+    {
+        // The state and block both come from the block's own seed, which is all the log needs.
+        seed += 0x9E3779B97F4A7C15;
+        Random random(seed);
+
+        BlockState state;
+        GenerateBlockState(random, state);
+
+        BlockInstruction block[FUZZ_BLOCK_SIZE];
+        GenerateBlock(random, block, FUZZ_BLOCK_SIZE);
+
+        RunBlock(block, FUZZ_BLOCK_SIZE, state);
+
+        LogRecord record = MakeLogRecord(LogForm::InstructionBlock, "BLOCK");
+        record.result = HashBlockState(state);
+        record.operands[0] = seed;
+        record.operands[1] = FUZZ_BLOCK_SIZE;
+        LogResult(record);
+    }
+}
+
+#endif
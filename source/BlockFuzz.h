@@ -0,0 +1,346 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "Digest.h"
+#include "Encoding.h"
+#include "FloatClasses.h"
+#include "PPCModel.h"
+#include "Random.h"
+
+// Straight-line instruction blocks.
+//
+// Every other test runs one instruction at a time, so nothing checks what a JIT does across
+// instructions: caching registers, propagating constants, or leaving CA, the CR fields and
+// the FPSCR in host flags until something reads them. The block fuzz tests generate random
+// blocks of the instructions the tests cover, working on a small pool of registers, and run
+// each one from a random initial state. Only a hash of the state at the end of the block is
+// logged, along with the seed both were generated from.
+//
+// The tests and the host tools generate the same block from the same seed, so this header
+// must not depend on anything target-specific. tools/modelcheck runs the block through the
+// model (see ModelBlock) and checks the hash.
+
+// Registers a block works on. The tests keep them in r3, r4 and r6-r11, and f0-f7.
+constexpr size_t BLOCK_GPR_COUNT = 8;
+constexpr size_t BLOCK_FPR_COUNT = 8;
+
+// Longest block the tests generate, and the host tools accept.
+constexpr size_t BLOCK_MAX_INSTRUCTIONS = 256;
+
+struct BlockState
+{
+    uint32_t gpr[BLOCK_GPR_COUNT];
+    uint64_t fpr[BLOCK_FPR_COUNT];
+    uint32_t cr;
+    uint32_t xer;
+    uint32_t fpscr;
+};
+
+// How an instruction's operands are encoded. The destination comes first, as in assembly.
+enum class BlockForm : uint8_t
+{
+    IntegerBinary,     // rD, rA, rB
+    IntegerUnary,      // rD, rA
+    LogicalBinary,     // rA, rS, rB. rS goes in the first field, like in EncodeXForm.
+    LogicalUnary,      // rA, rS
+    Compare,           // cr0, rA, rB. The model only compares into cr0.
+    Immediate,         // rD, rA, SIMM
+    LogicalImmediate,  // rA, rS, UIMM
+    CompareImmediate,  // cr0, rA, SIMM or UIMM
+    ShiftImmediate,    // rA, rS, SH
+    Rotate,            // rA, rS, SH, MB, ME
+    ConditionRegister, // crbD, crbA, crbB
+    FloatUnary,        // frD, frB
+    FloatBinary,       // frD, frA, frB
+    FloatMultiply,     // frD, frA, frC
+    FloatTernary,      // frD, frA, frC, frB
+    FloatCompare,      // crfD, frA, frB
+};
+
+// Whether an instruction has a record (.) form.
+enum class BlockRecord : uint8_t
+{
+    Never,
+    Optional,
+    Always, // ANDI., ANDIS. and ADDIC., which can only be encoded as the record form.
+};
+
+struct BlockOpcode
+{
+    ModelOp op;
+    BlockForm form;
+    uint8_t opcode;
+    uint16_t xo; // Extended opcode, where the form has one.
+    bool oe;     // Has an O form.
+    BlockRecord rc;
+};
+
+constexpr BlockOpcode block_opcodes[] = {
+    {ModelOp::Add, BlockForm::IntegerBinary, 31, 266, true, BlockRecord::Optional},
+    {ModelOp::Addc, BlockForm::IntegerBinary, 31, 10, true, BlockRecord::Optional},
+    {ModelOp::Adde, BlockForm::IntegerBinary, 31, 138, true, BlockRecord::Optional},
+    {ModelOp::Divw, BlockForm::IntegerBinary, 31, 491, true, BlockRecord::Optional},
+    {ModelOp::Divwu, BlockForm::IntegerBinary, 31, 459, true, BlockRecord::Optional},
+    {ModelOp::Mulhw, BlockForm::IntegerBinary, 31, 75, false, BlockRecord::Optional},
+    {ModelOp::Mulhwu, BlockForm::IntegerBinary, 31, 11, false, BlockRecord::Optional},
+    {ModelOp::Mullw, BlockForm::IntegerBinary, 31, 235, true, BlockRecord::Optional},
+    {ModelOp::Subf, BlockForm::IntegerBinary, 31, 40, true, BlockRecord::Optional},
+    {ModelOp::Subfc, BlockForm::IntegerBinary, 31, 8, true, BlockRecord::Optional},
+    {ModelOp::Subfe, BlockForm::IntegerBinary, 31, 136, true, BlockRecord::Optional},
+
+    {ModelOp::Addme, BlockForm::IntegerUnary, 31, 234, true, BlockRecord::Optional},
+    {ModelOp::Addze, BlockForm::IntegerUnary, 31, 202, true, BlockRecord::Optional},
+    {ModelOp::Neg, BlockForm::IntegerUnary, 31, 104, true, BlockRecord::Optional},
+    {ModelOp::Subfme, BlockForm::IntegerUnary, 31, 232, true, BlockRecord::Optional},
+    {ModelOp::Subfze, BlockForm::IntegerUnary, 31, 200, true, BlockRecord::Optional},
+
+    {ModelOp::And, BlockForm::LogicalBinary, 31, 28, false, BlockRecord::Optional},
+    {ModelOp::Andc, BlockForm::LogicalBinary, 31, 60, false, BlockRecord::Optional},
+    {ModelOp::Eqv, BlockForm::LogicalBinary, 31, 284, false, BlockRecord::Optional},
+    {ModelOp::Nand, BlockForm::LogicalBinary, 31, 476, false, BlockRecord::Optional},
+    {ModelOp::Nor, BlockForm::LogicalBinary, 31, 124, false, BlockRecord::Optional},
+    {ModelOp::Or, BlockForm::LogicalBinary, 31, 444, false, BlockRecord::Optional},
+    {ModelOp::Orc, BlockForm::LogicalBinary, 31, 412, false, BlockRecord::Optional},
+    {ModelOp::Slw, BlockForm::LogicalBinary, 31, 24, false, BlockRecord::Optional},
+    {ModelOp::Sraw, BlockForm::LogicalBinary, 31, 792, false, BlockRecord::Optional},
+    {ModelOp::Srw, BlockForm::LogicalBinary, 31, 536, false, BlockRecord::Optional},
+    {ModelOp::Xor, BlockForm::LogicalBinary, 31, 316, false, BlockRecord::Optional},
+
+    {ModelOp::Cntlzw, BlockForm::LogicalUnary, 31, 26, false, BlockRecord::Optional},
+    {ModelOp::Extsb, BlockForm::LogicalUnary, 31, 954, false, BlockRecord::Optional},
+    {ModelOp::Extsh, BlockForm::LogicalUnary, 31, 922, false, BlockRecord::Optional},
+
+    {ModelOp::Cmp, BlockForm::Compare, 31, 0, false, BlockRecord::Never},
+    {ModelOp::Cmpl, BlockForm::Compare, 31, 32, false, BlockRecord::Never},
+
+    {ModelOp::Addi, BlockForm::Immediate, 14, 0, false, BlockRecord::Never},
+    {ModelOp::Addic, BlockForm::Immediate, 12, 0, false, BlockRecord::Never},
+    {ModelOp::Addic, BlockForm::Immediate, 13, 0, false, BlockRecord::Always},
+    {ModelOp::Addis, BlockForm::Immediate, 15, 0, false, BlockRecord::Never},
+    {ModelOp::Mulli, BlockForm::Immediate, 7, 0, false, BlockRecord::Never},
+    {ModelOp::Subfic, BlockForm::Immediate, 8, 0, false, BlockRecord::Never},
+
+    {ModelOp::Andi, BlockForm::LogicalImmediate, 28, 0, false, BlockRecord::Always},
+    {ModelOp::Andis, BlockForm::LogicalImmediate, 29, 0, false, BlockRecord::Always},
+    {ModelOp::Ori, BlockForm::LogicalImmediate, 24, 0, false, BlockRecord::Never},
+    {ModelOp::Oris, BlockForm::LogicalImmediate, 25, 0, false, BlockRecord::Never},
+    {ModelOp::Xori, BlockForm::LogicalImmediate, 26, 0, false, BlockRecord::Never},
+    {ModelOp::Xoris, BlockForm::LogicalImmediate, 27, 0, false, BlockRecord::Never},
+
+    {ModelOp::Cmpi, BlockForm::CompareImmediate, 11, 0, false, BlockRecord::Never},
+    {ModelOp::Cmpli, BlockForm::CompareImmediate, 10, 0, false, BlockRecord::Never},
+
+    {ModelOp::Srawi, BlockForm::ShiftImmediate, 31, 824, false, BlockRecord::Optional},
+
+    {ModelOp::Rlwimi, BlockForm::Rotate, 20, 0, false, BlockRecord::Optional},
+    {ModelOp::Rlwinm, BlockForm::Rotate, 21, 0, false, BlockRecord::Optional},
+
+    {ModelOp::Crand, BlockForm::ConditionRegister, 19, XO_CRAND, false, BlockRecord::Never},
+    {ModelOp::Crandc, BlockForm::ConditionRegister, 19, XO_CRANDC, false, BlockRecord::Never},
+    {ModelOp::Creqv, BlockForm::ConditionRegister, 19, XO_CREQV, false, BlockRecord::Never},
+    {ModelOp::Crnand, BlockForm::ConditionRegister, 19, XO_CRNAND, false, BlockRecord::Never},
+    {ModelOp::Crnor, BlockForm::ConditionRegister, 19, XO_CRNOR, false, BlockRecord::Never},
+    {ModelOp::Cror, BlockForm::ConditionRegister, 19, XO_CROR, false, BlockRecord::Never},
+    {ModelOp::Crorc, BlockForm::ConditionRegister, 19, XO_CRORC, false, BlockRecord::Never},
+    {ModelOp::Crxor, BlockForm::ConditionRegister, 19, XO_CRXOR, false, BlockRecord::Never},
+
+    {ModelOp::Fabs, BlockForm::FloatUnary, 63, 264, false, BlockRecord::Optional},
+    {ModelOp::Fctiw, BlockForm::FloatUnary, 63, 14, false, BlockRecord::Optional},
+    {ModelOp::Fctiwz, BlockForm::FloatUnary, 63, 15, false, BlockRecord::Optional},
+    {ModelOp::Fnabs, BlockForm::FloatUnary, 63, 136, false, BlockRecord::Optional},
+    {ModelOp::Fneg, BlockForm::FloatUnary, 63, 40, false, BlockRecord::Optional},
+    {ModelOp::Fres, BlockForm::FloatUnary, 59, 24, false, BlockRecord::Optional},
+    {ModelOp::Frsp, BlockForm::FloatUnary, 63, 12, false, BlockRecord::Optional},
+    {ModelOp::Frsqrte, BlockForm::FloatUnary, 63, 26, false, BlockRecord::Optional},
+
+    {ModelOp::Fadd, BlockForm::FloatBinary, 63, 21, false, BlockRecord::Optional},
+    {ModelOp::Fadds, BlockForm::FloatBinary, 59, 21, false, BlockRecord::Optional},
+    {ModelOp::Fdiv, BlockForm::FloatBinary, 63, 18, false, BlockRecord::Optional},
+    {ModelOp::Fdivs, BlockForm::FloatBinary, 59, 18, false, BlockRecord::Optional},
+    {ModelOp::Fsub, BlockForm::FloatBinary, 63, 20, false, BlockRecord::Optional},
+    {ModelOp::Fsubs, BlockForm::FloatBinary, 59, 20, false, BlockRecord::Optional},
+
+    {ModelOp::Fmul, BlockForm::FloatMultiply, 63, 25, false, BlockRecord::Optional},
+    {ModelOp::Fmuls, BlockForm::FloatMultiply, 59, 25, false, BlockRecord::Optional},
+
+    {ModelOp::Fmadd, BlockForm::FloatTernary, 63, 29, false, BlockRecord::Optional},
+    {ModelOp::Fmadds, BlockForm::FloatTernary, 59, 29, false, BlockRecord::Optional},
+    {ModelOp::Fmsub, BlockForm::FloatTernary, 63, 28, false, BlockRecord::Optional},
+    {ModelOp::Fmsubs, BlockForm::FloatTernary, 59, 28, false, BlockRecord::Optional},
+    {ModelOp::Fnmadd, BlockForm::FloatTernary, 63, 31, false, BlockRecord::Optional},
+    {ModelOp::Fnmadds, BlockForm::FloatTernary, 59, 31, false, BlockRecord::Optional},
+    {ModelOp::Fnmsub, BlockForm::FloatTernary, 63, 30, false, BlockRecord::Optional},
+    {ModelOp::Fnmsubs, BlockForm::FloatTernary, 59, 30, false, BlockRecord::Optional},
+    {ModelOp::Fsel, BlockForm::FloatTernary, 63, 23, false, BlockRecord::Optional},
+
+    {ModelOp::Fcmpo, BlockForm::FloatCompare, 63, 32, false, BlockRecord::Never},
+    {ModelOp::Fcmpu, BlockForm::FloatCompare, 63, 0, false, BlockRecord::Never},
+};
+
+// One generated instruction. Register operands are indices into the pool, and CR operands
+// bit (or field) numbers.
+struct BlockInstruction
+{
+    const BlockOpcode* opcode;
+    ModelInstruction inst;
+    uint8_t d;
+    uint8_t a;
+    uint8_t b;
+    uint8_t c;
+    uint32_t imm; // SIMM/UIMM, or SH for SRAWI and the rotates.
+    uint8_t mb;
+    uint8_t me;
+};
+
+// Initial register values are boundary values a quarter of the time, small signed values a
+// quarter of the time, and uniformly random otherwise.
+inline uint32_t GenerateBlockGPR(Random& random)
+{
+    static constexpr uint32_t boundary_values[] = {0, 1, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF};
+
+    const uint64_t value = random.Next();
+    switch (value & 3)
+    {
+    case 0:
+        return boundary_values[(value >> 8) % std::size(boundary_values)];
+    case 1:
+        return static_cast<uint32_t>(static_cast<int32_t>(static_cast<int8_t>(value >> 8)));
+    default:
+        return static_cast<uint32_t>(value >> 32);
+    }
+}
+
+// The initial state: random registers and CR, a random XER (with only its implemented bits),
+// and the FPSCR of one of the floating-point modes (see GetInitialFPSCR).
+inline void GenerateBlockState(Random& random, BlockState& state)
+{
+    for (uint32_t& gpr : state.gpr)
+        gpr = GenerateBlockGPR(random);
+    for (uint64_t& fpr : state.fpr)
+        fpr = GenerateFloat(random, (random.Next() & 1) != 0);
+
+    state.cr = static_cast<uint32_t>(random.Next());
+    state.xer = static_cast<uint32_t>(random.Next()) & XER_MASK;
+
+    constexpr uint64_t first_mode = static_cast<uint64_t>(LogMode::RoundToNearest);
+    constexpr uint64_t mode_count = static_cast<uint64_t>(LogMode::StickyExceptionsEnabled) - first_mode + 1;
+    state.fpscr = GetInitialFPSCR(static_cast<LogMode>(first_mode + random.Next() % mode_count));
+}
+
+// Generates count instructions, with opcodes and operands picked uniformly. Immediates are small
+// half the time, so adds and compares produce carries and equal results as often as not.
+inline void GenerateBlock(Random& random, BlockInstruction* block, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint64_t value = random.Next();
+        const BlockOpcode& opcode = block_opcodes[value % std::size(block_opcodes)];
+        const uint64_t fields = random.Next();
+
+        BlockInstruction& inst = block[i];
+        inst.opcode = &opcode;
+        inst.inst.op = opcode.op;
+        inst.inst.cls = opcode.form == BlockForm::ConditionRegister ? ModelClass::ConditionRegister
+                        : opcode.form >= BlockForm::FloatUnary      ? ModelClass::FloatingPoint
+                                                                    : ModelClass::Integer;
+        inst.inst.oe = opcode.oe && (value & (1ULL << 62)) != 0;
+        inst.inst.rc = opcode.rc == BlockRecord::Always || (opcode.rc == BlockRecord::Optional && (value & (1ULL << 63)) != 0);
+
+        if (opcode.form == BlockForm::ConditionRegister)
+        {
+            inst.d = fields & 31;
+            inst.a = (fields >> 5) & 31;
+            inst.b = (fields >> 10) & 31;
+        }
+        else
+        {
+            inst.d = fields & 7;
+            inst.a = (fields >> 3) & 7;
+            inst.b = (fields >> 6) & 7;
+            inst.c = (fields >> 9) & 7;
+        }
+
+        inst.imm = (fields & (1ULL << 12)) != 0 ? static_cast<uint32_t>(fields >> 16) & 0xFFFF
+                                                 : static_cast<uint32_t>(static_cast<int32_t>(static_cast<int8_t>(fields >> 16))) & 0xFFFF;
+        inst.mb = (fields >> 32) & 31;
+        inst.me = (fields >> 37) & 31;
+        if (opcode.form == BlockForm::ShiftImmediate || opcode.form == BlockForm::Rotate)
+            inst.imm = (fields >> 42) & 31;
+    }
+}
+
+// Hashes the state at the end of a block.
+inline uint64_t HashBlockState(const BlockState& state)
+{
+    ResultDigest digest;
+    for (size_t i = 0; i < BLOCK_GPR_COUNT; i += 2)
+        digest.Add((static_cast<uint64_t>(state.gpr[i]) << 32) | state.gpr[i + 1]);
+    for (const uint64_t fpr : state.fpr)
+        digest.Add(fpr);
+    digest.Add((static_cast<uint64_t>(state.cr) << 32) | state.xer);
+    digest.Add(state.fpscr);
+    return digest.Finish();
+}
+
+// Runs a block through the model. Host tools only, since the floating-point model is.
+inline void ModelBlock(const BlockInstruction* block, size_t count, BlockState& state)
+{
+    ModelState model{state.cr, state.xer, state.fpscr};
+    uint32_t* const gpr = state.gpr;
+    uint64_t* const fpr = state.fpr;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const BlockInstruction& inst = block[i];
+        switch (inst.opcode->form)
+        {
+        case BlockForm::IntegerBinary:
+        case BlockForm::LogicalBinary:
+            gpr[inst.d] = ModelInteger(inst.inst, gpr[inst.d], {gpr[inst.a], gpr[inst.b], 0, 0}, model);
+            break;
+        case BlockForm::IntegerUnary:
+        case BlockForm::LogicalUnary:
+            gpr[inst.d] = ModelInteger(inst.inst, gpr[inst.d], {gpr[inst.a], 0, 0, 0}, model);
+            break;
+        case BlockForm::Compare:
+            ModelInteger(inst.inst, 0, {gpr[inst.a], gpr[inst.b], 0, 0}, model);
+            break;
+        case BlockForm::CompareImmediate:
+            ModelInteger(inst.inst, 0, {gpr[inst.a], inst.imm, 0, 0}, model);
+            break;
+        case BlockForm::Immediate:
+        case BlockForm::LogicalImmediate:
+        case BlockForm::ShiftImmediate:
+            gpr[inst.d] = ModelInteger(inst.inst, gpr[inst.d], {gpr[inst.a], inst.imm, 0, 0}, model);
+            break;
+        case BlockForm::Rotate:
+            gpr[inst.d] = ModelInteger(inst.inst, gpr[inst.d], {gpr[inst.a], inst.imm, inst.mb, inst.me}, model);
+            break;
+        case BlockForm::ConditionRegister:
+            ModelConditionRegister(inst.inst, inst.d, inst.a, inst.b, model);
+            break;
+        case BlockForm::FloatUnary:
+            fpr[inst.d] = ModelFloat(inst.inst, fpr[inst.d], {fpr[inst.b], 0, 0}, 0, model);
+            break;
+        case BlockForm::FloatBinary:
+            fpr[inst.d] = ModelFloat(inst.inst, fpr[inst.d], {fpr[inst.a], fpr[inst.b], 0}, 0, model);
+            break;
+        case BlockForm::FloatMultiply:
+            fpr[inst.d] = ModelFloat(inst.inst, fpr[inst.d], {fpr[inst.a], fpr[inst.c], 0}, 0, model);
+            break;
+        case BlockForm::FloatTernary:
+            fpr[inst.d] = ModelFloat(inst.inst, fpr[inst.d], {fpr[inst.a], fpr[inst.c], fpr[inst.b]}, 0, model);
+            break;
+        case BlockForm::FloatCompare:
+            ModelFloat(inst.inst, 0, {fpr[inst.a], fpr[inst.b], 0}, inst.d, model);
+            break;
+        }
+    }
+
+    state.cr = model.cr;
+    state.xer = model.xer;
+    state.fpscr = model.fpscr;
+}
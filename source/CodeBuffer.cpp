@@ -0,0 +1,38 @@
+#include "CodeBuffer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Platform.h"
+
+constexpr uint32_t INST_BLR = 0x4E800020;
+
+// Generated sequences are mostly a handful of instructions long. Fuzzed blocks (see BlockFuzz.h)
+// can be up to BLOCK_MAX_INSTRUCTIONS, plus the code that loads and stores their state.
+constexpr size_t CODE_BUFFER_SIZE = 512;
+
+// Allocated by the platform, since not all of them can execute static data.
+static uint32_t* code_buffer = nullptr;
+
+GeneratedFunction EmitCode(const uint32_t* code, size_t count)
+{
+    if (code_buffer == nullptr)
+        code_buffer = static_cast<uint32_t*>(PlatformAllocateCode(CODE_BUFFER_SIZE * sizeof(uint32_t)));
+
+    if (count >= CODE_BUFFER_SIZE)
+    {
+        printf("Generated code doesn't fit in the code buffer (%zu instructions)\n", count);
+        exit(0);
+    }
+
+    std::memcpy(code_buffer, code, count * sizeof(uint32_t));
+    code_buffer[count] = INST_BLR;
+
+    // The instructions were written through the data cache, so they have to reach
+    // memory before the instruction cache can fetch them.
+    const size_t size = (count + 1) * sizeof(uint32_t);
+    PlatformSyncCode(code_buffer, size);
+
+    return reinterpret_cast<GeneratedFunction>(code_buffer);
+}
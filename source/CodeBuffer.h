@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Executes instructions that are generated at runtime.
+//
+// Some tests need to cover every value of an instruction field (e.g. every CR bit index),
+// which can't be done with inline asm, since the field has to be an assembly-time constant.
+// Those tests encode the instructions themselves and run them from this buffer instead.
+
+// Generated code takes values in r3-r5 and returns one in r3, following the normal calling convention.
+using GeneratedFunction = uint32_t (*)(uint32_t, uint32_t, void*);
+
+// Copies count instructions into the code buffer, followed by a blr, and makes them executable.
+// The returned function stays valid until the next call to EmitCode.
+GeneratedFunction EmitCode(const uint32_t* code, size_t count);
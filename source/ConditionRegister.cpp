@@ -1,6 +1,9 @@
 #include <cinttypes>
 #include <cstdio>
 
+#include "CodeBuffer.h"
+#include "Encoding.h"
+#include "Log.h"
 #include "Tests.h"
 
 // CR fields are only 4 bits in size.
@@ -50,6 +53,16 @@ static uint32_t GetShiftValue(uint32_t mask)
 #define SetCRField(cr_mask, value) \
     asm volatile ("mtcrf %[mask], %[val]" :: [mask]"I"(cr_mask), [val]"r"(value << GetShiftValue(cr_mask)))
 
+static void LogCRResult(const char* inst, uint32_t bit, uint32_t crA, uint32_t crB, uint32_t cr)
+{
+    LogRecord record = MakeLogRecord(LogForm::ConditionRegisterBit, inst);
+    record.cr = cr;
+    record.operands[0] = bit;
+    record.operands[1] = crA;
+    record.operands[2] = crB;
+    LogResult(record);
+}
+
 // Since we evaluate all of the bits of a 4-bit field, this simplifies resetting the clean test state.
 #define SetupPreTest(CRAMask, CRBMask, CRAValue, CRBValue) \
 {                                                          \
@@ -72,23 +85,89 @@ static uint32_t GetShiftValue(uint32_t mask)
         {                                                                                                               \
             SetupPreTest(CRAMask, CRBMask, i, j);                                                                       \
             asm volatile (inst " cr0, 4*cr" #CRAField "+0, 4*cr" #CRBField "+0" ::: "cr0");                             \
-            printf("     Bit 0 ::  crA 0x%08" PRIX32 " | crB 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", i, j, GetCR());  \
+            LogCRResult(inst, 0, i, j, GetCR());                                                                        \
                                                                                                                         \
             SetupPreTest(CRAMask, CRBMask, i, j);                                                                       \
             asm volatile (inst " cr0, 4*cr" #CRAField "+1, 4*cr" #CRBField "+1" ::: "cr0");                             \
-            printf("     Bit 1 ::  crA 0x%08" PRIX32 " | crB 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", i, j, GetCR());  \
+            LogCRResult(inst, 1, i, j, GetCR());                                                                        \
                                                                                                                         \
             SetupPreTest(CRAMask, CRBMask, i, j);                                                                       \
             asm volatile (inst " cr0, 4*cr" #CRAField "+2, 4*cr" #CRBField "+2" ::: "cr0");                             \
-            printf("     Bit 2 ::  crA 0x%08" PRIX32 " | crB 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", i, j, GetCR());  \
+            LogCRResult(inst, 2, i, j, GetCR());                                                                        \
                                                                                                                         \
             SetupPreTest(CRAMask, CRBMask, i, j);                                                                       \
             asm volatile (inst " cr0, 4*cr" #CRAField "+3, 4*cr" #CRBField "+3" ::: "cr0");                             \
-            printf("     Bit 3 ::  crA 0x%08" PRIX32 " | crB 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", i, j, GetCR());  \
+            LogCRResult(inst, 3, i, j, GetCR());                                                                        \
         }                                                                                                               \
     }                                                                                                                   \
 }
 
+#ifdef EXHAUSTIVE_TESTS
+// The tests above can only name CR bits with immediates, so they're limited to a fixed
+// set of fields. The exhaustive tests encode the instructions themselves instead, which
+// makes it possible to cover every crbD/crbA/crbB combination.
+
+// CR bit 0 is the most significant bit.
+static uint32_t CRBit(uint32_t bit)
+{
+    return 0x80000000U >> bit;
+}
+
+static void LogCRSweepResult(const char* inst, uint32_t crbD, uint32_t crbA, uint32_t crbB, uint32_t input, uint32_t cr)
+{
+    LogRecord record = MakeLogRecord(LogForm::ConditionRegisterSweep, inst);
+    record.cr = cr;
+    record.operands[0] = crbD;
+    record.operands[1] = crbA;
+    record.operands[2] = crbB;
+    record.operands[3] = input;
+    LogResult(record);
+}
+
+// Runs a CR logical instruction with every crbD/crbA/crbB encoding, for all four
+// combinations of the two source bits.
+static void CRExhaustiveTest(const char* inst, uint32_t xo)
+{
+    printf("%s (all encodings)\n", inst);
+
+    for (uint32_t crbD = 0; crbD < 32; crbD++)
+    {
+        for (uint32_t crbA = 0; crbA < 32; crbA++)
+        {
+            for (uint32_t crbB = 0; crbB < 32; crbB++)
+            {
+                // Takes the input CR in r3 and returns the resulting CR in r3.
+                // cr2-cr4 are nonvolatile, so the caller's CR is restored before returning.
+                const uint32_t code[] = {
+                    EncodeMFCR(4),
+                    EncodeMTCRF(0xFF, 3),
+                    EncodeCRLogical(xo, crbD, crbA, crbB),
+                    EncodeMFCR(3),
+                    EncodeMTCRF(0xFF, 4),
+                };
+                const GeneratedFunction function = EmitCode(code, sizeof(code) / sizeof(code[0]));
+
+                // Fill the bits that aren't sources with a pattern that changes with the
+                // encoding, so a write to the wrong bit (or to more than one) shows up.
+                const uint32_t encoding = (crbD << 10) | (crbA << 5) | crbB;
+                const uint32_t background = (0xA5C3E10FU ^ (encoding * 0x9E3779B9U)) & ~(CRBit(crbA) | CRBit(crbB));
+
+                for (uint32_t sources = 0; sources < 4; sources++)
+                {
+                    uint32_t input = background;
+                    if (sources & 2)
+                        input |= CRBit(crbA);
+                    if (sources & 1)
+                        input |= CRBit(crbB);
+
+                    LogCRSweepResult(inst, crbD, crbA, crbB, input, function(input, 0, nullptr));
+                }
+            }
+        }
+    }
+}
+#endif
+
 void PPCConditionRegisterTests()
 {
     printf("\n\nCondition Register Tests\n\n");
@@ -101,4 +180,17 @@ void PPCConditionRegisterTests()
     OPTEST_3_COMPONENTS("CROR",   MASK_CR1, MASK_CR2, 1, 2);
     OPTEST_3_COMPONENTS("CRORC",  MASK_CR1, MASK_CR2, 1, 2);
     OPTEST_3_COMPONENTS("CRXOR",  MASK_CR1, MASK_CR2, 1, 2);
+
+#ifdef EXHAUSTIVE_TESTS
+    printf("\n\nCondition Register Exhaustive Tests\n\n");
+
+    CRExhaustiveTest("CRAND",  XO_CRAND);
+    CRExhaustiveTest("CRANDC", XO_CRANDC);
+    CRExhaustiveTest("CREQV",  XO_CREQV);
+    CRExhaustiveTest("CRNAND", XO_CRNAND);
+    CRExhaustiveTest("CRNOR",  XO_CRNOR);
+    CRExhaustiveTest("CROR",   XO_CROR);
+    CRExhaustiveTest("CRORC",  XO_CRORC);
+    CRExhaustiveTest("CRXOR",  XO_CRXOR);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LogRecord.h"
+
+// 64-bit digests of test results.
+//
+// Sweeps that run far too many vectors to log individually accumulate their results
+// into a digest and only log that. The host tools compute the same digests from the
+// reference model, so this header is shared with them and must not depend on anything
+// target-specific.
+//
+// The mixing is the per-lane round and final avalanche of xxHash64.
+
+class ResultDigest
+{
+public:
+    void Add(uint64_t value)
+    {
+        m_state += value * PRIME_2;
+        m_state = (m_state << 31) | (m_state >> 33);
+        m_state *= PRIME_1;
+    }
+
+    uint64_t Finish() const
+    {
+        uint64_t hash = m_state;
+        hash ^= hash >> 33;
+        hash *= PRIME_2;
+        hash ^= hash >> 29;
+        hash *= PRIME_3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+private:
+    static constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87;
+    static constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4F;
+    static constexpr uint64_t PRIME_3 = 0x165667B19E3779F9;
+    static constexpr uint64_t PRIME_5 = 0x27D4EB2F165667C5;
+
+    uint64_t m_state = PRIME_5;
+};
+
+// Adds the result of an integer instruction with a single register operand. Sweeps of binary
+// instructions over rA (with a fixed rB) use this as well, as do sweeps over an encoded field
+// (an immediate, or a packed SH/MB/ME), with the field value in place of rA.
+inline void DigestIntegerUnary(ResultDigest& digest, uint32_t rA, uint32_t rD, uint32_t xer, uint32_t cr)
+{
+    digest.Add((static_cast<uint64_t>(rA) << 32) | rD);
+    digest.Add((static_cast<uint64_t>(xer) << 32) | cr);
+}
+
+// Adds the result of a floating-point instruction. The operands are in assembly order.
+// Pass 0 for frD when an enabled exception suppressed the write (see ModelWriteSuppressed),
+// since the register then holds whatever was in it before.
+inline void DigestFloat(ResultDigest& digest, const uint64_t (&operands)[3], uint64_t frD, uint32_t fpscr, uint32_t cr)
+{
+    for (const uint64_t operand : operands)
+        digest.Add(operand);
+    digest.Add(frD);
+    digest.Add((static_cast<uint64_t>(fpscr) << 32) | cr);
+}
+
+// Adds a whole result record (in native byte order).
+inline void DigestRecord(ResultDigest& digest, const LogRecord& record)
+{
+    digest.Add((static_cast<uint64_t>(record.form) << 8) | static_cast<uint64_t>(record.mode));
+    digest.Add((static_cast<uint64_t>(record.xer) << 32) | record.fpscr);
+    digest.Add(record.cr);
+    digest.Add(record.result);
+    for (const uint64_t operand : record.operands)
+        digest.Add(operand);
+}
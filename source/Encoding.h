@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+
+// Instruction encoders for tests that generate their own code (see CodeBuffer.h).
+//
+// Only the forms the tests generate are covered. Field values are expected to be in range.
+
+// D-form, e.g. ADDI rD, rA, SIMM or ORI rA, rS, UIMM (rS then goes in the first field).
+constexpr uint32_t EncodeDForm(uint32_t opcode, uint32_t rD, uint32_t rA, uint32_t imm)
+{
+    return (opcode << 26) | (rD << 21) | (rA << 16) | (imm & 0xFFFF);
+}
+
+// X-form, e.g. SRAWI rA, rS, SH (SH goes in the rB field).
+constexpr uint32_t EncodeXForm(uint32_t opcode, uint32_t rS, uint32_t rA, uint32_t rB, uint32_t xo, bool rc)
+{
+    return (opcode << 26) | (rS << 21) | (rA << 16) | (rB << 11) | (xo << 1) | (rc ? 1 : 0);
+}
+
+// M-form, e.g. RLWINM rA, rS, SH, MB, ME
+constexpr uint32_t EncodeMForm(uint32_t opcode, uint32_t rS, uint32_t rA, uint32_t sh, uint32_t mb, uint32_t me, bool rc)
+{
+    return (opcode << 26) | (rS << 21) | (rA << 16) | (sh << 11) | (mb << 6) | (me << 1) | (rc ? 1 : 0);
+}
+
+// Extended opcodes of the CR logical instructions (primary opcode 19).
+constexpr uint32_t XO_CRAND  = 257;
+constexpr uint32_t XO_CRANDC = 129;
+constexpr uint32_t XO_CREQV  = 289;
+constexpr uint32_t XO_CRNAND = 225;
+constexpr uint32_t XO_CRNOR  = 33;
+constexpr uint32_t XO_CROR   = 449;
+constexpr uint32_t XO_CRORC  = 417;
+constexpr uint32_t XO_CRXOR  = 193;
+
+// XL-form CR logical instructions, e.g. CRAND crbD, crbA, crbB
+constexpr uint32_t EncodeCRLogical(uint32_t xo, uint32_t crbD, uint32_t crbA, uint32_t crbB)
+{
+    return (19U << 26) | (crbD << 21) | (crbA << 16) | (crbB << 11) | (xo << 1);
+}
+
+// A-form floating-point arithmetic, e.g. FMADD frD, frA, frC, frB. Unused fields are 0.
+constexpr uint32_t EncodeAForm(uint32_t opcode, uint32_t frD, uint32_t frA, uint32_t frB, uint32_t frC, uint32_t xo, bool rc)
+{
+    return (opcode << 26) | (frD << 21) | (frA << 16) | (frB << 11) | (frC << 6) | (xo << 1) | (rc ? 1 : 0);
+}
+
+// SPR numbers are encoded with their two 5-bit halves swapped.
+constexpr uint32_t EncodeSPR(uint32_t spr)
+{
+    return ((spr & 0x1F) << 5) | (spr >> 5);
+}
+
+constexpr uint32_t EncodeMFSPR(uint32_t rD, uint32_t spr)
+{
+    return EncodeXForm(31, rD, 0, 0, 339, false) | (EncodeSPR(spr) << 11);
+}
+
+constexpr uint32_t EncodeMTSPR(uint32_t spr, uint32_t rS)
+{
+    return EncodeXForm(31, rS, 0, 0, 467, false) | (EncodeSPR(spr) << 11);
+}
+
+constexpr uint32_t EncodeMFCR(uint32_t rD)
+{
+    return EncodeXForm(31, rD, 0, 0, 19, false);
+}
+
+// CRM selects the fields written, with 0x80 being cr0.
+constexpr uint32_t EncodeMTCRF(uint32_t crm, uint32_t rS)
+{
+    return EncodeXForm(31, rS, 0, 0, 144, false) | (crm << 12);
+}
+
+constexpr uint32_t EncodeMFFS(uint32_t frD)
+{
+    return EncodeXForm(63, frD, 0, 0, 583, false);
+}
+
+// FM selects the fields written, with 0x80 being the first.
+constexpr uint32_t EncodeMTFSF(uint32_t fm, uint32_t frB)
+{
+    return EncodeXForm(63, 0, 0, frB, 711, false) | (fm << 17);
+}
+
+constexpr uint32_t SPR_XER = 1;
+
+static_assert(EncodeMFSPR(6, SPR_XER) == 0x7CC102A6, "mfxer r6");
+static_assert(EncodeMTSPR(SPR_XER, 6) == 0x7CC103A6, "mtxer r6");
+static_assert(EncodeMFCR(4) == 0x7C800026, "mfcr r4");
+static_assert(EncodeMTCRF(0xFF, 3) == 0x7C6FF120, "mtcrf 0xFF, r3");
+static_assert(EncodeCRLogical(XO_CRXOR, 6, 6, 6) == 0x4CC63182, "crxor 6, 6, 6");
+static_assert(EncodeMForm(21, 4, 3, 1, 2, 3, true) == 0x54830887, "rlwinm. r3, r4, 1, 2, 3");
+static_assert(EncodeAForm(63, 1, 2, 4, 3, 29, false) == 0xFC2220FA, "fmadd f1, f2, f3, f4");
+static_assert(EncodeMFFS(8) == 0xFD00048E, "mffs f8");
+static_assert(EncodeMTFSF(0xFF, 8) == 0xFDFE458E, "mtfsf 0xFF, f8");
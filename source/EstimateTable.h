@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "PPCModel.h"
+
+// The tables behind FRES and FRSQRTE.
+//
+// Both estimates come from one of 32 table entries, picked by the top bits of the input's
+// fraction, and interpolated linearly within the entry by the bits below those:
+//
+//   FRES:    fraction bits 51-47 pick the entry, and bits 46-37 are the step (1024 per entry).
+//            The 23-bit significand is base - (dec * step + 1) / 2, and FI reports the
+//            half unit the division drops.
+//   FRSQRTE: fraction bits 51-48 pick the entry, plus 16 for inputs with an odd unbiased
+//            exponent, and bits 47-37 are the step (2048 per entry). The top 26 bits of the
+//            fraction are base - dec * step.
+//
+// The exhaustive tests recover each entry's base and dec from the hardware, and check that
+// they reproduce every step. tools/estimateexport writes the recovered tables out as:
+//
+//   "PPCESTBL"                 8-byte magic
+//   32 x {base, dec}           FRES, as 32-bit words
+//   32 x {base, dec}           FRSQRTE, even exponents (e.g. [1, 2)) first
+//
+// with every word big-endian, 520 bytes in all. This header is shared with the host tools.
+
+enum class EstimateTable : uint8_t
+{
+    Reciprocal,     // FRES
+    ReciprocalSqrt, // FRSQRTE
+};
+
+constexpr uint32_t ESTIMATE_TABLE_ENTRIES = 32;
+
+constexpr char ESTIMATE_EXPORT_MAGIC[8] = {'P', 'P', 'C', 'E', 'S', 'T', 'B', 'L'};
+constexpr size_t ESTIMATE_EXPORT_SIZE = sizeof(ESTIMATE_EXPORT_MAGIC) + 2 * ESTIMATE_TABLE_ENTRIES * 2 * sizeof(uint32_t);
+
+inline uint32_t GetEstimateStepCount(EstimateTable table)
+{
+    return table == EstimateTable::Reciprocal ? 1024 : 2048;
+}
+
+// The input at one step of an entry, in [1, 2), or [2, 4) for the second half of the FRSQRTE table.
+inline uint64_t GetEstimateInput(EstimateTable table, uint32_t entry, uint32_t step)
+{
+    if (table == EstimateTable::Reciprocal)
+        return (uint64_t{0x3FF} << 52) | (static_cast<uint64_t>(entry * 1024 + step) << 37);
+
+    const uint64_t exponent = entry < 16 ? 0x3FF : 0x400;
+    return (exponent << 52) | (static_cast<uint64_t>((entry % 16) * 2048 + step) << 37);
+}
+
+// The bits of a result that come from the table.
+inline uint32_t GetEstimateValue(EstimateTable table, uint64_t result)
+{
+    if (table == EstimateTable::Reciprocal)
+        return static_cast<uint32_t>(result >> 29) & 0x7FFFFF;
+
+    return static_cast<uint32_t>(result >> 26) & 0x3FFFFFF;
+}
+
+inline uint32_t InterpolateEstimate(EstimateTable table, uint32_t base, uint32_t dec, uint32_t step)
+{
+    if (table == EstimateTable::Reciprocal)
+        return base - (dec * step + 1) / 2;
+
+    return base - dec * step;
+}
+
+// Whether the interpolation drops anything, which sets FI.
+inline bool IsEstimateInexact(EstimateTable table, uint32_t dec, uint32_t step)
+{
+    return table == EstimateTable::Reciprocal && ((dec * step) & 1) != 0;
+}
+
+struct EstimateEntry
+{
+    uint32_t base;
+    uint32_t dec;
+    uint32_t mismatched; // Steps the interpolation doesn't reproduce.
+};
+
+struct EstimateResult
+{
+    uint64_t frD;
+    uint32_t fpscr;
+};
+
+// Recovers one table entry from run(input), which executes the estimate and returns an
+// EstimateResult. base is the value at step 0, and dec the difference at the first step
+// where the whole of it shows (FRES halves it).
+template <typename Run>
+EstimateEntry RecoverEstimateEntry(EstimateTable table, uint32_t entry, Run run)
+{
+    EstimateEntry out{};
+    const uint32_t dec_step = table == EstimateTable::Reciprocal ? 2 : 1;
+    out.base = GetEstimateValue(table, run(GetEstimateInput(table, entry, 0)).frD);
+    out.dec = out.base - GetEstimateValue(table, run(GetEstimateInput(table, entry, dec_step)).frD);
+
+    for (uint32_t step = 0; step < GetEstimateStepCount(table); step++)
+    {
+        const EstimateResult result = run(GetEstimateInput(table, entry, step));
+        if (GetEstimateValue(table, result.frD) != InterpolateEstimate(table, out.base, out.dec, step) ||
+            ((result.fpscr & FPSCR_FI) != 0) != IsEstimateInexact(table, out.dec, step))
+        {
+            out.mismatched++;
+        }
+    }
+
+    return out;
+}
@@ -0,0 +1,32 @@
+#include <cstdio>
+
+#include "Exceptions.h"
+#include "Log.h"
+#include "Platform.h"
+#include "Tests.h"
+
+// SRR1 bits 0-15 say why the exception was taken (for program exceptions: FP enabled, illegal,
+// privileged or trap). The rest is a copy of the MSR, which depends on the platform.
+constexpr uint32_t SRR1_CAUSE_MASK = 0xFFFF0000;
+
+void PPCExceptionTests()
+{
+    printf("\n\nException Tests\n\n");
+
+    for (const ExceptionTest& test : exception_tests)
+    {
+        PlatformExceptionSite site{};
+        PlatformExceptionState state{};
+
+        ClearFPSCR();
+        const bool delivered = PlatformCatchException(test.exception, test.raise, &site, &state);
+        ClearFPSCR();
+
+        LogRecord record = MakeLogRecord(LogForm::Exception, test.name);
+        record.fpscr = delivered ? state.fpscr : 0;
+        record.operands[0] = delivered ? 1 : 0;
+        record.operands[1] = delivered ? state.srr0 - site.address : 0;
+        record.operands[2] = delivered ? state.srr1 & SRR1_CAUSE_MASK : 0;
+        LogResult(record);
+    }
+}
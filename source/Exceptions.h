@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "PPCModel.h"
+#include "Platform.h"
+#include "Tests.h"
+
+// Exceptions raised on purpose.
+//
+// The (VE) results of the floating-point tests only show what an enabled exception does to
+// the FPSCR and the destination, since MSR[FE0/FE1] is never set and nothing is delivered.
+// These raise program, floating-point enabled, floating-point unavailable and alignment
+// exceptions, each with a handler in place (see PlatformCatchException). The tests log where
+// and why the handler found each one was raised. The benchmarks time how long delivery takes.
+
+// Word-aligned, so the raising instructions can point 2 bytes into it. Like the table below,
+// it's inline, so the tests and the benchmarks share one.
+alignas(8) inline uint8_t exception_buffer[8];
+
+// Raises an exception with inst between two readings of the timebase. bl/mflr finds the address
+// of the instruction wherever the code was linked. Execution resumes at the nop after it, so it
+// still comes back here if SRR0 points past the instruction. Nothing before inst touches the
+// FPRs, as FMR runs with MSR[FP] clear.
+#define RAISE_FUNC(inst)                                                                                  \
+    [](PlatformExceptionSite* site) {                                                                    \
+        uint32_t address, before, after, value = 0;                                                      \
+        asm volatile ("bl 1f\n"                                                                           \
+                      "1: mflr %[address]\n"                                                              \
+                      "mftb %[before]\n"                                                                  \
+                      inst "\n"                                                                           \
+                      "nop\n"                                                                             \
+                      "mftb %[after]\n"                                                                   \
+                      : [address]"=&r"(address), [before]"=&r"(before), [after]"=&r"(after), [value]"+r"(value) \
+                      : [ea]"b"(exception_buffer + 2)                                                     \
+                      : "lr", "cr0", "fr0", "memory");                                                    \
+        site->address = address + 8;                                                                     \
+        site->before = before;                                                                           \
+        site->after = after;                                                                             \
+    }
+
+// The same for the floating-point enabled exceptions, with invalid operation and zero divide
+// exceptions enabled in the FPSCR first.
+#define FP_RAISE_FUNC(inst)                                                                               \
+    [](PlatformExceptionSite* site) {                                                                    \
+        uint32_t address, before, after;                                                                 \
+        double d;                                                                                        \
+        asm volatile ("mtfsf 0xFF, %[fpscr]\n"                                                            \
+                      "bl 1f\n"                                                                           \
+                      "1: mflr %[address]\n"                                                              \
+                      "mftb %[before]\n"                                                                  \
+                      inst "\n"                                                                           \
+                      "nop\n"                                                                             \
+                      "mftb %[after]\n"                                                                   \
+                      : [address]"=&r"(address), [before]"=&r"(before), [after]"=&r"(after), [d]"=&f"(d)  \
+                      : [fpscr]"f"(MakeFPSCRImage(FPSCR_VE | FPSCR_ZE)), [one]"f"(1.0), [zero]"f"(0.0),   \
+                        [snan]"f"(std::numeric_limits<double>::signaling_NaN())                           \
+                      : "lr");                                                                            \
+        site->address = address + 8;                                                                     \
+        site->before = before;                                                                           \
+        site->after = after;                                                                             \
+    }
+
+struct ExceptionTest
+{
+    const char* name;
+    PlatformException exception;
+    PlatformRaiseFunc raise;
+};
+
+inline constexpr ExceptionTest exception_tests[] = {
+    {"TRAP", PlatformException::Program, RAISE_FUNC("trap")},
+    {"ILLEGAL", PlatformException::Program, RAISE_FUNC(".long 0")},
+    {"FADD", PlatformException::FloatingPointEnabled, FP_RAISE_FUNC("fadd %[d], %[snan], %[one]")},
+    {"FDIV", PlatformException::FloatingPointEnabled, FP_RAISE_FUNC("fdiv %[d], %[one], %[zero]")},
+    {"FMR", PlatformException::FloatingPointUnavailable, RAISE_FUNC("fmr 0, 0")},
+    {"LWARX", PlatformException::Alignment, RAISE_FUNC("lwarx %[value], 0, %[ea]")},
+    {"STWCX.", PlatformException::Alignment, RAISE_FUNC("stwcx. %[value], 0, %[ea]")},
+};
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "PPCModel.h"
+#include "Random.h"
+
+// Class-stratified floating-point operand generation.
+//
+// Uniformly random bit patterns are almost all ordinary normals, so the generator first picks
+// a class of value with equal probability, then a random value within it. The tests and the
+// host tools generate the same operands from the same seed, so this header must not depend on
+// anything target-specific.
+
+enum class FloatClass : uint8_t
+{
+    Zero,
+    Denormal,
+    Tiny,         // Normals near the bottom of the exponent range, whose results underflow.
+    Normal,       // Normals over the whole exponent range.
+    Boundary,     // Normals near 1.0 whose low mantissa bits sit on or next to a rounding boundary.
+    Huge,         // Normals near the top of the exponent range, whose results overflow.
+    MaxFinite,    // The largest finite value, or a few ulps below it.
+    Infinity,
+    QuietNaN,
+    SignalingNaN,
+
+    Count,
+};
+
+// Converts a single-precision bit pattern to the double-precision pattern lfs loads it as.
+// Denormals are normalized, and NaNs keep their payload (signaling NaNs aren't quieted).
+inline uint64_t SingleToDoubleBits(uint32_t single)
+{
+    const uint64_t sign = static_cast<uint64_t>(single >> 31) << 63;
+    const uint32_t exponent = (single >> 23) & 0xFF;
+    uint64_t mantissa = single & 0x7FFFFF;
+
+    if (exponent == 0xFF)
+        return sign | (0x7FFULL << 52) | (mantissa << 29);
+
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+            return sign;
+
+        int64_t unbiased = -126;
+        while ((mantissa & 0x800000) == 0)
+        {
+            mantissa <<= 1;
+            unbiased--;
+        }
+
+        return sign | (static_cast<uint64_t>(unbiased + 1023) << 52) | ((mantissa & 0x7FFFFF) << 29);
+    }
+
+    return sign | (static_cast<uint64_t>(exponent - 127 + 1023) << 52) | (mantissa << 29);
+}
+
+// Generates a value of the given class. Single-precision values are generated in the single
+// format and returned as the double they load as.
+inline uint64_t GenerateFloatOfClass(Random& random, FloatClass cls, bool single)
+{
+    const uint64_t r = random.Next();
+    const uint64_t payload = random.Next();
+
+    const uint32_t mantissa_bits = single ? 23 : 52;
+    const uint32_t exponent_bits = single ? 8 : 11;
+    const uint64_t mantissa_mask = (1ULL << mantissa_bits) - 1;
+    const uint64_t exponent_max = (1ULL << exponent_bits) - 1;
+    const uint64_t bias = exponent_max >> 1;
+
+    uint64_t exponent = 0;
+    uint64_t mantissa = 0;
+
+    switch (cls)
+    {
+    case FloatClass::Zero:
+    case FloatClass::Count:
+        break;
+
+    case FloatClass::Denormal:
+        // Vary the number of leading zeros, so both large and tiny denormals come up.
+        mantissa = (payload & mantissa_mask) >> ((r >> 16) % mantissa_bits);
+        if (mantissa == 0)
+            mantissa = 1;
+        break;
+
+    case FloatClass::Tiny:
+        exponent = 1 + (r >> 16) % 32;
+        mantissa = payload & mantissa_mask;
+        break;
+
+    case FloatClass::Normal:
+        exponent = 1 + (r >> 16) % (exponent_max - 1);
+        mantissa = payload & mantissa_mask;
+        break;
+
+    case FloatClass::Boundary:
+    {
+        // The low bits are all clear, all set, exactly half or just under half. Since the
+        // number of low bits varies, this covers the double and single rounding points.
+        const uint32_t low_bits = 1 + static_cast<uint32_t>((r >> 24) % (mantissa_bits - 1));
+        const uint64_t low_mask = (1ULL << low_bits) - 1;
+        const uint64_t half = 1ULL << (low_bits - 1);
+        uint64_t low = 0;
+        switch ((r >> 32) & 3)
+        {
+        case 1:
+            low = low_mask;
+            break;
+        case 2:
+            low = half;
+            break;
+        case 3:
+            low = half - 1;
+            break;
+        }
+
+        exponent = bias - 8 + (r >> 16) % 17;
+        mantissa = (payload & mantissa_mask & ~low_mask) | (low & low_mask);
+        break;
+    }
+
+    case FloatClass::Huge:
+        exponent = exponent_max - 1 - (r >> 16) % 32;
+        mantissa = payload & mantissa_mask;
+        break;
+
+    case FloatClass::MaxFinite:
+        exponent = exponent_max - 1;
+        mantissa = mantissa_mask - ((r >> 16) & 3);
+        break;
+
+    case FloatClass::Infinity:
+        exponent = exponent_max;
+        break;
+
+    case FloatClass::QuietNaN:
+        // Either the default payload or a random one.
+        exponent = exponent_max;
+        mantissa = 1ULL << (mantissa_bits - 1);
+        if ((r >> 16) & 1)
+            mantissa |= payload & mantissa_mask;
+        break;
+
+    case FloatClass::SignalingNaN:
+        exponent = exponent_max;
+        mantissa = payload & (mantissa_mask >> 1);
+        if (mantissa == 0)
+            mantissa = 1;
+        break;
+    }
+
+    const uint64_t sign = (r >> 8) & 1;
+    const uint64_t bits = (sign << (mantissa_bits + exponent_bits)) | (exponent << mantissa_bits) | mantissa;
+    return single ? SingleToDoubleBits(static_cast<uint32_t>(bits)) : bits;
+}
+
+// Generates a value of a random class.
+inline uint64_t GenerateFloat(Random& random, bool single)
+{
+    const auto cls = static_cast<FloatClass>(random.Next() % static_cast<uint64_t>(FloatClass::Count));
+    return GenerateFloatOfClass(random, cls, single);
+}
+
+// Whether an arithmetic instruction rounds its result to single precision.
+inline bool IsSinglePrecision(ModelOp op)
+{
+    switch (op)
+    {
+    case ModelOp::Fadds:
+    case ModelOp::Fdivs:
+    case ModelOp::Fmadds:
+    case ModelOp::Fmsubs:
+    case ModelOp::Fmuls:
+    case ModelOp::Fnmadds:
+    case ModelOp::Fnmsubs:
+    case ModelOp::Fsubs:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Number of source operands of an arithmetic instruction.
+inline size_t CountFloatOperands(ModelOp op)
+{
+    switch (op)
+    {
+    case ModelOp::Fmadd:
+    case ModelOp::Fmadds:
+    case ModelOp::Fmsub:
+    case ModelOp::Fmsubs:
+    case ModelOp::Fnmadd:
+    case ModelOp::Fnmadds:
+    case ModelOp::Fnmsub:
+    case ModelOp::Fnmsubs:
+        return 3;
+    default:
+        return 2;
+    }
+}
+
+// Generates the operands of the next vector of an arithmetic instruction, in assembly order
+// (frA, frB or frA, frC, frB) like ModelFloat takes them. Unused operands are zero.
+inline void GenerateFloatVector(Random& random, const ModelInstruction& inst, uint64_t (&operands)[3])
+{
+    const bool single = IsSinglePrecision(inst.op);
+    const size_t count = CountFloatOperands(inst.op);
+    for (size_t i = 0; i < 3; i++)
+        operands[i] = i < count ? GenerateFloat(random, single) : 0;
+}
@@ -1,218 +1,882 @@
+#include <algorithm>
 #include <cfloat>
 #include <cinttypes>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <iterator>
 #include <limits>
 #include <type_traits>
 
+#include "Digest.h"
+#include "EstimateTable.h"
+#include "FloatClasses.h"
+#include "Log.h"
+#include "PPCModel.h"
+#include "Random.h"
 #include "Tests.h"
 
 // NaN variants.
-#define FLOAT_SNAN  std::numeric_limits<float>::signaling_NaN()
-#define FLOAT_QNAN  std::numeric_limits<float>::quiet_NaN()
+//
+// The float NaNs are spelled as their double equivalents, since the operand tables
+// hold doubles and converting a float signaling NaN to double at compile time quiets it.
+// Loading the float with lfs produces these exact bit patterns.
+#define FLOAT_SNAN  std::numeric_limits<double>::signaling_NaN()
+#define FLOAT_QNAN  std::numeric_limits<double>::quiet_NaN()
 #define DOUBLE_SNAN std::numeric_limits<double>::signaling_NaN()
 #define DOUBLE_QNAN std::numeric_limits<double>::quiet_NaN()
 
-static void ClearFPSCR()
+static void CleanTestState()
 {
-    asm volatile ("mtfsf 0xFF, %[reg]" : : [reg]"f"(0.0));
+    ClearFPSCR();
+    SetCR(0);
 }
-static uint32_t GetFPSCR()
+
+
+// Like the integer tests, the floating-point tests are table driven.
+// Each instruction gets one function containing its inline asm,
+// and the operands are plain data.
+
+struct FPResult
 {
-    double d = 0.0;
-    asm volatile ("mffs %[out]" : [out]"=f"(d));
+    uint64_t frD;
+    uint32_t fpscr;
+    uint32_t cr;
+};
 
-    uint64_t i = 0;
-    std::memcpy(&i, &d, sizeof(uint64_t));
+// Executes an instruction under the given rounding mode or TEST_MODE_* value.
+using FPTestFunc = FPResult (*)(uint32_t mode, double frA, double frB, double frC);
 
-    // High 32 bits are undefined according to the PPC reference.
-    return static_cast<uint32_t>(i);
-}
+// Determines how a test's operands are interpreted and printed.
+enum class FPForm
+{
+    Unary,       // e.g. FABS frD, frB
+    UnaryRound,  // e.g. FRSP frD, frB, in every rounding mode
+    BinaryRound, // e.g. FADD frD, frA, frB, in every rounding mode
+    Compare,     // e.g. FCMPU cr1, frA, frB
+    Select,      // e.g. FSEL frD, frA, frC, frB
+    FusedRound,  // e.g. FMADD frD, frA, frC, frB, in every rounding mode
+};
+
+// Note that operands are ordered frA, frB, frC regardless of
+// the order the instruction's assembly syntax takes them in.
+struct FPVector
+{
+    double frA;
+    double frB = 0.0;
+    double frC = 0.0;
+};
+
+// Executes an instruction on each of count vectors in turn, each from the given FPSCR and
+// a clean CR. The mode matrix uses these, so the FPSCR is only worked out once per batch.
+using FPMatrixFunc = void (*)(uint32_t fpscr, const FPVector* vectors, FPResult* results, size_t count);
+
+struct FPTest
+{
+    const char* inst;
+    FPForm form;
+    FPTestFunc func;
+    FPMatrixFunc matrix_func;
+    const FPVector* vectors;
+    size_t num_vectors;
+};
+
+// Common body for test functions. The VE variant zeroes the
+// output before executing the instruction.
+#define FP_FUNC_BODY(inst, operands, ...)                                             \
+    FPResult result{};                                                                \
+                                                                                      \
+    CleanTestState();                                                                 \
+    if (mode == TEST_MODE_VE)                                                         \
+    {                                                                                 \
+        EnableInvalidOperationExceptions();                                           \
+        asm volatile(                                                                 \
+            "xor %[out], %[out], %[out]\n"                                            \
+            inst " %[out], " operands : [out]"=&f"(result.frD) : __VA_ARGS__);        \
+    }                                                                                 \
+    else                                                                              \
+    {                                                                                 \
+        if (mode != TEST_MODE_DEFAULT)                                                \
+            SetRoundingMode(mode);                                                    \
+                                                                                      \
+        asm volatile (inst " %[out], " operands : [out]"=&f"(result.frD) : __VA_ARGS__); \
+    }                                                                                 \
+                                                                                      \
+    result.fpscr = GetFPSCR();                                                        \
+    result.cr = GetCR();                                                              \
+    return result;
+
+#define UNARY_FUNC(inst)                                                 \
+    [](uint32_t mode, double frA, double, double) {                      \
+        FP_FUNC_BODY(inst, "%[Fra]", [Fra]"f"(frA))                      \
+    }
+
+#define BINARY_FUNC(inst)                                                \
+    [](uint32_t mode, double frA, double frB, double) {                  \
+        FP_FUNC_BODY(inst, "%[Fra], %[Frb]", [Fra]"f"(frA), [Frb]"f"(frB)) \
+    }
+
+#define FUSED_FUNC(inst)                                                                        \
+    [](uint32_t mode, double frA, double frB, double frC) {                                     \
+        FP_FUNC_BODY(inst, "%[Fra], %[Frc], %[Frb]", [Fra]"f"(frA), [Frc]"f"(frC), [Frb]"f"(frB)) \
+    }
+
+// Stores result to cr1.
+#define COMPARE_FUNC(inst)                                                        \
+    [](uint32_t, double frA, double frB, double) {                                \
+        FPResult result{};                                                        \
+                                                                                  \
+        CleanTestState();                                                         \
+        asm volatile (inst " cr1, %[Fra], %[Frb]" : : [Fra]"f"(frA), [Frb]"f"(frB)); \
+                                                                                  \
+        result.fpscr = GetFPSCR();                                                \
+        result.cr = GetCR();                                                      \
+        return result;                                                            \
+    }
+
+// Note: FSEL has never cleared the FPSCR or CR before executing.
+#define SELECT_FUNC(inst)                                                         \
+    [](uint32_t, double frA, double frB, double frC) {                            \
+        FPResult result{};                                                        \
+                                                                                  \
+        asm volatile (inst " %[out], %[Fra], %[Frc], %[Frb]"                      \
+            : [out]"=&f"(result.frD)                                              \
+            : [Fra]"f"(frA), [Frc]"f"(frC), [Frb]"f"(frB));                       \
+                                                                                  \
+        result.fpscr = GetFPSCR();                                                \
+        result.cr = GetCR();                                                      \
+        return result;                                                            \
+    }
+
+// Common body for matrix functions. Setting the FPSCR goes in the same asm statement as the
+// instruction, so no floating-point code the compiler generates can run in between. The
+// output is zeroed first, like the VE variant above, for when an enabled exception
+// suppresses the write.
+#define FP_MATRIX_BODY(asm_text, outputs, ...)                 \
+    const double fpscr_image = MakeFPSCRImage(fpscr);          \
+    for (size_t i = 0; i < count; i++)                         \
+    {                                                          \
+        [[maybe_unused]] const double frA = vectors[i].frA;    \
+        [[maybe_unused]] const double frB = vectors[i].frB;    \
+        [[maybe_unused]] const double frC = vectors[i].frC;    \
+        FPResult& result = results[i];                         \
+                                                               \
+        result.frD = 0;                                        \
+        SetCR(0);                                              \
+        asm volatile ("mtfsf 0xFF, %[Fpscr]\n" asm_text        \
+            : outputs : [Fpscr]"f"(fpscr_image), __VA_ARGS__); \
+                                                               \
+        result.fpscr = GetFPSCR();                             \
+        result.cr = GetCR();                                   \
+    }
+
+#define UNARY_MATRIX_FUNC(inst)                                                      \
+    [](uint32_t fpscr, const FPVector* vectors, FPResult* results, size_t count) {   \
+        FP_MATRIX_BODY(inst " %[out], %[Fra]", [out]"+f"(result.frD), [Fra]"f"(frA)) \
+    }
+
+#define BINARY_MATRIX_FUNC(inst)                                                                            \
+    [](uint32_t fpscr, const FPVector* vectors, FPResult* results, size_t count) {                          \
+        FP_MATRIX_BODY(inst " %[out], %[Fra], %[Frb]", [out]"+f"(result.frD), [Fra]"f"(frA), [Frb]"f"(frB)) \
+    }
+
+#define FUSED_MATRIX_FUNC(inst)                                                       \
+    [](uint32_t fpscr, const FPVector* vectors, FPResult* results, size_t count) {    \
+        FP_MATRIX_BODY(inst " %[out], %[Fra], %[Frc], %[Frb]", [out]"+f"(result.frD), \
+                       [Fra]"f"(frA), [Frc]"f"(frC), [Frb]"f"(frB))                   \
+    }
+
+// Stores result to cr1.
+#define COMPARE_MATRIX_FUNC(inst)                                                   \
+    [](uint32_t fpscr, const FPVector* vectors, FPResult* results, size_t count) {  \
+        FP_MATRIX_BODY(inst " cr1, %[Fra], %[Frb]", , [Fra]"f"(frA), [Frb]"f"(frB)) \
+    }
+
+// Unlike SELECT_FUNC, this does set the FPSCR and CR first.
+#define SELECT_MATRIX_FUNC(inst) FUSED_MATRIX_FUNC(inst)
+
+// Table entries.
+#define UNARY_TEST(inst, vectors) \
+    {inst, FPForm::Unary, UNARY_FUNC(inst), UNARY_MATRIX_FUNC(inst), std::data(vectors), std::size(vectors)}
+#define UNARY_ROUND_TEST(inst, vectors) \
+    {inst, FPForm::UnaryRound, UNARY_FUNC(inst), UNARY_MATRIX_FUNC(inst), std::data(vectors), std::size(vectors)}
+#define BINARY_ROUND_TEST(inst, vectors) \
+    {inst, FPForm::BinaryRound, BINARY_FUNC(inst), BINARY_MATRIX_FUNC(inst), std::data(vectors), std::size(vectors)}
+#define COMPARE_TEST(inst, vectors) \
+    {inst, FPForm::Compare, COMPARE_FUNC(inst), COMPARE_MATRIX_FUNC(inst), std::data(vectors), std::size(vectors)}
+#define SELECT_TEST(inst, vectors) \
+    {inst, FPForm::Select, SELECT_FUNC(inst), SELECT_MATRIX_FUNC(inst), std::data(vectors), std::size(vectors)}
+#define FUSED_ROUND_TEST(inst, vectors) \
+    {inst, FPForm::FusedRound, FUSED_FUNC(inst), FUSED_MATRIX_FUNC(inst), std::data(vectors), std::size(vectors)}
+
+//
+// Operand tables
+//
+
+static constexpr FPVector fabs_vectors[] = {
+    {0.0},
+    {-0.0},
+    {-1.0},
+    {-FLT_MIN},
+    {-FLT_MAX},
+    {-DBL_MIN},
+    {-DBL_MAX},
+    {FLOAT_QNAN},
+    {FLOAT_SNAN},
+    {INFINITY},
+    {-INFINITY},
+};
+
+static constexpr FPVector fadd_vectors[] = {
+    {0.0, 0.0},
+    {0.5, 0.5},
+    {1.0, 1.0},
+    {3.5, 3.5},
+    {3.92364e-044, 3.92364e-044},
+    {DBL_MAX, DBL_MAX},
+    {-DBL_MAX, -DBL_MAX},
+    {DBL_MAX, -DBL_MAX},
+    {FLOAT_SNAN, INFINITY},
+    {FLOAT_QNAN, INFINITY},
+    {FLOAT_QNAN, -INFINITY},
+    {INFINITY, FLOAT_QNAN},
+    {-INFINITY, FLOAT_QNAN},
+    {INFINITY, INFINITY},
+    {INFINITY, -INFINITY},
+    {-INFINITY, INFINITY},
+    {-INFINITY, -INFINITY},
+};
+
+static constexpr FPVector fadds_vectors[] = {
+    {0.0, 0.0},
+    {0.5, 0.5},
+    {1.0, 1.0},
+    {3.5, 3.5},
+    {3.92364e-044, 3.92364e-044},
+    {FLT_MAX, FLT_MAX},
+    {-FLT_MAX, -FLT_MAX},
+    {FLT_MAX, -FLT_MAX},
+    {0.0, DBL_MAX},
+    {FLOAT_SNAN, INFINITY},
+    {FLOAT_QNAN, INFINITY},
+    {FLOAT_QNAN, -INFINITY},
+    {INFINITY, FLOAT_QNAN},
+    {-INFINITY, FLOAT_QNAN},
+    {INFINITY, INFINITY},
+    {INFINITY, -INFINITY},
+    {-INFINITY, INFINITY},
+    {-INFINITY, -INFINITY},
+};
+
+static constexpr FPVector fcmpo_vectors[] = {
+    {0.0, 0.0},
+    {0.0, 1.0},
+    {1.0, 0.0},
+    {0.5, 0.5},
+    {0.0, 0.5},
+    {0.5, 0.0},
+    {DOUBLE_QNAN, DOUBLE_QNAN},
+    {DOUBLE_SNAN, DOUBLE_SNAN},
+    {INFINITY, INFINITY},
+    {INFINITY, -INFINITY},
+    {-INFINITY, INFINITY},
+    {-INFINITY, -INFINITY},
+};
+
+static constexpr FPVector fctiw_vectors[] = {
+    {0.0},
+    {0.5},
+    {-0.5},
+    {2.4679999352},
+    {-2.4679999352},
+};
+
+static constexpr FPVector fctiw_rc_denormal_vectors[] = {
+    {6.30584e-044},
+};
+
+static constexpr FPVector fctiw_special_vectors[] = {
+    {FLOAT_SNAN},
+    {FLOAT_QNAN},
+    {INFINITY},
+    {-INFINITY},
+};
 
-static void SetRoundingMode(uint32_t index)
+static constexpr FPVector fctiw_rc_vectors[] = {
+    {0.0},
+    {0.5},
+    {-0.5},
+    {2.4679999352},
+    {-2.4679999352},
+    {6.30584e-044},
+    {FLOAT_SNAN},
+    {FLOAT_QNAN},
+    {INFINITY},
+    {-INFINITY},
+};
+
+static constexpr FPVector fctiwz_vectors[] = {
+    {0.0},
+    {0.5},
+    {-0.5},
+    {2.4679999352},
+    {-2.4679999352},
+    {FLOAT_SNAN},
+    {FLOAT_QNAN},
+    {INFINITY},
+    {-INFINITY},
+};
+
+static constexpr FPVector fdiv_vectors[] = {
+    {0.0, 0.0},
+    {0.0, -0.0},
+    {-0.0, -0.0},
+    {1.0, 1.0},
+    {10.0, 5.0},
+    {4.9359998704, 2.4679999352},
+    {2.4679999352, 4.9359998704},
+    {2.10195e-044, 2.45208e-029},
+    {FLOAT_SNAN, FLOAT_SNAN},
+    {FLOAT_SNAN, FLOAT_QNAN},
+    {FLOAT_QNAN, FLOAT_SNAN},
+    {FLOAT_QNAN, FLOAT_QNAN},
+    {INFINITY, INFINITY},
+    {FLOAT_SNAN, INFINITY},
+    {FLOAT_QNAN, INFINITY},
+    {INFINITY, FLOAT_QNAN},
+    {INFINITY, FLOAT_SNAN},
+    {FLOAT_SNAN, -INFINITY},
+    {FLOAT_QNAN, -INFINITY},
+    {-INFINITY, FLOAT_QNAN},
+    {-INFINITY, FLOAT_SNAN},
+};
+
+static constexpr FPVector fmadd_vectors[] = {
+    {1.0, 1.0, 1.0},
+    {5.5, 5.5, 5.5},
+    {7.3233339282, 3.5, 7.9999999234},
+    {6.30584e-044, 1.54143e-044, 3.08286e-044},
+    {1.0, FLOAT_QNAN, 1.0},
+    {1.0, FLOAT_SNAN, 1.0},
+    {1.0, INFINITY, 1.0},
+    {1.0, -INFINITY, 1.0},
+};
+
+static constexpr FPVector fmul_vectors[] = {
+    {0.0, 0.0},
+    {-0.0, -0.0},
+    {0.0, INFINITY},
+    {INFINITY, 0.0},
+    {5.0, 5.0},
+    {0.25, 0.35},
+    {2.999999984523, 6.888239210233},
+    {5.0, FLOAT_QNAN},
+    {5.0, FLOAT_SNAN},
+    {5.0, INFINITY},
+    {5.0, -INFINITY},
+    {INFINITY, FLOAT_QNAN},
+    {INFINITY, FLOAT_SNAN},
+    {-INFINITY, FLOAT_QNAN},
+    {-INFINITY, FLOAT_SNAN},
+};
+
+static constexpr FPVector fneg_vectors[] = {
+    {0.0},
+    {-0.0},
+    {DBL_MAX},
+    {-DBL_MAX},
+    {DBL_MIN},
+    {-DBL_MIN},
+    {DOUBLE_QNAN},
+    {DOUBLE_SNAN},
+    {INFINITY},
+    {INFINITY},
+};
+
+static constexpr FPVector fres_vectors[] = {
+    {0.0},
+    {-0.0},
+    {100.986352178},
+    {7.3233339282},
+    {6.30584e-044},
+    {69.0},
+    {420.0},
+    {DBL_MAX},
+    {DBL_MIN},
+    {FLT_MAX},
+    {FLT_MIN},
+    {DOUBLE_QNAN},
+    {DOUBLE_SNAN},
+    {INFINITY},
+    {-INFINITY},
+};
+
+static constexpr FPVector frsp_vectors[] = {
+    {0.0},
+    {-0.0},
+    {DBL_MIN},
+    {DBL_MAX},
+    {FLT_MIN},
+    {FLT_MAX},
+    {5.6519082319399},
+    {21321.94923489023},
+    {DOUBLE_QNAN},
+    {DOUBLE_SNAN},
+    {INFINITY},
+    {-INFINITY},
+};
+
+static constexpr FPVector frsqrte_vectors[] = {
+    {0.0},
+    {-0.0},
+    {-1.0},
+    {36.0},
+    {100.0},
+    {52324.23123123212},
+    {2.66247e-044},
+    {DBL_MIN},
+    {DBL_MAX},
+    {FLT_MIN},
+    {FLT_MAX},
+    {DOUBLE_SNAN},
+    {DOUBLE_QNAN},
+    {INFINITY},
+    {-INFINITY},
+};
+
+static constexpr FPVector fsel_vectors[] = {
+    {0.0, 0.0, 0.0},
+    {10.0, 100.0, 50.0},
+    {-10.0, 100.0, 50.0},
+    {2.66247e-044, 2.0, 1.0},
+    {-2.66247e-044, 2.0, 1.0},
+    {DOUBLE_SNAN, 2.0, 1.0},
+    {DOUBLE_QNAN, 2.0, 1.0},
+    {DOUBLE_SNAN, -INFINITY, INFINITY},
+    {DOUBLE_QNAN, -INFINITY, INFINITY},
+    {DOUBLE_SNAN, INFINITY, -INFINITY},
+    {DOUBLE_QNAN, INFINITY, -INFINITY},
+    {INFINITY, -INFINITY, INFINITY},
+    {INFINITY, -INFINITY, INFINITY},
+    {INFINITY, DOUBLE_QNAN, DOUBLE_SNAN},
+    {INFINITY, DOUBLE_SNAN, DOUBLE_QNAN},
+    {INFINITY, INFINITY, INFINITY},
+    {-INFINITY, -INFINITY, INFINITY},
+    {-INFINITY, -INFINITY, -INFINITY},
+    {-INFINITY, DOUBLE_QNAN, DOUBLE_SNAN},
+    {-INFINITY, DOUBLE_SNAN, DOUBLE_QNAN},
+    {DOUBLE_SNAN, DOUBLE_SNAN, DOUBLE_SNAN},
+    {DOUBLE_QNAN, DOUBLE_QNAN, DOUBLE_QNAN},
+};
+
+static constexpr FPVector fsub_vectors[] = {
+    {0.0, 0.0},
+    {0.5, 0.5},
+    {1.0, 1.0},
+    {3.5, 3.5},
+    {3.92364e-044, 3.92364e-044},
+    {DBL_MAX, DBL_MAX},
+    {-DBL_MAX, -DBL_MAX},
+    {DBL_MAX, -DBL_MAX},
+    {INFINITY, 0.0},
+    {0.0, INFINITY},
+    {FLOAT_SNAN, INFINITY},
+    {FLOAT_QNAN, INFINITY},
+    {FLOAT_QNAN, -INFINITY},
+    {INFINITY, FLOAT_QNAN},
+    {-INFINITY, FLOAT_QNAN},
+    {INFINITY, INFINITY},
+    {INFINITY, -INFINITY},
+    {-INFINITY, INFINITY},
+    {-INFINITY, -INFINITY},
+};
+
+//
+// Test tables
+//
+
+static constexpr FPTest fabs_tests[] = {
+    UNARY_TEST("FABS", fabs_vectors),
+    UNARY_TEST("FABS.", fabs_vectors),
+};
+
+static constexpr FPTest fadd_tests[] = {
+    BINARY_ROUND_TEST("FADD", fadd_vectors),
+    BINARY_ROUND_TEST("FADD.", fadd_vectors),
+    BINARY_ROUND_TEST("FADDS", fadds_vectors),
+    BINARY_ROUND_TEST("FADDS.", fadds_vectors),
+};
+
+static constexpr FPTest fcmp_tests[] = {
+    COMPARE_TEST("FCMPO", fcmpo_vectors),
+    COMPARE_TEST("FCMPU", fcmpo_vectors),
+};
+
+static constexpr FPTest fcti_tests[] = {
+    UNARY_ROUND_TEST("FCTIW", fctiw_vectors),
+    UNARY_ROUND_TEST("FCTIW.", fctiw_rc_denormal_vectors),
+    UNARY_ROUND_TEST("FCTIW", fctiw_special_vectors),
+    UNARY_ROUND_TEST("FCTIW.", fctiw_rc_vectors),
+    UNARY_TEST("FCTIWZ", fctiwz_vectors),
+    UNARY_TEST("FCTIWZ.", fctiwz_vectors),
+};
+
+static constexpr FPTest fdiv_tests[] = {
+    BINARY_ROUND_TEST("FDIV", fdiv_vectors),
+    BINARY_ROUND_TEST("FDIV.", fdiv_vectors),
+    BINARY_ROUND_TEST("FDIVS", fdiv_vectors),
+    BINARY_ROUND_TEST("FDIVS.", fdiv_vectors),
+};
+
+static constexpr FPTest fmadd_tests[] = {
+    FUSED_ROUND_TEST("FMADD", fmadd_vectors),
+    FUSED_ROUND_TEST("FMADD.", fmadd_vectors),
+    FUSED_ROUND_TEST("FMADDS", fmadd_vectors),
+    FUSED_ROUND_TEST("FMADDS.", fmadd_vectors),
+};
+
+static constexpr FPTest fmsub_tests[] = {
+    FUSED_ROUND_TEST("FMSUB", fmadd_vectors),
+    FUSED_ROUND_TEST("FMSUB.", fmadd_vectors),
+    FUSED_ROUND_TEST("FMSUBS", fmadd_vectors),
+    FUSED_ROUND_TEST("FMSUBS.", fmadd_vectors),
+};
+
+static constexpr FPTest fmul_tests[] = {
+    BINARY_ROUND_TEST("FMUL", fmul_vectors),
+    BINARY_ROUND_TEST("FMUL.", fmul_vectors),
+    BINARY_ROUND_TEST("FMULS", fmul_vectors),
+    BINARY_ROUND_TEST("FMULS.", fmul_vectors),
+};
+
+static constexpr FPTest fnabs_tests[] = {
+    UNARY_TEST("FNABS", fabs_vectors),
+    UNARY_TEST("FNABS.", fabs_vectors),
+};
+
+static constexpr FPTest fneg_tests[] = {
+    UNARY_TEST("FNEG", fneg_vectors),
+    UNARY_TEST("FNEG.", fneg_vectors),
+};
+
+static constexpr FPTest fnmadd_tests[] = {
+    FUSED_ROUND_TEST("FNMADD", fmadd_vectors),
+    FUSED_ROUND_TEST("FNMADD.", fmadd_vectors),
+    FUSED_ROUND_TEST("FNMADDS", fmadd_vectors),
+    FUSED_ROUND_TEST("FNMADDS.", fmadd_vectors),
+};
+
+static constexpr FPTest fnmsub_tests[] = {
+    FUSED_ROUND_TEST("FNMSUB", fmadd_vectors),
+    FUSED_ROUND_TEST("FNMSUB.", fmadd_vectors),
+    FUSED_ROUND_TEST("FNMSUBS", fmadd_vectors),
+    FUSED_ROUND_TEST("FNMSUBS.", fmadd_vectors),
+};
+
+static constexpr FPTest fres_tests[] = {
+    UNARY_TEST("FRES", fres_vectors),
+    UNARY_TEST("FRES.", fres_vectors),
+};
+
+static constexpr FPTest frsp_tests[] = {
+    UNARY_ROUND_TEST("FRSP", frsp_vectors),
+    UNARY_ROUND_TEST("FRSP.", frsp_vectors),
+};
+
+static constexpr FPTest frsqrte_tests[] = {
+    UNARY_TEST("FRSQRTE", frsqrte_vectors),
+    UNARY_TEST("FRSQRTE.", frsqrte_vectors),
+};
+
+static constexpr FPTest fsel_tests[] = {
+    SELECT_TEST("FSEL", fsel_vectors),
+    SELECT_TEST("FSEL.", fsel_vectors),
+};
+
+static constexpr FPTest fsub_tests[] = {
+    BINARY_ROUND_TEST("FSUB", fsub_vectors),
+    BINARY_ROUND_TEST("FSUB.", fsub_vectors),
+    BINARY_ROUND_TEST("FSUBS", fsub_vectors),
+    BINARY_ROUND_TEST("FSUBS.", fsub_vectors),
+};
+
+static LogForm GetLogForm(FPForm form)
 {
-    if (index == 0)
-        asm volatile ("mtfsb0 30\nmtfsb0 31\n");
-    else if (index == 1)
-        asm volatile ("mtfsb0 30\nmtfsb1 31\n");
-    else if (index == 2)
-        asm volatile ("mtfsb1 30\nmtfsb0 31\n");
-    else if (index == 3)
-        asm volatile ("mtfsb1 30\nmtfsb1 31\n");
+    switch (form)
+    {
+    case FPForm::Unary:
+    case FPForm::UnaryRound:
+        return LogForm::FloatUnary;
+    case FPForm::BinaryRound:
+        return LogForm::FloatBinary;
+    case FPForm::Compare:
+        return LogForm::FloatCompare;
+    case FPForm::Select:
+    case FPForm::FusedRound:
+        break;
+    }
+
+    return LogForm::FloatTernary;
 }
 
-static void EnableInvalidOperationExceptions()
+static void LogFPResult(const FPTest& test, LogMode mode, const FPVector& vector, const FPResult& result)
 {
-    asm volatile ("mtfsb1 24");
+    LogRecord record = MakeLogRecord(GetLogForm(test.form), test.inst, mode);
+    record.result = result.frD;
+    record.fpscr = result.fpscr;
+    record.cr = result.cr;
+    record.operands[0] = DoubleToBits(vector.frA);
+
+    // Operands are logged in the order the instruction takes them.
+    if (record.form == LogForm::FloatTernary)
+    {
+        record.operands[1] = DoubleToBits(vector.frC);
+        record.operands[2] = DoubleToBits(vector.frB);
+    }
+    else
+    {
+        record.operands[1] = DoubleToBits(vector.frB);
+    }
+
+    LogResult(record);
 }
 
-static const char* GetRoundingModeString(uint32_t index)
+static void RunTest(const FPTest& test, const FPVector& vector)
 {
-    switch (index)
+    const auto run = [&](uint32_t mode) {
+        return test.func(mode, vector.frA, vector.frB, vector.frC);
+    };
+
+    switch (test.form)
     {
-    case 0: // Round to nearest
-        return "(RTN)";
-    case 1: // Round to zero
-        return "(RTZ)";
-    case 2: // Round to +inf
-        return "(RTPI)";
-    case 3: // Round to -inf
-        return "(RTNI)";
+    case FPForm::Compare:
+    case FPForm::Select:
+        LogFPResult(test, LogMode::None, vector, run(TEST_MODE_DEFAULT));
+        return;
+
+    case FPForm::Unary:
+        LogFPResult(test, LogMode::None, vector, run(TEST_MODE_DEFAULT));
+        break;
+
+    case FPForm::UnaryRound:
+    case FPForm::BinaryRound:
+    case FPForm::FusedRound:
+        for (uint32_t i = 0; i <= 3; i++)
+        {
+            const auto mode = static_cast<LogMode>(static_cast<uint32_t>(LogMode::RoundToNearest) + i);
+            LogFPResult(test, mode, vector, run(i));
+        }
+        break;
     }
 
-    return "Unknown";
+    // Test with invalid exceptions enabled
+    LogFPResult(test, LogMode::InvalidOperationException, vector, run(TEST_MODE_VE));
 }
 
-static void CleanTestState()
+template <size_t N>
+static void RunTests(const FPTest (&tests)[N])
 {
-    ClearFPSCR();
-    SetCR(0);
+    for (const FPTest& test : tests)
+    {
+        for (size_t i = 0; i < test.num_vectors; i++)
+            RunTest(test, test.vectors[i]);
+    }
 }
 
-// Test for a 2-component instruction
-// e.g. FABS frD, frB
-#define OPTEST_2_COMPONENTS(inst, frA)                                                                      \
-{                                                                                                           \
-    uint64_t output;                                                                                        \
-                                                                                                            \
-    CleanTestState();                                                                                       \
-    asm volatile (inst " %[out], %[Fra]": [out]"=&f"(output) : [Fra]"f"(frA));                              \
-                                                                                                            \
-    printf("%-8s :: frD 0x%016" PRIX64 " | frA %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",        \
-           inst, output, frA, GetFPSCR(), GetCR());                                                         \
-                                                                                                            \
-    /* Test with invalid exceptions enabled */                                                              \
-    CleanTestState();                                                                                       \
-    EnableInvalidOperationExceptions();                                                                     \
-    asm volatile(                                                                                           \
-        "xor %[out], %[out], %[out]\n"                                                                      \
-        inst " %[out], %[Fra]": [out]"=&f"(output) : [Fra]"f"(frA));                                        \
-                                                                                                            \
-    printf("%-8s %6s :: frD 0x%016" PRIX64 " | frA %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",    \
-           inst, "(VE)", output, frA, GetFPSCR(), GetCR());                                                 \
+// The mode matrix runs every vector again from FPSCR states the tests above never start from:
+// non-IEEE mode, which flushes denormalized results to zero, the exception enables, and
+// exception bits left set by earlier instructions, which FX has to be set for only when an
+// instruction raises another one. Each instruction runs all of its vectors under one mode
+// at a time. See GetInitialFPSCR for the FPSCR of each mode.
+static constexpr LogMode matrix_modes[] = {
+    LogMode::NonIEEE,
+    LogMode::OverflowUnderflowEnabled,
+    LogMode::ZeroDivideInexactEnabled,
+    LogMode::AllExceptionsEnabled,
+    LogMode::NonIEEEAllExceptionsEnabled,
+    LogMode::StickyExceptions,
+    LogMode::StickySummary,
+    LogMode::StickyExceptionsEnabled,
+};
+
+// Vectors per matrix function call, enough for any of the operand tables in one go.
+constexpr size_t MATRIX_BATCH_SIZE = 32;
+
+template <size_t N>
+static void RunModeTests(const FPTest (&tests)[N])
+{
+    FPResult results[MATRIX_BATCH_SIZE];
+
+    for (const FPTest& test : tests)
+    {
+        for (const LogMode mode : matrix_modes)
+        {
+            const uint32_t fpscr = GetInitialFPSCR(mode);
+            for (size_t first = 0; first < test.num_vectors; first += MATRIX_BATCH_SIZE)
+            {
+                const size_t count = std::min(MATRIX_BATCH_SIZE, test.num_vectors - first);
+                test.matrix_func(fpscr, test.vectors + first, results, count);
+
+                // The batch leaves the FPSCR under test in place, which can have NI or enabled
+                // exceptions set. Logging formats doubles, so it has to be cleared first.
+                ClearFPSCR();
+
+                for (size_t i = 0; i < count; i++)
+                    LogFPResult(test, mode, test.vectors[first + i], results[i]);
+            }
+        }
+    }
 }
 
-// Test for a 2-component instruction which tests all rounding modes.
-#define OPTEST_2_COMPONENTS_WITH_ROUND(inst, frA)                                                            \
-{                                                                                                            \
-    uint64_t output;                                                                                         \
-                                                                                                             \
-    for (int i = 0; i <= 3; i++)                                                                             \
-    {                                                                                                        \
-        CleanTestState();                                                                                    \
-                                                                                                             \
-        SetRoundingMode(i);                                                                                  \
-                                                                                                             \
-        asm volatile (inst " %[out], %[Fra]"                                                                 \
-            : [out]"=&f"(output)                                                                             \
-            : [Fra]"f"(frA));                                                                                \
-                                                                                                             \
-        printf("%-8s %6s :: frD 0x%016" PRIX64 " | frA %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", \
-               inst, GetRoundingModeString(i), output, frA, GetFPSCR(), GetCR());                            \
-    }                                                                                                        \
-                                                                                                             \
-    /* Test with invalid exceptions enabled */                                                               \
-    CleanTestState();                                                                                        \
-    EnableInvalidOperationExceptions();                                                                      \
-    asm volatile(                                                                                            \
-        "xor %[out], %[out], %[out]\n"                                                                       \
-        inst " %[out], %[Fra]": [out]"=&f"(output) : [Fra]"f"(frA));                                         \
-                                                                                                             \
-    printf("%-8s %6s :: frD 0x%016" PRIX64 " | frA %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",     \
-           inst, "(VE)", output, frA, GetFPSCR(), GetCR());                                                  \
+#ifdef FUZZ_TESTS
+// The fuzz tests run each arithmetic instruction with FUZZ_VECTORS operands from the
+// class-stratified generator (see FloatClasses.h), in every rounding mode and with invalid
+// operation exceptions enabled. The results are only logged as a digest of each batch of
+// vectors. The batch's seed is logged with it, so tools/modelcheck can generate the same
+// vectors and check the digest against the host's model.
+
+// Vectors per logged digest.
+constexpr uint32_t FUZZ_FLOAT_BATCH = 1 << 16;
+
+// The tests don't clear the compiler's own CR fields, so only cr1 is digested.
+constexpr uint32_t FUZZ_FLOAT_CR_MASK = 0x0F000000;
+
+static void FloatFuzzTest(const FPTest& test, uint64_t seed)
+{
+    ModelInstruction inst{};
+    if (!DecodeModelMnemonic(test.inst, &inst))
+    {
+        printf("%s: not modeled, skipped\n", test.inst);
+        return;
+    }
+
+    for (uint32_t i = 0; i <= 4; i++)
+    {
+        const uint32_t mode = i < 4 ? i : TEST_MODE_VE;
+        const auto log_mode = static_cast<LogMode>(static_cast<uint32_t>(LogMode::RoundToNearest) + i);
+
+        for (uint32_t first = 0; first < FUZZ_VECTORS; first += FUZZ_FLOAT_BATCH)
+        {
+            const uint32_t count = std::min<uint32_t>(FUZZ_FLOAT_BATCH, FUZZ_VECTORS - first);
+            const uint64_t batch_seed = seed ^ (first * 0xBF58476D1CE4E5B9);
+
+            Random random(batch_seed);
+            ResultDigest digest;
+
+            for (uint32_t vector = 0; vector < count; vector++)
+            {
+                uint64_t operands[3];
+                GenerateFloatVector(random, inst, operands);
+
+                // The operands are in assembly order, and the test functions take frA, frB, frC.
+                const double frA = BitsToDouble(operands[0]);
+                const FPResult result = test.form == FPForm::FusedRound
+                                            ? test.func(mode, frA, BitsToDouble(operands[2]), BitsToDouble(operands[1]))
+                                            : test.func(mode, frA, BitsToDouble(operands[1]), 0.0);
+
+                const uint64_t frD = ModelWriteSuppressed(result.fpscr) ? 0 : result.frD;
+                DigestFloat(digest, operands, frD, result.fpscr, result.cr & FUZZ_FLOAT_CR_MASK);
+            }
+
+            LogRecord record = MakeLogRecord(LogForm::FloatSweepDigest, test.inst, log_mode);
+            record.result = digest.Finish();
+            record.operands[0] = batch_seed;
+            record.operands[1] = count;
+            LogResult(record);
+        }
+    }
 }
 
-// Test for a 3-component instruction with all rounding modes.
-// e.g. FADDS frD, frA, frB
-#define OPTEST_3_COMPONENTS_WITH_ROUND(inst, frA, frB)                                                                \
-{                                                                                                                     \
-    uint64_t output;                                                                                                  \
-                                                                                                                      \
-    for (int i = 0; i <= 3; i++)                                                                                      \
-    {                                                                                                                 \
-        CleanTestState();                                                                                             \
-                                                                                                                      \
-        SetRoundingMode(i);                                                                                           \
-                                                                                                                      \
-        asm volatile (inst " %[out], %[Fra], %[Frb]"                                                                  \
-            : [out]"=&f"(output)                                                                                      \
-            : [Fra]"f"(frA), [Frb]"f"(frB));                                                                          \
-                                                                                                                      \
-        printf("%-8s %6s :: frD 0x%016" PRIX64 " | frA %e | frB %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", \
-               inst, GetRoundingModeString(i), output, frA, frB, GetFPSCR(), GetCR());                                \
-    }                                                                                                                 \
-                                                                                                                      \
-    /* Also perform one test of the instruction value with invalid operation exceptions on */                         \
-    CleanTestState();                                                                                                 \
-    EnableInvalidOperationExceptions();                                                                               \
-                                                                                                                      \
-    asm volatile (                                                                                                    \
-        "xor %[out], %[out], %[out]\n"                                                                                \
-        inst " %[out], %[Fra], %[Frb]"                                                                                \
-        : [out]"=&f"(output)                                                                                          \
-        : [Fra]"f"(frA), [Frb]"f"(frB));                                                                              \
-                                                                                                                      \
-    printf("%-8s %6s :: frD 0x%016" PRIX64 " | frA %e | frB %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08"                  \
-           PRIX32 "\n", inst, "(VE)", output, frA, frB, GetFPSCR(), GetCR());                                         \
+// Fuzzes the instructions of a test table. Each instruction gets its own sequence of
+// vectors, derived from the seed.
+template <size_t N>
+static void RunFloatFuzzTests(const FPTest (&tests)[N], uint64_t& seed)
+{
+    for (const FPTest& test : tests)
+    {
+        seed += 0x9E3779B97F4A7C15;
+        FloatFuzzTest(test, seed);
+    }
 }
+#endif
+
+#ifdef EXHAUSTIVE_TESTS
+// The single-precision sweeps run every single-precision bit pattern, as lfs loads it, through
+// the instructions whose results a handful of vectors can't pin down. For single-precision
+// inputs none of these depend on the rounding mode (FRSP is exact, FCTIWZ always truncates and
+// the estimates are table lookups), so they only run in the default mode. Each block of 2^23
+// inputs (one sign and exponent) is logged as one digest, which tools/modelcheck recomputes.
+static constexpr const char* single_sweep_insts[] = {"FCTIWZ.", "FRES.", "FRSP.", "FRSQRTE."};
+
+constexpr uint32_t SINGLE_SWEEP_BLOCK_SIZE = 1U << 23;
+
+// Only cr1 is digested, as in the fuzz tests.
+constexpr uint32_t SINGLE_SWEEP_CR_MASK = 0x0F000000;
+
+static void SingleSweepTest(const FPTest& test)
+{
+    printf("%s (all single-precision inputs)\n", test.inst);
 
-// Used for testing CMP instructions.
-#define OPTEST_3_COMPONENTS_CMP(inst, frA, frB)                                                   \
-{                                                                                                 \
-    CleanTestState();                                                                             \
-    asm volatile (inst " cr1, %[Fra], %[Frb]": : [Fra]"f"(frA), [Frb]"f"(frB));                   \
-                                                                                                  \
-    printf("%-8s :: frA %e | frB %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",            \
-           inst, frA, frB, GetFPSCR(), GetCR());                                                  \
+    for (uint64_t first = 0; first <= UINT32_MAX; first += SINGLE_SWEEP_BLOCK_SIZE)
+    {
+        ResultDigest digest;
+        const uint32_t last = static_cast<uint32_t>(first + SINGLE_SWEEP_BLOCK_SIZE - 1);
+
+        for (uint32_t single = static_cast<uint32_t>(first);; single++)
+        {
+            const uint64_t operands[3] = {SingleToDoubleBits(single), 0, 0};
+            const FPResult result = test.func(TEST_MODE_DEFAULT, BitsToDouble(operands[0]), 0.0, 0.0);
+            DigestFloat(digest, operands, result.frD, result.fpscr, result.cr & SINGLE_SWEEP_CR_MASK);
+
+            if (single == last)
+                break;
+        }
+
+        LogRecord record = MakeLogRecord(LogForm::FloatSingleDigest, test.inst);
+        record.result = digest.Finish();
+        record.operands[0] = first;
+        record.operands[1] = last;
+        LogResult(record);
+    }
 }
 
-// Test for a 4-component instruction.
-#define OPTEST_4_COMPONENTS(inst, frA, frC, frB)                                                                       \
-{                                                                                                                      \
-    uint64_t output;                                                                                                   \
-                                                                                                                       \
-    asm volatile (inst " %[out], %[Fra], %[Frc], %[Frb]"                                                               \
-        : [out]"=&f"(output)                                                                                           \
-        : [Fra]"f"(frA), [Frc]"f"(frC), [Frb]"f"(frB));                                                                \
-                                                                                                                       \
-    printf("%-8s :: frD 0x%016" PRIX64 " | frA %e | frC %e | frB %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", \
-           inst, output, frA, frC, frB, GetFPSCR(), GetCR());                                                          \
+// Runs the instructions of a test table that are in single_sweep_insts with every single-precision input.
+template <size_t N>
+static void RunSingleSweepTests(const FPTest (&tests)[N])
+{
+    for (const FPTest& test : tests)
+    {
+        for (const char* inst : single_sweep_insts)
+        {
+            if (std::strcmp(test.inst, inst) == 0)
+                SingleSweepTest(test);
+        }
+    }
 }
 
-// Test for a 4-component instruction with all rounding modes.
-// e.g. FMADD frD, frA, frC, frB
-#define OPTEST_4_COMPONENTS_WITH_ROUND(inst, frA, frC, frB)                                                                    \
-{                                                                                                                              \
-    uint64_t output;                                                                                                           \
-                                                                                                                               \
-    for (int i = 0; i <= 3; i++)                                                                                               \
-    {                                                                                                                          \
-        CleanTestState();                                                                                                      \
-                                                                                                                               \
-        SetRoundingMode(i);                                                                                                    \
-                                                                                                                               \
-        asm volatile (inst " %[out], %[Fra], %[Frc], %[Frb]"                                                                   \
-            : [out]"=&f"(output)                                                                                               \
-            : [Fra]"f"(frA), [Frc]"f"(frC), [Frb]"f"(frB));                                                                    \
-                                                                                                                               \
-        printf("%-8s %6s :: frD 0x%016" PRIX64 " | frA %e | frC %e | frB %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", \
-               inst, GetRoundingModeString(i), output, frA, frC, frB, GetFPSCR(), GetCR());                                    \
-    }                                                                                                                          \
-                                                                                                                               \
-    /* Also perform one test of the instruction value with invalid operation exceptions on */                                  \
-    CleanTestState();                                                                                                          \
-    EnableInvalidOperationExceptions();                                                                                        \
-                                                                                                                               \
-    asm volatile (                                                                                                             \
-        "xor %[out], %[out], %[out]\n"                                                                                         \
-        inst " %[out], %[Fra], %[Frc], %[Frb]"                                                                                 \
-        : [out]"=&f"(output)                                                                                                   \
-        : [Fra]"f"(frA), [Frc]"f"(frC), [Frb]"f"(frB));                                                                        \
-                                                                                                                               \
-    printf("%-8s %6s :: frD 0x%016" PRIX64 " | frA %e | frC %e | frB %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",     \
-           inst, "(VE)", output, frA, frC, frB, GetFPSCR(), GetCR());                                                          \
+// Recovers every entry of an estimate table from the hardware (see EstimateTable.h), along
+// with how many of the entry's steps its interpolation doesn't reproduce. tools/estimateexport
+// turns these into a table emulators can look the estimates up in.
+static void EstimateTableTest(const FPTest& test, EstimateTable table)
+{
+    printf("%s table\n", test.inst);
+
+    for (uint32_t entry = 0; entry < ESTIMATE_TABLE_ENTRIES; entry++)
+    {
+        const EstimateEntry recovered = RecoverEstimateEntry(table, entry, [&](uint64_t input) {
+            const FPResult result = test.func(TEST_MODE_DEFAULT, BitsToDouble(input), 0.0, 0.0);
+            return EstimateResult{result.frD, result.fpscr};
+        });
+
+        LogRecord record = MakeLogRecord(LogForm::EstimateTableEntry, test.inst);
+        record.result = (static_cast<uint64_t>(recovered.base) << 32) | recovered.dec;
+        record.operands[0] = entry;
+        record.operands[3] = recovered.mismatched;
+        LogResult(record);
+    }
 }
+#endif
 
 // Tests if floating point comparison functions (FCMPO/FCMPU) preserve the class bit when setting the FPCC bits.
 static void FPRFClassBitTest()
@@ -234,6 +898,62 @@ static void FPRFClassBitTest()
     printf("FCMPU :: frA %e | frB %e | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", qnan_1, qnan_2, GetFPSCR(), GetCR());
 }
 
+void PPCFloatingPointModeTests()
+{
+    printf("\n\nFloating-Point Mode Tests\n\n");
+
+    printf("FABS Variants\n");
+    RunModeTests(fabs_tests);
+
+    printf("\nFADD Variants\n");
+    RunModeTests(fadd_tests);
+
+    printf("\nFCMP variants\n");
+    RunModeTests(fcmp_tests);
+
+    printf("\nFCTI Variants\n");
+    RunModeTests(fcti_tests);
+
+    printf("\nFDIV Variants\n");
+    RunModeTests(fdiv_tests);
+
+    printf("\nFMADD Variants\n");
+    RunModeTests(fmadd_tests);
+
+    printf("\nFMSUB Variants\n");
+    RunModeTests(fmsub_tests);
+
+    printf("\nFMUL Variants\n");
+    RunModeTests(fmul_tests);
+
+    printf("\nFNABS Variants\n");
+    RunModeTests(fnabs_tests);
+
+    printf("\nFNEG Variants\n");
+    RunModeTests(fneg_tests);
+
+    printf("\nFNMADD Variants\n");
+    RunModeTests(fnmadd_tests);
+
+    printf("\nFNMSUB Variants\n");
+    RunModeTests(fnmsub_tests);
+
+    printf("\nFRES Variants\n");
+    RunModeTests(fres_tests);
+
+    printf("\nFRSP Variants\n");
+    RunModeTests(frsp_tests);
+
+    printf("\nFRSQRTE Variants\n");
+    RunModeTests(frsqrte_tests);
+
+    printf("\nFSEL Variants\n");
+    RunModeTests(fsel_tests);
+
+    printf("\nFSUB Variants\n");
+    RunModeTests(fsub_tests);
+}
+
 void PPCFloatingPointTests()
 {
     // Run specialized tests first.
@@ -241,709 +961,81 @@ void PPCFloatingPointTests()
     FPRFClassBitTest();
 
     printf("FABS Variants\n");
-    OPTEST_2_COMPONENTS("FABS", 0.0);
-    OPTEST_2_COMPONENTS("FABS", -0.0);
-    OPTEST_2_COMPONENTS("FABS", -1.0);
-    OPTEST_2_COMPONENTS("FABS", -FLT_MIN);
-    OPTEST_2_COMPONENTS("FABS", -FLT_MAX);
-    OPTEST_2_COMPONENTS("FABS", -DBL_MIN);
-    OPTEST_2_COMPONENTS("FABS", -DBL_MAX);
-    OPTEST_2_COMPONENTS("FABS", FLOAT_QNAN);
-    OPTEST_2_COMPONENTS("FABS", FLOAT_SNAN);
-    OPTEST_2_COMPONENTS("FABS", INFINITY);
-    OPTEST_2_COMPONENTS("FABS", -INFINITY);
-    OPTEST_2_COMPONENTS("FABS.", 0.0);
-    OPTEST_2_COMPONENTS("FABS.", -0.0);
-    OPTEST_2_COMPONENTS("FABS.", -1.0);
-    OPTEST_2_COMPONENTS("FABS.", -FLT_MIN);
-    OPTEST_2_COMPONENTS("FABS.", -FLT_MAX);
-    OPTEST_2_COMPONENTS("FABS.", -DBL_MIN);
-    OPTEST_2_COMPONENTS("FABS.", -DBL_MAX);
-    OPTEST_2_COMPONENTS("FABS.", FLOAT_QNAN);
-    OPTEST_2_COMPONENTS("FABS.", FLOAT_SNAN);
-    OPTEST_2_COMPONENTS("FABS.", INFINITY);
-    OPTEST_2_COMPONENTS("FABS.", -INFINITY);
+    RunTests(fabs_tests);
 
     printf("\nFADD Variants\n");
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", 3.5, 3.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", 3.92364e-044, 3.92364e-044);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", DBL_MAX, DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", -DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD", -INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", 3.5, 3.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", 3.92364e-044, 3.92364e-044);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", DBL_MAX, DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", -DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADD.", -INFINITY, -INFINITY);
-
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", 3.5, 3.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", 3.92364e-044, 3.92364e-044);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", FLT_MAX, FLT_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", -FLT_MAX, -FLT_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", FLT_MAX, -FLT_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", 0.0, DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS", -INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", 3.5, 3.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", 3.92364e-044, 3.92364e-044);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", FLT_MAX, FLT_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", -FLT_MAX, -FLT_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", FLT_MAX, -FLT_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", 0.0, DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FADDS.", -INFINITY, -INFINITY);
+    RunTests(fadd_tests);
 
     printf("\nFCMP variants\n");
-    OPTEST_3_COMPONENTS_CMP("FCMPO", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", 0.0, 1.0);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", 1.0, 0.0);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", 0.0, 0.5);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", 0.5, 0.0);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", DOUBLE_QNAN, DOUBLE_QNAN);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", DOUBLE_SNAN, DOUBLE_SNAN);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_CMP("FCMPO", -INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", 0.0, 1.0);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", 1.0, 0.0);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", 0.0, 0.5);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", 0.5, 0.0);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", DOUBLE_QNAN, DOUBLE_QNAN);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", DOUBLE_SNAN, DOUBLE_SNAN);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_CMP("FCMPU", -INFINITY, -INFINITY);
+    RunTests(fcmp_tests);
 
     printf("\nFCTI Variants\n");
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW", 0.0);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW", 0.5);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW", -0.5);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW", 2.4679999352);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW", -2.4679999352);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", 6.30584e-044);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW", FLOAT_SNAN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW", FLOAT_QNAN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW", INFINITY);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW", -INFINITY);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", 0.0);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", 0.5);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", -0.5);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", 2.4679999352);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", -2.4679999352);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", 6.30584e-044);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", FLOAT_SNAN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", FLOAT_QNAN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", INFINITY);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FCTIW.", -INFINITY);
-    OPTEST_2_COMPONENTS("FCTIWZ", 0.0);
-    OPTEST_2_COMPONENTS("FCTIWZ", 0.5);
-    OPTEST_2_COMPONENTS("FCTIWZ", -0.5);
-    OPTEST_2_COMPONENTS("FCTIWZ", 2.4679999352);
-    OPTEST_2_COMPONENTS("FCTIWZ", -2.4679999352);
-    OPTEST_2_COMPONENTS("FCTIWZ", FLOAT_SNAN);
-    OPTEST_2_COMPONENTS("FCTIWZ", FLOAT_QNAN);
-    OPTEST_2_COMPONENTS("FCTIWZ", INFINITY);
-    OPTEST_2_COMPONENTS("FCTIWZ", -INFINITY);
-    OPTEST_2_COMPONENTS("FCTIWZ.", 0.0);
-    OPTEST_2_COMPONENTS("FCTIWZ.", 0.5);
-    OPTEST_2_COMPONENTS("FCTIWZ.", -0.5);
-    OPTEST_2_COMPONENTS("FCTIWZ.", 2.4679999352);
-    OPTEST_2_COMPONENTS("FCTIWZ.", -2.4679999352);
-    OPTEST_2_COMPONENTS("FCTIWZ.", FLOAT_SNAN);
-    OPTEST_2_COMPONENTS("FCTIWZ.", FLOAT_QNAN);
-    OPTEST_2_COMPONENTS("FCTIWZ.", INFINITY);
-    OPTEST_2_COMPONENTS("FCTIWZ.", -INFINITY);
+    RunTests(fcti_tests);
 
     printf("\nFDIV Variants\n");
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", 0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", -0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", 10.0, 5.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", 4.9359998704, 2.4679999352);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", 2.4679999352, 4.9359998704);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", 2.10195e-044, 2.45208e-029);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", FLOAT_SNAN, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", FLOAT_SNAN, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", FLOAT_QNAN, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", FLOAT_QNAN, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", FLOAT_SNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV", -INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", 0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", -0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", 10.0, 5.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", 4.9359998704, 2.4679999352);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", 2.4679999352, 4.9359998704);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", 2.10195e-044, 2.45208e-029);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", FLOAT_SNAN, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", FLOAT_SNAN, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", FLOAT_QNAN, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", FLOAT_QNAN, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", FLOAT_SNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIV.", -INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", 0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", -0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", 10.0, 5.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", 4.9359998704, 2.4679999352);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", 2.4679999352, 4.9359998704);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", 2.10195e-044, 2.45208e-029);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", FLOAT_SNAN, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", FLOAT_SNAN, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", FLOAT_QNAN, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", FLOAT_QNAN, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", FLOAT_SNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS", -INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", 0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", -0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", 10.0, 5.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", 4.9359998704, 2.4679999352);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", 2.4679999352, 4.9359998704);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", 2.10195e-044, 2.45208e-029);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", FLOAT_SNAN, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", FLOAT_SNAN, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", FLOAT_QNAN, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", FLOAT_QNAN, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", FLOAT_SNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FDIVS.", -INFINITY, FLOAT_SNAN);
+    RunTests(fdiv_tests);
 
     printf("\nFMADD Variants\n");
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD.", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD.", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD.", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD.", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD.", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD.", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD.", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADD.", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS.", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS.", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS.", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS.", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS.", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS.", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS.", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMADDS.", 1.0, 1.0, -INFINITY);
+    RunTests(fmadd_tests);
 
     printf("\nFMSUB Variants\n");
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB.", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB.", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB.", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB.", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB.", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB.", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB.", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUB.", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS.", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS.", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS.", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS.", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS.", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS.", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS.", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FMSUBS.", 1.0, 1.0, -INFINITY);
+    RunTests(fmsub_tests);
 
     printf("\nFMUL Variants\n");
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", -0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", 0.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", INFINITY, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", 5.0, 5.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", 0.25, 0.35);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", 2.999999984523, 6.888239210233);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", 5.0, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", 5.0, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", 5.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", 5.0, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL", -INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", -0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", 0.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", INFINITY, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", 5.0, 5.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", 0.25, 0.35);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", 2.999999984523, 6.888239210233);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", 5.0, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", 5.0, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", 5.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", 5.0, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMUL.", -INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", -0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", 0.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", INFINITY, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", 5.0, 5.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", 0.25, 0.35);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", 2.999999984523, 6.888239210233);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", 5.0, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", 5.0, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", 5.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", 5.0, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS", -INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", -0.0, -0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", 0.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", INFINITY, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", 5.0, 5.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", 0.25, 0.35);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", 2.999999984523, 6.888239210233);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", 5.0, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", 5.0, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", 5.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", 5.0, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", INFINITY, FLOAT_SNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FMULS.", -INFINITY, FLOAT_SNAN);
+    RunTests(fmul_tests);
 
     printf("\nFNABS Variants\n");
-    OPTEST_2_COMPONENTS("FNABS", 0.0);
-    OPTEST_2_COMPONENTS("FNABS", -0.0);
-    OPTEST_2_COMPONENTS("FNABS", -1.0);
-    OPTEST_2_COMPONENTS("FNABS", -FLT_MIN);
-    OPTEST_2_COMPONENTS("FNABS", -FLT_MAX);
-    OPTEST_2_COMPONENTS("FNABS", -DBL_MIN);
-    OPTEST_2_COMPONENTS("FNABS", -DBL_MAX);
-    OPTEST_2_COMPONENTS("FNABS", FLOAT_QNAN);
-    OPTEST_2_COMPONENTS("FNABS", FLOAT_SNAN);
-    OPTEST_2_COMPONENTS("FNABS", INFINITY);
-    OPTEST_2_COMPONENTS("FNABS", -INFINITY);
-    OPTEST_2_COMPONENTS("FNABS.", 0.0);
-    OPTEST_2_COMPONENTS("FNABS.", -0.0);
-    OPTEST_2_COMPONENTS("FNABS.", -1.0);
-    OPTEST_2_COMPONENTS("FNABS.", -FLT_MIN);
-    OPTEST_2_COMPONENTS("FNABS.", -FLT_MAX);
-    OPTEST_2_COMPONENTS("FNABS.", -DBL_MIN);
-    OPTEST_2_COMPONENTS("FNABS.", -DBL_MAX);
-    OPTEST_2_COMPONENTS("FNABS.", FLOAT_QNAN);
-    OPTEST_2_COMPONENTS("FNABS.", FLOAT_SNAN);
-    OPTEST_2_COMPONENTS("FNABS.", INFINITY);
-    OPTEST_2_COMPONENTS("FNABS.", -INFINITY);
+    RunTests(fnabs_tests);
 
     printf("\nFNEG Variants\n");
-    OPTEST_2_COMPONENTS("FNEG", 0.0);
-    OPTEST_2_COMPONENTS("FNEG", -0.0);
-    OPTEST_2_COMPONENTS("FNEG", DBL_MAX);
-    OPTEST_2_COMPONENTS("FNEG", -DBL_MAX);
-    OPTEST_2_COMPONENTS("FNEG", DBL_MIN);
-    OPTEST_2_COMPONENTS("FNEG", -DBL_MIN);
-    OPTEST_2_COMPONENTS("FNEG", DOUBLE_QNAN);
-    OPTEST_2_COMPONENTS("FNEG", DOUBLE_SNAN);
-    OPTEST_2_COMPONENTS("FNEG", INFINITY);
-    OPTEST_2_COMPONENTS("FNEG", INFINITY);
-    OPTEST_2_COMPONENTS("FNEG.", 0.0);
-    OPTEST_2_COMPONENTS("FNEG.", -0.0);
-    OPTEST_2_COMPONENTS("FNEG.", DBL_MAX);
-    OPTEST_2_COMPONENTS("FNEG.", -DBL_MAX);
-    OPTEST_2_COMPONENTS("FNEG.", DBL_MIN);
-    OPTEST_2_COMPONENTS("FNEG.", -DBL_MIN);
-    OPTEST_2_COMPONENTS("FNEG.", DOUBLE_QNAN);
-    OPTEST_2_COMPONENTS("FNEG.", DOUBLE_SNAN);
-    OPTEST_2_COMPONENTS("FNEG.", INFINITY);
-    OPTEST_2_COMPONENTS("FNEG.", INFINITY);
+    RunTests(fneg_tests);
 
     printf("\nFNMADD Variants\n");
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD.", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD.", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD.", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD.", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD.", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD.", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD.", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADD.", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS.", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS.", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS.", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS.", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS.", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS.", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS.", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMADDS.", 1.0, 1.0, -INFINITY);
+    RunTests(fnmadd_tests);
 
     printf("\nFNMSUB Variants\n");
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB.", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB.", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB.", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB.", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB.", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB.", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB.", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUB.", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS", 1.0, 1.0, -INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS.", 1.0, 1.0, 1.0);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS.", 5.5, 5.5, 5.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS.", 7.3233339282, 7.9999999234, 3.5);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS.", 6.30584e-044, 3.08286e-044, 1.54143e-044);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS.", 1.0, 1.0, FLOAT_QNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS.", 1.0, 1.0, FLOAT_SNAN);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS.", 1.0, 1.0, INFINITY);
-    OPTEST_4_COMPONENTS_WITH_ROUND("FNMSUBS.", 1.0, 1.0, -INFINITY);
+    RunTests(fnmsub_tests);
 
     printf("\nFRES Variants\n");
-    OPTEST_2_COMPONENTS("FRES", 0.0);
-    OPTEST_2_COMPONENTS("FRES", -0.0);
-    OPTEST_2_COMPONENTS("FRES", 100.986352178);
-    OPTEST_2_COMPONENTS("FRES", 7.3233339282);
-    OPTEST_2_COMPONENTS("FRES", 6.30584e-044);
-    OPTEST_2_COMPONENTS("FRES", 69.0);
-    OPTEST_2_COMPONENTS("FRES", 420.0);
-    OPTEST_2_COMPONENTS("FRES", DBL_MAX);
-    OPTEST_2_COMPONENTS("FRES", DBL_MIN);
-    OPTEST_2_COMPONENTS("FRES", FLT_MAX);
-    OPTEST_2_COMPONENTS("FRES", FLT_MIN);
-    OPTEST_2_COMPONENTS("FRES", DOUBLE_QNAN);
-    OPTEST_2_COMPONENTS("FRES", DOUBLE_SNAN);
-    OPTEST_2_COMPONENTS("FRES", INFINITY);
-    OPTEST_2_COMPONENTS("FRES", -INFINITY);
-    OPTEST_2_COMPONENTS("FRES.", 0.0);
-    OPTEST_2_COMPONENTS("FRES.", -0.0);
-    OPTEST_2_COMPONENTS("FRES.", 100.986352178);
-    OPTEST_2_COMPONENTS("FRES.", 7.3233339282);
-    OPTEST_2_COMPONENTS("FRES.", 6.30584e-044);
-    OPTEST_2_COMPONENTS("FRES.", 69.0);
-    OPTEST_2_COMPONENTS("FRES.", 420.0);
-    OPTEST_2_COMPONENTS("FRES.", DBL_MAX);
-    OPTEST_2_COMPONENTS("FRES.", DBL_MIN);
-    OPTEST_2_COMPONENTS("FRES.", FLT_MAX);
-    OPTEST_2_COMPONENTS("FRES.", FLT_MIN);
-    OPTEST_2_COMPONENTS("FRES.", DOUBLE_QNAN);
-    OPTEST_2_COMPONENTS("FRES.", DOUBLE_SNAN);
-    OPTEST_2_COMPONENTS("FRES.", INFINITY);
-    OPTEST_2_COMPONENTS("FRES.", -INFINITY);
+    RunTests(fres_tests);
 
     printf("\nFRSP Variants\n");
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", 0.0);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", -0.0);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", DBL_MIN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", DBL_MAX);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", FLT_MIN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", FLT_MAX);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", 5.6519082319399);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", 21321.94923489023);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", DOUBLE_QNAN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", DOUBLE_SNAN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", INFINITY);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP", -INFINITY);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", 0.0);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", -0.0);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", DBL_MIN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", DBL_MAX);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", FLT_MIN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", FLT_MAX);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", 5.6519082319399);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", 21321.94923489023);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", DOUBLE_QNAN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", DOUBLE_SNAN);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", INFINITY);
-    OPTEST_2_COMPONENTS_WITH_ROUND("FRSP.", -INFINITY);
+    RunTests(frsp_tests);
 
     printf("\nFRSQRTE Variants\n");
-    OPTEST_2_COMPONENTS("FRSQRTE", 0.0);
-    OPTEST_2_COMPONENTS("FRSQRTE", -0.0);
-    OPTEST_2_COMPONENTS("FRSQRTE", -1.0);
-    OPTEST_2_COMPONENTS("FRSQRTE", 36.0);
-    OPTEST_2_COMPONENTS("FRSQRTE", 100.0);
-    OPTEST_2_COMPONENTS("FRSQRTE", 52324.23123123212);
-    OPTEST_2_COMPONENTS("FRSQRTE", 2.66247e-044);
-    OPTEST_2_COMPONENTS("FRSQRTE", DBL_MIN);
-    OPTEST_2_COMPONENTS("FRSQRTE", DBL_MAX);
-    OPTEST_2_COMPONENTS("FRSQRTE", FLT_MIN);
-    OPTEST_2_COMPONENTS("FRSQRTE", FLT_MAX);
-    OPTEST_2_COMPONENTS("FRSQRTE", DOUBLE_SNAN);
-    OPTEST_2_COMPONENTS("FRSQRTE", DOUBLE_QNAN);
-    OPTEST_2_COMPONENTS("FRSQRTE", INFINITY);
-    OPTEST_2_COMPONENTS("FRSQRTE", -INFINITY);
-    OPTEST_2_COMPONENTS("FRSQRTE.", 0.0);
-    OPTEST_2_COMPONENTS("FRSQRTE.", -0.0);
-    OPTEST_2_COMPONENTS("FRSQRTE.", -1.0);
-    OPTEST_2_COMPONENTS("FRSQRTE.", 36.0);
-    OPTEST_2_COMPONENTS("FRSQRTE.", 100.0);
-    OPTEST_2_COMPONENTS("FRSQRTE.", 52324.23123123212);
-    OPTEST_2_COMPONENTS("FRSQRTE.", 2.66247e-044);
-    OPTEST_2_COMPONENTS("FRSQRTE.", DBL_MIN);
-    OPTEST_2_COMPONENTS("FRSQRTE.", DBL_MAX);
-    OPTEST_2_COMPONENTS("FRSQRTE.", FLT_MIN);
-    OPTEST_2_COMPONENTS("FRSQRTE.", FLT_MAX);
-    OPTEST_2_COMPONENTS("FRSQRTE.", DOUBLE_SNAN);
-    OPTEST_2_COMPONENTS("FRSQRTE.", DOUBLE_QNAN);
-    OPTEST_2_COMPONENTS("FRSQRTE.", INFINITY);
-    OPTEST_2_COMPONENTS("FRSQRTE.", -INFINITY);
+    RunTests(frsqrte_tests);
 
     printf("\nFSEL Variants\n");
-    OPTEST_4_COMPONENTS("FSEL", 0.0, 0.0, 0.0);
-    OPTEST_4_COMPONENTS("FSEL", 10.0, 50.0, 100.0);
-    OPTEST_4_COMPONENTS("FSEL", -10.0, 50.0, 100.0);
-    OPTEST_4_COMPONENTS("FSEL", 2.66247e-044, 1.0, 2.0)
-    OPTEST_4_COMPONENTS("FSEL", -2.66247e-044, 1.0, 2.0)
-    OPTEST_4_COMPONENTS("FSEL", DOUBLE_SNAN, 1.0, 2.0);
-    OPTEST_4_COMPONENTS("FSEL", DOUBLE_QNAN, 1.0, 2.0);
-    OPTEST_4_COMPONENTS("FSEL", DOUBLE_SNAN, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL", DOUBLE_QNAN, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL", DOUBLE_SNAN, -INFINITY, INFINITY);
-    OPTEST_4_COMPONENTS("FSEL", DOUBLE_QNAN, -INFINITY, INFINITY);
-    OPTEST_4_COMPONENTS("FSEL", INFINITY, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL", INFINITY, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL", INFINITY, DOUBLE_SNAN, DOUBLE_QNAN);
-    OPTEST_4_COMPONENTS("FSEL", INFINITY, DOUBLE_QNAN, DOUBLE_SNAN);
-    OPTEST_4_COMPONENTS("FSEL", INFINITY, INFINITY, INFINITY);
-    OPTEST_4_COMPONENTS("FSEL", -INFINITY, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL", -INFINITY, -INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL", -INFINITY, DOUBLE_SNAN, DOUBLE_QNAN);
-    OPTEST_4_COMPONENTS("FSEL", -INFINITY, DOUBLE_QNAN, DOUBLE_SNAN);
-    OPTEST_4_COMPONENTS("FSEL", DOUBLE_SNAN, DOUBLE_SNAN, DOUBLE_SNAN);
-    OPTEST_4_COMPONENTS("FSEL", DOUBLE_QNAN, DOUBLE_QNAN, DOUBLE_QNAN);
-    OPTEST_4_COMPONENTS("FSEL.", 0.0, 0.0, 0.0);
-    OPTEST_4_COMPONENTS("FSEL.", 10.0, 50.0, 100.0);
-    OPTEST_4_COMPONENTS("FSEL.", -10.0, 50.0, 100.0);
-    OPTEST_4_COMPONENTS("FSEL.", 2.66247e-044, 1.0, 2.0)
-    OPTEST_4_COMPONENTS("FSEL.", -2.66247e-044, 1.0, 2.0)
-    OPTEST_4_COMPONENTS("FSEL.", DOUBLE_SNAN, 1.0, 2.0);
-    OPTEST_4_COMPONENTS("FSEL.", DOUBLE_QNAN, 1.0, 2.0);
-    OPTEST_4_COMPONENTS("FSEL.", DOUBLE_SNAN, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL.", DOUBLE_QNAN, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL.", DOUBLE_SNAN, -INFINITY, INFINITY);
-    OPTEST_4_COMPONENTS("FSEL.", DOUBLE_QNAN, -INFINITY, INFINITY);
-    OPTEST_4_COMPONENTS("FSEL.", INFINITY, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL.", INFINITY, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL.", INFINITY, DOUBLE_SNAN, DOUBLE_QNAN);
-    OPTEST_4_COMPONENTS("FSEL.", INFINITY, DOUBLE_QNAN, DOUBLE_SNAN);
-    OPTEST_4_COMPONENTS("FSEL.", INFINITY, INFINITY, INFINITY);
-    OPTEST_4_COMPONENTS("FSEL.", -INFINITY, INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL.", -INFINITY, -INFINITY, -INFINITY);
-    OPTEST_4_COMPONENTS("FSEL.", -INFINITY, DOUBLE_SNAN, DOUBLE_QNAN);
-    OPTEST_4_COMPONENTS("FSEL.", -INFINITY, DOUBLE_QNAN, DOUBLE_SNAN);
-    OPTEST_4_COMPONENTS("FSEL.", DOUBLE_SNAN, DOUBLE_SNAN, DOUBLE_SNAN);
-    OPTEST_4_COMPONENTS("FSEL.", DOUBLE_QNAN, DOUBLE_QNAN, DOUBLE_QNAN);
+    RunTests(fsel_tests);
 
     printf("\nFSUB Variants\n");
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", 3.5, 3.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", 3.92364e-044, 3.92364e-044);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", DBL_MAX, DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", -DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", INFINITY, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", 0.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB", -INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", 3.5, 3.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", 3.92364e-044, 3.92364e-044);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", DBL_MAX, DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", -DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", INFINITY, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", 0.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUB.", -INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", 3.5, 3.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", 3.92364e-044, 3.92364e-044);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", DBL_MAX, DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", -DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", INFINITY, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", 0.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS", -INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", 0.0, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", 0.5, 0.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", 1.0, 1.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", 3.5, 3.5);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", 3.92364e-044, 3.92364e-044);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", DBL_MAX, DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", -DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", DBL_MAX, -DBL_MAX);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", INFINITY, 0.0);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", 0.0, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", FLOAT_SNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", FLOAT_QNAN, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", FLOAT_QNAN, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", -INFINITY, FLOAT_QNAN);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", INFINITY, -INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", -INFINITY, INFINITY);
-    OPTEST_3_COMPONENTS_WITH_ROUND("FSUBS.", -INFINITY, -INFINITY);
+    RunTests(fsub_tests);
+
+#ifdef FUZZ_TESTS
+    // Offset from the integer fuzz tests' seeds, so the two don't share vectors.
+    printf("\n\nFloating-Point Fuzz Tests (seed 0x%016" PRIX64 ", %" PRIu32 " vectors each)\n\n",
+           static_cast<uint64_t>(FUZZ_SEED), static_cast<uint32_t>(FUZZ_VECTORS));
+
+    uint64_t seed = ~static_cast<uint64_t>(FUZZ_SEED);
+    RunFloatFuzzTests(fadd_tests, seed);
+    RunFloatFuzzTests(fdiv_tests, seed);
+    RunFloatFuzzTests(fmadd_tests, seed);
+    RunFloatFuzzTests(fmsub_tests, seed);
+    RunFloatFuzzTests(fmul_tests, seed);
+    RunFloatFuzzTests(fnmadd_tests, seed);
+    RunFloatFuzzTests(fnmsub_tests, seed);
+    RunFloatFuzzTests(fsub_tests, seed);
+#endif
+
+#ifdef EXHAUSTIVE_TESTS
+    printf("\n\nFloating-Point Exhaustive Tests\n\n");
+
+    RunSingleSweepTests(fcti_tests);
+    RunSingleSweepTests(fres_tests);
+    RunSingleSweepTests(frsp_tests);
+    RunSingleSweepTests(frsqrte_tests);
+
+    EstimateTableTest(fres_tests[0], EstimateTable::Reciprocal);
+    EstimateTableTest(frsqrte_tests[0], EstimateTable::ReciprocalSqrt);
+#endif
 }
@@ -1,92 +1,1003 @@
+#include <array>
 #include <cinttypes>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
-
+#include <cstring>
+#include <iterator>
+
+#include "CodeBuffer.h"
+#include "Digest.h"
+#include "Encoding.h"
+#include "IntegerChain.h"
+#include "Log.h"
+#include "PPCModel.h"
+#include "Random.h"
 #include "Tests.h"
 
-// Test for a 2-component instruction
-// e.g. ADDME rD, rA
-#define OPTEST_2_COMPONENTS(inst, rA)                                                                            \
-{                                                                                                                \
-    uint32_t output;                                                                                             \
-                                                                                                                 \
-    SetXER(0);                                                                                                   \
-    SetCR(0);                                                                                                    \
-    asm volatile (inst " %[out], %[Ra]": [out]"=&r"(output) : [Ra]"r"(rA));                                      \
-                                                                                                                 \
-    printf("%-8s :: rD 0x%08" PRIX32 " | rA 0x%08" PRIX32 " | XER: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",     \
-           inst, output, static_cast<uint32_t>(rA), GetXER(), GetCR());                                          \
+// The general instruction tests are table driven. Each instruction gets
+// exactly one small function containing its inline asm, and the operands
+// it's tested with are plain data. This keeps the code size proportional
+// to the number of instructions rather than the number of test vectors.
+
+// Architectural state captured after executing a test vector.
+struct IntegerResult
+{
+    uint32_t rD;
+    uint32_t xer;
+    uint32_t cr;
+};
+
+// XER and CR an instruction starts from.
+struct IntegerState
+{
+    uint32_t xer;
+    uint32_t cr;
+};
+
+// Executes an instruction with the given operands from each of count starting states in
+// turn, storing a result for each. The operands stay in their registers throughout, so only
+// XER and CR are set up again for each state.
+// Unary instructions ignore rB. Immediate forms ignore it as well,
+// since their immediate has to be encoded into the function itself.
+using IntegerTestFunc = void (*)(uint32_t rA, uint32_t rB, const IntegerState* states, IntegerResult* results, size_t count);
+
+struct IntegerVector
+{
+    uint32_t rA;
+    uint32_t rB = 0; // Holds the immediate for immediate forms.
+
+    // Immediate forms can't take their immediate at runtime, so each of their vectors
+    // carries its own function. This is null for every other form.
+    IntegerTestFunc func = nullptr;
+};
+
+struct IntegerTest
+{
+    const char* inst;
+    LogForm form; // Determines how the operands are interpreted and logged.
+    IntegerTestFunc func;
+    const IntegerVector* vectors;
+    size_t num_vectors;
+};
+
+#define UNARY_FUNC(inst)                                                                          \
+    [](uint32_t rA, uint32_t, const IntegerState* states, IntegerResult* results, size_t count) { \
+        for (size_t i = 0; i < count; i++)                                                        \
+        {                                                                                         \
+            IntegerResult& result = results[i];                                                   \
+            SetXER(states[i].xer);                                                                \
+            SetCR(states[i].cr);                                                                  \
+            asm volatile (inst " %[out], %[Ra]" : [out]"=&r"(result.rD) : [Ra]"r"(rA));           \
+            result.xer = GetXER();                                                                \
+            result.cr = GetCR();                                                                  \
+        }                                                                                         \
+    }
+
+#define BINARY_FUNC(inst)                                                                                   \
+    [](uint32_t rA, uint32_t rB, const IntegerState* states, IntegerResult* results, size_t count) {        \
+        for (size_t i = 0; i < count; i++)                                                                  \
+        {                                                                                                   \
+            IntegerResult& result = results[i];                                                             \
+            SetCR(states[i].cr);                                                                            \
+            SetXER(states[i].xer);                                                                          \
+            asm volatile (inst " %[out], %[Ra], %[Rb]" : [out]"=&r"(result.rD) : [Ra]"r"(rA), [Rb]"r"(rB)); \
+            result.xer = GetXER();                                                                          \
+            result.cr = GetCR();                                                                            \
+        }                                                                                                   \
+    }
+
+#define IMMEDIATE_FUNC(inst, imm)                                                                              \
+    [](uint32_t rA, uint32_t, const IntegerState* states, IntegerResult* results, size_t count) {              \
+        for (size_t i = 0; i < count; i++)                                                                     \
+        {                                                                                                      \
+            IntegerResult& result = results[i];                                                                \
+            SetCR(states[i].cr);                                                                               \
+            SetXER(states[i].xer);                                                                             \
+            asm volatile (inst " %[out], %[Ra], %[Imm]" : [out]"=&r"(result.rD) : [Ra]"r"(rA), [Imm]"i"(imm)); \
+            result.xer = GetXER();                                                                             \
+            result.cr = GetCR();                                                                               \
+        }                                                                                                      \
+    }
+
+// Stores result to cr0.
+#define COMPARE_FUNC(inst)                                                                           \
+    [](uint32_t rA, uint32_t rB, const IntegerState* states, IntegerResult* results, size_t count) { \
+        for (size_t i = 0; i < count; i++)                                                           \
+        {                                                                                            \
+            IntegerResult& result = results[i];                                                      \
+            result.rD = 0;                                                                           \
+            SetCR(states[i].cr);                                                                     \
+            SetXER(states[i].xer);                                                                   \
+            asm volatile (inst " cr0, %[Ra], %[Rb]" : : [Ra]"r"(rA), [Rb]"r"(rB));                   \
+            result.xer = GetXER();                                                                   \
+            result.cr = GetCR();                                                                     \
+        }                                                                                            \
+    }
+
+#define COMPARE_IMMEDIATE_FUNC(inst, imm)                                                         \
+    [](uint32_t rA, uint32_t, const IntegerState* states, IntegerResult* results, size_t count) { \
+        for (size_t i = 0; i < count; i++)                                                        \
+        {                                                                                         \
+            IntegerResult& result = results[i];                                                   \
+            result.rD = 0;                                                                        \
+            SetCR(states[i].cr);                                                                  \
+            SetXER(states[i].xer);                                                                \
+            asm volatile (inst " cr0, %[Ra], %[Imm]" : : [Ra]"r"(rA), [Imm]"i"(imm));             \
+            result.xer = GetXER();                                                                \
+            result.cr = GetCR();                                                                  \
+        }                                                                                         \
+    }
+
+// Runs a single vector from a clean CR and the given XER.
+static IntegerResult RunIntegerVector(IntegerTestFunc func, uint32_t rA, uint32_t rB, uint32_t xer)
+{
+    const IntegerState state{xer, 0};
+    IntegerResult result{};
+    func(rA, rB, &state, &result, 1);
+    return result;
 }
 
-// Test for a 3-component instruction
-// e.g. ADD rD, rA, rB
-#define OPTEST_3_COMPONENTS(inst, rA, rB)                                                                                                    \
-{                                                                                                                                            \
-    uint32_t output;                                                                                                                         \
-                                                                                                                                             \
-    SetCR(0);                                                                                                                                \
-    SetXER(0);                                                                                                                               \
-    asm volatile (inst " %[out], %[Ra], %[Rb]": [out]"=&r"(output) : [Ra]"r"(rA), [Rb]"r"(rB));                                              \
-                                                                                                                                             \
-    printf("%-8s :: rD 0x%08" PRIX32 " | rA 0x%08" PRIX32 " | rB 0x%08" PRIX32 " | XER: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",            \
-           inst, output, static_cast<uint32_t>(rA), static_cast<uint32_t>(rB), GetXER(), GetCR());                                           \
+// Vectors for immediate forms.
+#define IMM(inst, rA, imm) \
+    {static_cast<uint32_t>(rA), static_cast<uint32_t>(imm), IMMEDIATE_FUNC(inst, imm)}
+#define CMP_IMM(inst, rA, imm) \
+    {static_cast<uint32_t>(rA), static_cast<uint32_t>(imm), COMPARE_IMMEDIATE_FUNC(inst, imm)}
+
+// Table entries.
+#define UNARY_TEST(inst, vectors) \
+    {inst, LogForm::IntegerUnary, UNARY_FUNC(inst), std::data(vectors), std::size(vectors)}
+#define BINARY_TEST(inst, vectors) \
+    {inst, LogForm::IntegerBinary, BINARY_FUNC(inst), std::data(vectors), std::size(vectors)}
+#define IMMEDIATE_TEST(inst, vectors) \
+    {inst, LogForm::IntegerImmediate, nullptr, std::data(vectors), std::size(vectors)}
+#define COMPARE_TEST(inst, vectors) \
+    {inst, LogForm::IntegerCompare, COMPARE_FUNC(inst), std::data(vectors), std::size(vectors)}
+#define COMPARE_IMMEDIATE_TEST(inst, vectors) \
+    {inst, LogForm::IntegerCompareImmediate, nullptr, std::data(vectors), std::size(vectors)}
+
+// Test for a 5-component instruction (sets the rD before the operation).
+// e.g. RLWIMI rA, rS, SH, MB, ME
+//
+// SH, MB and ME are immediates, so these can't be driven from a table yet
+// and still expand in place.
+#define OPTEST_5_COMPONENTS(inst, rA, rS, SH, MB, ME)                          \
+{                                                                              \
+    uint32_t output = rA;                                                      \
+                                                                               \
+    SetCR(0);                                                                  \
+    SetXER(0);                                                                 \
+    asm volatile (inst " %[out], %[Rs], %[Sh], %[Mb], %[Me]"                   \
+        : [out]"=&r"(output)                                                   \
+        : [Rs]"r"(rS), [Sh]"r"(SH), [Mb]"r"(MB), [Me]"r"(ME));                 \
+                                                                               \
+    LogRecord record = MakeLogRecord(LogForm::IntegerRotate, inst);            \
+    record.result = output;                                                    \
+    record.xer = GetXER();                                                     \
+    record.cr = GetCR();                                                       \
+    record.operands[0] = static_cast<uint32_t>(rS);                            \
+    record.operands[1] = static_cast<uint32_t>(SH);                            \
+    record.operands[2] = static_cast<uint32_t>(MB);                            \
+    record.operands[3] = static_cast<uint32_t>(ME);                            \
+    LogResult(record);                                                         \
 }
 
-// Test for a 3-component instruction, where the third component is an immediate.
-#define OPTEST_3_COMPONENTS_IMM(inst, rA, imm)                                                                                               \
-{                                                                                                                                            \
-    uint32_t output;                                                                                                                         \
-                                                                                                                                             \
-    SetCR(0);                                                                                                                                \
-    SetXER(0);                                                                                                                               \
-    asm volatile (inst " %[out], %[Ra], %[Imm]": [out]"=&r"(output) : [Ra]"r"(rA), [Imm]"i"(imm));                                           \
-                                                                                                                                             \
-    printf("%-8s :: rD 0x%08" PRIX32 " | rA 0x%08" PRIX32 " | imm 0x%08" PRIX32 " | XER: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",           \
-           inst, output, static_cast<uint32_t>(rA), static_cast<uint32_t>(imm), GetXER(), GetCR());                                          \
+//
+// Operand tables
+//
+
+static constexpr IntegerVector add_vectors[] = {
+    {0x7FFFFFFF, 1},
+    {0x80000000, 1},
+    {0xFFFFFFFF, 1},
+    {0xFFFFFFFF, 1},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+    {1, 0},
+    {0, 0xFFFFFFFF},
+};
+
+static constexpr IntegerVector add_extended_overflow_vectors[] = {
+    {0x7FFFFFFF, 1},
+    {0x80000000, 1},
+    {0x80000000, 0x80000000},
+    {0xFFFFFFFF, 1},
+    {0xFFFFFFFF, 1},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+    {1, 0},
+    {0, 0xFFFFFFFF},
+};
+
+#define ADD_IMMEDIATE_VECTORS(inst) \
+    IMM(inst, 0x7FFFFFFF, 1),       \
+    IMM(inst, 0x80000000, 1),       \
+    IMM(inst, 0xFFFFFFFF, 1),       \
+    IMM(inst, -1, 1),               \
+    IMM(inst, -1, -1),              \
+    IMM(inst, 1, 0),                \
+    IMM(inst, 0, -1)
+
+static constexpr IntegerVector addi_vectors[] = { ADD_IMMEDIATE_VECTORS("ADDI") };
+static constexpr IntegerVector addic_vectors[] = { ADD_IMMEDIATE_VECTORS("ADDIC") };
+static constexpr IntegerVector addic_rc_vectors[] = { ADD_IMMEDIATE_VECTORS("ADDIC.") };
+static constexpr IntegerVector addis_vectors[] = { ADD_IMMEDIATE_VECTORS("ADDIS") };
+
+static constexpr IntegerVector add_unary_vectors[] = {
+    {0x7FFFFFFF},
+    {0x80000000},
+    {0xFFFFFFFF},
+    {0xFFFFFFFF},
+    {1},
+    {0},
+};
+
+static constexpr IntegerVector and_vectors[] = {
+    {0, 0},
+    {0, 1},
+    {1, 1},
+    {0xFFFFFFFF, 0},
+    {0xFFFFFFFF, 1},
+};
+
+#define AND_IMMEDIATE_VECTORS(inst) \
+    IMM(inst, 0, 0),                \
+    IMM(inst, 0, 1),                \
+    IMM(inst, 1, 1),                \
+    IMM(inst, 0xFFFFFFFF, 0),       \
+    IMM(inst, 0xFFFFFFFF, 1)
+
+static constexpr IntegerVector andi_vectors[] = { AND_IMMEDIATE_VECTORS("ANDI.") };
+static constexpr IntegerVector andis_vectors[] = { AND_IMMEDIATE_VECTORS("ANDIS.") };
+
+static constexpr IntegerVector cmp_vectors[] = {
+    {0, 0},
+    {0, 1},
+    {1, 0},
+    {0x7FFFFFFF, 0x7FFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+};
+
+#define CMP_IMMEDIATE_VECTORS(inst) \
+    CMP_IMM(inst, 0, 0),            \
+    CMP_IMM(inst, 0, 1),            \
+    CMP_IMM(inst, 1, 0),            \
+    CMP_IMM(inst, 0x7FFF, 0x7FFF),  \
+    CMP_IMM(inst, 0x2FFF, 0x1FFF)
+
+static constexpr IntegerVector cmpi_vectors[] = { CMP_IMMEDIATE_VECTORS("CMPI") };
+static constexpr IntegerVector cmpli_vectors[] = { CMP_IMMEDIATE_VECTORS("CMPLI") };
+
+// Every single-bit value.
+static constexpr auto cntlzw_vectors = [] {
+    std::array<IntegerVector, 32> vectors{};
+    for (uint32_t i = 0; i < 32; i++)
+        vectors[i] = {1U << i, 0, nullptr};
+    return vectors;
+}();
+
+static constexpr IntegerVector divw_vectors[] = {
+    {0, 0},
+    {0x7FFFFFFF, 0},
+    {0x7FFFFFFF, 0xFFFFFFFF},
+    {0x80000000, 0xFFFFFFFF},
+    {0, 1},
+    {1, 1},
+    {10, 2},
+    {0x000001A4, 0x00000045},
+    {0xFFFFFFFF, 0x7FFFFFFF},
+    {0xFFFFFFFF, 0x80000000},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+};
+
+// Same as above, minus 0x7FFFFFFF / -1.
+static constexpr IntegerVector div_vectors[] = {
+    {0, 0},
+    {0x7FFFFFFF, 0},
+    {0x80000000, 0xFFFFFFFF},
+    {0, 1},
+    {1, 1},
+    {10, 2},
+    {0x000001A4, 0x00000045},
+    {0xFFFFFFFF, 0x7FFFFFFF},
+    {0xFFFFFFFF, 0x80000000},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+};
+
+static constexpr IntegerVector eqv_vectors[] = {
+    {0, 0},
+    {1, 1},
+    {0x7FFFFFFF, 0x7FFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+};
+
+// Used by EXTS[x], NEG and the SUBF[x]E variants.
+static constexpr IntegerVector unary_vectors[] = {
+    {0},
+    {1},
+    {0x7FFFFFFF},
+    {0x80000000},
+    {0xFFFFFFFF},
+};
+
+static constexpr IntegerVector mul_vectors[] = {
+    {0, 0},
+    {50, 50},
+    {0x7FFF, 0x7FFF},
+    {0xFFFF, 0xFFFF},
+    {0x7FFFFFFF, 0x7FFFFFFF},
+    {0x80000000, 0x80000000},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+};
+
+static constexpr IntegerVector mulli_vectors[] = {
+    IMM("MULLI", 0, 0),
+    IMM("MULLI", 50, 50),
+    IMM("MULLI", 0x7FFF, 0x7FFF),
+    IMM("MULLI", 0xFFFF, 0x7FFF),
+    IMM("MULLI", 0x7FFFFFFF, 0x7FFF),
+    IMM("MULLI", 0x80000000, 0x7FFF),
+    IMM("MULLI", 0xFFFFFFFF, 0x7FFF),
+};
+
+static constexpr IntegerVector nand_vectors[] = {
+    {0, 0},
+    {0, 1},
+    {1, 0},
+    {1, 1},
+    {0x7FFF, 0x7FFF},
+    {0x8000, 0x8000},
+    {0xFFFF, 0xFFFF},
+    {0x7FFFFFFF, 0x7FFFFFFF},
+    {0x80000000, 0x80000000},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+};
+
+// Used by NOR, OR and ORC.
+static constexpr IntegerVector or_vectors[] = {
+    {0, 0},
+    {0, 1},
+    {1, 0},
+    {1, 1},
+    {0x7FFFFFFF, 0x7FFFFFFF},
+    {0x80000000, 0x80000000},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+};
+
+#define OR_IMMEDIATE_VECTORS(inst) \
+    IMM(inst, 0, 0),               \
+    IMM(inst, 0, 1),               \
+    IMM(inst, 1, 0),               \
+    IMM(inst, 1, 1),               \
+    IMM(inst, 1, 0x1FFF),          \
+    IMM(inst, 1, 0x3FFF),          \
+    IMM(inst, 1, 0x7FFF)
+
+static constexpr IntegerVector ori_vectors[] = { OR_IMMEDIATE_VECTORS("ORI") };
+static constexpr IntegerVector oris_vectors[] = { OR_IMMEDIATE_VECTORS("ORIS") };
+
+// Shifts greater than 31 for 32-bit should produce zero.
+static constexpr auto shift_vectors = [] {
+    std::array<IntegerVector, 65 * 4> vectors{};
+    for (uint32_t i = 0; i <= 64; i++)
+    {
+        vectors[i * 4 + 0] = {i, i, nullptr};
+        vectors[i * 4 + 1] = {1, i, nullptr};
+        vectors[i * 4 + 2] = {0x7FFFFFFF, i, nullptr};
+        vectors[i * 4 + 3] = {0xFFFFFFFF, i, nullptr};
+    }
+    return vectors;
+}();
+
+static constexpr IntegerVector subf_vectors[] = {
+    {0, 0},
+    {0, 1},
+    {1, 0},
+    {0x00000001, 0x80000000},
+    {0x7FFFFFFF, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+};
+
+// SUBFEO has always run two of the vectors in the opposite order.
+static constexpr IntegerVector subfeo_vectors[] = {
+    {0, 0},
+    {0, 1},
+    {1, 0},
+    {0x7FFFFFFF, 0xFFFFFFFF},
+    {0x00000001, 0x80000000},
+    {0xFFFFFFFF, 0xFFFFFFFF},
+};
+
+static constexpr IntegerVector subfic_vectors[] = {
+    IMM("SUBFIC", 0, 0),
+    IMM("SUBFIC", 0, 1),
+    IMM("SUBFIC", 1, 0),
+    IMM("SUBFIC", 1, 1),
+    IMM("SUBFIC", 0x7FFFFFFF, 0x7FFF),
+    IMM("SUBFIC", 0xFFFFFFFF, 0x7FFF),
+};
+
+static constexpr IntegerVector xor_vectors[] = {
+    {0, 0},
+    {0, 1},
+    {1, 0},
+    {1, 1},
+    {0xFFFFFFFF, 0x1FFF},
+    {0xFFFFFFFF, 0x3FFF},
+};
+
+#define XOR_IMMEDIATE_VECTORS(inst) \
+    IMM(inst, 0, 0),                \
+    IMM(inst, 0, 1),                \
+    IMM(inst, 1, 0),                \
+    IMM(inst, 1, 1),                \
+    IMM(inst, 0xFFFFFFFF, 0x1FFF),  \
+    IMM(inst, 0xFFFFFFFF, 0x3FFF)
+
+static constexpr IntegerVector xori_vectors[] = { XOR_IMMEDIATE_VECTORS("XORI") };
+static constexpr IntegerVector xoris_vectors[] = { XOR_IMMEDIATE_VECTORS("XORIS") };
+
+//
+// Test tables
+//
+
+static constexpr IntegerTest add_tests[] = {
+    BINARY_TEST("ADD", add_vectors),
+    BINARY_TEST("ADD.", add_vectors),
+    BINARY_TEST("ADDC", add_vectors),
+    BINARY_TEST("ADDC.", add_vectors),
+    BINARY_TEST("ADDCO", add_vectors),
+    BINARY_TEST("ADDCO.", add_vectors),
+    BINARY_TEST("ADDO", add_vectors),
+    BINARY_TEST("ADDO.", add_vectors),
+    BINARY_TEST("ADDE", add_vectors),
+    BINARY_TEST("ADDE.", add_vectors),
+    BINARY_TEST("ADDEO", add_extended_overflow_vectors),
+    BINARY_TEST("ADDEO.", add_extended_overflow_vectors),
+    IMMEDIATE_TEST("ADDI", addi_vectors),
+    IMMEDIATE_TEST("ADDIC", addic_vectors),
+    IMMEDIATE_TEST("ADDIC.", addic_rc_vectors),
+    IMMEDIATE_TEST("ADDIS", addis_vectors),
+    UNARY_TEST("ADDME", add_unary_vectors),
+    UNARY_TEST("ADDME.", add_unary_vectors),
+    UNARY_TEST("ADDMEO", add_unary_vectors),
+    UNARY_TEST("ADDMEO.", add_unary_vectors),
+    UNARY_TEST("ADDZE", add_unary_vectors),
+    UNARY_TEST("ADDZE.", add_unary_vectors),
+    UNARY_TEST("ADDZEO", add_unary_vectors),
+    UNARY_TEST("ADDZEO.", add_unary_vectors),
+};
+
+static constexpr IntegerTest and_tests[] = {
+    BINARY_TEST("AND", and_vectors),
+    BINARY_TEST("AND.", and_vectors),
+    BINARY_TEST("ANDC", and_vectors),
+    BINARY_TEST("ANDC.", and_vectors),
+    IMMEDIATE_TEST("ANDI.", andi_vectors),
+    IMMEDIATE_TEST("ANDIS.", andis_vectors),
+};
+
+static constexpr IntegerTest cmp_tests[] = {
+    COMPARE_TEST("CMP", cmp_vectors),
+    COMPARE_IMMEDIATE_TEST("CMPI", cmpi_vectors),
+    COMPARE_TEST("CMPL", cmp_vectors),
+    COMPARE_IMMEDIATE_TEST("CMPLI", cmpli_vectors),
+};
+
+static constexpr IntegerTest cntlzw_tests[] = {
+    UNARY_TEST("CNTLZW", cntlzw_vectors),
+    UNARY_TEST("CNTLZW.", cntlzw_vectors),
+};
+
+static constexpr IntegerTest divw_tests[] = {
+    BINARY_TEST("DIVW", divw_vectors),
+    BINARY_TEST("DIVW.", div_vectors),
+    BINARY_TEST("DIVWO", div_vectors),
+    BINARY_TEST("DIVWO.", div_vectors),
+    BINARY_TEST("DIVWU", div_vectors),
+    BINARY_TEST("DIVWU.", div_vectors),
+    BINARY_TEST("DIVWUO", div_vectors),
+    BINARY_TEST("DIVWUO.", div_vectors),
+};
+
+static constexpr IntegerTest eqv_tests[] = {
+    BINARY_TEST("EQV", eqv_vectors),
+    BINARY_TEST("EQV.", eqv_vectors),
+};
+
+static constexpr IntegerTest exts_tests[] = {
+    UNARY_TEST("EXTSB", unary_vectors),
+    UNARY_TEST("EXTSB.", unary_vectors),
+    UNARY_TEST("EXTSH", unary_vectors),
+    UNARY_TEST("EXTSH.", unary_vectors),
+};
+
+static constexpr IntegerTest mulhw_tests[] = {
+    BINARY_TEST("MULHW", mul_vectors),
+    BINARY_TEST("MULHW.", mul_vectors),
+    BINARY_TEST("MULHWU", mul_vectors),
+    BINARY_TEST("MULHWU.", mul_vectors),
+};
+
+static constexpr IntegerTest mulli_tests[] = {
+    IMMEDIATE_TEST("MULLI", mulli_vectors),
+};
+
+static constexpr IntegerTest mullw_tests[] = {
+    BINARY_TEST("MULLW", mul_vectors),
+    BINARY_TEST("MULLW.", mul_vectors),
+    BINARY_TEST("MULLWO", mul_vectors),
+    BINARY_TEST("MULLWO.", mul_vectors),
+};
+
+static constexpr IntegerTest nand_tests[] = {
+    BINARY_TEST("NAND", nand_vectors),
+    BINARY_TEST("NAND.", nand_vectors),
+};
+
+static constexpr IntegerTest neg_tests[] = {
+    UNARY_TEST("NEG", unary_vectors),
+    UNARY_TEST("NEG.", unary_vectors),
+    UNARY_TEST("NEGO", unary_vectors),
+    UNARY_TEST("NEGO.", unary_vectors),
+};
+
+static constexpr IntegerTest nor_tests[] = {
+    BINARY_TEST("NOR", or_vectors),
+    BINARY_TEST("NOR.", or_vectors),
+};
+
+static constexpr IntegerTest or_tests[] = {
+    BINARY_TEST("OR", or_vectors),
+    BINARY_TEST("OR.", or_vectors),
+    BINARY_TEST("ORC", or_vectors),
+    BINARY_TEST("ORC.", or_vectors),
+    IMMEDIATE_TEST("ORI", ori_vectors),
+    IMMEDIATE_TEST("ORIS", oris_vectors),
+};
+
+// Note: SRAWI takes SH as an immediate, so it's given the register number rB
+//       was allocated to rather than rB's value.
+static constexpr IntegerTest shift_tests[] = {
+    BINARY_TEST("SLW", shift_vectors),
+    BINARY_TEST("SLW.", shift_vectors),
+    BINARY_TEST("SRAW", shift_vectors),
+    BINARY_TEST("SRAW.", shift_vectors),
+    BINARY_TEST("SRAWI", shift_vectors),
+    BINARY_TEST("SRAWI.", shift_vectors),
+    BINARY_TEST("SRW", shift_vectors),
+    BINARY_TEST("SRW.", shift_vectors),
+};
+
+//
+// TODO: Alternate the carry flag for SUBFC
+//
+static constexpr IntegerTest subf_tests[] = {
+    BINARY_TEST("SUBF", subf_vectors),
+    BINARY_TEST("SUBF.", subf_vectors),
+    BINARY_TEST("SUBFO", subf_vectors),
+    BINARY_TEST("SUBFO.", subf_vectors),
+    BINARY_TEST("SUBFC", subf_vectors),
+    BINARY_TEST("SUBFC.", subf_vectors),
+    BINARY_TEST("SUBFCO", subf_vectors),
+    BINARY_TEST("SUBFCO.", subf_vectors),
+    BINARY_TEST("SUBFE", subf_vectors),
+    BINARY_TEST("SUBFE.", subf_vectors),
+    BINARY_TEST("SUBFEO", subfeo_vectors),
+    BINARY_TEST("SUBFEO.", subf_vectors),
+    IMMEDIATE_TEST("SUBFIC", subfic_vectors),
+    UNARY_TEST("SUBFME", unary_vectors),
+    UNARY_TEST("SUBFME.", unary_vectors),
+    UNARY_TEST("SUBFMEO", unary_vectors),
+    UNARY_TEST("SUBFMEO.", unary_vectors),
+    UNARY_TEST("SUBFZE", unary_vectors),
+    UNARY_TEST("SUBFZE.", unary_vectors),
+    UNARY_TEST("SUBFZEO", unary_vectors),
+    UNARY_TEST("SUBFZEO.", unary_vectors),
+};
+
+static constexpr IntegerTest xor_tests[] = {
+    BINARY_TEST("XOR", xor_vectors),
+    BINARY_TEST("XOR.", xor_vectors),
+    IMMEDIATE_TEST("XORI", xori_vectors),
+    IMMEDIATE_TEST("XORIS", xoris_vectors),
+};
+
+static void LogIntegerResult(const IntegerTest& test, const IntegerVector& vector, const IntegerResult& result)
+{
+    LogRecord record = MakeLogRecord(test.form, test.inst);
+    record.result = result.rD;
+    record.xer = result.xer;
+    record.cr = result.cr;
+    record.operands[0] = vector.rA;
+    record.operands[1] = vector.rB;
+    LogResult(record);
 }
 
-// Used for testing the CMP instructions.
-// Stores result to cr0.
-#define OPTEST_3_COMPONENTS_CMP(inst, rA, rB)                                                                 \
-{                                                                                                             \
-    SetCR(0);                                                                                                 \
-    SetXER(0);                                                                                                \
-    asm volatile (inst " cr0, %[Ra], %[Rb]": : [Ra]"r"(rA), [Rb]"r"(rB));                                     \
-                                                                                                              \
-    printf("%-8s :: rA 0x%08" PRIX32 " | rB 0x%08" PRIX32 " | XER: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",  \
-           inst, static_cast<uint32_t>(rA), static_cast<uint32_t>(rB), GetXER(), GetCR());                    \
+template <size_t N>
+static void RunTests(const IntegerTest (&tests)[N])
+{
+    for (const IntegerTest& test : tests)
+    {
+        for (size_t i = 0; i < test.num_vectors; i++)
+        {
+            const IntegerVector& vector = test.vectors[i];
+            const IntegerTestFunc func = test.func != nullptr ? test.func : vector.func;
+
+            LogIntegerResult(test, vector, RunIntegerVector(func, vector.rA, vector.rB, 0));
+        }
+    }
 }
 
-// Used for testing the immediate variants of CMP.
-#define OPTEST_3_COMPONENTS_CMP_IMM(inst, rA, imm)                                                               \
-{                                                                                                                \
-    SetCR(0);                                                                                                    \
-    SetXER(0);                                                                                                   \
-    asm volatile (inst " cr0, %[Ra], %[Imm]": : [Ra]"r"(rA), [Imm]"i"(imm));                                     \
-                                                                                                                 \
-    printf("%-8s :: rA 0x%08" PRIX32 " | imm 0x%08" PRIX32 " | XER: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n",    \
-           inst, static_cast<uint32_t>(rA), static_cast<uint32_t>(imm), GetXER(), GetCR());                      \
+// The tests above always start from a clean XER and CR, so every vector is run again from
+// each of these: CA set, which the extended forms carry in; SO and OV set, where SO has to
+// stay set and be copied into cr0, and OV has to be left alone by everything but the O
+// forms; and every CR field set, where only compares and record forms may change cr0.
+static constexpr IntegerState integer_states[] = {
+    {XER_CA, 0},
+    {XER_SO | XER_OV, 0},
+    {XER_SO | XER_OV | XER_CA, 0},
+    {0, 0xFFFFFFFF},
+    {XER_CA, 0xFFFFFFFF},
+    {XER_SO | XER_OV, 0xFFFFFFFF},
+    {XER_SO | XER_OV | XER_CA, 0xFFFFFFFF},
+};
+
+static void LogIntegerStateResult(const IntegerTest& test, const IntegerVector& vector, const IntegerState& state,
+                                  const IntegerResult& result)
+{
+    LogRecord record = MakeLogRecord(LogForm::IntegerState, test.inst);
+    record.result = result.rD;
+    record.xer = result.xer;
+    record.cr = result.cr;
+    record.operands[0] = vector.rA;
+    record.operands[1] = vector.rB;
+    record.operands[2] = state.xer;
+    record.operands[3] = state.cr;
+    LogResult(record);
 }
 
-// Test for a 5-component instruction (sets the rD before the operation).
-// e.g. RLWIMI rA, rS, SH, MB, ME
-#define OPTEST_5_COMPONENTS(inst, rA, rS, SH, MB, ME)                                                                                                                         \
-{                                                                                                                                                                             \
-    uint32_t output = rA;                                                                                                                                                     \
-                                                                                                                                                                              \
-    SetCR(0);                                                                                                                                                                 \
-    SetXER(0);                                                                                                                                                                \
-    asm volatile (inst " %[out], %[Rs], %[Sh], %[Mb], %[Me]"                                                                                                                  \
-        : [out]"=&r"(output)                                                                                                                                                  \
-        : [Rs]"r"(rS), [Sh]"r"(SH), [Mb]"r"(MB), [Me]"r"(ME));                                                                                                                \
-                                                                                                                                                                              \
-    printf("%-8s :: rD 0x%08" PRIX32 " | rS 0x%08" PRIX32 " | SH 0x%08" PRIX32 " | MB: 0x%08" PRIX32 " | ME: 0x%08" PRIX32 " | XER: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", \
-           inst, output,                                                                                                                                                      \
-           static_cast<uint32_t>(rS),                                                                                                                                         \
-           static_cast<uint32_t>(SH),                                                                                                                                         \
-           static_cast<uint32_t>(MB),                                                                                                                                         \
-           static_cast<uint32_t>(ME), GetXER(), GetCR());                                                                                                                     \
+// Runs every vector of a test table from each of the starting states.
+template <size_t N>
+static void RunStateTests(const IntegerTest (&tests)[N])
+{
+    for (const IntegerTest& test : tests)
+    {
+        for (size_t i = 0; i < test.num_vectors; i++)
+        {
+            const IntegerVector& vector = test.vectors[i];
+            const IntegerTestFunc func = test.func != nullptr ? test.func : vector.func;
+
+            IntegerResult results[std::size(integer_states)];
+            func(vector.rA, vector.rB, integer_states, results, std::size(integer_states));
+
+            for (size_t j = 0; j < std::size(integer_states); j++)
+                LogIntegerStateResult(test, vector, integer_states[j], results[j]);
+        }
+    }
+}
+
+#ifdef EXHAUSTIVE_TESTS
+// The exhaustive tests run every possible rA, which is far too many results to log.
+// Instead, each chunk of inputs is logged as a digest of its results, which the
+// host tools compare against digests computed from the reference model.
+constexpr uint32_t EXHAUSTIVE_CHUNK_SIZE = 1U << 24;
+
+static void LogIntegerDigest(const char* inst, uint32_t first, uint32_t last, uint64_t digest)
+{
+    LogRecord record = MakeLogRecord(LogForm::IntegerUnaryDigest, inst);
+    record.result = digest;
+    record.operands[0] = first;
+    record.operands[1] = last;
+    LogResult(record);
+}
+
+static void UnaryExhaustiveTest(const IntegerTest& test)
+{
+    printf("%s (all inputs)\n", test.inst);
+
+    for (uint64_t first = 0; first <= UINT32_MAX; first += EXHAUSTIVE_CHUNK_SIZE)
+    {
+        ResultDigest digest;
+        const uint32_t last = static_cast<uint32_t>(first + EXHAUSTIVE_CHUNK_SIZE - 1);
+
+        for (uint32_t rA = static_cast<uint32_t>(first);; rA++)
+        {
+            const IntegerResult result = RunIntegerVector(test.func, rA, 0, 0);
+            DigestIntegerUnary(digest, rA, result.rD, result.xer, result.cr);
+
+            if (rA == last)
+                break;
+        }
+
+        LogIntegerDigest(test.inst, static_cast<uint32_t>(first), last, digest.Finish());
+    }
+}
+
+// Runs the unary instructions of a test table with every possible input.
+template <size_t N>
+static void RunExhaustiveTests(const IntegerTest (&tests)[N])
+{
+    for (const IntegerTest& test : tests)
+    {
+        if (test.form == LogForm::IntegerUnary)
+            UnaryExhaustiveTest(test);
+    }
+}
+
+// Binary instructions can't be run with every pair of operands, so these run every rA against
+// a few rB values (zero, one, the sign bit, all ones and an irregular pattern), and the extended
+// forms with CA both clear and set. Only the recording overflow forms are swept: their rD is the
+// same as the other forms', and they set every flag the others do.
+struct BinarySweep
+{
+    const char* inst;
+    bool uses_carry;
+};
+
+static constexpr BinarySweep binary_sweeps[] = {
+    {"ADDEO.", true},
+    {"DIVWO.", false},
+    {"DIVWUO.", false},
+    {"MULHW.", false},
+    {"MULHWU.", false},
+    {"MULLWO.", false},
+    {"SUBFEO.", true},
+};
+
+static constexpr uint32_t binary_sweep_rB[] = {
+    0x00000000, 0x00000001, 0x80000000, 0xFFFFFFFF, 0x9E3779B9,
+};
+
+static void LogIntegerBinaryDigest(const char* inst, uint32_t rB, uint32_t xer, uint32_t first, uint32_t last, uint64_t digest)
+{
+    LogRecord record = MakeLogRecord(LogForm::IntegerBinaryDigest, inst);
+    record.result = digest;
+    record.operands[0] = rB;
+    record.operands[1] = xer;
+    record.operands[2] = first;
+    record.operands[3] = last;
+    LogResult(record);
+}
+
+static void BinaryExhaustiveTest(const IntegerTest& test, bool uses_carry)
+{
+    printf("%s (all rA)\n", test.inst);
+
+    const uint32_t xer_values[] = {0, XER_CA};
+    for (const uint32_t xer : xer_values)
+    {
+        if (xer != 0 && !uses_carry)
+            break;
+
+        for (const uint32_t rB : binary_sweep_rB)
+        {
+            for (uint64_t first = 0; first <= UINT32_MAX; first += EXHAUSTIVE_CHUNK_SIZE)
+            {
+                ResultDigest digest;
+                const uint32_t last = static_cast<uint32_t>(first + EXHAUSTIVE_CHUNK_SIZE - 1);
+
+                for (uint32_t rA = static_cast<uint32_t>(first);; rA++)
+                {
+                    const IntegerResult result = RunIntegerVector(test.func, rA, rB, xer);
+                    DigestIntegerUnary(digest, rA, result.rD, result.xer, result.cr);
+
+                    if (rA == last)
+                        break;
+                }
+
+                LogIntegerBinaryDigest(test.inst, rB, xer, static_cast<uint32_t>(first), last, digest.Finish());
+            }
+        }
+    }
+}
+
+// Runs the instructions of a test table that are in binary_sweeps with every rA.
+template <size_t N>
+static void RunBinaryExhaustiveTests(const IntegerTest (&tests)[N])
+{
+    for (const IntegerTest& test : tests)
+    {
+        for (const BinarySweep& sweep : binary_sweeps)
+        {
+            if (std::strcmp(test.inst, sweep.inst) == 0)
+                BinaryExhaustiveTest(test, sweep.uses_carry);
+        }
+    }
+}
+
+// The immediate forms above can only cover the immediates (and SH/MB/ME values) that are
+// written into their asm. These tests generate the instruction instead, so every value of
+// the field can be run. Each source value's results are logged as one digest.
+struct FieldTest
+{
+    const char* inst;
+    uint32_t encoding;    // The instruction with its field cleared, writing r3 from r4.
+    uint32_t field_shift; // Bit position of the field in the instruction.
+    uint32_t field_count; // Number of values the field can take.
+};
+
+// The SH, MB and ME fields are adjacent, so they're swept as one 15-bit field.
+#define ROTATE_FIELD_TEST(inst, opcode, rc) {inst, EncodeMForm(opcode, 4, 3, 0, 0, 0, rc), 1, 1U << 15}
+#define SHIFT_FIELD_TEST(inst, rc)          {inst, EncodeXForm(31, 4, 3, 0, 824, rc), 11, 32}
+#define ARITHMETIC_FIELD_TEST(inst, opcode) {inst, EncodeDForm(opcode, 3, 4, 0), 0, 1U << 16}
+#define LOGICAL_FIELD_TEST(inst, opcode)    {inst, EncodeDForm(opcode, 4, 3, 0), 0, 1U << 16}
+// Compares write cr0 and leave r3 untouched.
+#define COMPARE_FIELD_TEST(inst, opcode)    {inst, EncodeDForm(opcode, 0, 4, 0), 0, 1U << 16}
+
+static constexpr FieldTest field_tests[] = {
+    ARITHMETIC_FIELD_TEST("ADDI", 14),
+    ARITHMETIC_FIELD_TEST("ADDIC", 12),
+    ARITHMETIC_FIELD_TEST("ADDIC.", 13),
+    ARITHMETIC_FIELD_TEST("ADDIS", 15),
+    LOGICAL_FIELD_TEST("ANDI.", 28),
+    LOGICAL_FIELD_TEST("ANDIS.", 29),
+    COMPARE_FIELD_TEST("CMPI", 11),
+    COMPARE_FIELD_TEST("CMPLI", 10),
+    ARITHMETIC_FIELD_TEST("MULLI", 7),
+    LOGICAL_FIELD_TEST("ORI", 24),
+    LOGICAL_FIELD_TEST("ORIS", 25),
+    ROTATE_FIELD_TEST("RLWIMI", 20, false),
+    ROTATE_FIELD_TEST("RLWIMI.", 20, true),
+    ROTATE_FIELD_TEST("RLWINM", 21, false),
+    ROTATE_FIELD_TEST("RLWINM.", 21, true),
+    SHIFT_FIELD_TEST("SRAWI", false),
+    SHIFT_FIELD_TEST("SRAWI.", true),
+    ARITHMETIC_FIELD_TEST("SUBFIC", 8),
+    LOGICAL_FIELD_TEST("XORI", 26),
+    LOGICAL_FIELD_TEST("XORIS", 27),
+};
+
+// Each field value runs with every one of these in r4. r3 starts out as the complement,
+// so every bit RLWIMI inserts differs from the one it replaces.
+static constexpr uint32_t field_test_sources[] = {
+    0x00000000, 0x00000001, 0x00007FFF, 0x00008000, 0x0000FFFF,
+    0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0xA5C3E10F,
+};
+
+// Only cr0 is cleared before the instruction (cr2-cr4 are nonvolatile), so only cr0 is logged.
+constexpr uint32_t FIELD_TEST_CR_MASK = 0xF0000000;
+
+static void FieldExhaustiveTest(const FieldTest& test)
+{
+    printf("%s (all encodings)\n", test.inst);
+
+    ResultDigest digests[std::size(field_test_sources)];
+
+    for (uint32_t field = 0; field < test.field_count; field++)
+    {
+        // Takes the initial rD in r3 and the source in r4, and returns rD in r3. XER and CR
+        // are stored through r5 before returning, so nothing the compiler does afterwards
+        // can disturb them.
+        const uint32_t code[] = {
+            EncodeDForm(14, 6, 0, 0), // li r6, 0
+            EncodeMTSPR(SPR_XER, 6),
+            EncodeMTCRF(0x80, 6),
+            test.encoding | (field << test.field_shift),
+            EncodeMFSPR(6, SPR_XER),
+            EncodeDForm(36, 6, 5, 0), // stw r6, 0(r5)
+            EncodeMFCR(6),
+            EncodeDForm(36, 6, 5, 4), // stw r6, 4(r5)
+        };
+        const GeneratedFunction function = EmitCode(code, std::size(code));
+
+        for (size_t i = 0; i < std::size(field_test_sources); i++)
+        {
+            const uint32_t source = field_test_sources[i];
+            uint32_t state[2] = {};
+            const uint32_t rD = function(~source, source, state);
+            DigestIntegerUnary(digests[i], field, rD, state[0], state[1] & FIELD_TEST_CR_MASK);
+        }
+    }
+
+    for (size_t i = 0; i < std::size(field_test_sources); i++)
+    {
+        LogRecord record = MakeLogRecord(LogForm::IntegerFieldDigest, test.inst);
+        record.result = digests[i].Finish();
+        record.operands[0] = field_test_sources[i];
+        record.operands[1] = ~field_test_sources[i];
+        record.operands[2] = 0;
+        record.operands[3] = test.field_count - 1;
+        LogResult(record);
+    }
+}
+#endif
+
+#ifdef FUZZ_TESTS
+// The fuzz tests run each two-operand instruction with FUZZ_VECTORS generated operand
+// pairs and initial XER values, checking every result against the reference model as
+// they go. Only the results that don't match are logged, so the vector count can be
+// large. The vectors only depend on FUZZ_SEED, so a run can be repeated exactly.
+
+// Mismatches logged per instruction. Any past this are only counted.
+constexpr uint32_t FUZZ_MAX_LOGGED_MISMATCHES = 32;
+
+// Operands at the edges of the signed and unsigned ranges.
+static constexpr uint32_t fuzz_boundary_values[] = {
+    0, 1, 2, 0x7FFFFFFE, 0x7FFFFFFF, 0x80000000, 0x80000001, 0xFFFFFFFE, 0xFFFFFFFF,
+};
+
+// Half of the operands are boundary values or (near) powers of two, the rest are uniformly random.
+static uint32_t NextFuzzOperand(Random& random)
+{
+    const uint64_t value = random.Next();
+    const uint32_t power = 1U << ((value >> 8) & 31);
+
+    switch (value & 7)
+    {
+    case 0:
+        return fuzz_boundary_values[(value >> 16) % std::size(fuzz_boundary_values)];
+    case 1:
+        return power;
+    case 2:
+        return power - 1;
+    case 3:
+        return 0U - power;
+    default:
+        return static_cast<uint32_t>(value >> 32);
+    }
+}
+
+static void LogFuzzMismatch(const IntegerTest& test, uint32_t rA, uint32_t rB, uint32_t xer,
+                            const IntegerResult& result, uint32_t model_rD, const ModelState& model)
+{
+    LogRecord record = MakeLogRecord(LogForm::IntegerBinaryState, test.inst);
+    record.result = result.rD;
+    record.xer = result.xer;
+    record.cr = result.cr;
+    record.operands[0] = rA;
+    record.operands[1] = rB;
+    record.operands[2] = xer;
+    LogResult(record);
+
+    printf("  model: rD 0x%08" PRIX32 " | XER: 0x%08" PRIX32 " | CR: 0x%08" PRIX32 "\n", model_rD, model.xer, model.cr);
+}
+
+static void FuzzTest(const IntegerTest& test, uint64_t seed)
+{
+    ModelInstruction inst{};
+    if (!DecodeModelMnemonic(test.inst, &inst))
+    {
+        printf("%s: not modeled, skipped\n", test.inst);
+        return;
+    }
+
+    Random random(seed);
+    uint32_t mismatches = 0;
+
+    for (uint32_t i = 0; i < FUZZ_VECTORS; i++)
+    {
+        const uint32_t rA = NextFuzzOperand(random);
+        const uint32_t rB = NextFuzzOperand(random);
+        const uint32_t xer = static_cast<uint32_t>(random.Next()) & XER_MASK;
+
+        const IntegerResult result = RunIntegerVector(test.func, rA, rB, xer);
+
+        ModelState model{0, xer, 0};
+        const uint32_t model_rD = ModelInteger(inst, 0, {rA, rB, 0, 0}, model);
+        if (result.rD == model_rD && result.xer == model.xer && result.cr == model.cr)
+            continue;
+
+        if (mismatches++ < FUZZ_MAX_LOGGED_MISMATCHES)
+            LogFuzzMismatch(test, rA, rB, xer, result, model_rD, model);
+    }
+
+    printf("%s: %" PRIu32 "/%" PRIu32 " vectors matched the model\n", test.inst, FUZZ_VECTORS - mismatches, FUZZ_VECTORS);
+}
+
+// Fuzzes the two-operand instructions of a test table. Each instruction gets its own
+// sequence of vectors, derived from the seed.
+template <size_t N>
+static void RunFuzzTests(const IntegerTest (&tests)[N], uint64_t& seed)
+{
+    for (const IntegerTest& test : tests)
+    {
+        if (test.form != LogForm::IntegerBinary && test.form != LogForm::IntegerCompare)
+            continue;
+
+        seed += 0x9E3779B97F4A7C15;
+        FuzzTest(test, seed);
+    }
 }
+#endif
 
 static void XEROverflowClearTest()
 {
@@ -239,347 +1150,25 @@ void PPCIntegerTests()
 
     printf("General Instruction Test\n");
     printf("ADD Variants\n");
-    OPTEST_3_COMPONENTS("ADD", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADD", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADD", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADD", -1, 1);
-    OPTEST_3_COMPONENTS("ADD", -1, -1);
-    OPTEST_3_COMPONENTS("ADD", 1, 0);
-    OPTEST_3_COMPONENTS("ADD", 0, -1);
-    OPTEST_3_COMPONENTS("ADD.", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADD.", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADD.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADD.", -1, 1);
-    OPTEST_3_COMPONENTS("ADD.", -1, -1);
-    OPTEST_3_COMPONENTS("ADD.", 1, 0);
-    OPTEST_3_COMPONENTS("ADD.", 0, -1);
-    OPTEST_3_COMPONENTS("ADDC", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDC", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDC", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDC", -1, 1);
-    OPTEST_3_COMPONENTS("ADDC", -1, -1);
-    OPTEST_3_COMPONENTS("ADDC", 1, 0);
-    OPTEST_3_COMPONENTS("ADDC", 0, -1);
-    OPTEST_3_COMPONENTS("ADDC.", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDC.", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDC.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDC.", -1, 1);
-    OPTEST_3_COMPONENTS("ADDC.", -1, -1);
-    OPTEST_3_COMPONENTS("ADDC.", 1, 0);
-    OPTEST_3_COMPONENTS("ADDC.", 0, -1);
-    OPTEST_3_COMPONENTS("ADDCO", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDCO", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDCO", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDCO", -1, 1);
-    OPTEST_3_COMPONENTS("ADDCO", -1, -1);
-    OPTEST_3_COMPONENTS("ADDCO", 1, 0);
-    OPTEST_3_COMPONENTS("ADDCO", 0, -1);
-    OPTEST_3_COMPONENTS("ADDCO.", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDCO.", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDCO.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDCO.", -1, 1);
-    OPTEST_3_COMPONENTS("ADDCO.", -1, -1);
-    OPTEST_3_COMPONENTS("ADDCO.", 1, 0);
-    OPTEST_3_COMPONENTS("ADDCO.", 0, -1);
-    OPTEST_3_COMPONENTS("ADDO", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDO", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDO", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDO", -1, 1);
-    OPTEST_3_COMPONENTS("ADDO", -1, -1);
-    OPTEST_3_COMPONENTS("ADDO", 1, 0);
-    OPTEST_3_COMPONENTS("ADDO", 0, -1);
-    OPTEST_3_COMPONENTS("ADDO.", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDO.", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDO.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDO.", -1, 1);
-    OPTEST_3_COMPONENTS("ADDO.", -1, -1);
-    OPTEST_3_COMPONENTS("ADDO.", 1, 0);
-    OPTEST_3_COMPONENTS("ADDO.", 0, -1);
-    OPTEST_3_COMPONENTS("ADDE", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDE", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDE", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDE", -1, 1);
-    OPTEST_3_COMPONENTS("ADDE", -1, -1);
-    OPTEST_3_COMPONENTS("ADDE", 1, 0);
-    OPTEST_3_COMPONENTS("ADDE", 0, -1);
-    OPTEST_3_COMPONENTS("ADDE.", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDE.", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDE.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDE.", -1, 1);
-    OPTEST_3_COMPONENTS("ADDE.", -1, -1);
-    OPTEST_3_COMPONENTS("ADDE.", 1, 0);
-    OPTEST_3_COMPONENTS("ADDE.", 0, -1);
-    OPTEST_3_COMPONENTS("ADDEO", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDEO", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDEO", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("ADDEO", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDEO", -1, 1);
-    OPTEST_3_COMPONENTS("ADDEO", -1, -1);
-    OPTEST_3_COMPONENTS("ADDEO", 1, 0);
-    OPTEST_3_COMPONENTS("ADDEO", 0, -1);
-    OPTEST_3_COMPONENTS("ADDEO.", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDEO.", 0x80000000, 1);
-    OPTEST_3_COMPONENTS("ADDEO.", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("ADDEO.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ADDEO.", -1, 1);
-    OPTEST_3_COMPONENTS("ADDEO.", -1, -1);
-    OPTEST_3_COMPONENTS("ADDEO.", 1, 0);
-    OPTEST_3_COMPONENTS("ADDEO.", 0, -1);
-    OPTEST_3_COMPONENTS_IMM("ADDI", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDI", 0x80000000, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDI", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDI", -1, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDI", -1, -1);
-    OPTEST_3_COMPONENTS_IMM("ADDI", 1, 0);
-    OPTEST_3_COMPONENTS_IMM("ADDI", 0, -1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC", 0x80000000, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC", -1, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC", -1, -1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC", 1, 0);
-    OPTEST_3_COMPONENTS_IMM("ADDIC", 0, -1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC.", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC.", 0x80000000, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC.", -1, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC.", -1, -1);
-    OPTEST_3_COMPONENTS_IMM("ADDIC.", 1, 0);
-    OPTEST_3_COMPONENTS_IMM("ADDIC.", 0, -1);
-    OPTEST_3_COMPONENTS_IMM("ADDIS", 0x7FFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIS", 0x80000000, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIS", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIS", -1, 1);
-    OPTEST_3_COMPONENTS_IMM("ADDIS", -1, -1);
-    OPTEST_3_COMPONENTS_IMM("ADDIS", 1, 0);
-    OPTEST_3_COMPONENTS_IMM("ADDIS", 0, -1);
-    OPTEST_2_COMPONENTS("ADDME", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("ADDME", 0x80000000);
-    OPTEST_2_COMPONENTS("ADDME", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("ADDME", -1);
-    OPTEST_2_COMPONENTS("ADDME", 1);
-    OPTEST_2_COMPONENTS("ADDME", 0);
-    OPTEST_2_COMPONENTS("ADDME.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("ADDME.", 0x80000000);
-    OPTEST_2_COMPONENTS("ADDME.", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("ADDME.", -1);
-    OPTEST_2_COMPONENTS("ADDME.", 1);
-    OPTEST_2_COMPONENTS("ADDME.", 0);
-    OPTEST_2_COMPONENTS("ADDMEO", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("ADDMEO", 0x80000000);
-    OPTEST_2_COMPONENTS("ADDMEO", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("ADDMEO", -1);
-    OPTEST_2_COMPONENTS("ADDMEO", 1);
-    OPTEST_2_COMPONENTS("ADDMEO", 0);
-    OPTEST_2_COMPONENTS("ADDMEO.", 0x7FFFFFFF)
-    OPTEST_2_COMPONENTS("ADDMEO.", 0x80000000)
-    OPTEST_2_COMPONENTS("ADDMEO.", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("ADDMEO.", -1);
-    OPTEST_2_COMPONENTS("ADDMEO.", 1);
-    OPTEST_2_COMPONENTS("ADDMEO.", 0);
-    OPTEST_2_COMPONENTS("ADDZE", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("ADDZE", 0x80000000);
-    OPTEST_2_COMPONENTS("ADDZE", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("ADDZE", -1);
-    OPTEST_2_COMPONENTS("ADDZE", 1);
-    OPTEST_2_COMPONENTS("ADDZE", 0);
-    OPTEST_2_COMPONENTS("ADDZE.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("ADDZE.", 0x80000000);
-    OPTEST_2_COMPONENTS("ADDZE.", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("ADDZE.", -1);
-    OPTEST_2_COMPONENTS("ADDZE.", 1);
-    OPTEST_2_COMPONENTS("ADDZE.", 0);
-    OPTEST_2_COMPONENTS("ADDZEO", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("ADDZEO", 0x80000000);
-    OPTEST_2_COMPONENTS("ADDZEO", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("ADDZEO", -1);
-    OPTEST_2_COMPONENTS("ADDZEO", 1);
-    OPTEST_2_COMPONENTS("ADDZEO", 0);
-    OPTEST_2_COMPONENTS("ADDZEO.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("ADDZEO.", 0x80000000);
-    OPTEST_2_COMPONENTS("ADDZEO.", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("ADDZEO.", -1);
-    OPTEST_2_COMPONENTS("ADDZEO.", 1);
-    OPTEST_2_COMPONENTS("ADDZEO.", 0);
+    RunTests(add_tests);
 
     printf("\nAND Variants\n");
-    OPTEST_3_COMPONENTS("AND", 0, 0);
-    OPTEST_3_COMPONENTS("AND", 0, 1);
-    OPTEST_3_COMPONENTS("AND", 1, 1);
-    OPTEST_3_COMPONENTS("AND", 0xFFFFFFFF, 0);
-    OPTEST_3_COMPONENTS("AND", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("AND.", 0, 0);
-    OPTEST_3_COMPONENTS("AND.", 0, 1);
-    OPTEST_3_COMPONENTS("AND.", 1, 1);
-    OPTEST_3_COMPONENTS("AND.", 0xFFFFFFFF, 0);
-    OPTEST_3_COMPONENTS("AND.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ANDC", 0, 0);
-    OPTEST_3_COMPONENTS("ANDC", 0, 1);
-    OPTEST_3_COMPONENTS("ANDC", 1, 1);
-    OPTEST_3_COMPONENTS("ANDC", 0xFFFFFFFF, 0);
-    OPTEST_3_COMPONENTS("ANDC", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS("ANDC.", 0, 0);
-    OPTEST_3_COMPONENTS("ANDC.", 0, 1);
-    OPTEST_3_COMPONENTS("ANDC.", 1, 1);
-    OPTEST_3_COMPONENTS("ANDC.", 0xFFFFFFFF, 0);
-    OPTEST_3_COMPONENTS("ANDC.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ANDI.", 0, 0);
-    OPTEST_3_COMPONENTS_IMM("ANDI.", 0, 1);
-    OPTEST_3_COMPONENTS_IMM("ANDI.", 1, 1);
-    OPTEST_3_COMPONENTS_IMM("ANDI.", 0xFFFFFFFF, 0);
-    OPTEST_3_COMPONENTS_IMM("ANDI.", 0xFFFFFFFF, 1);
-    OPTEST_3_COMPONENTS_IMM("ANDIS.", 0, 0);
-    OPTEST_3_COMPONENTS_IMM("ANDIS.", 0, 1);
-    OPTEST_3_COMPONENTS_IMM("ANDIS.", 1, 1);
-    OPTEST_3_COMPONENTS_IMM("ANDIS.", 0xFFFFFFFF, 0);
-    OPTEST_3_COMPONENTS_IMM("ANDIS.", 0xFFFFFFFF, 1);
+    RunTests(and_tests);
 
     printf("\nCMP Variants\n");
-    OPTEST_3_COMPONENTS_CMP("CMP", 0, 0);
-    OPTEST_3_COMPONENTS_CMP("CMP", 0, 1);
-    OPTEST_3_COMPONENTS_CMP("CMP", 1, 0);
-    OPTEST_3_COMPONENTS_CMP("CMP", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS_CMP("CMP", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPI", 0, 0);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPI", 0, 1);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPI", 1, 0);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPI", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPI", 0x2FFF, 0x1FFF);
-    OPTEST_3_COMPONENTS_CMP("CMPL", 0, 0);
-    OPTEST_3_COMPONENTS_CMP("CMPL", 0, 1);
-    OPTEST_3_COMPONENTS_CMP("CMPL", 1, 0);
-    OPTEST_3_COMPONENTS_CMP("CMPL", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS_CMP("CMPL", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPLI", 0, 0);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPLI", 0, 1);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPLI", 1, 0);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPLI", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS_CMP_IMM("CMPLI", 0x2FFF, 0x1FFF);
+    RunTests(cmp_tests);
 
     printf("\nCNTLZW Variants\n");
-    for (uint32_t i = 0; i < 32; i++)
-    {
-        OPTEST_2_COMPONENTS("CNTLZW", (1U << i));
-    }
-    for (uint32_t i = 0; i < 32; i++)
-    {
-        OPTEST_2_COMPONENTS("CNTLZW.", (1U << i));
-    }
+    RunTests(cntlzw_tests);
 
     printf("\nDIVW Variants\n");
-    OPTEST_3_COMPONENTS("DIVW", 0, 0);
-    OPTEST_3_COMPONENTS("DIVW", 0x7FFFFFFF, 0);
-    OPTEST_3_COMPONENTS("DIVW", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVW", 0x80000000, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVW", 0, 1);
-    OPTEST_3_COMPONENTS("DIVW", 1, 1);
-    OPTEST_3_COMPONENTS("DIVW", 10, 2);
-    OPTEST_3_COMPONENTS("DIVW", 0x000001A4, 0x00000045);
-    OPTEST_3_COMPONENTS("DIVW", 0xFFFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("DIVW", 0xFFFFFFFF, 0x80000000);
-    OPTEST_3_COMPONENTS("DIVW", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVW.", 0, 0);
-    OPTEST_3_COMPONENTS("DIVW.", 0x7FFFFFFF, 0);
-    OPTEST_3_COMPONENTS("DIVW.", 0x80000000, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVW.", 0, 1);
-    OPTEST_3_COMPONENTS("DIVW.", 1, 1);
-    OPTEST_3_COMPONENTS("DIVW.", 10, 2);
-    OPTEST_3_COMPONENTS("DIVW.", 0x000001A4, 0x00000045);
-    OPTEST_3_COMPONENTS("DIVW.", 0xFFFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("DIVW.", 0xFFFFFFFF, 0x80000000);
-    OPTEST_3_COMPONENTS("DIVW.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWO", 0, 0);
-    OPTEST_3_COMPONENTS("DIVWO", 0x7FFFFFFF, 0);
-    OPTEST_3_COMPONENTS("DIVWO", 0x80000000, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWO", 0, 1);
-    OPTEST_3_COMPONENTS("DIVWO", 1, 1);
-    OPTEST_3_COMPONENTS("DIVWO", 10, 2);
-    OPTEST_3_COMPONENTS("DIVWO", 0x000001A4, 0x00000045);
-    OPTEST_3_COMPONENTS("DIVWO", 0xFFFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWO", 0xFFFFFFFF, 0x80000000);
-    OPTEST_3_COMPONENTS("DIVWO", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWO.", 0, 0);
-    OPTEST_3_COMPONENTS("DIVWO.", 0x7FFFFFFF, 0);
-    OPTEST_3_COMPONENTS("DIVWO.", 0x80000000, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWO.", 0, 1);
-    OPTEST_3_COMPONENTS("DIVWO.", 1, 1);
-    OPTEST_3_COMPONENTS("DIVWO.", 10, 2);
-    OPTEST_3_COMPONENTS("DIVWO.", 0x000001A4, 0x00000045);
-    OPTEST_3_COMPONENTS("DIVWO.", 0xFFFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWO.", 0xFFFFFFFF, 0x80000000);
-    OPTEST_3_COMPONENTS("DIVWO.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWU", 0, 0);
-    OPTEST_3_COMPONENTS("DIVWU", 0x7FFFFFFF, 0);
-    OPTEST_3_COMPONENTS("DIVWU", 0x80000000, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWU", 0, 1);
-    OPTEST_3_COMPONENTS("DIVWU", 1, 1);
-    OPTEST_3_COMPONENTS("DIVWU", 10, 2);
-    OPTEST_3_COMPONENTS("DIVWU", 0x000001A4, 0x00000045);
-    OPTEST_3_COMPONENTS("DIVWU", 0xFFFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWU", 0xFFFFFFFF, 0x80000000);
-    OPTEST_3_COMPONENTS("DIVWU", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWU.", 0, 0);
-    OPTEST_3_COMPONENTS("DIVWU.", 0x7FFFFFFF, 0);
-    OPTEST_3_COMPONENTS("DIVWU.", 0x80000000, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWU.", 0, 1);
-    OPTEST_3_COMPONENTS("DIVWU.", 1, 1);
-    OPTEST_3_COMPONENTS("DIVWU.", 10, 2);
-    OPTEST_3_COMPONENTS("DIVWU.", 0x000001A4, 0x00000045);
-    OPTEST_3_COMPONENTS("DIVWU.", 0xFFFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWU.", 0xFFFFFFFF, 0x80000000);
-    OPTEST_3_COMPONENTS("DIVWU.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWUO", 0, 0);
-    OPTEST_3_COMPONENTS("DIVWUO", 0x7FFFFFFF, 0);
-    OPTEST_3_COMPONENTS("DIVWUO", 0x80000000, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWUO", 0, 1);
-    OPTEST_3_COMPONENTS("DIVWUO", 1, 1);
-    OPTEST_3_COMPONENTS("DIVWUO", 10, 2);
-    OPTEST_3_COMPONENTS("DIVWUO", 0x000001A4, 0x00000045);
-    OPTEST_3_COMPONENTS("DIVWUO", 0xFFFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWUO", 0xFFFFFFFF, 0x80000000);
-    OPTEST_3_COMPONENTS("DIVWUO", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWUO.", 0, 0);
-    OPTEST_3_COMPONENTS("DIVWUO.", 0x7FFFFFFF, 0);
-    OPTEST_3_COMPONENTS("DIVWUO.", 0x80000000, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWUO.", 0, 1);
-    OPTEST_3_COMPONENTS("DIVWUO.", 1, 1);
-    OPTEST_3_COMPONENTS("DIVWUO.", 10, 2);
-    OPTEST_3_COMPONENTS("DIVWUO.", 0x000001A4, 0x00000045);
-    OPTEST_3_COMPONENTS("DIVWUO.", 0xFFFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("DIVWUO.", 0xFFFFFFFF, 0x80000000);
-    OPTEST_3_COMPONENTS("DIVWUO.", 0xFFFFFFFF, 0xFFFFFFFF);
+    RunTests(divw_tests);
 
     printf("\nEQV Variants\n");
-    OPTEST_3_COMPONENTS("EQV", 0, 0);
-    OPTEST_3_COMPONENTS("EQV", 1, 1);
-    OPTEST_3_COMPONENTS("EQV", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("EQV", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("EQV.", 0, 0);
-    OPTEST_3_COMPONENTS("EQV.", 1, 1);
-    OPTEST_3_COMPONENTS("EQV.", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("EQV.", 0xFFFFFFFF, 0xFFFFFFFF);
+    RunTests(eqv_tests);
 
     printf("\nEXTSB Variants\n");
-    OPTEST_2_COMPONENTS("EXTSB", 0);
-    OPTEST_2_COMPONENTS("EXTSB", 1);
-    OPTEST_2_COMPONENTS("EXTSB", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("EXTSB", 0x80000000);
-    OPTEST_2_COMPONENTS("EXTSB", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("EXTSB.", 0);
-    OPTEST_2_COMPONENTS("EXTSB.", 1);
-    OPTEST_2_COMPONENTS("EXTSB.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("EXTSB.", 0x80000000);
-    OPTEST_2_COMPONENTS("EXTSB.", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("EXTSH", 0);
-    OPTEST_2_COMPONENTS("EXTSH", 1);
-    OPTEST_2_COMPONENTS("EXTSH", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("EXTSH", 0x80000000);
-    OPTEST_2_COMPONENTS("EXTSH", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("EXTSH.", 0);
-    OPTEST_2_COMPONENTS("EXTSH.", 1);
-    OPTEST_2_COMPONENTS("EXTSH.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("EXTSH.", 0x80000000);
-    OPTEST_2_COMPONENTS("EXTSH.", 0xFFFFFFFF);
+    RunTests(exts_tests);
 
     //
     // TODO: Tests for load instructions.
@@ -590,177 +1179,25 @@ void PPCIntegerTests()
     //
 
     printf("\nMULHW Variants\n");
-    OPTEST_3_COMPONENTS("MULHW", 0, 0);
-    OPTEST_3_COMPONENTS("MULHW", 50, 50);
-    OPTEST_3_COMPONENTS("MULHW", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("MULHW", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("MULHW", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("MULHW", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("MULHW", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("MULHW.", 0, 0);
-    OPTEST_3_COMPONENTS("MULHW.", 50, 50);
-    OPTEST_3_COMPONENTS("MULHW.", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("MULHW.", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("MULHW.", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("MULHW.", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("MULHW.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("MULHWU", 0, 0);
-    OPTEST_3_COMPONENTS("MULHWU", 50, 50);
-    OPTEST_3_COMPONENTS("MULHWU", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("MULHWU", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("MULHWU", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("MULHWU", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("MULHWU", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("MULHWU.", 0, 0);
-    OPTEST_3_COMPONENTS("MULHWU.", 50, 50);
-    OPTEST_3_COMPONENTS("MULHWU.", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("MULHWU.", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("MULHWU.", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("MULHWU.", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("MULHWU.", 0xFFFFFFFF, 0xFFFFFFFF);
+    RunTests(mulhw_tests);
 
     printf("\nMULLI\n");
-    OPTEST_3_COMPONENTS_IMM("MULLI", 0, 0);
-    OPTEST_3_COMPONENTS_IMM("MULLI", 50, 50);
-    OPTEST_3_COMPONENTS_IMM("MULLI", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS_IMM("MULLI", 0xFFFF, 0x7FFF);
-    OPTEST_3_COMPONENTS_IMM("MULLI", 0x7FFFFFFF, 0x7FFF);
-    OPTEST_3_COMPONENTS_IMM("MULLI", 0x80000000, 0x7FFF);
-    OPTEST_3_COMPONENTS_IMM("MULLI", 0xFFFFFFFF, 0x7FFF);
+    RunTests(mulli_tests);
 
     printf("\nMULLW Variants\n");
-    OPTEST_3_COMPONENTS("MULLW", 0, 0);
-    OPTEST_3_COMPONENTS("MULLW", 50, 50);
-    OPTEST_3_COMPONENTS("MULLW", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("MULLW", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("MULLW", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("MULLW", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("MULLW", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("MULLW.", 0, 0);
-    OPTEST_3_COMPONENTS("MULLW.", 50, 50);
-    OPTEST_3_COMPONENTS("MULLW.", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("MULLW.", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("MULLW.", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("MULLW.", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("MULLW.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("MULLWO", 0, 0);
-    OPTEST_3_COMPONENTS("MULLWO", 50, 50);
-    OPTEST_3_COMPONENTS("MULLWO", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("MULLWO", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("MULLWO", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("MULLWO", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("MULLWO", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("MULLWO.", 0, 0);
-    OPTEST_3_COMPONENTS("MULLWO.", 50, 50);
-    OPTEST_3_COMPONENTS("MULLWO.", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("MULLWO.", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("MULLWO.", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("MULLWO.", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("MULLWO.", 0xFFFFFFFF, 0xFFFFFFFF);
+    RunTests(mullw_tests);
 
     printf("\nNAND Variants\n");
-    OPTEST_3_COMPONENTS("NAND", 0, 0);
-    OPTEST_3_COMPONENTS("NAND", 0, 1);
-    OPTEST_3_COMPONENTS("NAND", 1, 0);
-    OPTEST_3_COMPONENTS("NAND", 1, 1);
-    OPTEST_3_COMPONENTS("NAND", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("NAND", 0x8000, 0x8000);
-    OPTEST_3_COMPONENTS("NAND", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("NAND", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("NAND", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("NAND", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("NAND.", 0, 0);
-    OPTEST_3_COMPONENTS("NAND.", 0, 1);
-    OPTEST_3_COMPONENTS("NAND.", 1, 0);
-    OPTEST_3_COMPONENTS("NAND.", 1, 1);
-    OPTEST_3_COMPONENTS("NAND.", 0x7FFF, 0x7FFF);
-    OPTEST_3_COMPONENTS("NAND.", 0x8000, 0x8000);
-    OPTEST_3_COMPONENTS("NAND.", 0xFFFF, 0xFFFF);
-    OPTEST_3_COMPONENTS("NAND.", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("NAND.", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("NAND.", 0xFFFFFFFF, 0xFFFFFFFF);
+    RunTests(nand_tests);
 
     printf("\nNEG Variants\n");
-    OPTEST_2_COMPONENTS("NEG", 0);
-    OPTEST_2_COMPONENTS("NEG", 1);
-    OPTEST_2_COMPONENTS("NEG", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("NEG", 0x80000000);
-    OPTEST_2_COMPONENTS("NEG", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("NEG.", 0);
-    OPTEST_2_COMPONENTS("NEG.", 1);
-    OPTEST_2_COMPONENTS("NEG.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("NEG.", 0x80000000);
-    OPTEST_2_COMPONENTS("NEG.", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("NEGO", 0);
-    OPTEST_2_COMPONENTS("NEGO", 1);
-    OPTEST_2_COMPONENTS("NEGO", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("NEGO", 0x80000000);
-    OPTEST_2_COMPONENTS("NEGO", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("NEGO.", 0);
-    OPTEST_2_COMPONENTS("NEGO.", 1);
-    OPTEST_2_COMPONENTS("NEGO.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("NEGO.", 0x80000000);
-    OPTEST_2_COMPONENTS("NEGO.", 0xFFFFFFFF);
+    RunTests(neg_tests);
 
     printf("\nNOR Variants\n");
-    OPTEST_3_COMPONENTS("NOR", 0, 0);
-    OPTEST_3_COMPONENTS("NOR", 0, 1);
-    OPTEST_3_COMPONENTS("NOR", 1, 0);
-    OPTEST_3_COMPONENTS("NOR", 1, 1);
-    OPTEST_3_COMPONENTS("NOR", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("NOR", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("NOR", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("NOR.", 0, 0);
-    OPTEST_3_COMPONENTS("NOR.", 0, 1);
-    OPTEST_3_COMPONENTS("NOR.", 1, 0);
-    OPTEST_3_COMPONENTS("NOR.", 1, 1);
-    OPTEST_3_COMPONENTS("NOR.", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("NOR.", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("NOR.", 0xFFFFFFFF, 0xFFFFFFFF);
+    RunTests(nor_tests);
 
     printf("\nOR Variants\n");
-    OPTEST_3_COMPONENTS("OR", 0, 0);
-    OPTEST_3_COMPONENTS("OR", 0, 1);
-    OPTEST_3_COMPONENTS("OR", 1, 0);
-    OPTEST_3_COMPONENTS("OR", 1, 1);
-    OPTEST_3_COMPONENTS("OR", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("OR", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("OR", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("OR.", 0, 0);
-    OPTEST_3_COMPONENTS("OR.", 0, 1);
-    OPTEST_3_COMPONENTS("OR.", 1, 0);
-    OPTEST_3_COMPONENTS("OR.", 1, 1);
-    OPTEST_3_COMPONENTS("OR.", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("OR.", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("OR.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("ORC", 0, 0);
-    OPTEST_3_COMPONENTS("ORC", 0, 1);
-    OPTEST_3_COMPONENTS("ORC", 1, 0);
-    OPTEST_3_COMPONENTS("ORC", 1, 1);
-    OPTEST_3_COMPONENTS("ORC", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("ORC", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("ORC", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("ORC.", 0, 0);
-    OPTEST_3_COMPONENTS("ORC.", 0, 1);
-    OPTEST_3_COMPONENTS("ORC.", 1, 0);
-    OPTEST_3_COMPONENTS("ORC.", 1, 1);
-    OPTEST_3_COMPONENTS("ORC.", 0x7FFFFFFF, 0x7FFFFFFF);
-    OPTEST_3_COMPONENTS("ORC.", 0x80000000, 0x80000000);
-    OPTEST_3_COMPONENTS("ORC.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS_IMM("ORI", 0, 0);
-    OPTEST_3_COMPONENTS_IMM("ORI", 0, 1);
-    OPTEST_3_COMPONENTS_IMM("ORI", 1, 0);
-    OPTEST_3_COMPONENTS_IMM("ORI", 1, 1);
-    OPTEST_3_COMPONENTS_IMM("ORI", 1, 0x1FFF);
-    OPTEST_3_COMPONENTS_IMM("ORI", 1, 0x3FFF);
-    OPTEST_3_COMPONENTS_IMM("ORI", 1, 0x7FFF);
-    OPTEST_3_COMPONENTS_IMM("ORIS", 0, 0);
-    OPTEST_3_COMPONENTS_IMM("ORIS", 0, 1);
-    OPTEST_3_COMPONENTS_IMM("ORIS", 1, 0);
-    OPTEST_3_COMPONENTS_IMM("ORIS", 1, 1);
-    OPTEST_3_COMPONENTS_IMM("ORIS", 1, 0x1FFF);
-    OPTEST_3_COMPONENTS_IMM("ORIS", 1, 0x3FFF);
-    OPTEST_3_COMPONENTS_IMM("ORIS", 1, 0x7FFF);
+    RunTests(or_tests);
 
     printf("\nRL[x] Variants\n");
 
@@ -814,215 +1251,217 @@ void PPCIntegerTests()
     }
 
     printf("\nShift Variants\n");
-    // Shifts greater than 31 for 32-bit should produce zero.
-    for (uint32_t i = 0; i <= 64; i++)
-    {
-        OPTEST_3_COMPONENTS("SLW", i, i);
-        OPTEST_3_COMPONENTS("SLW", 1, i);
-        OPTEST_3_COMPONENTS("SLW", 0x7FFFFFFF, i);
-        OPTEST_3_COMPONENTS("SLW", 0xFFFFFFFF, i);
-    }
-    for (uint32_t i = 0; i <= 64; i++)
-    {
-        OPTEST_3_COMPONENTS("SLW.", i, i);
-        OPTEST_3_COMPONENTS("SLW.", 1, i);
-        OPTEST_3_COMPONENTS("SLW.", 0x7FFFFFFF, i);
-        OPTEST_3_COMPONENTS("SLW.", 0xFFFFFFFF, i);
-    }
-    for (uint32_t i = 0; i <= 64; i++)
-    {
-        OPTEST_3_COMPONENTS("SRAW", i, i);
-        OPTEST_3_COMPONENTS("SRAW", 1, i);
-        OPTEST_3_COMPONENTS("SRAW", 0x7FFFFFFF, i);
-        OPTEST_3_COMPONENTS("SRAW", 0xFFFFFFFF, i);
-    }
-    for (uint32_t i = 0; i <= 64; i++)
-    {
-        OPTEST_3_COMPONENTS("SRAW.", i, i);
-        OPTEST_3_COMPONENTS("SRAW.", 1, i);
-        OPTEST_3_COMPONENTS("SRAW.", 0x7FFFFFFF, i);
-        OPTEST_3_COMPONENTS("SRAW.", 0xFFFFFFFF, i);
-    }
-    for (uint32_t i = 0; i <= 64; i++)
-    {
-        OPTEST_3_COMPONENTS("SRAWI", i, i);
-        OPTEST_3_COMPONENTS("SRAWI", 1, i);
-        OPTEST_3_COMPONENTS("SRAWI", 0x7FFFFFFF, i);
-        OPTEST_3_COMPONENTS("SRAWI", 0xFFFFFFFF, i);
-    }
-    for (uint32_t i = 0; i <= 64; i++)
-    {
-        OPTEST_3_COMPONENTS("SRAWI.", i, i);
-        OPTEST_3_COMPONENTS("SRAWI.", 1, i);
-        OPTEST_3_COMPONENTS("SRAWI.", 0x7FFFFFFF, i);
-        OPTEST_3_COMPONENTS("SRAWI.", 0xFFFFFFFF, i);
-    }
-    for (uint32_t i = 0; i <= 64; i++)
-    {
-        OPTEST_3_COMPONENTS("SRW", i, i);
-        OPTEST_3_COMPONENTS("SRW", 1, i);
-        OPTEST_3_COMPONENTS("SRW", 0x7FFFFFFF, i);
-        OPTEST_3_COMPONENTS("SRW", 0xFFFFFFFF, i);
-    }
-    for (uint32_t i = 0; i <= 64; i++)
-    {
-        OPTEST_3_COMPONENTS("SRW.", i, i);
-        OPTEST_3_COMPONENTS("SRW.", 1, i);
-        OPTEST_3_COMPONENTS("SRW.", 0x7FFFFFFF, i);
-        OPTEST_3_COMPONENTS("SRW.", 0xFFFFFFFF, i);
-    }
+    RunTests(shift_tests);
 
     printf("\nSUBF Variants\n");
-    OPTEST_3_COMPONENTS("SUBF", 0, 0);
-    OPTEST_3_COMPONENTS("SUBF", 0, 1);
-    OPTEST_3_COMPONENTS("SUBF", 1, 0);
-    OPTEST_3_COMPONENTS("SUBF", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBF", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBF", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBF.", 0, 0);
-    OPTEST_3_COMPONENTS("SUBF.", 0, 1);
-    OPTEST_3_COMPONENTS("SUBF.", 1, 0);
-    OPTEST_3_COMPONENTS("SUBF.", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBF.", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBF.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFO", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFO", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFO", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFO", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFO", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFO", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFO.", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFO.", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFO.", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFO.", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFO.", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFO.", 0xFFFFFFFF, 0xFFFFFFFF);
+    RunTests(subf_tests);
 
-    //
-    // TODO: Make this a loop, but alternate the carry flag for SUBFC
-    //
-    OPTEST_3_COMPONENTS("SUBFC", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFC", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFC", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFC", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFC", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFC", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFC.", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFC.", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFC.", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFC.", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFC.", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFC.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFCO", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFCO", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFCO", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFCO", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFCO", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFCO", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFCO.", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFCO.", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFCO.", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFCO.", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFCO.", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFCO.", 0xFFFFFFFF, 0xFFFFFFFF);
-
-    OPTEST_3_COMPONENTS("SUBFE", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFE", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFE", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFE", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFE", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFE", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFE.", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFE.", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFE.", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFE.", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFE.", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFE.", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFEO", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFEO", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFEO", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFEO", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFEO", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFEO", 0xFFFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFEO.", 0, 0);
-    OPTEST_3_COMPONENTS("SUBFEO.", 0, 1);
-    OPTEST_3_COMPONENTS("SUBFEO.", 1, 0);
-    OPTEST_3_COMPONENTS("SUBFEO.", 0x00000001, 0x80000000);
-    OPTEST_3_COMPONENTS("SUBFEO.", 0x7FFFFFFF, 0xFFFFFFFF);
-    OPTEST_3_COMPONENTS("SUBFEO.", 0xFFFFFFFF, 0xFFFFFFFF);
-
-    OPTEST_3_COMPONENTS_IMM("SUBFIC", 0, 0);
-    OPTEST_3_COMPONENTS_IMM("SUBFIC", 0, 1);
-    OPTEST_3_COMPONENTS_IMM("SUBFIC", 1, 0);
-    OPTEST_3_COMPONENTS_IMM("SUBFIC", 1, 1);
-    OPTEST_3_COMPONENTS_IMM("SUBFIC", 0x7FFFFFFF, 0x7FFF);
-    OPTEST_3_COMPONENTS_IMM("SUBFIC", 0xFFFFFFFF, 0x7FFF);
-
-    OPTEST_2_COMPONENTS("SUBFME", 0);
-    OPTEST_2_COMPONENTS("SUBFME", 1);
-    OPTEST_2_COMPONENTS("SUBFME", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFME", 0x80000000);
-    OPTEST_2_COMPONENTS("SUBFME", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFME.", 0);
-    OPTEST_2_COMPONENTS("SUBFME.", 1);
-    OPTEST_2_COMPONENTS("SUBFME.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFME.", 0x80000000);
-    OPTEST_2_COMPONENTS("SUBFME.", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFMEO", 0);
-    OPTEST_2_COMPONENTS("SUBFMEO", 1);
-    OPTEST_2_COMPONENTS("SUBFMEO", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFMEO", 0x80000000);
-    OPTEST_2_COMPONENTS("SUBFMEO", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFMEO.", 0);
-    OPTEST_2_COMPONENTS("SUBFMEO.", 1);
-    OPTEST_2_COMPONENTS("SUBFMEO.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFMEO.", 0x80000000);
-    OPTEST_2_COMPONENTS("SUBFMEO.", 0xFFFFFFFF);
-
-    OPTEST_2_COMPONENTS("SUBFZE", 0);
-    OPTEST_2_COMPONENTS("SUBFZE", 1);
-    OPTEST_2_COMPONENTS("SUBFZE", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFZE", 0x80000000);
-    OPTEST_2_COMPONENTS("SUBFZE", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFZE.", 0);
-    OPTEST_2_COMPONENTS("SUBFZE.", 1);
-    OPTEST_2_COMPONENTS("SUBFZE.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFZE.", 0x80000000);
-    OPTEST_2_COMPONENTS("SUBFZE.", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFZEO", 0);
-    OPTEST_2_COMPONENTS("SUBFZEO", 1);
-    OPTEST_2_COMPONENTS("SUBFZEO", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFZEO", 0x80000000);
-    OPTEST_2_COMPONENTS("SUBFZEO", 0xFFFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFZEO.", 0);
-    OPTEST_2_COMPONENTS("SUBFZEO.", 1);
-    OPTEST_2_COMPONENTS("SUBFZEO.", 0x7FFFFFFF);
-    OPTEST_2_COMPONENTS("SUBFZEO.", 0x80000000);
-    OPTEST_2_COMPONENTS("SUBFZEO.", 0xFFFFFFFF);
+    printf("\nXOR Variants\n");
+    RunTests(xor_tests);
+
+#ifdef FUZZ_TESTS
+    printf("\n\nInteger Fuzz Tests (seed 0x%016" PRIX64 ", %" PRIu32 " vectors each)\n\n",
+           static_cast<uint64_t>(FUZZ_SEED), static_cast<uint32_t>(FUZZ_VECTORS));
+
+    uint64_t seed = FUZZ_SEED;
+    RunFuzzTests(add_tests, seed);
+    RunFuzzTests(and_tests, seed);
+    RunFuzzTests(cmp_tests, seed);
+    RunFuzzTests(divw_tests, seed);
+    RunFuzzTests(eqv_tests, seed);
+    RunFuzzTests(mulhw_tests, seed);
+    RunFuzzTests(mullw_tests, seed);
+    RunFuzzTests(nand_tests, seed);
+    RunFuzzTests(nor_tests, seed);
+    RunFuzzTests(or_tests, seed);
+    RunFuzzTests(shift_tests, seed);
+    RunFuzzTests(subf_tests, seed);
+    RunFuzzTests(xor_tests, seed);
+#endif
+
+#ifdef EXHAUSTIVE_TESTS
+    printf("\n\nInteger Exhaustive Tests\n\n");
+
+    RunExhaustiveTests(add_tests);
+    RunExhaustiveTests(cntlzw_tests);
+    RunExhaustiveTests(exts_tests);
+    RunExhaustiveTests(neg_tests);
+    RunExhaustiveTests(subf_tests);
+
+    for (const FieldTest& test : field_tests)
+        FieldExhaustiveTest(test);
+
+    RunBinaryExhaustiveTests(add_tests);
+    RunBinaryExhaustiveTests(divw_tests);
+    RunBinaryExhaustiveTests(mulhw_tests);
+    RunBinaryExhaustiveTests(mullw_tests);
+    RunBinaryExhaustiveTests(subf_tests);
+#endif
+}
+
+void PPCIntegerStateTests()
+{
+    printf("\n\nInteger State Tests\n\n");
+
+    printf("ADD Variants\n");
+    RunStateTests(add_tests);
+
+    printf("\nAND Variants\n");
+    RunStateTests(and_tests);
+
+    printf("\nCMP Variants\n");
+    RunStateTests(cmp_tests);
+
+    printf("\nCNTLZW Variants\n");
+    RunStateTests(cntlzw_tests);
+
+    printf("\nDIVW Variants\n");
+    RunStateTests(divw_tests);
+
+    printf("\nEQV Variants\n");
+    RunStateTests(eqv_tests);
+
+    printf("\nEXTSB Variants\n");
+    RunStateTests(exts_tests);
+
+    printf("\nMULHW Variants\n");
+    RunStateTests(mulhw_tests);
+
+    printf("\nMULLI\n");
+    RunStateTests(mulli_tests);
+
+    printf("\nMULLW Variants\n");
+    RunStateTests(mullw_tests);
+
+    printf("\nNAND Variants\n");
+    RunStateTests(nand_tests);
+
+    printf("\nNEG Variants\n");
+    RunStateTests(neg_tests);
+
+    printf("\nNOR Variants\n");
+    RunStateTests(nor_tests);
+
+    printf("\nOR Variants\n");
+    RunStateTests(or_tests);
+
+    printf("\nShift Variants\n");
+    RunStateTests(shift_tests);
+
+    printf("\nSUBF Variants\n");
+    RunStateTests(subf_tests);
 
     printf("\nXOR Variants\n");
-    OPTEST_3_COMPONENTS("XOR", 0, 0);
-    OPTEST_3_COMPONENTS("XOR", 0, 1);
-    OPTEST_3_COMPONENTS("XOR", 1, 0);
-    OPTEST_3_COMPONENTS("XOR", 1, 1);
-    OPTEST_3_COMPONENTS("XOR", 0xFFFFFFFF, 0x1FFF);
-    OPTEST_3_COMPONENTS("XOR", 0xFFFFFFFF, 0x3FFF);
-    OPTEST_3_COMPONENTS("XOR.", 0, 0);
-    OPTEST_3_COMPONENTS("XOR.", 0, 1);
-    OPTEST_3_COMPONENTS("XOR.", 1, 0);
-    OPTEST_3_COMPONENTS("XOR.", 1, 1);
-    OPTEST_3_COMPONENTS("XOR.", 0xFFFFFFFF, 0x1FFF);
-    OPTEST_3_COMPONENTS("XOR.", 0xFFFFFFFF, 0x3FFF);
-    OPTEST_3_COMPONENTS_IMM("XORI", 0, 0);
-    OPTEST_3_COMPONENTS_IMM("XORI", 0, 1);
-    OPTEST_3_COMPONENTS_IMM("XORI", 1, 0);
-    OPTEST_3_COMPONENTS_IMM("XORI", 1, 1);
-    OPTEST_3_COMPONENTS_IMM("XORI", 0xFFFFFFFF, 0x1FFF);
-    OPTEST_3_COMPONENTS_IMM("XORI", 0xFFFFFFFF, 0x3FFF);
-    OPTEST_3_COMPONENTS_IMM("XORIS", 0, 0);
-    OPTEST_3_COMPONENTS_IMM("XORIS", 0, 1);
-    OPTEST_3_COMPONENTS_IMM("XORIS", 1, 0);
-    OPTEST_3_COMPONENTS_IMM("XORIS", 1, 1);
-    OPTEST_3_COMPONENTS_IMM("XORIS", 0xFFFFFFFF, 0x1FFF);
-    OPTEST_3_COMPONENTS_IMM("XORIS", 0xFFFFFFFF, 0x3FFF);
+    RunStateTests(xor_tests);
+}
+
+//
+// Carry and overflow chains (see IntegerChain.h)
+//
+
+struct ChainResult
+{
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t xer;
+    uint32_t cr;
+};
+
+// Executes a chain on a and b from a clean CR and the given XER.
+using ChainTestFunc = ChainResult (*)(uint64_t a, uint64_t b, uint32_t xer);
+
+#define CHAIN_FUNC(chain)                                                                        \
+    [](uint64_t a, uint64_t b, uint32_t xer) {                                                   \
+        ChainResult result{};                                                                    \
+        const uint32_t a_lo = static_cast<uint32_t>(a);                                          \
+        const uint32_t a_hi = static_cast<uint32_t>(a >> 32);                                    \
+        const uint32_t b_lo = static_cast<uint32_t>(b);                                          \
+        const uint32_t b_hi = static_cast<uint32_t>(b >> 32);                                    \
+        SetCR(0);                                                                                \
+        SetXER(xer);                                                                             \
+        asm volatile (chain("%[lo]", "%[hi]", "%[a_lo]", "%[a_hi]", "%[b_lo]", "%[b_hi]")        \
+            : [lo]"=&r"(result.lo), [hi]"=&r"(result.hi)                                         \
+            : [a_lo]"r"(a_lo), [a_hi]"r"(a_hi), [b_lo]"r"(b_lo), [b_hi]"r"(b_hi));               \
+        result.xer = GetXER();                                                                   \
+        result.cr = GetCR();                                                                     \
+        return result;                                                                           \
+    }
+
+struct ChainTest
+{
+    const char* name; // As in integer_chains.
+    ChainTestFunc func;
+};
+
+static constexpr ChainTest chain_tests[] = {
+    {"ADD64", CHAIN_FUNC(CHAIN_ADD64)},
+    {"ADD64O.", CHAIN_FUNC(CHAIN_ADD64O)},
+    {"SUB64", CHAIN_FUNC(CHAIN_SUB64)},
+    {"SUB64O.", CHAIN_FUNC(CHAIN_SUB64O)},
+    {"NEG64", CHAIN_FUNC(CHAIN_NEG64)},
+    {"INC64", CHAIN_FUNC(CHAIN_INC64)},
+    {"DEC64", CHAIN_FUNC(CHAIN_DEC64)},
+    {"CSUM", CHAIN_FUNC(CHAIN_CSUM)},
+    {"SRAWIZE", CHAIN_FUNC(CHAIN_SRAWIZE)},
+    {"CMPCARRY", CHAIN_FUNC(CHAIN_CMPCARRY)},
+    {"CAKEEP.", CHAIN_FUNC(CHAIN_CAKEEP)},
+    {"SOSTICK.", CHAIN_FUNC(CHAIN_SOSTICK)},
+    {"OVCLEAR.", CHAIN_FUNC(CHAIN_OVCLEAR)},
+    {"MULSUBO.", CHAIN_FUNC(CHAIN_MULSUBO)},
+};
+
+// Carries out of and into each word, and signed overflow of each word and of the whole value.
+static constexpr uint64_t chain_values[] = {
+    0,
+    1,
+    0x00000000FFFFFFFF,
+    0x0000000100000000,
+    0x7FFFFFFFFFFFFFFF,
+    0x8000000000000000,
+    0xFFFFFFFFFFFFFFFF,
+    0x123456789ABCDEF0,
+};
+
+// Every chain starts from a clear XER, and from one with everything the chain could read or leave behind already set.
+static constexpr uint32_t chain_xers[] = {0, XER_SO | XER_OV | XER_CA};
+
+static void RunChainTest(const ChainTest& test)
+{
+    const IntegerChain* chain = FindIntegerChain(test.name);
+    const bool reads_b = chain == nullptr || ChainReadsB(*chain);
+
+    for (const uint32_t xer : chain_xers)
+    {
+        for (const uint64_t a : chain_values)
+        {
+            for (const uint64_t b : chain_values)
+            {
+                const ChainResult result = test.func(a, b, xer);
+
+                LogRecord record = MakeLogRecord(LogForm::IntegerChain, test.name);
+                record.result = (static_cast<uint64_t>(result.hi) << 32) | result.lo;
+                record.xer = result.xer;
+                record.cr = result.cr;
+                record.operands[0] = a;
+                record.operands[1] = b;
+                record.operands[2] = xer;
+                LogResult(record);
+
+                // Chains that only read a need only one b.
+                if (!reads_b)
+                    break;
+            }
+        }
+    }
+}
+
+void PPCIntegerChainTests()
+{
+    printf("\n\nInteger Chain Tests\n\n");
+
+    for (const ChainTest& test : chain_tests)
+    {
+        printf("%s\n", test.name);
+        RunChainTest(test);
+    }
 }
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#include "PPCModel.h"
+
+// Carry and overflow chains.
+//
+// The integer tests start every instruction from a clean XER and CR, so nothing checks an
+// instruction that consumes the CA, OV or SO left behind by the one before it, which is
+// exactly where JITs keep XER in host flags and skip writing it back. Each chain is a short
+// sequence run back to back on two 64-bit operands (a and b, as pairs of words), writing a
+// 64-bit result (lo and hi), and only the state at the end is logged. The benchmarks time
+// the same sequences.
+//
+// Each chain is written twice: as asm (the CHAIN_* macros), which the tests and benchmarks
+// run, and as steps the model runs (integer_chains), which the host tools check against.
+// The asm takes the operand names to use, so the benchmarks can feed results back in.
+// Chains are either 2 or 4 instructions long.
+
+#define CHAIN_ADD64(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "addc " lo ", " a_lo ", " b_lo "\n"             \
+    "adde " hi ", " a_hi ", " b_hi "\n"
+
+#define CHAIN_ADD64O(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "addco " lo ", " a_lo ", " b_lo "\n"             \
+    "addeo. " hi ", " a_hi ", " b_hi "\n"
+
+#define CHAIN_SUB64(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "subfc " lo ", " a_lo ", " b_lo "\n"            \
+    "subfe " hi ", " a_hi ", " b_hi "\n"
+
+#define CHAIN_SUB64O(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "subfco " lo ", " a_lo ", " b_lo "\n"            \
+    "subfeo. " hi ", " a_hi ", " b_hi "\n"
+
+#define CHAIN_NEG64(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "subfic " lo ", " a_lo ", 0\n"                  \
+    "subfze " hi ", " a_hi "\n"
+
+#define CHAIN_INC64(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "addic " lo ", " a_lo ", 1\n"                   \
+    "addze " hi ", " a_hi "\n"
+
+#define CHAIN_DEC64(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "addic " lo ", " a_lo ", -1\n"                  \
+    "addme " hi ", " a_hi "\n"
+
+// One's complement sum of the four words (as in an IP checksum), before and after folding in the last carry.
+#define CHAIN_CSUM(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "addc " lo ", " a_lo ", " a_hi "\n"            \
+    "adde " lo ", " lo ", " b_lo "\n"              \
+    "adde " lo ", " lo ", " b_hi "\n"              \
+    "addze " hi ", " lo "\n"
+
+// Signed division of each word of a by 16, rounding toward zero.
+#define CHAIN_SRAWIZE(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "srawi " lo ", " a_lo ", 4\n"                     \
+    "addze " lo ", " lo "\n"                          \
+    "srawi " hi ", " a_hi ", 4\n"                     \
+    "addze " hi ", " hi "\n"
+
+// Compares between the carry's producer and consumer (a compare clobbers the host's carry flag on x86).
+#define CHAIN_CMPCARRY(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "subfc " lo ", " a_lo ", " b_lo "\n"               \
+    "cmpw " a_hi ", " b_hi "\n"                        \
+    "cmplw " a_lo ", " b_hi "\n"                       \
+    "subfe " hi ", " a_hi ", " b_hi "\n"
+
+// Logical and non-carrying arithmetic between the carry's producer and consumer.
+#define CHAIN_CAKEEP(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "addc " lo ", " a_lo ", " b_lo "\n"              \
+    "and. " hi ", " a_hi ", " b_hi "\n"              \
+    "add " hi ", " hi ", " a_lo "\n"                 \
+    "adde " hi ", " hi ", " b_hi "\n"
+
+// SO set by one instruction, and copied into cr0 by a later one that doesn't touch OV.
+#define CHAIN_SOSTICK(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "addo " lo ", " a_lo ", " b_lo "\n"               \
+    "add. " hi ", " a_hi ", " b_hi "\n"
+
+// OV set by one instruction and cleared by the next, with SO left set.
+#define CHAIN_OVCLEAR(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "addo " lo ", " a_lo ", " b_lo "\n"               \
+    "addo. " hi ", " a_hi ", " b_hi "\n"
+
+#define CHAIN_MULSUBO(lo, hi, a_lo, a_hi, b_lo, b_hi) \
+    "mullwo " lo ", " a_lo ", " b_lo "\n"             \
+    "subfo. " hi ", " a_hi ", " b_hi "\n"
+
+// Registers the model's steps read and write.
+enum ChainRegister : uint8_t
+{
+    CHAIN_A_LO,
+    CHAIN_A_HI,
+    CHAIN_B_LO,
+    CHAIN_B_HI,
+    CHAIN_LO,
+    CHAIN_HI,
+    CHAIN_REGISTER_COUNT,
+
+    CHAIN_NONE = 0xFF, // rB of a step that takes an immediate (or nothing), and rD of a compare.
+};
+
+struct ChainStep
+{
+    const char* inst;
+    uint8_t rD;
+    uint8_t rA;
+    uint8_t rB;
+    uint32_t imm;
+};
+
+struct IntegerChain
+{
+    const char* name;
+    ChainStep steps[4]; // The steps of 2-instruction chains are followed by empty ones.
+};
+
+#define CHAIN_BINARY(inst, rD, rA, rB)     {inst, rD, rA, rB, 0}
+#define CHAIN_UNARY(inst, rD, rA)          {inst, rD, rA, CHAIN_NONE, 0}
+#define CHAIN_IMMEDIATE(inst, rD, rA, imm) {inst, rD, rA, CHAIN_NONE, static_cast<uint32_t>(imm)}
+#define CHAIN_COMPARE(inst, rA, rB)        {inst, CHAIN_NONE, rA, rB, 0}
+
+// In the same order as the tests and benchmarks.
+constexpr IntegerChain integer_chains[] = {
+    {"ADD64", {CHAIN_BINARY("ADDC", CHAIN_LO, CHAIN_A_LO, CHAIN_B_LO), CHAIN_BINARY("ADDE", CHAIN_HI, CHAIN_A_HI, CHAIN_B_HI)}},
+    {"ADD64O.", {CHAIN_BINARY("ADDCO", CHAIN_LO, CHAIN_A_LO, CHAIN_B_LO), CHAIN_BINARY("ADDEO.", CHAIN_HI, CHAIN_A_HI, CHAIN_B_HI)}},
+    {"SUB64", {CHAIN_BINARY("SUBFC", CHAIN_LO, CHAIN_A_LO, CHAIN_B_LO), CHAIN_BINARY("SUBFE", CHAIN_HI, CHAIN_A_HI, CHAIN_B_HI)}},
+    {"SUB64O.", {CHAIN_BINARY("SUBFCO", CHAIN_LO, CHAIN_A_LO, CHAIN_B_LO), CHAIN_BINARY("SUBFEO.", CHAIN_HI, CHAIN_A_HI, CHAIN_B_HI)}},
+    {"NEG64", {CHAIN_IMMEDIATE("SUBFIC", CHAIN_LO, CHAIN_A_LO, 0), CHAIN_UNARY("SUBFZE", CHAIN_HI, CHAIN_A_HI)}},
+    {"INC64", {CHAIN_IMMEDIATE("ADDIC", CHAIN_LO, CHAIN_A_LO, 1), CHAIN_UNARY("ADDZE", CHAIN_HI, CHAIN_A_HI)}},
+    {"DEC64", {CHAIN_IMMEDIATE("ADDIC", CHAIN_LO, CHAIN_A_LO, -1), CHAIN_UNARY("ADDME", CHAIN_HI, CHAIN_A_HI)}},
+    {"CSUM", {CHAIN_BINARY("ADDC", CHAIN_LO, CHAIN_A_LO, CHAIN_A_HI), CHAIN_BINARY("ADDE", CHAIN_LO, CHAIN_LO, CHAIN_B_LO),
+              CHAIN_BINARY("ADDE", CHAIN_LO, CHAIN_LO, CHAIN_B_HI), CHAIN_UNARY("ADDZE", CHAIN_HI, CHAIN_LO)}},
+    {"SRAWIZE", {CHAIN_IMMEDIATE("SRAWI", CHAIN_LO, CHAIN_A_LO, 4), CHAIN_UNARY("ADDZE", CHAIN_LO, CHAIN_LO),
+                 CHAIN_IMMEDIATE("SRAWI", CHAIN_HI, CHAIN_A_HI, 4), CHAIN_UNARY("ADDZE", CHAIN_HI, CHAIN_HI)}},
+    {"CMPCARRY", {CHAIN_BINARY("SUBFC", CHAIN_LO, CHAIN_A_LO, CHAIN_B_LO), CHAIN_COMPARE("CMP", CHAIN_A_HI, CHAIN_B_HI),
+                  CHAIN_COMPARE("CMPL", CHAIN_A_LO, CHAIN_B_HI), CHAIN_BINARY("SUBFE", CHAIN_HI, CHAIN_A_HI, CHAIN_B_HI)}},
+    {"CAKEEP.", {CHAIN_BINARY("ADDC", CHAIN_LO, CHAIN_A_LO, CHAIN_B_LO), CHAIN_BINARY("AND.", CHAIN_HI, CHAIN_A_HI, CHAIN_B_HI),
+                 CHAIN_BINARY("ADD", CHAIN_HI, CHAIN_HI, CHAIN_A_LO), CHAIN_BINARY("ADDE", CHAIN_HI, CHAIN_HI, CHAIN_B_HI)}},
+    {"SOSTICK.", {CHAIN_BINARY("ADDO", CHAIN_LO, CHAIN_A_LO, CHAIN_B_LO), CHAIN_BINARY("ADD.", CHAIN_HI, CHAIN_A_HI, CHAIN_B_HI)}},
+    {"OVCLEAR.", {CHAIN_BINARY("ADDO", CHAIN_LO, CHAIN_A_LO, CHAIN_B_LO), CHAIN_BINARY("ADDO.", CHAIN_HI, CHAIN_A_HI, CHAIN_B_HI)}},
+    {"MULSUBO.", {CHAIN_BINARY("MULLWO", CHAIN_LO, CHAIN_A_LO, CHAIN_B_LO), CHAIN_BINARY("SUBFO.", CHAIN_HI, CHAIN_A_HI, CHAIN_B_HI)}},
+};
+
+inline const IntegerChain* FindIntegerChain(const char* name)
+{
+    for (const IntegerChain& chain : integer_chains)
+    {
+        if (std::strcmp(chain.name, name) == 0)
+            return &chain;
+    }
+
+    return nullptr;
+}
+
+// Whether any step reads b, which chains that only operate on a don't.
+inline bool ChainReadsB(const IntegerChain& chain)
+{
+    for (const ChainStep& step : chain.steps)
+    {
+        if (step.inst == nullptr)
+            break;
+
+        for (const uint8_t reg : {step.rA, step.rB})
+        {
+            if (reg == CHAIN_B_LO || reg == CHAIN_B_HI)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// Runs a chain through the model from the given initial state, and returns hi << 32 | lo.
+// Returns false if a step isn't modeled.
+inline bool ModelIntegerChain(const IntegerChain& chain, uint64_t a, uint64_t b, ModelState& state, uint64_t* result)
+{
+    uint32_t regs[CHAIN_REGISTER_COUNT] = {static_cast<uint32_t>(a), static_cast<uint32_t>(a >> 32),
+                                           static_cast<uint32_t>(b), static_cast<uint32_t>(b >> 32), 0, 0};
+
+    for (const ChainStep& step : chain.steps)
+    {
+        if (step.inst == nullptr)
+            break;
+
+        ModelInstruction inst{};
+        if (!DecodeModelMnemonic(step.inst, &inst))
+            return false;
+
+        const uint32_t rB = step.rB == CHAIN_NONE ? step.imm : regs[step.rB];
+        const uint32_t rD_in = step.rD == CHAIN_NONE ? 0 : regs[step.rD];
+        const uint32_t rD = ModelInteger(inst, rD_in, {regs[step.rA], rB, 0, 0}, state);
+        if (step.rD != CHAIN_NONE)
+            regs[step.rD] = rD;
+    }
+
+    *result = (static_cast<uint64_t>(regs[CHAIN_HI]) << 32) | regs[CHAIN_LO];
+    return true;
+}
@@ -0,0 +1,449 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include "Log.h"
+#include "Tests.h"
+
+// Load and store tests.
+//
+// Every access goes to a buffer that straddles a page boundary, at aligned, unaligned,
+// cache-line-crossing and page-crossing offsets. Before each access the bytes around it are
+// reset to a fixed pattern, and loads get their value written at the effective address first.
+// Stores log the 24 bytes from 8 before the effective address afterwards, so bytes that
+// shouldn't have been written (or should have) show up, even when the write went astray.
+// Addresses are logged as offsets into the buffer, so logs from different platforms and
+// runs stay comparable.
+//
+// D-form instructions address the buffer as 8(rA) and indexed ones as rA + rB with rB = 16,
+// so the address calculation is tested as well. Update forms log how far rA moved.
+
+constexpr size_t LS_BUFFER_SIZE = 8192;
+constexpr size_t LS_PAGE_SIZE = 4096;
+
+alignas(LS_PAGE_SIZE) static uint8_t ls_buffer[LS_BUFFER_SIZE];
+
+static uint8_t PatternByte(size_t offset)
+{
+    return static_cast<uint8_t>(offset * 0x25 + 0x5A);
+}
+
+// Resets the bytes an access at offset can reach (and some either side).
+static void ResetBuffer(size_t offset)
+{
+    const size_t begin = offset >= 32 ? offset - 32 : 0;
+    const size_t end = offset + 40 <= LS_BUFFER_SIZE ? offset + 40 : LS_BUFFER_SIZE;
+    for (size_t i = begin; i < end; i++)
+        ls_buffer[i] = PatternByte(i);
+}
+
+static void WriteBigEndian64(uint8_t* memory, uint64_t value)
+{
+    for (size_t i = 0; i < 8; i++)
+        memory[i] = static_cast<uint8_t>(value >> (56 - i * 8));
+}
+
+static uint64_t ReadBigEndian64(const uint8_t* memory)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++)
+        value = (value << 8) | memory[i];
+    return value;
+}
+
+struct LSResult
+{
+    uint64_t value;  // rD (r30:r31 for the multiple and string forms, the bits of frD for floating-point loads)
+    uint32_t update; // How far rA moved
+};
+
+// Executes an instruction with an effective address of ea. value is what stores store, and
+// count is the byte count of the XER-counted string instructions.
+using LSTestFunc = LSResult (*)(uint8_t* ea, uint64_t value, uint32_t count);
+
+enum class LSKind
+{
+    Load,
+    Store,
+};
+
+struct LSTest
+{
+    const char* inst;
+    LSKind kind;
+    uint32_t size; // Bytes accessed
+    LSTestFunc func;
+    const uint32_t* offsets;
+    size_t num_offsets;
+    const uint64_t* values;
+    size_t num_values;
+};
+
+//
+// Test functions
+//
+
+#define LS_FUNC(...)                                                   \
+    [](uint8_t* ea, uint64_t value, uint32_t count) {                  \
+        (void)value;                                                   \
+        (void)count;                                                   \
+        __VA_ARGS__                                                    \
+    }
+
+#define INTEGER_LOAD_FUNC(inst, operands, base_offset, ...)            \
+    LS_FUNC(                                                           \
+        uint8_t* const base = ea - (base_offset);                      \
+        uint8_t* rA = base;                                            \
+        uint32_t rD;                                                   \
+        asm volatile (inst " %[rD], " operands                         \
+            : [rD]"=r"(rD), [rA]"+b"(rA) : __VA_ARGS__ : "memory");    \
+        return LSResult{rD, static_cast<uint32_t>(rA - base)};)
+
+#define INTEGER_STORE_FUNC(inst, operands, base_offset, ...)           \
+    LS_FUNC(                                                           \
+        uint8_t* const base = ea - (base_offset);                      \
+        uint8_t* rA = base;                                            \
+        const uint32_t rS = static_cast<uint32_t>(value);              \
+        asm volatile (inst " %[rS], " operands                         \
+            : [rA]"+b"(rA) : [rS]"r"(rS), ##__VA_ARGS__ : "memory");   \
+        return LSResult{0, static_cast<uint32_t>(rA - base)};)
+
+#define FLOAT_LOAD_FUNC(inst, operands, base_offset, ...)              \
+    LS_FUNC(                                                           \
+        uint8_t* const base = ea - (base_offset);                      \
+        uint8_t* rA = base;                                            \
+        double frD;                                                    \
+        asm volatile (inst " %[frD], " operands                        \
+            : [frD]"=f"(frD), [rA]"+b"(rA) : __VA_ARGS__ : "memory");  \
+        return LSResult{DoubleToBits(frD), static_cast<uint32_t>(rA - base)};)
+
+#define FLOAT_STORE_FUNC(inst, operands, base_offset, ...)             \
+    LS_FUNC(                                                           \
+        uint8_t* const base = ea - (base_offset);                      \
+        uint8_t* rA = base;                                            \
+        const double frS = BitsToDouble(value);                        \
+        asm volatile (inst " %[frS], " operands                        \
+            : [rA]"+b"(rA) : [frS]"f"(frS), ##__VA_ARGS__ : "memory"); \
+        return LSResult{0, static_cast<uint32_t>(rA - base)};)
+
+#define D_OPERANDS "8(%[rA])"
+#define X_OPERANDS "%[rA], %[rB]"
+#define X_INPUTS   [rB]"r"(16)
+
+#define INTEGER_LOAD_D(inst)   INTEGER_LOAD_FUNC(inst, D_OPERANDS, 8, )
+#define INTEGER_LOAD_X(inst)   INTEGER_LOAD_FUNC(inst, X_OPERANDS, 16, X_INPUTS)
+#define INTEGER_STORE_D(inst)  INTEGER_STORE_FUNC(inst, D_OPERANDS, 8)
+#define INTEGER_STORE_X(inst)  INTEGER_STORE_FUNC(inst, X_OPERANDS, 16, X_INPUTS)
+#define FLOAT_LOAD_D(inst)     FLOAT_LOAD_FUNC(inst, D_OPERANDS, 8, )
+#define FLOAT_LOAD_X(inst)     FLOAT_LOAD_FUNC(inst, X_OPERANDS, 16, X_INPUTS)
+#define FLOAT_STORE_D(inst)    FLOAT_STORE_FUNC(inst, D_OPERANDS, 8)
+#define FLOAT_STORE_X(inst)    FLOAT_STORE_FUNC(inst, X_OPERANDS, 16, X_INPUTS)
+
+// Indexed forms with rA = 0, which use rB alone as the address.
+#define INTEGER_LOAD_X0(inst)                                                              \
+    LS_FUNC(                                                                               \
+        uint32_t rD;                                                                       \
+        asm volatile (inst " %[rD], 0, %[rB]" : [rD]"=r"(rD) : [rB]"r"(ea) : "memory");    \
+        return LSResult{rD, 0};)
+
+#define INTEGER_STORE_X0(inst)                                                             \
+    LS_FUNC(                                                                               \
+        const uint32_t rS = static_cast<uint32_t>(value);                                  \
+        asm volatile (inst " %[rS], 0, %[rB]" : : [rS]"r"(rS), [rB]"r"(ea) : "memory");    \
+        return LSResult{0, 0};)
+
+// The multiple and string forms load and store r30 and r31, which start out as 0xCCCCCCCC
+// for loads, so registers that aren't written stand out. Counts are kept to 8 bytes, so they
+// never wrap around to r0 (and the stack pointer).
+#define MULTIPLE_LOAD_FUNC(asm_text, ...)                                                  \
+    LS_FUNC(                                                                               \
+        uint32_t out[2];                                                                   \
+        asm volatile ("lis 30, 0xCCCC\n"                                                   \
+                      "ori 30, 30, 0xCCCC\n"                                               \
+                      "mr 31, 30\n"                                                        \
+                      asm_text "\n"                                                        \
+                      "stw 30, 0(%[out])\n"                                                \
+                      "stw 31, 4(%[out])\n"                                                \
+                      : : [out]"b"(out), __VA_ARGS__ : "r30", "r31", "xer", "memory");     \
+        return LSResult{(uint64_t{out[0]} << 32) | out[1], 0};)
+
+#define MULTIPLE_STORE_FUNC(asm_text, ...)                                                 \
+    LS_FUNC(                                                                               \
+        const uint32_t in[2] = {static_cast<uint32_t>(value >> 32), static_cast<uint32_t>(value)}; \
+        asm volatile ("lwz 30, 0(%[in])\n"                                                 \
+                      "lwz 31, 4(%[in])\n"                                                 \
+                      asm_text "\n"                                                        \
+                      : : [in]"b"(in), __VA_ARGS__ : "r30", "r31", "xer", "memory");       \
+        return LSResult{0, 0};)
+
+#define LMW_FUNC   MULTIPLE_LOAD_FUNC("lmw 30, 8(%[rA])", [rA]"b"(ea - 8))
+#define STMW_FUNC  MULTIPLE_STORE_FUNC("stmw 30, 8(%[rA])", [rA]"b"(ea - 8))
+#define LSWI_FUNC(nb)  MULTIPLE_LOAD_FUNC("lswi 30, %[rA], " #nb, [rA]"b"(ea))
+#define STSWI_FUNC(nb) MULTIPLE_STORE_FUNC("stswi 30, %[rA], " #nb, [rA]"b"(ea))
+#define LSWX_FUNC  MULTIPLE_LOAD_FUNC("mtxer %[count]\nlswx 30, %[rA], %[rB]", [rA]"b"(ea - 16), [rB]"r"(16), [count]"r"(count))
+#define STSWX_FUNC MULTIPLE_STORE_FUNC("mtxer %[count]\nstswx 30, %[rA], %[rB]", [rA]"b"(ea - 16), [rB]"r"(16), [count]"r"(count))
+
+// Table entries.
+#define LOAD_TEST(inst, bytes, func, offsets, values) \
+    {inst, LSKind::Load, bytes, func, std::data(offsets), std::size(offsets), std::data(values), std::size(values)}
+#define STORE_TEST(inst, bytes, func, offsets, values) \
+    {inst, LSKind::Store, bytes, func, std::data(offsets), std::size(offsets), std::data(values), std::size(values)}
+
+//
+// Operand tables
+//
+
+// Aligned, unaligned, crossing the cache line at 0x120, and crossing the page at 0x1000.
+static constexpr uint32_t unaligned_offsets[] = {
+    0x100, 0x101, 0x102, 0x103, 0x11D, 0x11E, 0x11F, 0xFFD, 0xFFE, 0xFFF,
+};
+
+// The multiple and floating-point forms take an alignment exception on unaligned addresses,
+// so they only cover word-aligned ones (including ones crossing the line and the page).
+static constexpr uint32_t aligned_offsets[] = {
+    0x100, 0x104, 0x11C, 0xFFC,
+};
+
+// Memory at the effective address, most significant byte first. Both signs, for the
+// sign-extending and byte-reversed loads.
+static constexpr uint64_t load_values[] = {
+    0x8081828384858687,
+    0x7F7E7D7C7B7A7978,
+};
+
+// rS (the low 32 bits for single-register stores, r30:r31 for the others).
+static constexpr uint64_t store_values[] = {
+    0x0123456789ABCDEF,
+    0xFEDCBA9876543210,
+};
+
+// LFS reads the upper word as a single, and LFD reads all of it as a double.
+static constexpr uint64_t float_load_values[] = {
+    0x3FF0000000000000, // 1.875 as a single, 1.0 as a double
+    0x7F80000100000000, // A signaling NaN as a single, a large normal as a double
+    0x0000000100000000, // The smallest denormal as a single, a denormal as a double
+    0x807FFFFF00000000, // The largest negative denormal as a single, a negative tiny normal as a double
+    0xFFF0000000000001, // A negative quiet NaN as a single, a negative signaling NaN as a double
+    0x0008000000000000, // A denormal as either
+};
+
+// frS. STFS doesn't round, so values outside the single range are interesting too.
+static constexpr uint64_t float_store_values[] = {
+    0x3FF0000000000000, // 1.0
+    0x3FF0000010000000, // 1.0 plus bits below single precision
+    0x36A0000000000000, // Single denormal range
+    0x0010000000000000, // Smallest double normal
+    0x7FEFFFFFFFFFFFFF, // Largest double
+    0x7FF0000000000001, // Signaling NaN
+    0xFFF8000000000000, // Quiet NaN
+};
+
+//
+// Test tables
+//
+
+static constexpr LSTest byte_load_tests[] = {
+    LOAD_TEST("LBZ", 1, INTEGER_LOAD_D("lbz"), unaligned_offsets, load_values),
+    LOAD_TEST("LBZU", 1, INTEGER_LOAD_D("lbzu"), unaligned_offsets, load_values),
+    LOAD_TEST("LBZX", 1, INTEGER_LOAD_X("lbzx"), unaligned_offsets, load_values),
+    LOAD_TEST("LBZUX", 1, INTEGER_LOAD_X("lbzux"), unaligned_offsets, load_values),
+};
+
+static constexpr LSTest half_load_tests[] = {
+    LOAD_TEST("LHA", 2, INTEGER_LOAD_D("lha"), unaligned_offsets, load_values),
+    LOAD_TEST("LHAU", 2, INTEGER_LOAD_D("lhau"), unaligned_offsets, load_values),
+    LOAD_TEST("LHAX", 2, INTEGER_LOAD_X("lhax"), unaligned_offsets, load_values),
+    LOAD_TEST("LHAUX", 2, INTEGER_LOAD_X("lhaux"), unaligned_offsets, load_values),
+    LOAD_TEST("LHBRX", 2, INTEGER_LOAD_X("lhbrx"), unaligned_offsets, load_values),
+    LOAD_TEST("LHZ", 2, INTEGER_LOAD_D("lhz"), unaligned_offsets, load_values),
+    LOAD_TEST("LHZU", 2, INTEGER_LOAD_D("lhzu"), unaligned_offsets, load_values),
+    LOAD_TEST("LHZX", 2, INTEGER_LOAD_X("lhzx"), unaligned_offsets, load_values),
+    LOAD_TEST("LHZUX", 2, INTEGER_LOAD_X("lhzux"), unaligned_offsets, load_values),
+};
+
+static constexpr LSTest word_load_tests[] = {
+    LOAD_TEST("LWBRX", 4, INTEGER_LOAD_X("lwbrx"), unaligned_offsets, load_values),
+    LOAD_TEST("LWZ", 4, INTEGER_LOAD_D("lwz"), unaligned_offsets, load_values),
+    LOAD_TEST("LWZU", 4, INTEGER_LOAD_D("lwzu"), unaligned_offsets, load_values),
+    LOAD_TEST("LWZX", 4, INTEGER_LOAD_X("lwzx"), unaligned_offsets, load_values),
+    LOAD_TEST("LWZUX", 4, INTEGER_LOAD_X("lwzux"), unaligned_offsets, load_values),
+};
+
+static constexpr LSTest byte_store_tests[] = {
+    STORE_TEST("STB", 1, INTEGER_STORE_D("stb"), unaligned_offsets, store_values),
+    STORE_TEST("STBU", 1, INTEGER_STORE_D("stbu"), unaligned_offsets, store_values),
+    STORE_TEST("STBX", 1, INTEGER_STORE_X("stbx"), unaligned_offsets, store_values),
+    STORE_TEST("STBUX", 1, INTEGER_STORE_X("stbux"), unaligned_offsets, store_values),
+};
+
+static constexpr LSTest half_store_tests[] = {
+    STORE_TEST("STH", 2, INTEGER_STORE_D("sth"), unaligned_offsets, store_values),
+    STORE_TEST("STHBRX", 2, INTEGER_STORE_X("sthbrx"), unaligned_offsets, store_values),
+    STORE_TEST("STHU", 2, INTEGER_STORE_D("sthu"), unaligned_offsets, store_values),
+    STORE_TEST("STHX", 2, INTEGER_STORE_X("sthx"), unaligned_offsets, store_values),
+    STORE_TEST("STHUX", 2, INTEGER_STORE_X("sthux"), unaligned_offsets, store_values),
+};
+
+static constexpr LSTest word_store_tests[] = {
+    STORE_TEST("STW", 4, INTEGER_STORE_D("stw"), unaligned_offsets, store_values),
+    STORE_TEST("STWBRX", 4, INTEGER_STORE_X("stwbrx"), unaligned_offsets, store_values),
+    STORE_TEST("STWU", 4, INTEGER_STORE_D("stwu"), unaligned_offsets, store_values),
+    STORE_TEST("STWX", 4, INTEGER_STORE_X("stwx"), unaligned_offsets, store_values),
+    STORE_TEST("STWUX", 4, INTEGER_STORE_X("stwux"), unaligned_offsets, store_values),
+};
+
+static constexpr LSTest zero_base_tests[] = {
+    LOAD_TEST("LBZX", 1, INTEGER_LOAD_X0("lbzx"), unaligned_offsets, load_values),
+    LOAD_TEST("LHZX", 2, INTEGER_LOAD_X0("lhzx"), unaligned_offsets, load_values),
+    LOAD_TEST("LWZX", 4, INTEGER_LOAD_X0("lwzx"), unaligned_offsets, load_values),
+    STORE_TEST("STBX", 1, INTEGER_STORE_X0("stbx"), unaligned_offsets, store_values),
+    STORE_TEST("STHX", 2, INTEGER_STORE_X0("sthx"), unaligned_offsets, store_values),
+    STORE_TEST("STWX", 4, INTEGER_STORE_X0("stwx"), unaligned_offsets, store_values),
+};
+
+static constexpr LSTest multiple_tests[] = {
+    LOAD_TEST("LMW", 8, LMW_FUNC, aligned_offsets, load_values),
+    STORE_TEST("STMW", 8, STMW_FUNC, aligned_offsets, store_values),
+};
+
+static constexpr LSTest string_tests[] = {
+    LOAD_TEST("LSWI", 1, LSWI_FUNC(1), unaligned_offsets, load_values),
+    LOAD_TEST("LSWI", 2, LSWI_FUNC(2), unaligned_offsets, load_values),
+    LOAD_TEST("LSWI", 3, LSWI_FUNC(3), unaligned_offsets, load_values),
+    LOAD_TEST("LSWI", 4, LSWI_FUNC(4), unaligned_offsets, load_values),
+    LOAD_TEST("LSWI", 5, LSWI_FUNC(5), unaligned_offsets, load_values),
+    LOAD_TEST("LSWI", 6, LSWI_FUNC(6), unaligned_offsets, load_values),
+    LOAD_TEST("LSWI", 7, LSWI_FUNC(7), unaligned_offsets, load_values),
+    LOAD_TEST("LSWI", 8, LSWI_FUNC(8), unaligned_offsets, load_values),
+    LOAD_TEST("LSWX", 0, LSWX_FUNC, unaligned_offsets, load_values),
+    LOAD_TEST("LSWX", 1, LSWX_FUNC, unaligned_offsets, load_values),
+    LOAD_TEST("LSWX", 3, LSWX_FUNC, unaligned_offsets, load_values),
+    LOAD_TEST("LSWX", 4, LSWX_FUNC, unaligned_offsets, load_values),
+    LOAD_TEST("LSWX", 5, LSWX_FUNC, unaligned_offsets, load_values),
+    LOAD_TEST("LSWX", 8, LSWX_FUNC, unaligned_offsets, load_values),
+    STORE_TEST("STSWI", 1, STSWI_FUNC(1), unaligned_offsets, store_values),
+    STORE_TEST("STSWI", 2, STSWI_FUNC(2), unaligned_offsets, store_values),
+    STORE_TEST("STSWI", 3, STSWI_FUNC(3), unaligned_offsets, store_values),
+    STORE_TEST("STSWI", 4, STSWI_FUNC(4), unaligned_offsets, store_values),
+    STORE_TEST("STSWI", 5, STSWI_FUNC(5), unaligned_offsets, store_values),
+    STORE_TEST("STSWI", 6, STSWI_FUNC(6), unaligned_offsets, store_values),
+    STORE_TEST("STSWI", 7, STSWI_FUNC(7), unaligned_offsets, store_values),
+    STORE_TEST("STSWI", 8, STSWI_FUNC(8), unaligned_offsets, store_values),
+    STORE_TEST("STSWX", 0, STSWX_FUNC, unaligned_offsets, store_values),
+    STORE_TEST("STSWX", 1, STSWX_FUNC, unaligned_offsets, store_values),
+    STORE_TEST("STSWX", 3, STSWX_FUNC, unaligned_offsets, store_values),
+    STORE_TEST("STSWX", 4, STSWX_FUNC, unaligned_offsets, store_values),
+    STORE_TEST("STSWX", 5, STSWX_FUNC, unaligned_offsets, store_values),
+    STORE_TEST("STSWX", 8, STSWX_FUNC, unaligned_offsets, store_values),
+};
+
+static constexpr LSTest float_load_tests[] = {
+    LOAD_TEST("LFD", 8, FLOAT_LOAD_D("lfd"), aligned_offsets, float_load_values),
+    LOAD_TEST("LFDU", 8, FLOAT_LOAD_D("lfdu"), aligned_offsets, float_load_values),
+    LOAD_TEST("LFDX", 8, FLOAT_LOAD_X("lfdx"), aligned_offsets, float_load_values),
+    LOAD_TEST("LFDUX", 8, FLOAT_LOAD_X("lfdux"), aligned_offsets, float_load_values),
+    LOAD_TEST("LFS", 4, FLOAT_LOAD_D("lfs"), aligned_offsets, float_load_values),
+    LOAD_TEST("LFSU", 4, FLOAT_LOAD_D("lfsu"), aligned_offsets, float_load_values),
+    LOAD_TEST("LFSX", 4, FLOAT_LOAD_X("lfsx"), aligned_offsets, float_load_values),
+    LOAD_TEST("LFSUX", 4, FLOAT_LOAD_X("lfsux"), aligned_offsets, float_load_values),
+};
+
+static constexpr LSTest float_store_tests[] = {
+    STORE_TEST("STFD", 8, FLOAT_STORE_D("stfd"), aligned_offsets, float_store_values),
+    STORE_TEST("STFDU", 8, FLOAT_STORE_D("stfdu"), aligned_offsets, float_store_values),
+    STORE_TEST("STFDX", 8, FLOAT_STORE_X("stfdx"), aligned_offsets, float_store_values),
+    STORE_TEST("STFDUX", 8, FLOAT_STORE_X("stfdux"), aligned_offsets, float_store_values),
+    STORE_TEST("STFIWX", 4, FLOAT_STORE_X("stfiwx"), aligned_offsets, float_store_values),
+    STORE_TEST("STFS", 4, FLOAT_STORE_D("stfs"), aligned_offsets, float_store_values),
+    STORE_TEST("STFSU", 4, FLOAT_STORE_D("stfsu"), aligned_offsets, float_store_values),
+    STORE_TEST("STFSX", 4, FLOAT_STORE_X("stfsx"), aligned_offsets, float_store_values),
+    STORE_TEST("STFSUX", 4, FLOAT_STORE_X("stfsux"), aligned_offsets, float_store_values),
+};
+
+static void RunTest(const LSTest& test, uint32_t offset, uint64_t value)
+{
+    uint8_t* const ea = ls_buffer + offset;
+
+    ResetBuffer(offset);
+    if (test.kind == LSKind::Load)
+        WriteBigEndian64(ea, value);
+
+    const LSResult result = test.func(ea, value, test.size);
+
+    if (test.kind == LSKind::Load)
+    {
+        LogRecord record = MakeLogRecord(LogForm::Load, test.inst);
+        record.result = result.value;
+        record.operands[0] = value;
+        record.operands[1] = offset;
+        record.operands[2] = test.size;
+        record.operands[3] = result.update;
+        LogResult(record);
+        return;
+    }
+
+    // Every offset is at least 8 bytes into the buffer, and 16 short of its end.
+    LogRecord record = MakeLogRecord(LogForm::Store, test.inst);
+    record.result = ReadBigEndian64(ea);
+    record.operands[0] = value;
+    record.operands[1] = PackStoreAccess(offset, test.size, result.update);
+    record.operands[2] = ReadBigEndian64(ea - 8);
+    record.operands[3] = ReadBigEndian64(ea + 8);
+    LogResult(record);
+}
+
+template <size_t N>
+static void RunTests(const LSTest (&tests)[N])
+{
+    for (const LSTest& test : tests)
+    {
+        for (size_t i = 0; i < test.num_offsets; i++)
+        {
+            for (size_t j = 0; j < test.num_values; j++)
+                RunTest(test, test.offsets[i], test.values[j]);
+        }
+    }
+}
+
+void PPCLoadStoreTests()
+{
+    for (size_t i = 0; i < LS_BUFFER_SIZE; i++)
+        ls_buffer[i] = PatternByte(i);
+
+    printf("\n\nLoad/Store Tests\n\n");
+
+    printf("Byte Loads\n");
+    RunTests(byte_load_tests);
+
+    printf("\nHalfword Loads\n");
+    RunTests(half_load_tests);
+
+    printf("\nWord Loads\n");
+    RunTests(word_load_tests);
+
+    printf("\nByte Stores\n");
+    RunTests(byte_store_tests);
+
+    printf("\nHalfword Stores\n");
+    RunTests(half_store_tests);
+
+    printf("\nWord Stores\n");
+    RunTests(word_store_tests);
+
+    printf("\nIndexed Variants (rA = 0)\n");
+    RunTests(zero_base_tests);
+
+    printf("\nLMW/STMW (r30-r31)\n");
+    RunTests(multiple_tests);
+
+    printf("\nString Variants (r30-r31)\n");
+    RunTests(string_tests);
+
+    printf("\nFloating-Point Loads\n");
+    RunTests(float_load_tests);
+
+    printf("\nFloating-Point Stores\n");
+    RunTests(float_store_tests);
+}
@@ -0,0 +1,422 @@
+#include "Log.h"
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include "Platform.h"
+
+#ifdef DIGEST_LOG
+#include "Digest.h"
+#endif
+
+#ifdef SELF_CHECK
+#include <algorithm>
+#include <vector>
+
+#include "SelfCheck.h"
+
+// Generated from SELF_CHECK_REFERENCE by tools/expectgen.
+#include "expected_results.inc"
+
+#ifdef DIGEST_LOG
+#error "SELF_CHECK and DIGEST_LOG can't be combined"
+#endif
+#endif
+
+static FILE* log_file = nullptr;
+
+// Output is collected in blocks that the platform writes out in the background (see
+// Platform.h), since every individual write to the SD card is expensive.
+static uint8_t* log_block = nullptr;
+static size_t log_block_used = 0;
+
+static void FlushBlock()
+{
+    if (log_block_used == 0)
+        return;
+
+    PlatformWriteLogBlock(log_block, log_block_used);
+    log_block = nullptr;
+    log_block_used = 0;
+}
+
+// Copies size bytes into the current block, starting a new one whenever it fills up.
+static void WriteLogData(const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+
+    while (size != 0)
+    {
+        if (log_block == nullptr)
+            log_block = PlatformGetLogBlock();
+
+        const size_t space = PLATFORM_LOG_BLOCK_SIZE - log_block_used;
+        const size_t chunk = size < space ? size : space;
+        std::memcpy(&log_block[log_block_used], bytes, chunk);
+
+        log_block_used += chunk;
+        bytes += chunk;
+        size -= chunk;
+
+        if (log_block_used == PLATFORM_LOG_BLOCK_SIZE)
+            FlushBlock();
+    }
+}
+
+#ifdef BINARY_LOG
+static_assert(PLATFORM_LOG_BLOCK_SIZE % LOG_RECORD_SIZE == 0, "Records mustn't straddle blocks");
+
+// Copies size bytes into the log, padded with zeroes to a multiple of the record size.
+static void WriteRecordData(const void* data, size_t size)
+{
+    static const uint8_t padding[LOG_RECORD_SIZE] = {};
+
+    WriteLogData(data, size);
+    if (size % LOG_RECORD_SIZE != 0)
+        WriteLogData(padding, LOG_RECORD_SIZE - size % LOG_RECORD_SIZE);
+}
+#endif
+
+// Writes text to the log as it is, whatever the results are logged as.
+static void WriteText(const char* text, size_t length)
+{
+#ifdef BINARY_LOG
+    LogRecord record{};
+    record.type = LogRecordType::Text;
+    record.result = length;
+
+    const LogRecord swapped = SwapLogRecord(record);
+    WriteRecordData(&swapped, sizeof(swapped));
+    WriteRecordData(text, length);
+#else
+    WriteLogData(text, length);
+#endif
+}
+
+// Writes a result to the log in full.
+static void WriteResult(const LogRecord& record)
+{
+#ifdef BINARY_LOG
+    const LogRecord swapped = SwapLogRecord(record);
+    WriteRecordData(&swapped, sizeof(swapped));
+#else
+    // Goes through stdout like any other output so that it stays in order with it.
+    char buffer[256];
+    FormatLogRecord(record, buffer, sizeof(buffer));
+    fputs(buffer, stdout);
+#endif
+}
+
+#ifdef DIGEST_LOG
+// Consecutive results of the same instruction under the same mode form a group,
+// and only the digest of each group is logged.
+static LogRecord digest_group{};
+static ResultDigest digest;
+static bool digest_group_open = false;
+
+// Index of the next result, counting from the first one logged.
+static uint64_t result_index = 0;
+
+static void FlushDigestGroup()
+{
+    if (!digest_group_open)
+        return;
+
+    // Closed first, since in text mode the write comes back through LogText.
+    digest_group_open = false;
+    digest_group.result = digest.Finish();
+    WriteResult(digest_group);
+}
+
+static bool IsExpandedResult(uint64_t index)
+{
+#ifdef DIGEST_EXPAND_FIRST
+    return index >= DIGEST_EXPAND_FIRST && index <= DIGEST_EXPAND_LAST;
+#else
+    (void)index;
+    return false;
+#endif
+}
+#endif
+
+#ifdef SELF_CHECK
+// Results that match the expected ones are dropped. Only mismatches, and results the
+// reference doesn't have (which can't be checked here), are logged in full. Text is held
+// back as well, apart from lines that report something, and each section header is only
+// written once something under it is.
+//
+// Consecutive results of the same instruction under the same mode form a group, as with
+// DIGEST_LOG, and the log ends with a bitmap of which groups matched completely.
+enum SelfCheckCount
+{
+    SELF_CHECK_MATCHED,
+    SELF_CHECK_MISMATCHED,
+    SELF_CHECK_MISSING,
+    SELF_CHECK_COUNTS,
+};
+
+static uint64_t self_check_counts[SELF_CHECK_COUNTS];
+
+// How many times each key has come up so far, by the index of its first expected result.
+static uint32_t self_check_repeats[std::size(expected_keys)];
+
+// Text being written out, which comes back through LogText in text mode.
+static bool self_check_writing = false;
+
+static char self_check_line[256];
+static size_t self_check_line_length = 0;
+static char self_check_header[256];
+static size_t self_check_header_length = 0;
+static uint64_t self_check_header_hash = 0;
+static bool self_check_header_written = true;
+
+static LogRecord self_check_group{};
+static bool self_check_group_open = false;
+static bool self_check_group_matched = false;
+static std::vector<uint64_t> self_check_group_bits;
+static size_t self_check_group_count = 0;
+
+static void WriteSelfCheckText(const char* text, size_t length)
+{
+    self_check_writing = true;
+    WriteText(text, length);
+    self_check_writing = false;
+}
+
+static void WriteSelfCheckHeader()
+{
+    if (self_check_header_written)
+        return;
+
+    self_check_header_written = true;
+    WriteSelfCheckText("\n", 1);
+    WriteSelfCheckText(self_check_header, self_check_header_length);
+}
+
+static void CheckLine(const char* line, size_t length)
+{
+    if (IsSelfCheckHeader(line, length))
+    {
+        const size_t kept = length < sizeof(self_check_header) ? length : sizeof(self_check_header) - 1;
+        std::memcpy(self_check_header, line, kept);
+        self_check_header[kept - 1] = '\n';
+        self_check_header_length = kept;
+        self_check_header_hash = HashSelfCheckHeader(line, length);
+        self_check_header_written = false;
+        return;
+    }
+
+    // Blank lines only space the sections out.
+    if (length <= 1)
+        return;
+
+    WriteSelfCheckHeader();
+    WriteSelfCheckText(line, length);
+}
+
+static void CheckText(const char* text, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        // Overlong lines are checked in pieces.
+        self_check_line[self_check_line_length++] = text[i];
+        if (text[i] == '\n' || self_check_line_length == sizeof(self_check_line))
+        {
+            CheckLine(self_check_line, self_check_line_length);
+            self_check_line_length = 0;
+        }
+    }
+}
+
+static void CloseSelfCheckGroup()
+{
+    if (!self_check_group_open)
+        return;
+
+    if (self_check_group_count % 64 == 0)
+        self_check_group_bits.push_back(0);
+    if (self_check_group_matched)
+        self_check_group_bits.back() |= uint64_t{1} << (63 - self_check_group_count % 64);
+
+    self_check_group_count++;
+    self_check_group_open = false;
+}
+
+static void WriteSelfCheckSummary()
+{
+    CloseSelfCheckGroup();
+
+    const uint64_t total = self_check_counts[SELF_CHECK_MATCHED] + self_check_counts[SELF_CHECK_MISMATCHED] +
+                           self_check_counts[SELF_CHECK_MISSING];
+
+    char buffer[192];
+    int length = snprintf(buffer, sizeof(buffer),
+                          "\n\nSelf-Check (against %s)\n\n%" PRIu64 " results: %" PRIu64 " matched, %" PRIu64
+                          " mismatched, %" PRIu64 " not in the reference\n",
+                          expected_reference, total, self_check_counts[SELF_CHECK_MATCHED],
+                          self_check_counts[SELF_CHECK_MISMATCHED], self_check_counts[SELF_CHECK_MISSING]);
+    WriteSelfCheckText(buffer, static_cast<size_t>(length));
+
+    length = snprintf(buffer, sizeof(buffer), "\nGroups matched (%" PRIu64 " groups, the first of each line in the top bit)\n",
+                      static_cast<uint64_t>(self_check_group_count));
+    WriteSelfCheckText(buffer, static_cast<size_t>(length));
+
+    for (size_t i = 0; i < self_check_group_bits.size(); i++)
+    {
+        length = snprintf(buffer, sizeof(buffer), "%6" PRIu64 "  0x%016" PRIX64 "\n", static_cast<uint64_t>(i * 64),
+                          self_check_group_bits[i]);
+        WriteSelfCheckText(buffer, static_cast<size_t>(length));
+    }
+}
+#endif
+
+bool LogOpen(const char* path)
+{
+    log_file = fopen(path, "wb");
+    if (log_file == nullptr)
+        return false;
+
+    // Blocks are written as they are, so that they go straight to whole sectors.
+    setvbuf(log_file, nullptr, _IONBF, 0);
+    PlatformStartLogWriter(log_file);
+    return true;
+}
+
+void LogClose()
+{
+    if (log_file == nullptr)
+        return;
+
+#ifdef DIGEST_LOG
+    FlushDigestGroup();
+#endif
+
+#ifdef SELF_CHECK
+    WriteSelfCheckSummary();
+#endif
+
+    FlushBlock();
+    PlatformStopLogWriter();
+
+    fclose(log_file);
+    log_file = nullptr;
+}
+
+#ifdef DIGEST_LOG
+void LogText(const char* text, size_t length)
+{
+    FlushDigestGroup();
+    WriteText(text, length);
+}
+#elif defined(SELF_CHECK)
+void LogText(const char* text, size_t length)
+{
+    if (self_check_writing)
+        WriteText(text, length);
+    else
+        CheckText(text, length);
+}
+#else
+void LogText(const char* text, size_t length)
+{
+    WriteText(text, length);
+}
+#endif
+
+#ifdef DIGEST_LOG
+void LogResult(const LogRecord& record)
+{
+    const uint64_t index = result_index++;
+
+    // Results being bisected are logged in full, outside of any group.
+    if (IsExpandedResult(index))
+    {
+        FlushDigestGroup();
+        WriteResult(record);
+        return;
+    }
+
+    if (digest_group_open && (std::memcmp(digest_group.inst, record.inst, sizeof(record.inst)) != 0 ||
+                              digest_group.mode != record.mode))
+    {
+        FlushDigestGroup();
+    }
+
+    if (!digest_group_open)
+    {
+        digest_group = MakeLogRecord(LogForm::GroupDigest, "", record.mode);
+        std::memcpy(digest_group.inst, record.inst, sizeof(record.inst));
+        digest_group.operands[0] = index;
+        digest = ResultDigest();
+        digest_group_open = true;
+    }
+
+    DigestRecord(digest, record);
+    digest_group.operands[1] = index;
+}
+#elif defined(SELF_CHECK)
+void LogResult(const LogRecord& record)
+{
+    char buffer[256];
+    const int length = FormatLogRecord(record, buffer, sizeof(buffer));
+    const size_t formatted = length < 0 ? 0 : std::min(static_cast<size_t>(length), sizeof(buffer) - 1);
+
+    uint64_t key = 0;
+    uint32_t value = 0;
+    HashSelfCheckResult(self_check_header_hash, buffer, formatted, &key, &value);
+
+    // Repeats of a key take the reference's results for it in turn.
+    constexpr size_t expected_count = std::size(expected_keys);
+    size_t index = FindSelfCheckResult(expected_keys, expected_count, key);
+    if (index != expected_count)
+    {
+        const size_t first = index;
+        index += self_check_repeats[first]++;
+        if (index >= expected_count || expected_keys[index] != key)
+            index = expected_count;
+    }
+
+    const SelfCheckCount count = index == expected_count            ? SELF_CHECK_MISSING
+                                 : expected_values[index] == value ? SELF_CHECK_MATCHED
+                                                                   : SELF_CHECK_MISMATCHED;
+    self_check_counts[count]++;
+
+    if (self_check_group_open && (std::memcmp(self_check_group.inst, record.inst, sizeof(record.inst)) != 0 ||
+                                  self_check_group.mode != record.mode))
+    {
+        CloseSelfCheckGroup();
+    }
+
+    if (!self_check_group_open)
+    {
+        self_check_group = record;
+        self_check_group_open = true;
+        self_check_group_matched = true;
+    }
+
+    if (count == SELF_CHECK_MATCHED)
+        return;
+
+    self_check_group_matched = false;
+    WriteSelfCheckHeader();
+
+    self_check_writing = true;
+    WriteResult(record);
+    fflush(stdout);
+    self_check_writing = false;
+
+    if (count == SELF_CHECK_MISMATCHED)
+    {
+        static const char marker[] = "  ^ mismatched the reference\n";
+        WriteSelfCheckText(marker, sizeof(marker) - 1);
+    }
+}
+#else
+void LogResult(const LogRecord& record)
+{
+    WriteResult(record);
+}
+#endif
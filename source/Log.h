@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+
+#include "LogRecord.h"
+
+// Building with BINARY_LOG defined writes results as packed LogRecords
+// instead of text, which avoids formatting every result on the console.
+// tools/logdecode turns the binary log back into the text output.
+//
+// Benchmark builds log to their own file, so they don't overwrite the test results.
+#if defined(BENCHMARKS) && defined(BINARY_LOG)
+#define LOG_FILE_NAME "instruction_benchmarks.bin"
+#elif defined(BENCHMARKS)
+#define LOG_FILE_NAME "instruction_benchmarks.txt"
+#elif defined(BINARY_LOG)
+#define LOG_FILE_NAME "instruction_tests.bin"
+#else
+#define LOG_FILE_NAME "instruction_tests.txt"
+#endif
+
+bool LogOpen(const char* path);
+void LogClose();
+
+// Writes raw text to the log. Everything printed to stdout ends up here.
+void LogText(const char* text, size_t length);
+
+// Writes a single instruction result to the log.
+//
+// Building with DIGEST_LOG defined logs a digest of each group of results (consecutive
+// results of one instruction under one mode) instead, which keeps the log small no matter
+// how many vectors are run. DIGEST_EXPAND_FIRST/DIGEST_EXPAND_LAST select a range of
+// results (counting from 0) that are still logged in full, to find the first vector of a
+// group that differs.
+void LogResult(const LogRecord& record);
@@ -0,0 +1,532 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// Binary result log records.
+//
+// Every record is 64 bytes and stored big-endian, regardless of the host that writes it.
+// This header is shared with the host tools, so it must not depend on anything target-specific.
+
+enum class LogRecordType : uint8_t
+{
+    // Free-form text (section headers, specialized tests). The record's result field holds the
+    // length of the text, which follows the record, padded out to a multiple of the record size.
+    Text,
+
+    // A single instruction result.
+    Result,
+};
+
+// Determines which operands a result record has and how it is printed.
+enum class LogForm : uint8_t
+{
+    IntegerUnary,            // rD, rA
+    IntegerBinary,           // rD, rA, rB
+    IntegerImmediate,        // rD, rA, imm
+    IntegerCompare,          // rA, rB
+    IntegerCompareImmediate, // rA, imm
+    IntegerRotate,           // rD, rS, SH, MB, ME
+    FloatUnary,              // frD, frA
+    FloatBinary,             // frD, frA, frB
+    FloatCompare,            // frA, frB
+    FloatTernary,            // frD, frA, frC, frB
+    ConditionRegisterBit,    // bit, crA, crB
+    ConditionRegisterSweep,  // crbD, crbA, crbB, input CR
+    IntegerUnaryDigest,      // first rA, last rA. The result is the digest of every rA in between (see Digest.h).
+    GroupDigest,             // first result, last result. The result is the digest of those results (see Log.h).
+    IntegerBinaryState,      // rD, rA, rB, initial XER
+    FloatSweepDigest,        // seed, vector count. The result is the digest of the generated vectors (see FloatClasses.h).
+    IntegerFieldDigest,      // rA/rS, initial rD, first field, last field. The result is the digest of every encoded field value in between.
+    InstructionTiming,       // throughput, instructions per run. The result is the latency. Both are in hundredths of a cycle.
+    PairedSingleUnary,       // frD, frA. Paired singles hold ps0 in the upper half and ps1 in the lower half, as single bits.
+    PairedSingleBinary,      // frD, frA, frB
+    PairedSingleCompare,     // frA, frB
+    PairedSingleTernary,     // frD, frA, frC, frB
+    QuantizedLoad,           // memory, GQR, W. The result is the paired single loaded.
+    QuantizedStore,          // frS, GQR, W. The result is the 8 bytes of memory stored to, in memory order.
+    Load,                    // memory, EA, size, update. EA is an offset into the test buffer, and update how far rA moved.
+    Store,                   // rS, EA/size/update (see PackStoreAccess), the 8 bytes before EA, the 8 bytes after those at EA.
+                             // The result is the 8 bytes at EA. Memory is as it is afterwards, in memory order.
+    MemoryBandwidth,         // write, buffer size. The result is the read bandwidth. Both are in hundredths of a byte per cycle.
+    IntegerBinaryDigest,     // rB, initial XER, first rA, last rA. The result is the digest of every rA in between (see Digest.h).
+    FloatSingleDigest,       // first input, last input. The result is the digest of every single-precision input in between.
+    EstimateTableEntry,      // entry, -, -, mismatched steps. The result is base << 32 | dec (see EstimateTable.h).
+    IntegerChain,            // a, b, initial XER. The result is hi << 32 | lo, at the end of the chain (see IntegerChain.h).
+    IntegerState,            // rD, rA, rB (or imm), initial XER, initial CR
+    Exception,               // delivered, SRR0 - the raising instruction's address, SRR1 cause bits. FPSCR is as the handler found it.
+    InstructionBlock,        // seed, instruction count. The result is the hash of the state at the end of the block (see BlockFuzz.h).
+};
+
+// Floating-point execution mode a result was produced under.
+enum class LogMode : uint8_t
+{
+    None,
+    RoundToNearest,
+    RoundToZero,
+    RoundToPositiveInfinity,
+    RoundToNegativeInfinity,
+    InvalidOperationException,
+
+    // The floating-point mode matrix, which starts from other FPSCR states (see GetInitialFPSCR in PPCModel.h).
+    NonIEEE,
+    OverflowUnderflowEnabled,
+    ZeroDivideInexactEnabled,
+    AllExceptionsEnabled,
+    NonIEEEAllExceptionsEnabled,
+    StickyExceptions,
+    StickySummary,
+    StickyExceptionsEnabled,
+};
+
+struct LogRecord
+{
+    LogRecordType type;
+    LogForm form;
+    LogMode mode;
+    uint8_t reserved;
+    char inst[8]; // Not null-terminated when the mnemonic is 8 characters long.
+
+    uint32_t xer;
+    uint32_t fpscr;
+    uint32_t cr;
+
+    uint64_t result;      // rD or the bits of frD.
+    uint64_t operands[4]; // Inputs in the order listed by LogForm. Doubles are stored as their bits.
+};
+static_assert(sizeof(LogRecord) == 64, "Log records must stay 64 bytes in size");
+
+constexpr size_t LOG_RECORD_SIZE = sizeof(LogRecord);
+
+// Latency of an InstructionTiming record that has none (e.g. compares).
+constexpr uint64_t TIMING_NOT_MEASURED = UINT64_MAX;
+
+// Store records log memory either side of EA as well, so EA, the size and how far rA moved
+// share an operand. EA and the size are the inputs, in the lower 32 bits.
+constexpr uint64_t PackStoreAccess(uint32_t ea, uint32_t size, uint32_t update)
+{
+    return (ea & 0xFFFF) | (uint64_t{size & 0xFFFF} << 16) | (uint64_t{update} << 32);
+}
+
+constexpr uint64_t STORE_ACCESS_INPUTS = 0xFFFFFFFF;
+
+inline LogRecord MakeLogRecord(LogForm form, const char* inst, LogMode mode = LogMode::None)
+{
+    LogRecord record{};
+    record.type = LogRecordType::Result;
+    record.form = form;
+    record.mode = mode;
+    std::memcpy(record.inst, inst, strnlen(inst, sizeof(record.inst)));
+    return record;
+}
+
+inline uint64_t DoubleToBits(double value)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double BitsToDouble(uint64_t bits)
+{
+    double value = 0.0;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline float BitsToFloat(uint32_t bits)
+{
+    float value = 0.0f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// ps0 and ps1 of a paired single, for printing.
+inline double PairedSingle0(uint64_t bits)
+{
+    return BitsToFloat(static_cast<uint32_t>(bits >> 32));
+}
+
+inline double PairedSingle1(uint64_t bits)
+{
+    return BitsToFloat(static_cast<uint32_t>(bits));
+}
+
+inline uint32_t SwapBigEndian32(uint32_t value)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return __builtin_bswap32(value);
+#else
+    return value;
+#endif
+}
+
+inline uint64_t SwapBigEndian64(uint64_t value)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return __builtin_bswap64(value);
+#else
+    return value;
+#endif
+}
+
+// Converts a record between native and big-endian byte order. This is its own inverse.
+inline LogRecord SwapLogRecord(LogRecord record)
+{
+    record.xer = SwapBigEndian32(record.xer);
+    record.fpscr = SwapBigEndian32(record.fpscr);
+    record.cr = SwapBigEndian32(record.cr);
+    record.result = SwapBigEndian64(record.result);
+    for (uint64_t& operand : record.operands)
+        operand = SwapBigEndian64(operand);
+    return record;
+}
+
+inline const char* GetLogModeString(LogMode mode)
+{
+    switch (mode)
+    {
+    case LogMode::RoundToNearest:
+        return "(RTN)";
+    case LogMode::RoundToZero:
+        return "(RTZ)";
+    case LogMode::RoundToPositiveInfinity:
+        return "(RTPI)";
+    case LogMode::RoundToNegativeInfinity:
+        return "(RTNI)";
+    case LogMode::InvalidOperationException:
+        return "(VE)";
+    case LogMode::NonIEEE:
+        return "(NI)";
+    case LogMode::OverflowUnderflowEnabled:
+        return "(OEUE)";
+    case LogMode::ZeroDivideInexactEnabled:
+        return "(ZEXE)";
+    case LogMode::AllExceptionsEnabled:
+        return "(EN)";
+    case LogMode::NonIEEEAllExceptionsEnabled:
+        return "(NIEN)";
+    case LogMode::StickyExceptions:
+        return "(STKY)";
+    case LogMode::StickySummary:
+        return "(FX)";
+    case LogMode::StickyExceptionsEnabled:
+        return "(STEN)";
+    case LogMode::None:
+        break;
+    }
+
+    return "";
+}
+
+// Builds a line of text in a caller's buffer without going through printf, which spends
+// most of its time on the console parsing the format. Writes as much as fits, always
+// null-terminated, and counts the full length like snprintf.
+class LogLineWriter
+{
+public:
+    LogLineWriter(char* buffer, size_t size) : m_buffer(buffer), m_size(size)
+    {
+        if (m_size != 0)
+            m_buffer[0] = '\0';
+    }
+
+    // Returns the length of the whole line, including whatever didn't fit.
+    int Length() const { return static_cast<int>(m_length); }
+
+    LogLineWriter& Text(const char* text) { return Text(text, std::strlen(text)); }
+
+    LogLineWriter& Text(const char* text, size_t length)
+    {
+        if (m_length + length < m_size)
+        {
+            std::memcpy(&m_buffer[m_length], text, length);
+            m_length += length;
+        }
+        else
+        {
+            for (size_t i = 0; i < length; i++)
+                Put(text[i]);
+        }
+
+        return Terminate();
+    }
+
+    // Text left-justified in a field of the given width (%-*.*s).
+    LogLineWriter& TextLeft(const char* text, size_t length, size_t width)
+    {
+        Text(text, length);
+        for (size_t i = length; i < width; i++)
+            Put(' ');
+        return Terminate();
+    }
+
+    // Text right-justified in a field of the given width (%*s).
+    LogLineWriter& TextRight(const char* text, size_t width)
+    {
+        const size_t length = std::strlen(text);
+        for (size_t i = length; i < width; i++)
+            Put(' ');
+        return Text(text, length);
+    }
+
+    // Uppercase hex, zero-padded to at least the given number of digits (%0*X).
+    LogLineWriter& Hex(uint64_t value, int digits)
+    {
+        static const char hex_digits[] = "0123456789ABCDEF";
+
+        while (digits < 16 && (value >> (digits * 4)) != 0)
+            digits++;
+
+        char text[16];
+        for (int i = digits - 1; i >= 0; i--, value >>= 4)
+            text[i] = hex_digits[value & 0xF];
+        return Text(text, digits);
+    }
+
+    // Decimal, space-padded to at least the given width (%*u).
+    LogLineWriter& Decimal(uint64_t value, size_t width = 0)
+    {
+        char digits[20];
+        size_t count = 0;
+        do
+        {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+
+        for (size_t i = count; i < width; i++)
+            Put(' ');
+        while (count != 0)
+            Put(digits[--count]);
+        return Terminate();
+    }
+
+    // A count of hundredths as a decimal with two places ("%u.%02u").
+    LogLineWriter& Hundredths(uint64_t value)
+    {
+        Decimal(value / 100).Put('.');
+        Put(static_cast<char>('0' + value % 100 / 10));
+        Put(static_cast<char>('0' + value % 10));
+        return Terminate();
+    }
+
+    // Doubles still go through printf (%e), since printing them exactly takes far more than a table.
+    LogLineWriter& Float(double value)
+    {
+        char text[32];
+        const int length = snprintf(text, sizeof(text), "%e", value);
+        return Text(text, length < 0 ? 0 : static_cast<size_t>(length));
+    }
+
+    // A paired single's ps0 and ps1 ("%e,%e").
+    LogLineWriter& PairedSingle(uint64_t bits)
+    {
+        Float(PairedSingle0(bits)).Put(',');
+        return Float(PairedSingle1(bits));
+    }
+
+private:
+    LogLineWriter& Put(char c)
+    {
+        if (m_length + 1 < m_size)
+            m_buffer[m_length] = c;
+        m_length++;
+        return *this;
+    }
+
+    LogLineWriter& Terminate()
+    {
+        if (m_size != 0)
+            m_buffer[m_length < m_size ? m_length : m_size - 1] = '\0';
+        return *this;
+    }
+
+    char* m_buffer;
+    size_t m_size;
+    size_t m_length = 0;
+};
+
+// Formats a result record (in native byte order) into the text form of the test output,
+// including the trailing newline. Returns the number of characters written, like snprintf.
+inline int FormatLogRecord(const LogRecord& record, char* buffer, size_t size)
+{
+    const size_t inst_length = strnlen(record.inst, sizeof(record.inst));
+    const uint64_t* const op = record.operands;
+
+    LogLineWriter line(buffer, size);
+    if (record.mode != LogMode::None)
+        line.TextLeft(record.inst, inst_length, 8).Text(" ").TextRight(GetLogModeString(record.mode), 6).Text(" :: ");
+    else if (record.form != LogForm::ConditionRegisterBit)
+        line.TextLeft(record.inst, inst_length, 8).Text(" :: ");
+
+    switch (record.form)
+    {
+    case LogForm::IntegerUnary:
+        line.Text("rD 0x").Hex(static_cast<uint32_t>(record.result), 8).Text(" | rA 0x").Hex(static_cast<uint32_t>(op[0]), 8);
+        line.Text(" | XER: 0x").Hex(record.xer, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::IntegerBinary:
+        line.Text("rD 0x").Hex(static_cast<uint32_t>(record.result), 8).Text(" | rA 0x").Hex(static_cast<uint32_t>(op[0]), 8);
+        line.Text(" | rB 0x").Hex(static_cast<uint32_t>(op[1]), 8);
+        line.Text(" | XER: 0x").Hex(record.xer, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::IntegerImmediate:
+        line.Text("rD 0x").Hex(static_cast<uint32_t>(record.result), 8).Text(" | rA 0x").Hex(static_cast<uint32_t>(op[0]), 8);
+        line.Text(" | imm 0x").Hex(static_cast<uint32_t>(op[1]), 8);
+        line.Text(" | XER: 0x").Hex(record.xer, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::IntegerBinaryState:
+        line.Text("rD 0x").Hex(static_cast<uint32_t>(record.result), 8).Text(" | rA 0x").Hex(static_cast<uint32_t>(op[0]), 8);
+        line.Text(" | rB 0x").Hex(static_cast<uint32_t>(op[1]), 8).Text(" | XER in 0x").Hex(static_cast<uint32_t>(op[2]), 8);
+        line.Text(" | XER: 0x").Hex(record.xer, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::IntegerState:
+        line.Text("rD 0x").Hex(static_cast<uint32_t>(record.result), 8).Text(" | rA 0x").Hex(static_cast<uint32_t>(op[0]), 8);
+        line.Text(" | rB 0x").Hex(static_cast<uint32_t>(op[1]), 8).Text(" | XER in 0x").Hex(static_cast<uint32_t>(op[2]), 8);
+        line.Text(" | CR in 0x").Hex(static_cast<uint32_t>(op[3]), 8);
+        line.Text(" | XER: 0x").Hex(record.xer, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::IntegerCompare:
+        line.Text("rA 0x").Hex(static_cast<uint32_t>(op[0]), 8).Text(" | rB 0x").Hex(static_cast<uint32_t>(op[1]), 8);
+        line.Text(" | XER: 0x").Hex(record.xer, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::IntegerCompareImmediate:
+        line.Text("rA 0x").Hex(static_cast<uint32_t>(op[0]), 8).Text(" | imm 0x").Hex(static_cast<uint32_t>(op[1]), 8);
+        line.Text(" | XER: 0x").Hex(record.xer, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::IntegerRotate:
+        line.Text("rD 0x").Hex(static_cast<uint32_t>(record.result), 8).Text(" | rS 0x").Hex(static_cast<uint32_t>(op[0]), 8);
+        line.Text(" | SH 0x").Hex(static_cast<uint32_t>(op[1]), 8).Text(" | MB: 0x").Hex(static_cast<uint32_t>(op[2]), 8);
+        line.Text(" | ME: 0x").Hex(static_cast<uint32_t>(op[3]), 8);
+        line.Text(" | XER: 0x").Hex(record.xer, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::FloatUnary:
+        line.Text("frD 0x").Hex(record.result, 16).Text(" | frA ").Float(BitsToDouble(op[0]));
+        line.Text(" | FPSCR: 0x").Hex(record.fpscr, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::FloatBinary:
+        line.Text("frD 0x").Hex(record.result, 16).Text(" | frA ").Float(BitsToDouble(op[0]));
+        line.Text(" | frB ").Float(BitsToDouble(op[1]));
+        line.Text(" | FPSCR: 0x").Hex(record.fpscr, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::FloatCompare:
+        line.Text("frA ").Float(BitsToDouble(op[0])).Text(" | frB ").Float(BitsToDouble(op[1]));
+        line.Text(" | FPSCR: 0x").Hex(record.fpscr, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::FloatTernary:
+        line.Text("frD 0x").Hex(record.result, 16).Text(" | frA ").Float(BitsToDouble(op[0]));
+        line.Text(" | frC ").Float(BitsToDouble(op[1])).Text(" | frB ").Float(BitsToDouble(op[2]));
+        line.Text(" | FPSCR: 0x").Hex(record.fpscr, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::ConditionRegisterBit:
+        line.Text("     Bit ").Decimal(static_cast<uint32_t>(op[0])).Text(" ::  crA 0x").Hex(static_cast<uint32_t>(op[1]), 8);
+        line.Text(" | crB 0x").Hex(static_cast<uint32_t>(op[2]), 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::ConditionRegisterSweep:
+        line.Text("crbD ").Decimal(static_cast<uint32_t>(op[0]), 2).Text(" | crbA ").Decimal(static_cast<uint32_t>(op[1]), 2);
+        line.Text(" | crbB ").Decimal(static_cast<uint32_t>(op[2]), 2).Text(" | CR in 0x").Hex(static_cast<uint32_t>(op[3]), 8);
+        line.Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::IntegerUnaryDigest:
+        line.Text("rA 0x").Hex(static_cast<uint32_t>(op[0]), 8).Text("-0x").Hex(static_cast<uint32_t>(op[1]), 8);
+        line.Text(" | digest 0x").Hex(record.result, 16).Text("\n");
+        return line.Length();
+    case LogForm::GroupDigest:
+        line.Text("results ").Decimal(op[0]).Text("-").Decimal(op[1]).Text(" | digest 0x").Hex(record.result, 16).Text("\n");
+        return line.Length();
+    case LogForm::IntegerFieldDigest:
+        line.Text("source 0x").Hex(static_cast<uint32_t>(op[0]), 8).Text(" | rD in 0x").Hex(static_cast<uint32_t>(op[1]), 8);
+        line.Text(" | fields 0x").Hex(static_cast<uint32_t>(op[2]), 4).Text("-0x").Hex(static_cast<uint32_t>(op[3]), 4);
+        line.Text(" | digest 0x").Hex(record.result, 16).Text("\n");
+        return line.Length();
+    case LogForm::InstructionTiming:
+        if (record.result == TIMING_NOT_MEASURED)
+            line.Text("latency - | throughput ").Hundredths(op[0]).Text("\n");
+        else
+            line.Text("latency ").Hundredths(record.result).Text(" | throughput ").Hundredths(op[0]).Text("\n");
+        return line.Length();
+    case LogForm::PairedSingleUnary:
+        line.Text("frD 0x").Hex(record.result, 16).Text(" | frA ").PairedSingle(op[0]);
+        line.Text(" | FPSCR: 0x").Hex(record.fpscr, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::PairedSingleBinary:
+        line.Text("frD 0x").Hex(record.result, 16).Text(" | frA ").PairedSingle(op[0]).Text(" | frB ").PairedSingle(op[1]);
+        line.Text(" | FPSCR: 0x").Hex(record.fpscr, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::PairedSingleCompare:
+        line.Text("frA ").PairedSingle(op[0]).Text(" | frB ").PairedSingle(op[1]);
+        line.Text(" | FPSCR: 0x").Hex(record.fpscr, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::PairedSingleTernary:
+        line.Text("frD 0x").Hex(record.result, 16).Text(" | frA ").PairedSingle(op[0]).Text(" | frC ").PairedSingle(op[1]);
+        line.Text(" | frB ").PairedSingle(op[2]);
+        line.Text(" | FPSCR: 0x").Hex(record.fpscr, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::QuantizedLoad:
+        line.Text("frD 0x").Hex(record.result, 16).Text(" | mem 0x").Hex(op[0], 16);
+        line.Text(" | GQR 0x").Hex(static_cast<uint32_t>(op[1]), 8).Text(" | W ").Decimal(static_cast<uint32_t>(op[2])).Text("\n");
+        return line.Length();
+    case LogForm::QuantizedStore:
+        line.Text("stored 0x").Hex(record.result, 16).Text(" | frS ").PairedSingle(op[0]);
+        line.Text(" | GQR 0x").Hex(static_cast<uint32_t>(op[1]), 8).Text(" | W ").Decimal(static_cast<uint32_t>(op[2])).Text("\n");
+        return line.Length();
+    case LogForm::Load:
+        line.Text("rD 0x").Hex(record.result, 16).Text(" | mem 0x").Hex(op[0], 16).Text(" | EA +0x").Hex(static_cast<uint32_t>(op[1]), 4);
+        line.Text(" | size ").Decimal(static_cast<uint32_t>(op[2])).Text(" | update ").Decimal(static_cast<uint32_t>(op[3])).Text("\n");
+        return line.Length();
+    case LogForm::Store:
+        line.Text("stored 0x").Hex(record.result, 16).Text(" | before 0x").Hex(op[2], 16).Text(" | after 0x").Hex(op[3], 16);
+        line.Text(" | rS 0x").Hex(op[0], 16).Text(" | EA +0x").Hex(static_cast<uint32_t>(op[1] & 0xFFFF), 4);
+        line.Text(" | size ").Decimal(static_cast<uint32_t>((op[1] >> 16) & 0xFFFF)).Text(" | update ").Decimal(static_cast<uint32_t>(op[1] >> 32)).Text("\n");
+        return line.Length();
+    case LogForm::MemoryBandwidth:
+        line.Text("read ").Hundredths(record.result).Text(" | write ").Hundredths(op[0]).Text(" | size ").Decimal(op[1]).Text("\n");
+        return line.Length();
+    case LogForm::IntegerBinaryDigest:
+        line.Text("rB 0x").Hex(static_cast<uint32_t>(op[0]), 8).Text(" | XER in 0x").Hex(static_cast<uint32_t>(op[1]), 8);
+        line.Text(" | rA 0x").Hex(static_cast<uint32_t>(op[2]), 8).Text("-0x").Hex(static_cast<uint32_t>(op[3]), 8);
+        line.Text(" | digest 0x").Hex(record.result, 16).Text("\n");
+        return line.Length();
+    case LogForm::FloatSingleDigest:
+        line.Text("single 0x").Hex(static_cast<uint32_t>(op[0]), 8).Text("-0x").Hex(static_cast<uint32_t>(op[1]), 8);
+        line.Text(" | digest 0x").Hex(record.result, 16).Text("\n");
+        return line.Length();
+    case LogForm::EstimateTableEntry:
+        line.Text("entry ").Decimal(static_cast<uint32_t>(op[0]), 2).Text(" | base 0x").Hex(static_cast<uint32_t>(record.result >> 32), 7);
+        line.Text(" | dec 0x").Hex(static_cast<uint32_t>(record.result), 3);
+        line.Text(" | mismatched ").Decimal(static_cast<uint32_t>(op[3])).Text("\n");
+        return line.Length();
+    case LogForm::IntegerChain:
+        line.Text("rD 0x").Hex(record.result, 16).Text(" | rA 0x").Hex(op[0], 16).Text(" | rB 0x").Hex(op[1], 16);
+        line.Text(" | XER in 0x").Hex(static_cast<uint32_t>(op[2]), 8);
+        line.Text(" | XER: 0x").Hex(record.xer, 8).Text(" | CR: 0x").Hex(record.cr, 8).Text("\n");
+        return line.Length();
+    case LogForm::Exception:
+    {
+        // Logged under an output label, so self-checking builds see a change either way as a mismatch.
+        if (op[0] == 0)
+        {
+            line.Text("SRR0: undelivered\n");
+            return line.Length();
+        }
+
+        const uint32_t offset = static_cast<uint32_t>(op[1]);
+        line.Text("SRR0: site").Text((offset & 0x80000000) ? "-0x" : "+0x").Hex((offset & 0x80000000) ? 0 - offset : offset, 1);
+        line.Text(" | SRR1: 0x").Hex(static_cast<uint32_t>(op[2]), 8).Text(" | FPSCR: 0x").Hex(record.fpscr, 8).Text("\n");
+        return line.Length();
+    }
+    case LogForm::InstructionBlock:
+        line.Text("seed 0x").Hex(op[0], 16).Text(" | instructions ").Decimal(op[1]).Text(" | digest 0x").Hex(record.result, 16).Text("\n");
+        return line.Length();
+    case LogForm::FloatSweepDigest:
+        line.Text("seed 0x").Hex(op[0], 16).Text(" | vectors ").Decimal(op[1]).Text(" | digest 0x").Hex(record.result, 16).Text("\n");
+        return line.Length();
+    }
+
+    // A form this build doesn't know, e.g. from a newer log.
+    return -1;
+}
@@ -0,0 +1,444 @@
+#include "PPCModel.h"
+
+#include <strings.h>
+
+//
+// Mnemonics
+//
+
+namespace
+{
+struct MnemonicEntry
+{
+    const char* name;
+    ModelOp op;
+    ModelClass cls;
+    bool oe;
+    bool rc;
+};
+
+// Every form the tests use. The record forms of ANDI, ANDIS and ADDIC are the only way
+// to encode them, so their names always carry the dot.
+constexpr MnemonicEntry mnemonics[] = {
+#define I(name, op) {name, ModelOp::op, ModelClass::Integer, false, false}, \
+                    {name ".", ModelOp::op, ModelClass::Integer, false, true}
+#define IO(name, op) I(name, op), \
+                     {name "O", ModelOp::op, ModelClass::Integer, true, false}, \
+                     {name "O.", ModelOp::op, ModelClass::Integer, true, true}
+#define F(name, op) {name, ModelOp::op, ModelClass::FloatingPoint, false, false}, \
+                    {name ".", ModelOp::op, ModelClass::FloatingPoint, false, true}
+
+    IO("ADD", Add), IO("ADDC", Addc), IO("ADDE", Adde),
+    {"ADDI", ModelOp::Addi, ModelClass::Integer, false, false},
+    {"ADDIC", ModelOp::Addic, ModelClass::Integer, false, false},
+    {"ADDIC.", ModelOp::Addic, ModelClass::Integer, false, true},
+    {"ADDIS", ModelOp::Addis, ModelClass::Integer, false, false},
+    IO("ADDME", Addme), IO("ADDZE", Addze),
+    I("AND", And), I("ANDC", Andc),
+    {"ANDI.", ModelOp::Andi, ModelClass::Integer, false, true},
+    {"ANDIS.", ModelOp::Andis, ModelClass::Integer, false, true},
+    {"CMP", ModelOp::Cmp, ModelClass::Integer, false, false},
+    {"CMPI", ModelOp::Cmpi, ModelClass::Integer, false, false},
+    {"CMPL", ModelOp::Cmpl, ModelClass::Integer, false, false},
+    {"CMPLI", ModelOp::Cmpli, ModelClass::Integer, false, false},
+    I("CNTLZW", Cntlzw),
+    IO("DIVW", Divw), IO("DIVWU", Divwu),
+    I("EQV", Eqv), I("EXTSB", Extsb), I("EXTSH", Extsh),
+    I("MULHW", Mulhw), I("MULHWU", Mulhwu),
+    {"MULLI", ModelOp::Mulli, ModelClass::Integer, false, false},
+    IO("MULLW", Mullw),
+    I("NAND", Nand), IO("NEG", Neg), I("NOR", Nor), I("OR", Or), I("ORC", Orc),
+    {"ORI", ModelOp::Ori, ModelClass::Integer, false, false},
+    {"ORIS", ModelOp::Oris, ModelClass::Integer, false, false},
+    I("RLWIMI", Rlwimi), I("RLWINM", Rlwinm),
+    I("SLW", Slw), I("SRAW", Sraw), I("SRAWI", Srawi), I("SRW", Srw),
+    IO("SUBF", Subf), IO("SUBFC", Subfc), IO("SUBFE", Subfe),
+    {"SUBFIC", ModelOp::Subfic, ModelClass::Integer, false, false},
+    IO("SUBFME", Subfme), IO("SUBFZE", Subfze),
+    I("XOR", Xor),
+    {"XORI", ModelOp::Xori, ModelClass::Integer, false, false},
+    {"XORIS", ModelOp::Xoris, ModelClass::Integer, false, false},
+
+    {"CRAND", ModelOp::Crand, ModelClass::ConditionRegister, false, false},
+    {"CRANDC", ModelOp::Crandc, ModelClass::ConditionRegister, false, false},
+    {"CREQV", ModelOp::Creqv, ModelClass::ConditionRegister, false, false},
+    {"CRNAND", ModelOp::Crnand, ModelClass::ConditionRegister, false, false},
+    {"CRNOR", ModelOp::Crnor, ModelClass::ConditionRegister, false, false},
+    {"CROR", ModelOp::Cror, ModelClass::ConditionRegister, false, false},
+    {"CRORC", ModelOp::Crorc, ModelClass::ConditionRegister, false, false},
+    {"CRXOR", ModelOp::Crxor, ModelClass::ConditionRegister, false, false},
+
+    F("FABS", Fabs), F("FADD", Fadd), F("FADDS", Fadds),
+    {"FCMPO", ModelOp::Fcmpo, ModelClass::FloatingPoint, false, false},
+    {"FCMPU", ModelOp::Fcmpu, ModelClass::FloatingPoint, false, false},
+    F("FCTIW", Fctiw), F("FCTIWZ", Fctiwz), F("FDIV", Fdiv), F("FDIVS", Fdivs),
+    F("FMADD", Fmadd), F("FMADDS", Fmadds), F("FMSUB", Fmsub), F("FMSUBS", Fmsubs),
+    F("FMUL", Fmul), F("FMULS", Fmuls), F("FNABS", Fnabs), F("FNEG", Fneg),
+    F("FNMADD", Fnmadd), F("FNMADDS", Fnmadds), F("FNMSUB", Fnmsub), F("FNMSUBS", Fnmsubs),
+    F("FRES", Fres), F("FRSP", Frsp), F("FRSQRTE", Frsqrte), F("FSEL", Fsel),
+    F("FSUB", Fsub), F("FSUBS", Fsubs),
+
+#undef I
+#undef IO
+#undef F
+};
+} // Anonymous namespace
+
+bool DecodeModelMnemonic(const char* mnemonic, ModelInstruction* out)
+{
+    for (const MnemonicEntry& entry : mnemonics)
+    {
+        if (strcasecmp(entry.name, mnemonic) != 0)
+            continue;
+
+        *out = {entry.op, entry.cls, entry.oe, entry.rc};
+        return true;
+    }
+
+    return false;
+}
+
+//
+// Integer
+//
+
+namespace
+{
+uint32_t SignExtend16(uint32_t value)
+{
+    return static_cast<uint32_t>(static_cast<int32_t>(static_cast<int16_t>(value)));
+}
+
+uint32_t RotateLeft(uint32_t value, uint32_t amount)
+{
+    amount &= 31;
+    return amount == 0 ? value : (value << amount) | (value >> (32 - amount));
+}
+
+uint32_t RotateMask(uint32_t mb, uint32_t me)
+{
+    const uint32_t begin = 0xFFFFFFFFU >> mb;
+    const uint32_t end = me >= 31 ? 0xFFFFFFFFU : ~(0x7FFFFFFFU >> me);
+    return mb <= me ? (begin & end) : (begin | end);
+}
+
+// Returns the CR field value (LT, GT, EQ, SO) for a signed comparison.
+uint32_t CompareSigned(int32_t a, int32_t b, uint32_t xer)
+{
+    const uint32_t so = (xer & XER_SO) ? 1 : 0;
+    if (a < b)
+        return 0x8 | so;
+    if (a > b)
+        return 0x4 | so;
+    return 0x2 | so;
+}
+
+uint32_t CompareUnsigned(uint32_t a, uint32_t b, uint32_t xer)
+{
+    const uint32_t so = (xer & XER_SO) ? 1 : 0;
+    if (a < b)
+        return 0x8 | so;
+    if (a > b)
+        return 0x4 | so;
+    return 0x2 | so;
+}
+
+void SetCarry(ModelState& state, bool carry)
+{
+    if (carry)
+        state.xer |= XER_CA;
+    else
+        state.xer &= ~XER_CA;
+}
+
+void SetOverflow(ModelState& state, bool overflow)
+{
+    if (overflow)
+        state.xer |= XER_OV | XER_SO;
+    else
+        state.xer &= ~XER_OV;
+}
+
+// a + b + carry_in, updating CA.
+uint32_t AddWithCarry(ModelState& state, uint32_t a, uint32_t b, uint32_t carry_in)
+{
+    const uint64_t sum = uint64_t{a} + b + carry_in;
+    SetCarry(state, (sum >> 32) != 0);
+    return static_cast<uint32_t>(sum);
+}
+
+bool AddOverflows(uint32_t a, uint32_t b, uint32_t result)
+{
+    return ((a ^ result) & (b ^ result) & 0x80000000) != 0;
+}
+} // Anonymous namespace
+
+uint32_t ModelInteger(const ModelInstruction& inst, uint32_t rD, const uint32_t (&operands)[4], ModelState& state)
+{
+    const uint32_t a = operands[0];
+    const uint32_t b = operands[1];
+    const uint32_t ca = (state.xer & XER_CA) ? 1 : 0;
+
+    uint32_t result = rD;
+    bool overflow = false;
+
+    switch (inst.op)
+    {
+    case ModelOp::Add:
+        result = a + b;
+        overflow = AddOverflows(a, b, result);
+        break;
+    case ModelOp::Addc:
+        result = AddWithCarry(state, a, b, 0);
+        overflow = AddOverflows(a, b, result);
+        break;
+    case ModelOp::Adde:
+        result = AddWithCarry(state, a, b, ca);
+        overflow = AddOverflows(a, b, result);
+        break;
+    case ModelOp::Addi:
+        result = a + SignExtend16(b);
+        break;
+    case ModelOp::Addic:
+        result = AddWithCarry(state, a, SignExtend16(b), 0);
+        break;
+    case ModelOp::Addis:
+        result = a + (b << 16);
+        break;
+    case ModelOp::Addme:
+        result = AddWithCarry(state, a, 0xFFFFFFFF, ca);
+        overflow = AddOverflows(a, 0xFFFFFFFF, result);
+        break;
+    case ModelOp::Addze:
+        result = AddWithCarry(state, a, 0, ca);
+        overflow = AddOverflows(a, 0, result);
+        break;
+
+    case ModelOp::And:
+        result = a & b;
+        break;
+    case ModelOp::Andc:
+        result = a & ~b;
+        break;
+    case ModelOp::Andi:
+        result = a & (b & 0xFFFF);
+        break;
+    case ModelOp::Andis:
+        result = a & (b << 16);
+        break;
+
+    case ModelOp::Cmp:
+        ModelSetCRField(state.cr, 0, CompareSigned(static_cast<int32_t>(a), static_cast<int32_t>(b), state.xer));
+        return rD;
+    case ModelOp::Cmpi:
+        ModelSetCRField(state.cr, 0, CompareSigned(static_cast<int32_t>(a), static_cast<int32_t>(SignExtend16(b)), state.xer));
+        return rD;
+    case ModelOp::Cmpl:
+        ModelSetCRField(state.cr, 0, CompareUnsigned(a, b, state.xer));
+        return rD;
+    case ModelOp::Cmpli:
+        ModelSetCRField(state.cr, 0, CompareUnsigned(a, b & 0xFFFF, state.xer));
+        return rD;
+
+    case ModelOp::Cntlzw:
+        result = a == 0 ? 32 : static_cast<uint32_t>(__builtin_clz(a));
+        break;
+
+    case ModelOp::Divw:
+        if (b == 0 || (a == 0x80000000 && b == 0xFFFFFFFF))
+        {
+            // The quotient is undefined. Gekko produces -1 for negative dividends and 0 otherwise.
+            overflow = true;
+            result = (a & 0x80000000) ? 0xFFFFFFFF : 0;
+        }
+        else
+        {
+            result = static_cast<uint32_t>(static_cast<int32_t>(a) / static_cast<int32_t>(b));
+        }
+        break;
+    case ModelOp::Divwu:
+        if (b == 0)
+        {
+            overflow = true;
+            result = 0;
+        }
+        else
+        {
+            result = a / b;
+        }
+        break;
+
+    case ModelOp::Eqv:
+        result = ~(a ^ b);
+        break;
+    case ModelOp::Extsb:
+        result = static_cast<uint32_t>(static_cast<int32_t>(static_cast<int8_t>(a)));
+        break;
+    case ModelOp::Extsh:
+        result = SignExtend16(a);
+        break;
+
+    case ModelOp::Mulhw:
+        result = static_cast<uint32_t>((int64_t{static_cast<int32_t>(a)} * static_cast<int32_t>(b)) >> 32);
+        break;
+    case ModelOp::Mulhwu:
+        result = static_cast<uint32_t>((uint64_t{a} * b) >> 32);
+        break;
+    case ModelOp::Mulli:
+        result = a * SignExtend16(b);
+        break;
+    case ModelOp::Mullw:
+    {
+        const int64_t product = int64_t{static_cast<int32_t>(a)} * static_cast<int32_t>(b);
+        result = static_cast<uint32_t>(product);
+        overflow = product != static_cast<int32_t>(result);
+        break;
+    }
+
+    case ModelOp::Nand:
+        result = ~(a & b);
+        break;
+    case ModelOp::Neg:
+        result = 0 - a;
+        overflow = a == 0x80000000;
+        break;
+    case ModelOp::Nor:
+        result = ~(a | b);
+        break;
+    case ModelOp::Or:
+        result = a | b;
+        break;
+    case ModelOp::Orc:
+        result = a | ~b;
+        break;
+    case ModelOp::Ori:
+        result = a | (b & 0xFFFF);
+        break;
+    case ModelOp::Oris:
+        result = a | (b << 16);
+        break;
+
+    case ModelOp::Rlwimi:
+    {
+        const uint32_t mask = RotateMask(operands[2] & 31, operands[3] & 31);
+        result = (RotateLeft(a, b) & mask) | (rD & ~mask);
+        break;
+    }
+    case ModelOp::Rlwinm:
+        result = RotateLeft(a, b) & RotateMask(operands[2] & 31, operands[3] & 31);
+        break;
+
+    case ModelOp::Slw:
+        result = (b & 0x20) ? 0 : a << (b & 31);
+        break;
+    case ModelOp::Srw:
+        result = (b & 0x20) ? 0 : a >> (b & 31);
+        break;
+    case ModelOp::Sraw:
+    case ModelOp::Srawi:
+    {
+        const uint32_t amount = inst.op == ModelOp::Srawi ? (b & 31) : (b & 0x3F);
+        const int32_t value = static_cast<int32_t>(a);
+        if (amount >= 32)
+        {
+            result = value < 0 ? 0xFFFFFFFF : 0;
+            SetCarry(state, value < 0);
+        }
+        else
+        {
+            result = static_cast<uint32_t>(value >> amount);
+            SetCarry(state, value < 0 && amount != 0 && (a << (32 - amount)) != 0);
+        }
+        break;
+    }
+
+    case ModelOp::Subf:
+        result = b - a;
+        overflow = AddOverflows(~a, b, result);
+        break;
+    case ModelOp::Subfc:
+        result = AddWithCarry(state, ~a, b, 1);
+        overflow = AddOverflows(~a, b, result);
+        break;
+    case ModelOp::Subfe:
+        result = AddWithCarry(state, ~a, b, ca);
+        overflow = AddOverflows(~a, b, result);
+        break;
+    case ModelOp::Subfic:
+        result = AddWithCarry(state, ~a, SignExtend16(b), 1);
+        break;
+    case ModelOp::Subfme:
+        result = AddWithCarry(state, ~a, 0xFFFFFFFF, ca);
+        overflow = AddOverflows(~a, 0xFFFFFFFF, result);
+        break;
+    case ModelOp::Subfze:
+        result = AddWithCarry(state, ~a, 0, ca);
+        overflow = AddOverflows(~a, 0, result);
+        break;
+
+    case ModelOp::Xor:
+        result = a ^ b;
+        break;
+    case ModelOp::Xori:
+        result = a ^ (b & 0xFFFF);
+        break;
+    case ModelOp::Xoris:
+        result = a ^ (b << 16);
+        break;
+
+    default:
+        return rD;
+    }
+
+    if (inst.oe)
+        SetOverflow(state, overflow);
+
+    if (inst.rc)
+        ModelSetCRField(state.cr, 0, CompareSigned(static_cast<int32_t>(result), 0, state.xer));
+
+    return result;
+}
+
+//
+// Condition register logical
+//
+
+void ModelConditionRegister(const ModelInstruction& inst, uint32_t crbD, uint32_t crbA, uint32_t crbB, ModelState& state)
+{
+    const bool a = (state.cr >> (31 - (crbA & 31))) & 1;
+    const bool b = (state.cr >> (31 - (crbB & 31))) & 1;
+
+    bool d = false;
+    switch (inst.op)
+    {
+    case ModelOp::Crand:
+        d = a && b;
+        break;
+    case ModelOp::Crandc:
+        d = a && !b;
+        break;
+    case ModelOp::Creqv:
+        d = a == b;
+        break;
+    case ModelOp::Crnand:
+        d = !(a && b);
+        break;
+    case ModelOp::Crnor:
+        d = !(a || b);
+        break;
+    case ModelOp::Cror:
+        d = a || b;
+        break;
+    case ModelOp::Crorc:
+        d = a || !b;
+        break;
+    case ModelOp::Crxor:
+        d = a != b;
+        break;
+    default:
+        return;
+    }
+
+    const uint32_t bit = 0x80000000U >> (crbD & 31);
+    state.cr = d ? (state.cr | bit) : (state.cr & ~bit);
+}
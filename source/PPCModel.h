@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LogRecord.h"
+
+// Reference model of the Gekko/Broadway instructions covered by the tests.
+//
+// Every function is a pure function of its inputs: the architectural state that
+// an instruction reads (XER, CR, FPSCR) is passed in and updated in place, so the
+// model can be driven from any number of threads at once.
+//
+// The integer and CR logical parts (PPCModel.cpp) are built into both the tests and
+// the host tools, so the tests can check results as they go. The floating-point part
+// (tools/FloatModel.cpp) relies on the host's rounding modes, and is only built into
+// the host tools.
+
+enum class ModelOp : uint8_t
+{
+    // Integer
+    Add, Addc, Adde, Addi, Addic, Addis, Addme, Addze,
+    And, Andc, Andi, Andis,
+    Cmp, Cmpi, Cmpl, Cmpli,
+    Cntlzw,
+    Divw, Divwu,
+    Eqv, Extsb, Extsh,
+    Mulhw, Mulhwu, Mulli, Mullw,
+    Nand, Neg, Nor, Or, Orc, Ori, Oris,
+    Rlwimi, Rlwinm,
+    Slw, Sraw, Srawi, Srw,
+    Subf, Subfc, Subfe, Subfic, Subfme, Subfze,
+    Xor, Xori, Xoris,
+
+    // Condition register logical
+    Crand, Crandc, Creqv, Crnand, Crnor, Cror, Crorc, Crxor,
+
+    // Floating-point
+    Fabs, Fadd, Fadds, Fcmpo, Fcmpu, Fctiw, Fctiwz, Fdiv, Fdivs,
+    Fmadd, Fmadds, Fmsub, Fmsubs, Fmul, Fmuls, Fnabs, Fneg,
+    Fnmadd, Fnmadds, Fnmsub, Fnmsubs, Fres, Frsp, Frsqrte, Fsel, Fsub, Fsubs,
+};
+
+enum class ModelClass : uint8_t
+{
+    Integer,
+    ConditionRegister,
+    FloatingPoint,
+};
+
+struct ModelInstruction
+{
+    ModelOp op;
+    ModelClass cls;
+    bool oe; // Overflow enable (the O suffix)
+    bool rc; // Record (the . suffix)
+};
+
+// Decodes a mnemonic as printed by the tests (e.g. "ADDCO.", "fmadds").
+// Returns false if the mnemonic isn't modeled.
+bool DecodeModelMnemonic(const char* mnemonic, ModelInstruction* out);
+
+struct ModelState
+{
+    uint32_t cr;
+    uint32_t xer;
+    uint32_t fpscr;
+};
+
+// XER bits
+constexpr uint32_t XER_SO = 0x80000000;
+constexpr uint32_t XER_OV = 0x40000000;
+constexpr uint32_t XER_CA = 0x20000000;
+
+// Bits of XER that are actually implemented. Writes to the others are dropped.
+constexpr uint32_t XER_MASK = 0xE000FF7F;
+
+// FPSCR bits
+constexpr uint32_t FPSCR_FX     = 0x80000000;
+constexpr uint32_t FPSCR_FEX    = 0x40000000;
+constexpr uint32_t FPSCR_VX     = 0x20000000;
+constexpr uint32_t FPSCR_OX     = 0x10000000;
+constexpr uint32_t FPSCR_UX     = 0x08000000;
+constexpr uint32_t FPSCR_ZX     = 0x04000000;
+constexpr uint32_t FPSCR_XX     = 0x02000000;
+constexpr uint32_t FPSCR_VXSNAN = 0x01000000;
+constexpr uint32_t FPSCR_VXISI  = 0x00800000;
+constexpr uint32_t FPSCR_VXIDI  = 0x00400000;
+constexpr uint32_t FPSCR_VXZDZ  = 0x00200000;
+constexpr uint32_t FPSCR_VXIMZ  = 0x00100000;
+constexpr uint32_t FPSCR_VXVC   = 0x00080000;
+constexpr uint32_t FPSCR_FR     = 0x00040000;
+constexpr uint32_t FPSCR_FI     = 0x00020000;
+constexpr uint32_t FPSCR_FPRF   = 0x0001F000;
+constexpr uint32_t FPSCR_C      = 0x00010000;
+constexpr uint32_t FPSCR_FPCC   = 0x0000F000;
+constexpr uint32_t FPSCR_VXSOFT = 0x00000400;
+constexpr uint32_t FPSCR_VXSQRT = 0x00000200;
+constexpr uint32_t FPSCR_VXCVI  = 0x00000100;
+constexpr uint32_t FPSCR_VE     = 0x00000080;
+constexpr uint32_t FPSCR_OE     = 0x00000040;
+constexpr uint32_t FPSCR_UE     = 0x00000020;
+constexpr uint32_t FPSCR_ZE     = 0x00000010;
+constexpr uint32_t FPSCR_XE     = 0x00000008;
+constexpr uint32_t FPSCR_NI     = 0x00000004;
+constexpr uint32_t FPSCR_RN     = 0x00000003;
+
+constexpr uint32_t FPSCR_VX_ANY = FPSCR_VXSNAN | FPSCR_VXISI | FPSCR_VXIDI | FPSCR_VXZDZ | FPSCR_VXIMZ |
+                                  FPSCR_VXVC | FPSCR_VXSOFT | FPSCR_VXSQRT | FPSCR_VXCVI;
+
+// Whether an enabled invalid operation exception suppressed the write of frD, given the
+// FPSCR after an instruction that started with a clear FPSCR (other than the control bits).
+inline bool ModelWriteSuppressed(uint32_t fpscr)
+{
+    return (fpscr & FPSCR_VE) != 0 && (fpscr & FPSCR_VX) != 0;
+}
+
+// The FPSCR a floating-point result under a mode started from.
+inline uint32_t GetInitialFPSCR(LogMode mode)
+{
+    constexpr uint32_t enabled = FPSCR_VE | FPSCR_OE | FPSCR_UE | FPSCR_ZE | FPSCR_XE;
+    constexpr uint32_t sticky = FPSCR_OX | FPSCR_UX | FPSCR_ZX | FPSCR_XX | FPSCR_VX_ANY;
+
+    switch (mode)
+    {
+    case LogMode::RoundToZero:
+        return 1;
+    case LogMode::RoundToPositiveInfinity:
+        return 2;
+    case LogMode::RoundToNegativeInfinity:
+        return 3;
+    case LogMode::InvalidOperationException:
+        return FPSCR_VE;
+    case LogMode::NonIEEE:
+        return FPSCR_NI;
+    case LogMode::OverflowUnderflowEnabled:
+        return FPSCR_OE | FPSCR_UE;
+    case LogMode::ZeroDivideInexactEnabled:
+        return FPSCR_ZE | FPSCR_XE;
+    case LogMode::AllExceptionsEnabled:
+        return enabled;
+    case LogMode::NonIEEEAllExceptionsEnabled:
+        return FPSCR_NI | enabled;
+    case LogMode::StickyExceptions:
+        return sticky;
+    case LogMode::StickySummary:
+        return FPSCR_FX | sticky;
+    case LogMode::StickyExceptionsEnabled:
+        return sticky | enabled;
+    case LogMode::None:
+    case LogMode::RoundToNearest:
+        break;
+    }
+
+    return 0;
+}
+
+// Sets a CR field (0 = cr0) to a 4-bit value.
+inline void ModelSetCRField(uint32_t& cr, uint32_t field, uint32_t value)
+{
+    const uint32_t shift = (7 - field) * 4;
+    cr = (cr & ~(0xFU << shift)) | (value << shift);
+}
+
+// Executes an integer instruction and returns the new value of rD (or rA, for
+// instructions that write it). Compares return rD unchanged.
+//
+// operands holds the source operands in assembly order after the destination:
+//   rA/rS, then rB or the immediate (as a 32-bit value, truncated to the field width here),
+//   and for RLWIMI/RLWINM: rS, SH, MB, ME.
+// rD is the prior value of the destination, which RLWIMI reads.
+uint32_t ModelInteger(const ModelInstruction& inst, uint32_t rD, const uint32_t (&operands)[4], ModelState& state);
+
+// Executes a CR logical instruction on the given CR bit numbers (0 = MSB of CR).
+void ModelConditionRegister(const ModelInstruction& inst, uint32_t crbD, uint32_t crbA, uint32_t crbB, ModelState& state);
+
+// Executes a floating-point instruction. Values are the bit patterns of the registers.
+// Host tools only.
+//
+// operands holds the source operands in assembly order after the destination, e.g.
+//   FABS frB | FADD frA, frB | FMUL frA, frC | FMADD/FSEL frA, frC, frB | FCMPx frA, frB
+// frD is the prior value of the destination, which is returned when an enabled
+// exception suppresses the write. crfD is the CR field compares write to.
+uint64_t ModelFloat(const ModelInstruction& inst, uint64_t frD, const uint64_t (&operands)[3], uint32_t crfD, ModelState& state);
+
+// Results of FRES and FRSQRTE for a value, under a clear FPSCR. Host tools only.
+uint64_t ModelReciprocalEstimate(uint64_t value);
+uint64_t ModelReciprocalSqrtEstimate(uint64_t value);
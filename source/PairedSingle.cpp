@@ -0,0 +1,585 @@
+#ifdef GEKKO
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+#include "Log.h"
+#include "Tests.h"
+
+// Paired-single arithmetic and quantized load/store tests.
+//
+// Paired singles only exist on Gekko and Broadway, and need HID2[PSE] and HID2[LSQE] set,
+// which libogc does at startup. Operands are loaded into both halves of a register with
+// psq_l through GQR0, and results are stored with psq_st through it, so GQR0 is kept at 0
+// (singles, unscaled) while the tests run. The quantized load/store tests convert through GQR1.
+//
+// The log only has room for 8 characters of mnemonic, so results are logged with the PS_
+// prefix shortened to P (PS_MADDS0. logs as PMADDS0.).
+
+#define SINGLE_SNAN std::numeric_limits<float>::signaling_NaN()
+#define SINGLE_QNAN std::numeric_limits<float>::quiet_NaN()
+
+static void CleanTestState()
+{
+    ClearFPSCR();
+    SetCR(0);
+}
+
+// ps0 and ps1 as they're laid out in memory by psq_st with GQR0.
+struct alignas(8) PSPair
+{
+    float ps0;
+    float ps1;
+};
+
+// The target is big-endian, so ps0 ends up in the upper half.
+static uint64_t PairBits(const PSPair& pair)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &pair, sizeof(bits));
+    return bits;
+}
+
+// Like the floating-point tests, the paired-single tests are table driven.
+// Each instruction gets one function containing its inline asm,
+// and the operands are plain data.
+
+struct PSResult
+{
+    uint64_t frD;
+    uint32_t fpscr;
+    uint32_t cr;
+};
+
+// Note that operands are ordered frA, frB, frC regardless of
+// the order the instruction's assembly syntax takes them in.
+struct PSVector
+{
+    PSPair frA;
+    PSPair frB = {};
+    PSPair frC = {};
+};
+
+// Executes an instruction under the given rounding mode or TEST_MODE_* value.
+using PSTestFunc = PSResult (*)(uint32_t mode, const PSVector& vector);
+
+// Determines how a test's operands are interpreted and printed.
+enum class PSForm
+{
+    Unary,       // e.g. PS_ABS frD, frB
+    Binary,      // e.g. PS_MERGE00 frD, frA, frB
+    BinaryRound, // e.g. PS_ADD frD, frA, frB, in every rounding mode
+    Compare,     // e.g. PS_CMPU0 cr1, frA, frB
+    Select,      // e.g. PS_SEL frD, frA, frC, frB
+    FusedRound,  // e.g. PS_MADD frD, frA, frC, frB, in every rounding mode
+};
+
+struct PSTest
+{
+    const char* inst;
+    PSForm form;
+    PSTestFunc func;
+    const PSVector* vectors;
+    size_t num_vectors;
+};
+
+// Common body for test functions. frD starts out as a pair of zeros, so a result
+// that isn't written (e.g. with invalid operation exceptions enabled) shows up as such.
+#define PS_FUNC_BODY(inst, operands)                                                      \
+    PSResult result{};                                                                    \
+    PSPair out{};                                                                         \
+    double frD, frA, frB, frC;                                                            \
+                                                                                          \
+    CleanTestState();                                                                     \
+    if (mode == TEST_MODE_VE)                                                             \
+        EnableInvalidOperationExceptions();                                               \
+    else if (mode != TEST_MODE_DEFAULT)                                                   \
+        SetRoundingMode(mode);                                                            \
+                                                                                          \
+    asm volatile (                                                                        \
+        "psq_l %[frD], 0(%[out]), 0, 0\n"                                                 \
+        "psq_l %[frA], 0(%[a]), 0, 0\n"                                                   \
+        "psq_l %[frB], 0(%[b]), 0, 0\n"                                                   \
+        "psq_l %[frC], 0(%[c]), 0, 0\n"                                                   \
+        inst " " operands "\n"                                                            \
+        "psq_st %[frD], 0(%[out]), 0, 0\n"                                                \
+        : [frD]"=&f"(frD), [frA]"=&f"(frA), [frB]"=&f"(frB), [frC]"=&f"(frC)              \
+        : [out]"b"(&out), [a]"b"(&vector.frA), [b]"b"(&vector.frB), [c]"b"(&vector.frC)  \
+        : "memory", "cr1");                                                               \
+                                                                                          \
+    result.frD = PairBits(out);                                                           \
+    result.fpscr = GetFPSCR();                                                            \
+    result.cr = GetCR();                                                                  \
+    return result;
+
+#define PS_FUNC(inst, operands)                         \
+    [](uint32_t mode, const PSVector& vector) {         \
+        PS_FUNC_BODY(inst, operands)                    \
+    }
+
+// Multiplies take frC as their second operand. It's logged as frB, like FMUL's.
+#define PS_UNARY_OPERANDS   "%[frD], %[frA]"
+#define PS_BINARY_OPERANDS  "%[frD], %[frA], %[frB]"
+#define PS_COMPARE_OPERANDS "cr1, %[frA], %[frB]"
+#define PS_TERNARY_OPERANDS "%[frD], %[frA], %[frC], %[frB]"
+
+// Table entries.
+#define PS_UNARY_TEST(name, inst, vectors) \
+    {name, PSForm::Unary, PS_FUNC(inst, PS_UNARY_OPERANDS), std::data(vectors), std::size(vectors)}
+#define PS_BINARY_TEST(name, inst, vectors) \
+    {name, PSForm::Binary, PS_FUNC(inst, PS_BINARY_OPERANDS), std::data(vectors), std::size(vectors)}
+#define PS_BINARY_ROUND_TEST(name, inst, vectors) \
+    {name, PSForm::BinaryRound, PS_FUNC(inst, PS_BINARY_OPERANDS), std::data(vectors), std::size(vectors)}
+#define PS_COMPARE_TEST(name, inst, vectors) \
+    {name, PSForm::Compare, PS_FUNC(inst, PS_COMPARE_OPERANDS), std::data(vectors), std::size(vectors)}
+#define PS_SELECT_TEST(name, inst, vectors) \
+    {name, PSForm::Select, PS_FUNC(inst, PS_TERNARY_OPERANDS), std::data(vectors), std::size(vectors)}
+#define PS_FUSED_ROUND_TEST(name, inst, vectors) \
+    {name, PSForm::FusedRound, PS_FUNC(inst, PS_TERNARY_OPERANDS), std::data(vectors), std::size(vectors)}
+
+//
+// Operand tables
+//
+// ps0 and ps1 differ in most vectors, so results that mix up the two halves stand out.
+//
+
+static constexpr PSVector ps_move_vectors[] = {
+    {{0.0f, -0.0f}},
+    {{1.0f, -2.0f}},
+    {{FLT_MIN, -1e-40f}},
+    {{FLT_MAX, -FLT_MAX}},
+    {{INFINITY, -INFINITY}},
+    {{SINGLE_QNAN, SINGLE_SNAN}},
+    {{SINGLE_SNAN, -1.0f}},
+};
+
+static constexpr PSVector ps_estimate_vectors[] = {
+    {{0.0f, -0.0f}},
+    {{1.0f, 4.0f}},
+    {{-1.0f, 0.25f}},
+    {{3.0f, 100.0f}},
+    {{7.3233339282f, 420.0f}},
+    {{1e-40f, FLT_MIN}},
+    {{FLT_MAX, -FLT_MAX}},
+    {{INFINITY, -INFINITY}},
+    {{SINGLE_QNAN, SINGLE_SNAN}},
+    {{SINGLE_SNAN, 2.0f}},
+};
+
+static constexpr PSVector ps_add_vectors[] = {
+    {{0.0f, -0.0f}, {0.0f, -0.0f}},
+    {{0.5f, 1.0f}, {0.5f, 3.5f}},
+    {{1.0f, 16777216.0f}, {5.96046448e-08f, 1.0f}}, // Exactly halfway between two singles
+    {{1e-40f, FLT_MIN}, {1e-40f, -FLT_MIN}},
+    {{FLT_MAX, -FLT_MAX}, {FLT_MAX, -FLT_MAX}},
+    {{FLT_MAX, 1.0f}, {-FLT_MAX, -1.0f}},
+    {{SINGLE_SNAN, 1.0f}, {INFINITY, SINGLE_QNAN}},
+    {{SINGLE_QNAN, INFINITY}, {1.0f, -INFINITY}},
+    {{INFINITY, -INFINITY}, {INFINITY, -INFINITY}},
+    {{INFINITY, -INFINITY}, {-INFINITY, INFINITY}},
+};
+
+static constexpr PSVector ps_mul_vectors[] = {
+    {{0.0f, -0.0f}, {-0.0f, 0.0f}},
+    {{0.0f, INFINITY}, {INFINITY, 0.0f}},
+    {{5.0f, 0.25f}, {5.0f, 0.35f}},
+    {{2.99999998f, 3.0f}, {6.88823921f, 1.0f / 3.0f}},
+    {{FLT_MAX, FLT_MIN}, {2.0f, 0.5f}},
+    {{1e-20f, -1e-20f}, {1e-20f, 1e-20f}},
+    {{5.0f, INFINITY}, {SINGLE_QNAN, SINGLE_SNAN}},
+    {{SINGLE_SNAN, -INFINITY}, {5.0f, SINGLE_QNAN}},
+};
+
+static constexpr PSVector ps_div_vectors[] = {
+    {{0.0f, -0.0f}, {0.0f, 0.0f}},
+    {{1.0f, -1.0f}, {0.0f, -0.0f}},
+    {{10.0f, 1.0f}, {5.0f, 3.0f}},
+    {{4.9359998704f, 2.4679999352f}, {2.4679999352f, 4.9359998704f}},
+    {{FLT_MIN, FLT_MAX}, {FLT_MAX, FLT_MIN}},
+    {{INFINITY, -INFINITY}, {INFINITY, 2.0f}},
+    {{SINGLE_SNAN, SINGLE_QNAN}, {SINGLE_QNAN, SINGLE_SNAN}},
+};
+
+// Also used for PS_SUM0/PS_SUM1, which add across the halves.
+static constexpr PSVector ps_madd_vectors[] = {
+    {{1.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 1.0f}},
+    {{5.5f, -5.5f}, {5.5f, 5.5f}, {5.5f, 5.5f}},
+    {{7.3233339282f, 3.5f}, {7.9999999234f, 1.0f}, {3.5f, 2.0f}},
+    {{1.0f, 16777216.0f}, {5.96046448e-08f, 1.0f}, {1.0f, 1.0f}},
+    {{FLT_MAX, 2.0f}, {-FLT_MAX, 1.0f}, {2.0f, FLT_MAX}},
+    {{1.0f, 0.0f}, {-INFINITY, INFINITY}, {INFINITY, INFINITY}},
+    {{1.0f, SINGLE_SNAN}, {SINGLE_QNAN, 1.0f}, {1.0f, 1.0f}},
+    {{INFINITY, 1.0f}, {1.0f, -INFINITY}, {SINGLE_SNAN, 1.0f}},
+};
+
+static constexpr PSVector ps_sel_vectors[] = {
+    {{0.0f, -0.0f}, {1.0f, 2.0f}, {3.0f, 4.0f}},
+    {{10.0f, -10.0f}, {100.0f, 100.0f}, {50.0f, 50.0f}},
+    {{1e-40f, -1e-40f}, {2.0f, 2.0f}, {1.0f, 1.0f}},
+    {{SINGLE_QNAN, SINGLE_SNAN}, {2.0f, 2.0f}, {1.0f, 1.0f}},
+    {{INFINITY, -INFINITY}, {-INFINITY, INFINITY}, {INFINITY, -INFINITY}},
+};
+
+static constexpr PSVector ps_cmp_vectors[] = {
+    {{0.0f, 1.0f}, {0.0f, 0.0f}},
+    {{1.0f, 0.0f}, {0.0f, 1.0f}},
+    {{1.0f, 2.0f}, {2.0f, 1.0f}},
+    {{0.0f, -0.0f}, {-0.0f, 0.0f}},
+    {{SINGLE_QNAN, 1.0f}, {1.0f, SINGLE_QNAN}},
+    {{SINGLE_SNAN, 1.0f}, {1.0f, SINGLE_SNAN}},
+    {{INFINITY, -INFINITY}, {INFINITY, INFINITY}},
+};
+
+//
+// Test tables
+//
+
+static constexpr PSTest ps_add_tests[] = {
+    PS_BINARY_ROUND_TEST("PADD", "ps_add", ps_add_vectors),
+    PS_BINARY_ROUND_TEST("PADD.", "ps_add.", ps_add_vectors),
+    PS_BINARY_ROUND_TEST("PSUB", "ps_sub", ps_add_vectors),
+    PS_BINARY_ROUND_TEST("PSUB.", "ps_sub.", ps_add_vectors),
+};
+
+static constexpr PSTest ps_mul_tests[] = {
+    PS_BINARY_ROUND_TEST("PMUL", "ps_mul", ps_mul_vectors),
+    PS_BINARY_ROUND_TEST("PMUL.", "ps_mul.", ps_mul_vectors),
+    PS_BINARY_ROUND_TEST("PMULS0", "ps_muls0", ps_mul_vectors),
+    PS_BINARY_ROUND_TEST("PMULS0.", "ps_muls0.", ps_mul_vectors),
+    PS_BINARY_ROUND_TEST("PMULS1", "ps_muls1", ps_mul_vectors),
+    PS_BINARY_ROUND_TEST("PMULS1.", "ps_muls1.", ps_mul_vectors),
+};
+
+static constexpr PSTest ps_div_tests[] = {
+    PS_BINARY_ROUND_TEST("PDIV", "ps_div", ps_div_vectors),
+    PS_BINARY_ROUND_TEST("PDIV.", "ps_div.", ps_div_vectors),
+};
+
+static constexpr PSTest ps_madd_tests[] = {
+    PS_FUSED_ROUND_TEST("PMADD", "ps_madd", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PMADD.", "ps_madd.", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PMADDS0", "ps_madds0", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PMADDS0.", "ps_madds0.", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PMADDS1", "ps_madds1", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PMADDS1.", "ps_madds1.", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PMSUB", "ps_msub", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PMSUB.", "ps_msub.", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PNMADD", "ps_nmadd", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PNMADD.", "ps_nmadd.", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PNMSUB", "ps_nmsub", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PNMSUB.", "ps_nmsub.", ps_madd_vectors),
+};
+
+static constexpr PSTest ps_sum_tests[] = {
+    PS_FUSED_ROUND_TEST("PSUM0", "ps_sum0", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PSUM0.", "ps_sum0.", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PSUM1", "ps_sum1", ps_madd_vectors),
+    PS_FUSED_ROUND_TEST("PSUM1.", "ps_sum1.", ps_madd_vectors),
+};
+
+static constexpr PSTest ps_estimate_tests[] = {
+    PS_UNARY_TEST("PRES", "ps_res", ps_estimate_vectors),
+    PS_UNARY_TEST("PRES.", "ps_res.", ps_estimate_vectors),
+    PS_UNARY_TEST("PRSQRTE", "ps_rsqrte", ps_estimate_vectors),
+    PS_UNARY_TEST("PRSQRTE.", "ps_rsqrte.", ps_estimate_vectors),
+};
+
+static constexpr PSTest ps_move_tests[] = {
+    PS_UNARY_TEST("PABS", "ps_abs", ps_move_vectors),
+    PS_UNARY_TEST("PABS.", "ps_abs.", ps_move_vectors),
+    PS_UNARY_TEST("PMR", "ps_mr", ps_move_vectors),
+    PS_UNARY_TEST("PMR.", "ps_mr.", ps_move_vectors),
+    PS_UNARY_TEST("PNABS", "ps_nabs", ps_move_vectors),
+    PS_UNARY_TEST("PNABS.", "ps_nabs.", ps_move_vectors),
+    PS_UNARY_TEST("PNEG", "ps_neg", ps_move_vectors),
+    PS_UNARY_TEST("PNEG.", "ps_neg.", ps_move_vectors),
+};
+
+// The record forms (PS_MERGE00.) don't fit in the log's mnemonic field. Since merges
+// don't change the FPSCR, they'd only repeat the other record forms' CR results.
+static constexpr PSTest ps_merge_tests[] = {
+    PS_BINARY_TEST("PMERGE00", "ps_merge00", ps_add_vectors),
+    PS_BINARY_TEST("PMERGE01", "ps_merge01", ps_add_vectors),
+    PS_BINARY_TEST("PMERGE10", "ps_merge10", ps_add_vectors),
+    PS_BINARY_TEST("PMERGE11", "ps_merge11", ps_add_vectors),
+};
+
+static constexpr PSTest ps_sel_tests[] = {
+    PS_SELECT_TEST("PSEL", "ps_sel", ps_sel_vectors),
+    PS_SELECT_TEST("PSEL.", "ps_sel.", ps_sel_vectors),
+};
+
+static constexpr PSTest ps_cmp_tests[] = {
+    PS_COMPARE_TEST("PCMPO0", "ps_cmpo0", ps_cmp_vectors),
+    PS_COMPARE_TEST("PCMPO1", "ps_cmpo1", ps_cmp_vectors),
+    PS_COMPARE_TEST("PCMPU0", "ps_cmpu0", ps_cmp_vectors),
+    PS_COMPARE_TEST("PCMPU1", "ps_cmpu1", ps_cmp_vectors),
+};
+
+static LogForm GetLogForm(PSForm form)
+{
+    switch (form)
+    {
+    case PSForm::Unary:
+        return LogForm::PairedSingleUnary;
+    case PSForm::Binary:
+    case PSForm::BinaryRound:
+        return LogForm::PairedSingleBinary;
+    case PSForm::Compare:
+        return LogForm::PairedSingleCompare;
+    case PSForm::Select:
+    case PSForm::FusedRound:
+        break;
+    }
+
+    return LogForm::PairedSingleTernary;
+}
+
+static void LogPSResult(const PSTest& test, LogMode mode, const PSVector& vector, const PSResult& result)
+{
+    LogRecord record = MakeLogRecord(GetLogForm(test.form), test.inst, mode);
+    record.result = result.frD;
+    record.fpscr = result.fpscr;
+    record.cr = result.cr;
+    record.operands[0] = PairBits(vector.frA);
+
+    // Operands are logged in the order the instruction takes them.
+    if (record.form == LogForm::PairedSingleTernary)
+    {
+        record.operands[1] = PairBits(vector.frC);
+        record.operands[2] = PairBits(vector.frB);
+    }
+    else if (record.form != LogForm::PairedSingleUnary)
+    {
+        record.operands[1] = PairBits(vector.frB);
+    }
+
+    LogResult(record);
+}
+
+static void RunTest(const PSTest& test, const PSVector& vector)
+{
+    const auto run = [&](uint32_t mode) {
+        return test.func(mode, vector);
+    };
+
+    switch (test.form)
+    {
+    case PSForm::Compare:
+    case PSForm::Select:
+        LogPSResult(test, LogMode::None, vector, run(TEST_MODE_DEFAULT));
+        return;
+
+    case PSForm::Unary:
+    case PSForm::Binary:
+        LogPSResult(test, LogMode::None, vector, run(TEST_MODE_DEFAULT));
+        break;
+
+    case PSForm::BinaryRound:
+    case PSForm::FusedRound:
+        for (uint32_t i = 0; i <= 3; i++)
+        {
+            const auto mode = static_cast<LogMode>(static_cast<uint32_t>(LogMode::RoundToNearest) + i);
+            LogPSResult(test, mode, vector, run(i));
+        }
+        break;
+    }
+
+    // Test with invalid exceptions enabled
+    LogPSResult(test, LogMode::InvalidOperationException, vector, run(TEST_MODE_VE));
+}
+
+template <size_t N>
+static void RunTests(const PSTest (&tests)[N])
+{
+    for (const PSTest& test : tests)
+    {
+        for (size_t i = 0; i < test.num_vectors; i++)
+            RunTest(test, test.vectors[i]);
+    }
+}
+
+//
+// Quantized loads and stores
+//
+// Every type and scale of GQR1 is tested, with W (a single value) at scale 0. Types
+// 1-3 are reserved, and are included to see what the hardware does with them.
+//
+
+constexpr uint32_t GQR_TYPE_COUNT = 8;
+constexpr uint32_t GQR_SCALE_COUNT = 64;
+
+// Memory loaded, first byte first. Depending on the type, each is read as two singles,
+// two 16-bit values or two 8-bit values.
+static constexpr uint64_t quantized_load_vectors[] = {
+    0x3F800000C0000000, // 1.0, -2.0
+    0x807F01FF80007FFF,
+    0x7F800001FF800000, // Signaling NaN, -infinity
+    0x00000001807FFFFF, // Denormals
+    0xFFFEFDFC12345678,
+};
+
+static constexpr PSPair quantized_store_vectors[] = {
+    {1.0f, -2.0f},
+    {0.5f, 127.75f},
+    {255.0f, -1.5f},
+    {65535.5f, -32768.0f},
+    {1e10f, -1e10f}, // Out of range of every integer type
+    {1e-40f, INFINITY},
+    {SINGLE_QNAN, -0.0f},
+};
+
+// Returns the loaded pair, as stored through GQR0. With W set, ps1 is loaded as 1.0.
+static uint64_t QuantizedLoad(uint64_t memory, bool w)
+{
+    alignas(8) const uint64_t source = memory;
+    PSPair out{};
+    double frD;
+
+    if (w)
+    {
+        asm volatile ("psq_l %[frD], 0(%[source]), 1, 1\n"
+                      "psq_st %[frD], 0(%[out]), 0, 0\n"
+                      : [frD]"=&f"(frD) : [source]"b"(&source), [out]"b"(&out) : "memory");
+    }
+    else
+    {
+        asm volatile ("psq_l %[frD], 0(%[source]), 0, 1\n"
+                      "psq_st %[frD], 0(%[out]), 0, 0\n"
+                      : [frD]"=&f"(frD) : [source]"b"(&source), [out]"b"(&out) : "memory");
+    }
+
+    return PairBits(out);
+}
+
+// Returns the 8 bytes of memory stored to. They start out as 0xCC, so bytes
+// that aren't stored (e.g. ps1 with W set) stand out.
+static uint64_t QuantizedStore(const PSPair& value, bool w)
+{
+    alignas(8) uint64_t destination = 0xCCCCCCCCCCCCCCCC;
+    double frS;
+
+    if (w)
+    {
+        asm volatile ("psq_l %[frS], 0(%[value]), 0, 0\n"
+                      "psq_st %[frS], 0(%[destination]), 1, 1\n"
+                      : [frS]"=&f"(frS) : [value]"b"(&value), [destination]"b"(&destination) : "memory");
+    }
+    else
+    {
+        asm volatile ("psq_l %[frS], 0(%[value]), 0, 0\n"
+                      "psq_st %[frS], 0(%[destination]), 0, 1\n"
+                      : [frS]"=&f"(frS) : [value]"b"(&value), [destination]"b"(&destination) : "memory");
+    }
+
+    return destination;
+}
+
+static void RunQuantizedLoadTests()
+{
+    for (uint32_t type = 0; type < GQR_TYPE_COUNT; type++)
+    {
+        for (uint32_t scale = 0; scale < GQR_SCALE_COUNT; scale++)
+        {
+            const uint32_t gqr = MakeGQR(type, scale, 0, 0);
+            SetGQR1(gqr);
+
+            for (uint32_t w = 0; w <= (scale == 0 ? 1U : 0U); w++)
+            {
+                for (const uint64_t memory : quantized_load_vectors)
+                {
+                    CleanTestState();
+
+                    LogRecord record = MakeLogRecord(LogForm::QuantizedLoad, "PSQ_L");
+                    record.result = QuantizedLoad(memory, w != 0);
+                    record.operands[0] = memory;
+                    record.operands[1] = gqr;
+                    record.operands[2] = w;
+                    LogResult(record);
+                }
+            }
+        }
+    }
+}
+
+static void RunQuantizedStoreTests()
+{
+    for (uint32_t type = 0; type < GQR_TYPE_COUNT; type++)
+    {
+        for (uint32_t scale = 0; scale < GQR_SCALE_COUNT; scale++)
+        {
+            const uint32_t gqr = MakeGQR(0, 0, type, scale);
+            SetGQR1(gqr);
+
+            for (uint32_t w = 0; w <= (scale == 0 ? 1U : 0U); w++)
+            {
+                for (const PSPair& value : quantized_store_vectors)
+                {
+                    CleanTestState();
+
+                    LogRecord record = MakeLogRecord(LogForm::QuantizedStore, "PSQ_ST");
+                    record.result = QuantizedStore(value, w != 0);
+                    record.operands[0] = PairBits(value);
+                    record.operands[1] = gqr;
+                    record.operands[2] = w;
+                    LogResult(record);
+                }
+            }
+        }
+    }
+}
+
+void PPCPairedSingleTests()
+{
+    // The GQRs belong to whatever else runs, so they're put back afterwards.
+    const uint32_t saved_gqr0 = GetGQR0();
+    const uint32_t saved_gqr1 = GetGQR1();
+    SetGQR0(0);
+
+    printf("\n\nPaired-Single Tests\n\n");
+
+    printf("PS_ADD Variants\n");
+    RunTests(ps_add_tests);
+
+    printf("\nPS_CMP Variants\n");
+    RunTests(ps_cmp_tests);
+
+    printf("\nPS_DIV Variants\n");
+    RunTests(ps_div_tests);
+
+    printf("\nPS_MADD Variants\n");
+    RunTests(ps_madd_tests);
+
+    printf("\nPS_MERGE Variants\n");
+    RunTests(ps_merge_tests);
+
+    printf("\nPS_MOVE Variants\n");
+    RunTests(ps_move_tests);
+
+    printf("\nPS_MUL Variants\n");
+    RunTests(ps_mul_tests);
+
+    printf("\nPS_RES Variants\n");
+    RunTests(ps_estimate_tests);
+
+    printf("\nPS_SEL Variants\n");
+    RunTests(ps_sel_tests);
+
+    printf("\nPS_SUM Variants\n");
+    RunTests(ps_sum_tests);
+
+    printf("\nPSQ_L Variants\n");
+    RunQuantizedLoadTests();
+
+    printf("\nPSQ_ST Variants\n");
+    RunQuantizedStoreTests();
+
+    SetGQR1(saved_gqr1);
+    SetGQR0(saved_gqr0);
+}
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// Services the tests need from the system they run on.
+//
+// The tests themselves only depend on the CPU. Each platform (platform/wii, platform/linux)
+// implements these alongside its main(), which redirects stdout into the log (see Log.h)
+// and calls RunAllTests().
+
+// Allocates memory that generated code can be written to and executed from. The memory
+// is aligned to a cache line, so a flush of it never touches anything else.
+void* PlatformAllocateCode(size_t size);
+
+// Makes instructions written to memory through the data cache visible to instruction fetch.
+void PlatformSyncCode(void* start, size_t size);
+
+// Core clock cycles per tick of the timebase (mftb), for converting benchmark times.
+uint32_t PlatformCyclesPerTimebaseTick();
+
+// A block of memory, seen through one of its mappings.
+struct PlatformMemoryRegion
+{
+    const char* name; // Logged as a mnemonic, so up to 8 characters and no spaces.
+    void* memory;
+    size_t size;
+};
+
+// Allocates the memory the bandwidth benchmark measures (each kind of memory, through its
+// cached and uncached mappings if it has both), sets *regions to it and returns the count.
+size_t PlatformGetMemoryRegions(const PlatformMemoryRegion** regions);
+
+// The log is collected in blocks of PLATFORM_LOG_BLOCK_SIZE bytes, which the platform writes
+// to the log file while the tests carry on, rather than the tests waiting on every write.
+constexpr size_t PLATFORM_LOG_BLOCK_SIZE = 256 * 1024;
+
+// Starts writing the log to file, which stays open until after PlatformStopLogWriter.
+void PlatformStartLogWriter(FILE* file);
+
+// Returns an empty block, waiting for one to be written out if they're all in use.
+uint8_t* PlatformGetLogBlock();
+
+// Queues the first size bytes of a block from PlatformGetLogBlock to be written.
+void PlatformWriteLogBlock(uint8_t* block, size_t size);
+
+// Waits for every queued block to be written.
+void PlatformStopLogWriter();
+
+// Exceptions the exception tests raise on purpose.
+enum class PlatformException
+{
+    Program,                  // An illegal instruction or a trap.
+    FloatingPointEnabled,     // An enabled FPSCR exception, with MSR[FE0/FE1] set for precise mode.
+    FloatingPointUnavailable, // A floating-point instruction with MSR[FP] clear.
+    Alignment,                // e.g. LWARX at an address that isn't word-aligned.
+};
+
+// Filled in by the code that raises an exception: the address of the instruction that
+// raises it, and the lower timebase just before it and once execution is back after it.
+struct PlatformExceptionSite
+{
+    uint32_t address;
+    uint32_t before;
+    uint32_t after;
+};
+
+using PlatformRaiseFunc = void (*)(PlatformExceptionSite* site);
+
+// What the handler found when the exception was delivered.
+struct PlatformExceptionState
+{
+    uint32_t srr0;
+    uint32_t srr1;     // Where the platform can't see SRR1, its cause bits are worked out from what it can see.
+    uint32_t fpscr;
+    uint32_t timebase; // Lower timebase on entry to the handler.
+};
+
+// Calls raise with a handler for the exception in place, and with MSR[FE0/FE1] set or MSR[FP]
+// clear for the floating-point ones. The handler records its state and resumes after the
+// raising instruction, or, for FloatingPointUnavailable, sets MSR[FP] and retries it. Returns
+// false if the exception wasn't delivered, or the platform can't catch it.
+bool PlatformCatchException(PlatformException exception, PlatformRaiseFunc raise, PlatformExceptionSite* site,
+                            PlatformExceptionState* state);
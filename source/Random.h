@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+// Seeded xorshift64* generator, for tests that generate their own vectors.
+// Shared with the host tools, so a seed produces the same vectors everywhere.
+class Random
+{
+public:
+    explicit Random(uint64_t seed) : m_state(seed != 0 ? seed : 0x9E3779B97F4A7C15) {}
+
+    uint64_t Next()
+    {
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 0x2545F4914F6CDD1D;
+    }
+
+private:
+    uint64_t m_state;
+};
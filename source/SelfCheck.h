@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Digest.h"
+
+// Self-checking builds (make SELF_CHECK=1) compare every result on the console against an
+// expected result compiled into the build, and only log the ones that differ, along with a
+// summary and a pass/fail bitmap of the groups (see Log.cpp). tools/expectgen produces the
+// expected results from a reference log, text or binary, such as the console log in binary/.
+//
+// Results are matched up by their text rather than by position, so a reference still
+// applies after tests are added or reordered. Each result line is split into what
+// identifies it (the section header it's under, the mnemonic and mode before "::", and
+// its input fields) and what it produced (its output fields, by label). Each half is
+// hashed, 64 bits for the key and 32 for the value, so an expected result takes 12 bytes.
+// Runs of spaces are ignored, since the padding is only there to line up columns.
+//
+// The same key can come up more than once, since operands printed with %e (NaNs in
+// particular) don't tell every input apart. Those are matched up in the order they were
+// logged: the expected results are sorted by key, keeping that order within each key.
+//
+// This header is shared with the host tools.
+
+// Text lines without a colon name the results that follow them ("ADD Variants"). Lines
+// with one report something themselves ("addo: Resulting XER: 0x..."), as do results.
+inline bool IsSelfCheckHeader(const char* line, size_t length)
+{
+    bool blank = true;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (line[i] == ':')
+            return false;
+        if (line[i] != ' ' && line[i] != '\t' && line[i] != '\r' && line[i] != '\n')
+            blank = false;
+    }
+
+    return !blank;
+}
+
+inline bool IsSelfCheckResult(const char* line, size_t length)
+{
+    for (size_t i = 0; i + 4 <= length; i++)
+    {
+        if (std::memcmp(&line[i], " :: ", 4) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+// Fields whose values the instruction produced, rather than chose.
+inline bool IsSelfCheckOutputLabel(const char* label, size_t length)
+{
+    static const char* const labels[] = {
+        "rD", "frD", "XER", "FPSCR", "CR", "digest", "stored", "before", "after", "update", "base", "dec", "mismatched",
+        "latency", "throughput", "read", "write", "SRR0", "SRR1",
+    };
+
+    for (const char* output : labels)
+    {
+        if (std::strlen(output) == length && std::memcmp(output, label, length) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+// Adds text to a digest with leading and trailing spaces dropped, and other runs of them
+// reduced to one, followed by a terminator so neighbouring fields can't run together.
+inline void AddSelfCheckText(ResultDigest& digest, const char* begin, const char* end)
+{
+    const auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+
+    while (begin != end && is_space(*begin))
+        begin++;
+    while (end != begin && is_space(end[-1]))
+        end--;
+
+    for (const char* p = begin; p != end; p++)
+    {
+        if (is_space(*p) && is_space(p[1]))
+            continue;
+        digest.Add(is_space(*p) ? ' ' : static_cast<unsigned char>(*p));
+    }
+
+    digest.Add(0x100);
+}
+
+inline uint64_t HashSelfCheckHeader(const char* line, size_t length)
+{
+    ResultDigest digest;
+    AddSelfCheckText(digest, line, line + length);
+    return digest.Finish();
+}
+
+// Splits a result line ("INST     :: label 0x... | label: 0x... | ...") under the given
+// header into its key and value.
+inline void HashSelfCheckResult(uint64_t header, const char* line, size_t length, uint64_t* key, uint32_t* value)
+{
+    ResultDigest key_digest;
+    ResultDigest value_digest;
+    key_digest.Add(header);
+
+    const char* const end = line + length;
+    const char* field = line;
+    while (field != end && (field + 2 > end || std::memcmp(field, "::", 2) != 0))
+        field++;
+
+    AddSelfCheckText(key_digest, line, field);
+
+    while (field < end)
+    {
+        field += field[0] == ':' ? 2 : 1;
+        const char* field_end = field;
+        while (field_end != end && *field_end != '|')
+            field_end++;
+
+        // The label is everything before the last space, without a trailing colon ("XER: 0x...").
+        const char* value_begin = field_end;
+        while (value_begin != field && (value_begin[-1] == ' ' || value_begin[-1] == '\r' || value_begin[-1] == '\n'))
+            value_begin--;
+        while (value_begin != field && value_begin[-1] != ' ')
+            value_begin--;
+
+        const char* label_begin = field;
+        while (label_begin != value_begin && *label_begin == ' ')
+            label_begin++;
+        const char* label_end = value_begin;
+        while (label_end != label_begin && (label_end[-1] == ' ' || label_end[-1] == ':'))
+            label_end--;
+
+        ResultDigest& digest = IsSelfCheckOutputLabel(label_begin, label_end - label_begin) ? value_digest : key_digest;
+        AddSelfCheckText(digest, field, field_end);
+
+        field = field_end;
+    }
+
+    *key = key_digest.Finish();
+    *value = static_cast<uint32_t>(value_digest.Finish());
+}
+
+// Looks a key up in sorted expected results. Returns the index of its first value, or count
+// if it isn't there.
+inline size_t FindSelfCheckResult(const uint64_t* keys, size_t count, uint64_t key)
+{
+    size_t first = 0;
+    size_t last = count;
+    while (first < last)
+    {
+        const size_t middle = first + (last - first) / 2;
+        if (keys[middle] < key)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return first < count && keys[first] == key ? first : count;
+}
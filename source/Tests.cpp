@@ -0,0 +1,23 @@
+#include "Tests.h"
+
+void RunAllTests()
+{
+#ifdef BENCHMARKS
+    PPCBenchmarks();
+#else
+    PPCIntegerTests();
+    PPCFloatingPointTests();
+    PPCConditionRegisterTests();
+#ifdef GEKKO
+    PPCPairedSingleTests();
+#endif
+    PPCLoadStoreTests();
+    PPCIntegerChainTests();
+    PPCIntegerStateTests();
+    PPCFloatingPointModeTests();
+    PPCExceptionTests();
+#ifdef FUZZ_TESTS
+    PPCBlockFuzzTests();
+#endif
+#endif
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 
 inline uint32_t GetCR()
 {
@@ -26,6 +27,112 @@ inline void SetXER(uint32_t value)
     asm volatile ("mtxer %[val]" : : [val]"r"(value) : "xer");
 }
 
+inline uint32_t GetTimebase()
+{
+    uint32_t tb;
+    asm volatile ("mftb %[out]" : [out]"=r"(tb));
+    return tb;
+}
+
+inline void ClearFPSCR()
+{
+    asm volatile ("mtfsf 0xFF, %[reg]" : : [reg]"f"(0.0));
+}
+
+// The value mtfsf 0xFF takes to set the FPSCR to fpscr. Building it once and keeping it in a
+// register makes setting the whole FPSCR a single instruction.
+inline double MakeFPSCRImage(uint32_t fpscr)
+{
+    const uint64_t i = fpscr;
+    double d = 0.0;
+    std::memcpy(&d, &i, sizeof(double));
+    return d;
+}
+
+inline uint32_t GetFPSCR()
+{
+    double d = 0.0;
+    asm volatile ("mffs %[out]" : [out]"=f"(d));
+
+    uint64_t i = 0;
+    std::memcpy(&i, &d, sizeof(uint64_t));
+
+    // High 32 bits are undefined according to the PPC reference.
+    return static_cast<uint32_t>(i);
+}
+
+inline void SetRoundingMode(uint32_t index)
+{
+    if (index == 0)
+        asm volatile ("mtfsb0 30\nmtfsb0 31\n");
+    else if (index == 1)
+        asm volatile ("mtfsb0 30\nmtfsb1 31\n");
+    else if (index == 2)
+        asm volatile ("mtfsb1 30\nmtfsb0 31\n");
+    else if (index == 3)
+        asm volatile ("mtfsb1 30\nmtfsb1 31\n");
+}
+
+inline void EnableInvalidOperationExceptions()
+{
+    asm volatile ("mtfsb1 24");
+}
+
+// Values other than the rounding modes (0-3) passed to floating-point test functions.
+enum : uint32_t
+{
+    TEST_MODE_DEFAULT = 4, // Leave the rounding mode cleared.
+    TEST_MODE_VE = 5,      // Invalid operation exceptions enabled.
+};
+
+#ifdef GEKKO
+// Graphics quantization registers, which set the conversions of the paired-single
+// quantized loads and stores. GQR0-7 are SPRs 912-919.
+inline uint32_t GetGQR0()
+{
+    uint32_t gqr;
+    asm volatile ("mfspr %[out], 912" : [out]"=r"(gqr));
+    return gqr;
+}
+
+inline void SetGQR0(uint32_t value)
+{
+    asm volatile ("mtspr 912, %[val]" : : [val]"r"(value));
+}
+
+inline uint32_t GetGQR1()
+{
+    uint32_t gqr;
+    asm volatile ("mfspr %[out], 913" : [out]"=r"(gqr));
+    return gqr;
+}
+
+inline void SetGQR1(uint32_t value)
+{
+    asm volatile ("mtspr 913, %[val]" : : [val]"r"(value));
+}
+
+// The load type and scale are in the upper half of a GQR, and the store type and scale in the lower half.
+constexpr uint32_t MakeGQR(uint32_t load_type, uint32_t load_scale, uint32_t store_type, uint32_t store_scale)
+{
+    return (load_scale << 24) | (load_type << 16) | (store_scale << 8) | store_type;
+}
+#endif
+
 void PPCFloatingPointTests();
 void PPCIntegerTests();
-void PPCConditionRegisterTests();
\ No newline at end of file
+void PPCConditionRegisterTests();
+void PPCPairedSingleTests();
+void PPCLoadStoreTests();
+void PPCIntegerChainTests();
+void PPCIntegerStateTests();
+void PPCFloatingPointModeTests();
+void PPCExceptionTests();
+void PPCBlockFuzzTests();
+void PPCBenchmarks();
+
+// Runs every test above, in the order they appear in the log. Building with BENCHMARKS
+// defined runs the benchmarks instead. The paired-single tests only run on the Wii (GEKKO),
+// since other 750s (and qemu) don't have paired singles, and the block fuzz tests only run
+// with FUZZ_TESTS defined.
+void RunAllTests();
\ No newline at end of file
@@ -1,19 +1,29 @@
 #pragma once
 
 #include <cstdarg>
+#include <cstdio>
 #include <cstdlib>
 #include <string>
 
+// Formats into a stack buffer first, so short strings take no allocation beyond the
+// std::string's own. Result lines don't come through here (see LogLineWriter).
 inline std::string StringFromFormat(const char* format, ...)
 {
     va_list args;
-    char* buf = nullptr;
+    char buffer[256];
 
     va_start(args, format);
-    vasprintf(&buf, format, args);
+    const int length = vsnprintf(buffer, sizeof(buffer), format, args);
     va_end(args);
 
-    std::string temp = buf;
-    free(buf);
+    if (length < 0)
+        return {};
+    if (static_cast<size_t>(length) < sizeof(buffer))
+        return std::string(buffer, length);
+
+    std::string temp(length, '\0');
+    va_start(args, format);
+    vsnprintf(&temp[0], temp.size() + 1, format, args);
+    va_end(args);
     return temp;
 }
@@ -0,0 +1,201 @@
+// Extracts the FRES and FRSQRTE tables the exhaustive tests recover from the hardware,
+// and writes them out in the compact form described in EstimateTable.h, for emulators
+// to look the estimates up in.
+//
+// Every entry has to be present, and has to reproduce every step it covers, or nothing
+// is written.
+//
+// Usage: estimateexport <instruction_tests.txt|instruction_tests.bin> <estimate_tables.bin>
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "EstimateTable.h"
+#include "LogRecord.h"
+
+namespace
+{
+struct ExportEntry
+{
+    bool found = false;
+    uint32_t base = 0;
+    uint32_t dec = 0;
+    uint32_t mismatched = 0;
+};
+
+// FRES entries, then FRSQRTE entries.
+using ExportTables = ExportEntry[2][ESTIMATE_TABLE_ENTRIES];
+
+void AddEntry(ExportTables& tables, const char* inst, uint64_t entry, uint32_t base, uint32_t dec, uint32_t mismatched)
+{
+    size_t table;
+    if (std::strcmp(inst, "FRES") == 0)
+        table = 0;
+    else if (std::strcmp(inst, "FRSQRTE") == 0)
+        table = 1;
+    else
+        return;
+
+    if (entry >= ESTIMATE_TABLE_ENTRIES)
+        return;
+
+    ExportEntry& out = tables[table][entry];
+    out.found = true;
+    out.base = base;
+    out.dec = dec;
+    out.mismatched = mismatched;
+}
+
+bool ReadBinaryLog(FILE* in, ExportTables& tables)
+{
+    std::vector<char> text;
+    LogRecord record;
+
+    while (std::fread(&record, sizeof(record), 1, in) == 1)
+    {
+        record = SwapLogRecord(record);
+
+        if (record.type == LogRecordType::Text)
+        {
+            const size_t padded = (record.result + LOG_RECORD_SIZE - 1) / LOG_RECORD_SIZE * LOG_RECORD_SIZE;
+            text.resize(padded);
+            if (std::fread(text.data(), 1, padded, in) != padded)
+            {
+                std::fprintf(stderr, "Truncated text record\n");
+                return false;
+            }
+            continue;
+        }
+
+        if (record.type != LogRecordType::Result)
+        {
+            std::fprintf(stderr, "Unknown record type %u\n", static_cast<unsigned>(record.type));
+            return false;
+        }
+
+        if (record.form != LogForm::EstimateTableEntry)
+            continue;
+
+        char inst[sizeof(record.inst) + 1] = {};
+        std::memcpy(inst, record.inst, sizeof(record.inst));
+        AddEntry(tables, inst, record.operands[0], static_cast<uint32_t>(record.result >> 32),
+                 static_cast<uint32_t>(record.result), static_cast<uint32_t>(record.operands[3]));
+    }
+
+    return std::feof(in) != 0;
+}
+
+// "FRES     :: entry  0 | base 0x07FF800 | dec 0x3E1 | mismatched 0"
+bool ReadTextLog(FILE* in, ExportTables& tables)
+{
+    char line[512];
+    while (std::fgets(line, sizeof(line), in) != nullptr)
+    {
+        const char* entry = std::strstr(line, ":: entry ");
+        const char* base = std::strstr(line, "| base 0x");
+        const char* dec = std::strstr(line, "| dec 0x");
+        const char* mismatched = std::strstr(line, "| mismatched ");
+        if (entry == nullptr || base == nullptr || dec == nullptr || mismatched == nullptr)
+            continue;
+
+        char inst[16] = {};
+        std::sscanf(line, "%15s", inst);
+        AddEntry(tables, inst, std::strtoull(entry + 9, nullptr, 10), static_cast<uint32_t>(std::strtoul(base + 9, nullptr, 16)),
+                 static_cast<uint32_t>(std::strtoul(dec + 8, nullptr, 16)), static_cast<uint32_t>(std::strtoul(mismatched + 13, nullptr, 10)));
+    }
+
+    return true;
+}
+
+void PutBigEndian32(unsigned char* out, uint32_t value)
+{
+    out[0] = static_cast<unsigned char>(value >> 24);
+    out[1] = static_cast<unsigned char>(value >> 16);
+    out[2] = static_cast<unsigned char>(value >> 8);
+    out[3] = static_cast<unsigned char>(value);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "Usage: %s <instruction_tests.txt|instruction_tests.bin> <estimate_tables.bin>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = std::fopen(argv[1], "rb");
+    if (in == nullptr)
+    {
+        std::fprintf(stderr, "Unable to open: %s\n", argv[1]);
+        return 1;
+    }
+
+    // Binary logs start with a record type, which text output never contains.
+    const int first = std::fgetc(in);
+    std::rewind(in);
+
+    ExportTables tables;
+    const bool binary = first == static_cast<int>(LogRecordType::Text) || first == static_cast<int>(LogRecordType::Result);
+    const bool read = binary ? ReadBinaryLog(in, tables) : ReadTextLog(in, tables);
+    std::fclose(in);
+    if (!read)
+        return 1;
+
+    static const char* const names[] = {"FRES", "FRSQRTE"};
+    bool complete = true;
+    for (size_t table = 0; table < 2; table++)
+    {
+        for (uint32_t entry = 0; entry < ESTIMATE_TABLE_ENTRIES; entry++)
+        {
+            const ExportEntry& e = tables[table][entry];
+            if (!e.found)
+            {
+                std::fprintf(stderr, "%s entry %" PRIu32 " isn't in the log (was it built with EXHAUSTIVE=1?)\n", names[table], entry);
+                complete = false;
+            }
+            else if (e.mismatched != 0)
+            {
+                std::fprintf(stderr, "%s entry %" PRIu32 " doesn't reproduce %" PRIu32 " of its steps\n", names[table], entry, e.mismatched);
+                complete = false;
+            }
+        }
+    }
+
+    if (!complete)
+        return 1;
+
+    unsigned char output[ESTIMATE_EXPORT_SIZE];
+    std::memcpy(output, ESTIMATE_EXPORT_MAGIC, sizeof(ESTIMATE_EXPORT_MAGIC));
+    unsigned char* p = output + sizeof(ESTIMATE_EXPORT_MAGIC);
+    for (const auto& table : tables)
+    {
+        for (const ExportEntry& e : table)
+        {
+            PutBigEndian32(p, e.base);
+            PutBigEndian32(p + 4, e.dec);
+            p += 8;
+        }
+    }
+
+    FILE* out = std::fopen(argv[2], "wb");
+    if (out == nullptr)
+    {
+        std::fprintf(stderr, "Unable to open: %s\n", argv[2]);
+        return 1;
+    }
+
+    const bool written = std::fwrite(output, 1, sizeof(output), out) == sizeof(output);
+    if (std::fclose(out) != 0 || !written)
+    {
+        std::fprintf(stderr, "Unable to write: %s\n", argv[2]);
+        return 1;
+    }
+
+    return 0;
+}
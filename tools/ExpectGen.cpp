@@ -0,0 +1,180 @@
+// Turns a reference log into the expected results of a self-checking build (make SELF_CHECK=1),
+// as a source file the tests compile in. See SelfCheck.h for how results are matched up.
+//
+// Results that share a key stay in the order they were logged, which is the order the
+// console checks them in.
+//
+// Usage: expectgen <instruction_tests.txt|instruction_tests.bin> <expected_results.inc>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "LogRecord.h"
+#include "SelfCheck.h"
+
+using ExpectedResult = std::pair<uint64_t, uint32_t>;
+
+class ReferenceReader
+{
+public:
+    // Takes text as it was written, which may hold several lines or part of one.
+    void AddText(const char* text, size_t length)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            m_line += text[i];
+            if (text[i] == '\n')
+                FinishLine();
+        }
+    }
+
+    void AddLine(const char* line)
+    {
+        m_line = line;
+        FinishLine();
+    }
+
+    std::vector<ExpectedResult>& GetResults() { return m_results; }
+
+private:
+    void FinishLine()
+    {
+        if (IsSelfCheckHeader(m_line.data(), m_line.size()))
+        {
+            m_header = HashSelfCheckHeader(m_line.data(), m_line.size());
+        }
+        else if (IsSelfCheckResult(m_line.data(), m_line.size()))
+        {
+            ExpectedResult result;
+            HashSelfCheckResult(m_header, m_line.data(), m_line.size(), &result.first, &result.second);
+            m_results.push_back(result);
+        }
+
+        m_line.clear();
+    }
+
+    std::string m_line;
+    uint64_t m_header = 0;
+    std::vector<ExpectedResult> m_results;
+};
+
+static bool ReadBinaryLog(FILE* in, ReferenceReader& reader)
+{
+    std::vector<char> text;
+    LogRecord record;
+
+    while (fread(&record, sizeof(record), 1, in) == 1)
+    {
+        record = SwapLogRecord(record);
+
+        if (record.type == LogRecordType::Text)
+        {
+            const size_t padded = (record.result + LOG_RECORD_SIZE - 1) / LOG_RECORD_SIZE * LOG_RECORD_SIZE;
+            text.resize(padded);
+            if (fread(text.data(), 1, padded, in) != padded)
+            {
+                fprintf(stderr, "Truncated text record\n");
+                return false;
+            }
+            reader.AddText(text.data(), record.result);
+            continue;
+        }
+
+        if (record.type != LogRecordType::Result)
+        {
+            fprintf(stderr, "Unknown record type %u\n", static_cast<unsigned>(record.type));
+            return false;
+        }
+
+        char line[256];
+        if (FormatLogRecord(record, line, sizeof(line)) > 0)
+            reader.AddLine(line);
+    }
+
+    return feof(in) != 0;
+}
+
+static bool ReadTextLog(FILE* in, ReferenceReader& reader)
+{
+    char line[512];
+    while (fgets(line, sizeof(line), in) != nullptr)
+        reader.AddText(line, strlen(line));
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <instruction_tests.txt|instruction_tests.bin> <expected_results.inc>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = fopen(argv[1], "rb");
+    if (in == nullptr)
+    {
+        fprintf(stderr, "Unable to open: %s\n", argv[1]);
+        return 1;
+    }
+
+    // Binary logs start with a record type, which text output never contains.
+    const int first = fgetc(in);
+    rewind(in);
+
+    ReferenceReader reader;
+    const bool binary = first == static_cast<int>(LogRecordType::Text) || first == static_cast<int>(LogRecordType::Result);
+    const bool read = binary ? ReadBinaryLog(in, reader) : ReadTextLog(in, reader);
+    fclose(in);
+    if (!read)
+        return 1;
+
+    std::vector<ExpectedResult>& expected = reader.GetResults();
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const ExpectedResult& a, const ExpectedResult& b) { return a.first < b.first; });
+
+    if (expected.empty())
+    {
+        fprintf(stderr, "No results in %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE* out = fopen(argv[2], "w");
+    if (out == nullptr)
+    {
+        fprintf(stderr, "Unable to open: %s\n", argv[2]);
+        return 1;
+    }
+
+    // Only the file name of the reference is kept, to be printed in the log.
+    const char* name = strrchr(argv[1], '/');
+    name = name != nullptr ? name + 1 : argv[1];
+
+    fprintf(out, "// Generated by tools/expectgen from %s. Do not edit.\n\n", name);
+    fprintf(out, "static const char expected_reference[] = \"%s\";\n\n", name);
+
+    fprintf(out, "static const uint64_t expected_keys[] = {\n");
+    for (size_t i = 0; i < expected.size(); i++)
+        fprintf(out, "%s0x%016" PRIX64 ",%s", i % 4 == 0 ? "    " : " ", expected[i].first, i % 4 == 3 ? "\n" : "");
+    fprintf(out, "%s};\n\n", expected.size() % 4 != 0 ? "\n" : "");
+
+    fprintf(out, "static const uint32_t expected_values[] = {\n");
+    for (size_t i = 0; i < expected.size(); i++)
+        fprintf(out, "%s0x%08" PRIX32 ",%s", i % 8 == 0 ? "    " : " ", expected[i].second, i % 8 == 7 ? "\n" : "");
+    fprintf(out, "%s};\n", expected.size() % 8 != 0 ? "\n" : "");
+
+    if (fclose(out) != 0)
+    {
+        fprintf(stderr, "Unable to write: %s\n", argv[2]);
+        return 1;
+    }
+
+    printf("%zu expected results from %s\n", expected.size(), name);
+    return 0;
+}
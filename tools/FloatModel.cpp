@@ -0,0 +1,898 @@
+#include "PPCModel.h"
+
+#include <cfenv>
+#include <cmath>
+
+#include "LogRecord.h"
+
+//
+// Floating-point
+//
+
+namespace
+{
+constexpr uint64_t DOUBLE_SIGN = 0x8000000000000000;
+constexpr uint64_t DOUBLE_EXP = 0x7FF0000000000000;
+constexpr uint64_t DOUBLE_FRAC = 0x000FFFFFFFFFFFFF;
+constexpr uint64_t DOUBLE_QUIET = 0x0008000000000000;
+constexpr uint64_t DEFAULT_QNAN = 0x7FF8000000000000;
+
+// FPRF values
+constexpr uint32_t FPRF_QNAN = 0x11000;
+constexpr uint32_t FPRF_NEG_INF = 0x09000;
+constexpr uint32_t FPRF_NEG_NORMAL = 0x08000;
+constexpr uint32_t FPRF_NEG_DENORMAL = 0x18000;
+constexpr uint32_t FPRF_NEG_ZERO = 0x12000;
+constexpr uint32_t FPRF_POS_ZERO = 0x02000;
+constexpr uint32_t FPRF_POS_DENORMAL = 0x14000;
+constexpr uint32_t FPRF_POS_NORMAL = 0x04000;
+constexpr uint32_t FPRF_POS_INF = 0x05000;
+
+// Exception bits tracked while executing an instruction.
+constexpr uint32_t STICKY_EXCEPTIONS = FPSCR_OX | FPSCR_UX | FPSCR_ZX | FPSCR_XX | FPSCR_VX_ANY;
+
+bool IsNaN(uint64_t bits)
+{
+    return (bits & DOUBLE_EXP) == DOUBLE_EXP && (bits & DOUBLE_FRAC) != 0;
+}
+
+bool IsSNaN(uint64_t bits)
+{
+    return IsNaN(bits) && (bits & DOUBLE_QUIET) == 0;
+}
+
+bool IsInf(uint64_t bits)
+{
+    return (bits & ~DOUBLE_SIGN) == DOUBLE_EXP;
+}
+
+bool IsZero(uint64_t bits)
+{
+    return (bits & ~DOUBLE_SIGN) == 0;
+}
+
+bool IsNegative(uint64_t bits)
+{
+    return (bits & DOUBLE_SIGN) != 0;
+}
+
+// Classifies a result. Single-precision results are classified against the
+// single-precision ranges, even though they're held in double format.
+uint32_t ClassifyResult(uint64_t bits, bool single)
+{
+    const bool negative = IsNegative(bits);
+    const uint64_t magnitude = bits & ~DOUBLE_SIGN;
+
+    if (IsNaN(bits))
+        return FPRF_QNAN;
+    if (magnitude == DOUBLE_EXP)
+        return negative ? FPRF_NEG_INF : FPRF_POS_INF;
+    if (magnitude == 0)
+        return negative ? FPRF_NEG_ZERO : FPRF_POS_ZERO;
+
+    // FLT_MIN is 0x3810000000000000 in double format.
+    const bool denormal = single ? magnitude < 0x3810000000000000 : (magnitude & DOUBLE_EXP) == 0;
+    if (denormal)
+        return negative ? FPRF_NEG_DENORMAL : FPRF_POS_DENORMAL;
+    return negative ? FPRF_NEG_NORMAL : FPRF_POS_NORMAL;
+}
+
+// Exact or round-to-odd intermediate result of an arithmetic operation.
+// Round-to-odd at 64 bits of precision preserves enough information to
+// round correctly to either 24 or 53 bits afterwards.
+struct Intermediate
+{
+    long double value;
+    bool inexact;
+};
+
+template <typename Op>
+Intermediate ComputeIntermediate(Op op)
+{
+    const int old_round = std::fegetround();
+    std::fesetround(FE_TOWARDZERO);
+    std::feclearexcept(FE_INEXACT);
+
+    volatile long double value = op();
+    const bool inexact = std::fetestexcept(FE_INEXACT) != 0;
+
+    std::fesetround(old_round);
+    return {value, inexact};
+}
+
+struct RoundedResult
+{
+    uint64_t bits;
+    uint32_t exceptions; // OX, UX, XX
+    bool fr;
+    bool fi;
+};
+
+// Rounds an intermediate to double or single precision under the FPSCR's rounding mode,
+// handling denormalization, overflow and the OE/UE exponent adjustments.
+RoundedResult RoundResult(const Intermediate& in, bool single, uint32_t fpscr)
+{
+    RoundedResult out{};
+
+    const bool negative = std::signbit(in.value);
+    const uint64_t sign = negative ? DOUBLE_SIGN : 0;
+    if (in.value == 0)
+    {
+        out.bits = sign;
+        return out;
+    }
+    if (std::isinf(in.value))
+    {
+        out.bits = sign | DOUBLE_EXP;
+        return out;
+    }
+
+    const int precision = single ? 24 : 53;
+    const int emin = single ? -126 : -1022;
+    const int emax = single ? 127 : 1023;
+    const int adjust = single ? 192 : 1536;
+
+    int exp = 0;
+    const long double fraction = std::frexp(std::fabs(in.value), &exp); // [0.5, 1)
+    const long double scaled = std::ldexp(fraction, 64);
+    uint64_t mantissa = static_cast<uint64_t>(scaled);
+    bool sticky = in.inexact || static_cast<long double>(mantissa) != scaled;
+
+    // Unbiased exponent of the leading bit.
+    int e = exp - 1;
+    bool tiny = e < emin;
+    bool overflowing = false;
+
+    if (tiny && (fpscr & FPSCR_UE))
+    {
+        e += adjust;
+        exp += adjust;
+        tiny = false;
+        out.exceptions |= FPSCR_UX;
+    }
+
+    int bits = precision;
+    if (tiny)
+        bits = precision - (emin - e);
+
+    // Round to 'bits' significant bits.
+    const int drop = 64 - bits;
+    uint64_t kept = 0;
+    bool round_bit = false;
+    if (drop > 64)
+    {
+        sticky = sticky || mantissa != 0;
+    }
+    else if (drop == 64)
+    {
+        round_bit = (mantissa >> 63) != 0;
+        sticky = sticky || (mantissa << 1) != 0;
+    }
+    else
+    {
+        kept = mantissa >> drop;
+        round_bit = ((mantissa >> (drop - 1)) & 1) != 0;
+        sticky = sticky || (mantissa & ((uint64_t{1} << (drop - 1)) - 1)) != 0;
+    }
+
+    const bool inexact = round_bit || sticky;
+    bool increment = false;
+    switch (fpscr & FPSCR_RN)
+    {
+    case 0:
+        increment = round_bit && (sticky || (kept & 1));
+        break;
+    case 1:
+        break;
+    case 2:
+        increment = inexact && !negative;
+        break;
+    case 3:
+        increment = inexact && negative;
+        break;
+    }
+
+    if (increment)
+        kept++;
+
+    int scale = exp - bits;
+    if (kept != 0)
+    {
+        const int top = 63 - __builtin_clzll(kept);
+        if (scale + top > emax)
+        {
+            if (fpscr & FPSCR_OE)
+            {
+                scale -= adjust;
+                out.exceptions |= FPSCR_OX;
+            }
+            else
+            {
+                overflowing = true;
+            }
+        }
+    }
+
+    out.fr = increment;
+    out.fi = inexact;
+    if (inexact)
+        out.exceptions |= FPSCR_XX;
+    if (tiny && inexact)
+        out.exceptions |= FPSCR_UX;
+
+    if (overflowing)
+    {
+        out.exceptions |= FPSCR_OX | FPSCR_XX;
+        out.fi = true;
+
+        const uint64_t max = single ? 0x47EFFFFFE0000000 : 0x7FEFFFFFFFFFFFFF;
+        bool to_infinity = false;
+        switch (fpscr & FPSCR_RN)
+        {
+        case 0:
+            to_infinity = true;
+            break;
+        case 1:
+            break;
+        case 2:
+            to_infinity = !negative;
+            break;
+        case 3:
+            to_infinity = negative;
+            break;
+        }
+
+        out.bits = sign | (to_infinity ? DOUBLE_EXP : max);
+        return out;
+    }
+
+    if (kept == 0)
+    {
+        out.bits = sign;
+        return out;
+    }
+
+    // kept fits in 54 bits and the scaled value is always representable as a double,
+    // as single results lie well inside the double exponent range.
+    out.bits = sign | DoubleToBits(std::ldexp(static_cast<double>(kept), scale));
+
+    // Non-IEEE mode flushes denormalized results to zero.
+    if ((fpscr & FPSCR_NI) && tiny)
+    {
+        out.bits = sign;
+        out.exceptions |= FPSCR_UX | FPSCR_XX;
+        out.fi = true;
+        out.fr = false;
+    }
+
+    return out;
+}
+
+// Truncates a NaN to the precision of the destination, quieting it.
+uint64_t QuietNaN(uint64_t bits, bool single)
+{
+    bits |= DOUBLE_QUIET;
+    if (single)
+        bits &= 0xFFFFFFFFE0000000;
+    return bits;
+}
+
+// Result of an operation before the FPSCR is updated.
+struct FloatOutcome
+{
+    uint64_t bits = 0;
+    uint32_t exceptions = 0; // Sticky exception bits raised.
+    bool write = true;       // False when an enabled exception suppresses the result.
+    bool update_fprf = true;
+    bool fr = false;
+    bool fi = false;
+    bool single = false;
+};
+
+// Handles NaN operands, which propagate in order of frA, frB, frC.
+// Returns true if a NaN was found.
+bool PropagateNaN(FloatOutcome& out, uint64_t a, uint64_t b, uint64_t c, int count)
+{
+    const uint64_t ops[3] = {a, b, c};
+    for (int i = 0; i < count; i++)
+    {
+        if (IsSNaN(ops[i]))
+            out.exceptions |= FPSCR_VXSNAN;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (IsNaN(ops[i]))
+        {
+            out.bits = QuietNaN(ops[i], out.single);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void InvalidOperation(FloatOutcome& out, uint32_t exception)
+{
+    out.exceptions |= exception;
+    out.bits = DEFAULT_QNAN;
+}
+
+void ApplyRounding(FloatOutcome& out, const Intermediate& in, uint32_t fpscr)
+{
+    const RoundedResult rounded = RoundResult(in, out.single, fpscr);
+    out.bits = rounded.bits;
+    out.exceptions |= rounded.exceptions;
+    out.fr = rounded.fr;
+    out.fi = rounded.fi;
+}
+
+// frA op frB for the basic arithmetic instructions.
+FloatOutcome Arithmetic(ModelOp op, bool single, uint64_t a_bits, uint64_t b_bits, uint32_t fpscr)
+{
+    FloatOutcome out;
+    out.single = single;
+
+    if (PropagateNaN(out, a_bits, b_bits, 0, 2))
+        return out;
+
+    const double a = BitsToDouble(a_bits);
+    const double b = BitsToDouble(b_bits);
+
+    switch (op)
+    {
+    case ModelOp::Fadd:
+    case ModelOp::Fadds:
+    case ModelOp::Fsub:
+    case ModelOp::Fsubs:
+    {
+        const bool subtract = op == ModelOp::Fsub || op == ModelOp::Fsubs;
+        const uint64_t b_effective = subtract ? (b_bits ^ DOUBLE_SIGN) : b_bits;
+        if (IsInf(a_bits) && IsInf(b_bits) && IsNegative(a_bits) != IsNegative(b_effective))
+        {
+            InvalidOperation(out, FPSCR_VXISI);
+            return out;
+        }
+
+        const Intermediate in = ComputeIntermediate([&] {
+            return subtract ? static_cast<long double>(a) - b : static_cast<long double>(a) + b;
+        });
+
+        // An exact zero sum of opposite-signed operands is -0 only when rounding toward -inf.
+        if (in.value == 0 && IsNegative(a_bits) != IsNegative(b_effective))
+        {
+            out.bits = (fpscr & FPSCR_RN) == 3 ? DOUBLE_SIGN : 0;
+            return out;
+        }
+
+        ApplyRounding(out, in, fpscr);
+        return out;
+    }
+
+    case ModelOp::Fmul:
+    case ModelOp::Fmuls:
+    {
+        if ((IsInf(a_bits) && IsZero(b_bits)) || (IsZero(a_bits) && IsInf(b_bits)))
+        {
+            InvalidOperation(out, FPSCR_VXIMZ);
+            return out;
+        }
+
+        ApplyRounding(out, ComputeIntermediate([&] { return static_cast<long double>(a) * b; }), fpscr);
+        return out;
+    }
+
+    case ModelOp::Fdiv:
+    case ModelOp::Fdivs:
+    {
+        if (IsInf(a_bits) && IsInf(b_bits))
+        {
+            InvalidOperation(out, FPSCR_VXIDI);
+            return out;
+        }
+        if (IsZero(a_bits) && IsZero(b_bits))
+        {
+            InvalidOperation(out, FPSCR_VXZDZ);
+            return out;
+        }
+        if (IsZero(b_bits) && !IsInf(a_bits))
+        {
+            out.exceptions |= FPSCR_ZX;
+            out.bits = ((a_bits ^ b_bits) & DOUBLE_SIGN) | DOUBLE_EXP;
+            if (fpscr & FPSCR_ZE)
+                out.write = false;
+            return out;
+        }
+
+        ApplyRounding(out, ComputeIntermediate([&] { return static_cast<long double>(a) / b; }), fpscr);
+        return out;
+    }
+
+    default:
+        return out;
+    }
+}
+
+// frA * frC +/- frB. The negated forms are handled by the caller.
+FloatOutcome FusedMultiplyAdd(bool subtract, bool single, uint64_t a_bits, uint64_t c_bits, uint64_t b_bits, uint32_t fpscr)
+{
+    FloatOutcome out;
+    out.single = single;
+
+    if (PropagateNaN(out, a_bits, b_bits, c_bits, 3))
+        return out;
+
+    if ((IsInf(a_bits) && IsZero(c_bits)) || (IsZero(a_bits) && IsInf(c_bits)))
+    {
+        InvalidOperation(out, FPSCR_VXIMZ);
+        return out;
+    }
+
+    const uint64_t b_effective = subtract ? (b_bits ^ DOUBLE_SIGN) : b_bits;
+    const bool product_negative = IsNegative(a_bits) != IsNegative(c_bits);
+    if ((IsInf(a_bits) || IsInf(c_bits)) && IsInf(b_bits) && product_negative != IsNegative(b_effective))
+    {
+        InvalidOperation(out, FPSCR_VXISI);
+        return out;
+    }
+
+    const long double a = BitsToDouble(a_bits);
+    const long double c = BitsToDouble(c_bits);
+    const long double b = BitsToDouble(b_effective);
+    const Intermediate in = ComputeIntermediate([&] { return std::fma(a, c, b); });
+
+    if (in.value == 0 && (IsZero(a_bits) || IsZero(c_bits) || !IsZero(b_bits)) &&
+        product_negative != IsNegative(b_effective))
+    {
+        out.bits = (fpscr & FPSCR_RN) == 3 ? DOUBLE_SIGN : 0;
+        return out;
+    }
+
+    ApplyRounding(out, in, fpscr);
+    return out;
+}
+
+FloatOutcome RoundToSingle(uint64_t b_bits, uint32_t fpscr)
+{
+    FloatOutcome out;
+    out.single = true;
+
+    if (PropagateNaN(out, b_bits, 0, 0, 1))
+        return out;
+
+    if (IsInf(b_bits) || IsZero(b_bits))
+    {
+        out.bits = b_bits;
+        return out;
+    }
+
+    ApplyRounding(out, {BitsToDouble(b_bits), false}, fpscr);
+    return out;
+}
+
+FloatOutcome ConvertToInteger(uint64_t b_bits, bool toward_zero, uint32_t fpscr)
+{
+    FloatOutcome out;
+    out.update_fprf = false;
+
+    // The upper word of the result is undefined by the architecture. Gekko fills it
+    // with 0xFFF80000, and sets its low bit when the result is a negative zero.
+    constexpr uint64_t upper = 0xFFF8000000000000;
+
+    if (IsNaN(b_bits))
+    {
+        if (IsSNaN(b_bits))
+            out.exceptions |= FPSCR_VXSNAN;
+        out.exceptions |= FPSCR_VXCVI;
+        out.bits = upper | 0x80000000;
+        return out;
+    }
+
+    const double b = BitsToDouble(b_bits);
+    const uint32_t mode = toward_zero ? 1 : (fpscr & FPSCR_RN);
+
+    double rounded = 0.0;
+    switch (mode)
+    {
+    case 0:
+        rounded = std::nearbyint(b); // The default environment rounds to nearest even.
+        break;
+    case 1:
+        rounded = std::trunc(b);
+        break;
+    case 2:
+        rounded = std::ceil(b);
+        break;
+    case 3:
+        rounded = std::floor(b);
+        break;
+    }
+
+    if (rounded > 2147483647.0)
+    {
+        out.exceptions |= FPSCR_VXCVI;
+        out.bits = upper | 0x7FFFFFFF;
+        return out;
+    }
+    if (rounded < -2147483648.0)
+    {
+        out.exceptions |= FPSCR_VXCVI;
+        out.bits = upper | 0x80000000;
+        return out;
+    }
+
+    const int32_t integer = static_cast<int32_t>(rounded);
+    out.bits = upper | static_cast<uint32_t>(integer);
+    if (integer == 0 && IsNegative(b_bits))
+        out.bits |= 0x100000000;
+
+    if (rounded != b)
+    {
+        out.exceptions |= FPSCR_XX;
+        out.fi = true;
+        out.fr = std::fabs(rounded) > std::fabs(b);
+    }
+
+    return out;
+}
+
+
+// Reciprocal estimate table lookup. Sets half when the table interpolation
+// drops half a unit of the result's last place.
+uint64_t LookupReciprocalEstimate(uint64_t bits, int64_t* exponent_out, bool* half)
+{
+    struct BaseAndDec
+    {
+        uint32_t base;
+        uint32_t dec;
+    };
+
+    static constexpr BaseAndDec fres_expected[] = {
+        {0x7ff800, 0x3e1}, {0x783800, 0x3a7}, {0x70ea00, 0x371}, {0x6a0800, 0x340},
+        {0x638800, 0x313}, {0x5d6200, 0x2ea}, {0x579000, 0x2c4}, {0x520800, 0x2a0},
+        {0x4cc800, 0x27f}, {0x47ca00, 0x261}, {0x430800, 0x245}, {0x3e8000, 0x22a},
+        {0x3a2c00, 0x212}, {0x360800, 0x1fb}, {0x321400, 0x1e5}, {0x2e4a00, 0x1d1},
+        {0x2aa800, 0x1be}, {0x272c00, 0x1ac}, {0x23d600, 0x19b}, {0x209e00, 0x18b},
+        {0x1d8800, 0x17c}, {0x1a9000, 0x16e}, {0x17ae00, 0x15b}, {0x14f800, 0x15b},
+        {0x124400, 0x143}, {0x0fbe00, 0x143}, {0x0d3800, 0x12d}, {0x0ade00, 0x12d},
+        {0x088400, 0x11a}, {0x065000, 0x11a}, {0x041c00, 0x108}, {0x020c00, 0x106},
+    };
+
+    const uint32_t i = static_cast<uint32_t>((bits & DOUBLE_FRAC) >> 37);
+    const BaseAndDec& entry = fres_expected[i / 1024];
+    const uint32_t product = entry.dec * (i % 1024);
+
+    *exponent_out = 0x7FD - static_cast<int64_t>((bits & DOUBLE_EXP) >> 52);
+    *half = (product & 1) != 0;
+    return entry.base - (product + 1) / 2;
+}
+
+FloatOutcome ReciprocalEstimate(uint64_t b_bits, uint32_t fpscr)
+{
+    FloatOutcome out;
+    out.single = true;
+
+    if (PropagateNaN(out, b_bits, 0, 0, 1))
+        return out;
+
+    const uint64_t sign = b_bits & DOUBLE_SIGN;
+    if (IsZero(b_bits))
+    {
+        out.exceptions |= FPSCR_ZX;
+        out.bits = sign | DOUBLE_EXP;
+        if (fpscr & FPSCR_ZE)
+            out.write = false;
+        return out;
+    }
+
+    if (IsInf(b_bits))
+    {
+        out.bits = sign;
+        return out;
+    }
+
+    int64_t exponent = 0;
+    bool half = false;
+    const uint64_t significand = LookupReciprocalEstimate(b_bits, &exponent, &half);
+
+    // Results too large for single precision saturate rather than going to infinity.
+    // Neither this nor the underflow case below counts toward XX.
+    if (exponent > 127 + 1023)
+    {
+        out.bits = sign | 0x47EFFFFFE0000000;
+        out.exceptions |= FPSCR_OX;
+        out.fi = true;
+        return out;
+    }
+
+    // The estimate is truncated rather than rounded. FI reports any dropped bits,
+    // including the half-unit dropped by the table interpolation.
+    if (exponent >= 1 - 126 + 1023)
+    {
+        out.bits = sign | (static_cast<uint64_t>(exponent) << 52) | (significand << 29);
+        out.fi = half;
+        return out;
+    }
+
+    // Results below the single-precision normal range are denormalized by truncation as well.
+    const uint64_t full = (((uint64_t{1} << 23) | significand) << 1) | (half ? 1 : 0);
+    const int64_t drop = (-126 + 1023) - exponent + 1;
+    const uint64_t kept = drop > 25 ? 0 : full >> drop;
+
+    out.exceptions |= FPSCR_UX;
+    out.fi = drop > 25 || (full & ((uint64_t{1} << drop) - 1)) != 0;
+    out.bits = sign | DoubleToBits(std::ldexp(static_cast<double>(kept), -149));
+    return out;
+}
+
+uint64_t LookupReciprocalSqrtEstimate(uint64_t value)
+{
+    struct BaseAndDec
+    {
+        uint32_t base;
+        uint32_t dec;
+    };
+
+    static constexpr BaseAndDec frsqrte_expected[] = {
+        {0x3ffa000, 0x7a4}, {0x3c29000, 0x700}, {0x38aa000, 0x670}, {0x3572000, 0x5f2},
+        {0x3279000, 0x584}, {0x2fb7000, 0x524}, {0x2d26000, 0x4cc}, {0x2ac0000, 0x47e},
+        {0x2881000, 0x43a}, {0x2665000, 0x3fa}, {0x2468000, 0x3c2}, {0x2287000, 0x38e},
+        {0x20c1000, 0x35e}, {0x1f12000, 0x332}, {0x1d79000, 0x30a}, {0x1bf4000, 0x2e6},
+        {0x1a7e800, 0x568}, {0x17cb800, 0x4f3}, {0x1552800, 0x48d}, {0x130c000, 0x435},
+        {0x10f2000, 0x3e7}, {0x0eff000, 0x3a2}, {0x0d2e000, 0x365}, {0x0b7c000, 0x32e},
+        {0x09e5000, 0x2fc}, {0x0867000, 0x2d0}, {0x06ff000, 0x2a8}, {0x05ab800, 0x283},
+        {0x046a000, 0x261}, {0x0339800, 0x243}, {0x0218800, 0x226}, {0x0105800, 0x20b},
+    };
+
+    // Only called for positive, finite, non-zero values.
+    uint64_t mantissa = value & DOUBLE_FRAC;
+    int64_t exponent = static_cast<int64_t>(value & DOUBLE_EXP);
+
+    // Normalize denormals.
+    if (exponent == 0)
+    {
+        while ((mantissa & (DOUBLE_FRAC + 1)) == 0)
+        {
+            exponent -= int64_t{1} << 52;
+            mantissa <<= 1;
+        }
+        mantissa &= DOUBLE_FRAC;
+        exponent += int64_t{1} << 52;
+    }
+
+    const bool odd_exponent = (exponent & (int64_t{1} << 52)) == 0;
+    const int64_t result_exponent = ((int64_t{0x3FF} << 52) - ((exponent - (int64_t{0x3FE} << 52)) / 2)) &
+                                    (int64_t{0x7FF} << 52);
+
+    const uint32_t i = static_cast<uint32_t>(mantissa >> 37);
+    const BaseAndDec& entry = frsqrte_expected[i / 2048 + (odd_exponent ? 16 : 0)];
+
+    return static_cast<uint64_t>(result_exponent) |
+           (uint64_t{entry.base - entry.dec * (i % 2048)} << 26);
+}
+
+FloatOutcome ReciprocalSqrtEstimate(uint64_t b_bits)
+{
+    FloatOutcome out;
+
+    if (PropagateNaN(out, b_bits, 0, 0, 1))
+        return out;
+
+    if (IsZero(b_bits))
+    {
+        out.exceptions |= FPSCR_ZX;
+        out.bits = (b_bits & DOUBLE_SIGN) | DOUBLE_EXP;
+        return out;
+    }
+
+    if (IsNegative(b_bits))
+    {
+        InvalidOperation(out, FPSCR_VXSQRT);
+        return out;
+    }
+
+    if (IsInf(b_bits))
+    {
+        out.bits = 0;
+        return out;
+    }
+
+    out.bits = LookupReciprocalSqrtEstimate(b_bits);
+    return out;
+}
+
+void SetCR1(ModelState& state)
+{
+    state.cr = (state.cr & 0xF0FFFFFF) | ((state.fpscr >> 4) & 0x0F000000);
+}
+
+// Recomputes the VX and FEX summary bits, and sets FX for newly raised exceptions.
+void UpdateSummaryBits(ModelState& state, uint32_t old_fpscr)
+{
+    uint32_t fpscr = state.fpscr & ~(FPSCR_VX | FPSCR_FEX);
+
+    if (fpscr & FPSCR_VX_ANY)
+        fpscr |= FPSCR_VX;
+
+    const uint32_t enabled = ((fpscr & FPSCR_VX) && (fpscr & FPSCR_VE)) ||
+                             ((fpscr & FPSCR_OX) && (fpscr & FPSCR_OE)) ||
+                             ((fpscr & FPSCR_UX) && (fpscr & FPSCR_UE)) ||
+                             ((fpscr & FPSCR_ZX) && (fpscr & FPSCR_ZE)) ||
+                             ((fpscr & FPSCR_XX) && (fpscr & FPSCR_XE));
+    if (enabled)
+        fpscr |= FPSCR_FEX;
+
+    if ((fpscr & ~old_fpscr) & STICKY_EXCEPTIONS)
+        fpscr |= FPSCR_FX;
+
+    state.fpscr = fpscr;
+}
+
+uint64_t CommitOutcome(const ModelInstruction& inst, uint64_t frD, const FloatOutcome& out, ModelState& state)
+{
+    const uint32_t old_fpscr = state.fpscr;
+    state.fpscr |= out.exceptions;
+
+    bool write = out.write;
+    if ((out.exceptions & FPSCR_VX_ANY) && (state.fpscr & FPSCR_VE))
+        write = false;
+
+    state.fpscr &= ~(FPSCR_FR | FPSCR_FI);
+    if (write)
+    {
+        if (out.fr)
+            state.fpscr |= FPSCR_FR;
+        if (out.fi)
+            state.fpscr |= FPSCR_FI;
+        if (out.update_fprf)
+            state.fpscr = (state.fpscr & ~FPSCR_FPRF) | ClassifyResult(out.bits, out.single);
+    }
+
+    UpdateSummaryBits(state, old_fpscr);
+
+    if (inst.rc)
+        SetCR1(state);
+
+    return write ? out.bits : frD;
+}
+
+void Compare(const ModelInstruction& inst, uint64_t a_bits, uint64_t b_bits, uint32_t crfD, ModelState& state)
+{
+    const uint32_t old_fpscr = state.fpscr;
+
+    uint32_t fpcc = 0;
+    if (IsNaN(a_bits) || IsNaN(b_bits))
+    {
+        fpcc = 0x1;
+
+        const bool snan = IsSNaN(a_bits) || IsSNaN(b_bits);
+        if (snan)
+            state.fpscr |= FPSCR_VXSNAN;
+
+        // FCMPO also reports the unordered comparison itself, unless an enabled
+        // SNaN exception already took precedence.
+        if (inst.op == ModelOp::Fcmpo && !(snan && (state.fpscr & FPSCR_VE)))
+            state.fpscr |= FPSCR_VXVC;
+    }
+    else
+    {
+        const double a = BitsToDouble(a_bits);
+        const double b = BitsToDouble(b_bits);
+        fpcc = a < b ? 0x8 : (a > b ? 0x4 : 0x2);
+    }
+
+    state.fpscr = (state.fpscr & ~FPSCR_FPCC) | (fpcc << 12);
+    ModelSetCRField(state.cr, crfD & 7, fpcc);
+    UpdateSummaryBits(state, old_fpscr);
+}
+} // Anonymous namespace
+
+uint64_t ModelReciprocalEstimate(uint64_t value)
+{
+    ModelState state{};
+    const ModelInstruction inst{ModelOp::Fres, ModelClass::FloatingPoint, false, false};
+    return ModelFloat(inst, 0, {value, 0, 0}, 0, state);
+}
+
+uint64_t ModelReciprocalSqrtEstimate(uint64_t value)
+{
+    ModelState state{};
+    const ModelInstruction inst{ModelOp::Frsqrte, ModelClass::FloatingPoint, false, false};
+    return ModelFloat(inst, 0, {value, 0, 0}, 0, state);
+}
+
+uint64_t ModelFloat(const ModelInstruction& inst, uint64_t frD, const uint64_t (&operands)[3], uint32_t crfD, ModelState& state)
+{
+    const uint64_t op0 = operands[0];
+    const uint64_t op1 = operands[1];
+    const uint64_t op2 = operands[2];
+
+    FloatOutcome out;
+    switch (inst.op)
+    {
+    // Sign manipulation and selection don't touch the FPSCR.
+    case ModelOp::Fabs:
+    case ModelOp::Fnabs:
+    case ModelOp::Fneg:
+    case ModelOp::Fsel:
+    {
+        uint64_t result = 0;
+        if (inst.op == ModelOp::Fabs)
+            result = op0 & ~DOUBLE_SIGN;
+        else if (inst.op == ModelOp::Fnabs)
+            result = op0 | DOUBLE_SIGN;
+        else if (inst.op == ModelOp::Fneg)
+            result = op0 ^ DOUBLE_SIGN;
+        else
+            result = (!IsNaN(op0) && BitsToDouble(op0) >= 0.0) ? op1 : op2;
+
+        if (inst.rc)
+            SetCR1(state);
+        return result;
+    }
+
+    case ModelOp::Fcmpo:
+    case ModelOp::Fcmpu:
+        Compare(inst, op0, op1, crfD, state);
+        return frD;
+
+    case ModelOp::Fadd:
+    case ModelOp::Fsub:
+    case ModelOp::Fmul:
+    case ModelOp::Fdiv:
+        out = Arithmetic(inst.op, false, op0, op1, state.fpscr);
+        break;
+    case ModelOp::Fadds:
+    case ModelOp::Fsubs:
+    case ModelOp::Fmuls:
+    case ModelOp::Fdivs:
+        out = Arithmetic(inst.op, true, op0, op1, state.fpscr);
+        break;
+
+    case ModelOp::Fmadd:
+    case ModelOp::Fmsub:
+    case ModelOp::Fnmadd:
+    case ModelOp::Fnmsub:
+    case ModelOp::Fmadds:
+    case ModelOp::Fmsubs:
+    case ModelOp::Fnmadds:
+    case ModelOp::Fnmsubs:
+    {
+        const bool subtract = inst.op == ModelOp::Fmsub || inst.op == ModelOp::Fnmsub ||
+                              inst.op == ModelOp::Fmsubs || inst.op == ModelOp::Fnmsubs;
+        const bool negate = inst.op == ModelOp::Fnmadd || inst.op == ModelOp::Fnmsub ||
+                            inst.op == ModelOp::Fnmadds || inst.op == ModelOp::Fnmsubs;
+        const bool single = inst.op == ModelOp::Fmadds || inst.op == ModelOp::Fmsubs ||
+                            inst.op == ModelOp::Fnmadds || inst.op == ModelOp::Fnmsubs;
+
+        out = FusedMultiplyAdd(subtract, single, op0, op1, op2, state.fpscr);
+
+        // The negated forms negate the rounded result. NaNs keep their sign.
+        if (negate && !IsNaN(out.bits))
+            out.bits ^= DOUBLE_SIGN;
+        break;
+    }
+
+    case ModelOp::Fctiw:
+    case ModelOp::Fctiwz:
+        out = ConvertToInteger(op0, inst.op == ModelOp::Fctiwz, state.fpscr);
+        break;
+
+    case ModelOp::Fres:
+        out = ReciprocalEstimate(op0, state.fpscr);
+        break;
+    case ModelOp::Frsp:
+        out = RoundToSingle(op0, state.fpscr);
+        break;
+    case ModelOp::Frsqrte:
+        out = ReciprocalSqrtEstimate(op0);
+        if (out.exceptions & FPSCR_ZX)
+            out.write = (state.fpscr & FPSCR_ZE) == 0;
+        break;
+
+    default:
+        return frD;
+    }
+
+    return CommitOutcome(inst, frD, out, state);
+}
@@ -0,0 +1,53 @@
+#include "IntegerBatch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HAS_X86_BATCH_LEVELS
+#endif
+
+BatchLevel GetBestBatchLevel()
+{
+#ifdef HAS_X86_BATCH_LEVELS
+    static const BatchLevel best = __builtin_cpu_supports("avx2")   ? BatchLevel::AVX2
+                                 : __builtin_cpu_supports("sse4.1") ? BatchLevel::SSE4
+                                                                    : BatchLevel::Scalar;
+    return best;
+#else
+    return BatchLevel::Scalar;
+#endif
+}
+
+const char* GetBatchLevelName(BatchLevel level)
+{
+    switch (level)
+    {
+    case BatchLevel::SSE4:
+        return "sse4.1";
+    case BatchLevel::AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+void ModelIntegerBatch(const ModelInstruction& inst, const IntegerBatch& batch, size_t count, BatchLevel level)
+{
+    size_t done = 0;
+
+#ifdef HAS_X86_BATCH_LEVELS
+    if (level == BatchLevel::AVX2)
+        done = ModelIntegerBatchAVX2(inst, batch, count);
+    else if (level == BatchLevel::SSE4)
+        done = ModelIntegerBatchSSE4(inst, batch, count);
+#else
+    (void)level;
+#endif
+
+    // Whatever's left over, and everything without a vector version.
+    for (size_t i = done; i < count; i++)
+    {
+        ModelState state{0, batch.xer[i], 0};
+        batch.rD[i] = ModelInteger(inst, batch.rD_in, {batch.rA[i], batch.rB[i], 0, 0}, state);
+        batch.xer_out[i] = state.xer;
+        batch.cr[i] = state.cr;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "PPCModel.h"
+
+// Batch evaluation of the integer model (ModelInteger), for the sweeps that are far too
+// large to check one vector at a time.
+//
+// A batch runs one instruction over arrays of operands, several vectors at a time with
+// SSE4.1 or AVX2 when the host has them. Results always match ModelInteger exactly:
+// anything without a vector version (division, rotates) runs through ModelInteger itself.
+// Host tools only.
+
+// Arrays of count elements each. Every vector starts from a clear CR.
+struct IntegerBatch
+{
+    const uint32_t* rA;
+    const uint32_t* rB;  // rB, or the immediate of immediate forms
+    const uint32_t* xer; // Initial XER
+    uint32_t rD_in;      // Prior value of rD, which compares leave in place
+
+    uint32_t* rD;
+    uint32_t* xer_out;
+    uint32_t* cr;
+};
+
+enum class BatchLevel : uint8_t
+{
+    Scalar,
+    SSE4,
+    AVX2,
+};
+
+// The widest level the host supports.
+BatchLevel GetBestBatchLevel();
+
+const char* GetBatchLevelName(BatchLevel level);
+
+void ModelIntegerBatch(const ModelInstruction& inst, const IntegerBatch& batch, size_t count,
+                       BatchLevel level = GetBestBatchLevel());
+
+// Vector versions (IntegerBatchSSE4.cpp and IntegerBatchAVX2.cpp), which only exist on x86 hosts.
+// Each evaluates a multiple of its width from the start of the batch and returns how many
+// vectors it evaluated, which is 0 for instructions it doesn't have a version of.
+size_t ModelIntegerBatchSSE4(const ModelInstruction& inst, const IntegerBatch& batch, size_t count);
+size_t ModelIntegerBatchAVX2(const ModelInstruction& inst, const IntegerBatch& batch, size_t count);
@@ -0,0 +1,62 @@
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+#include "IntegerBatchKernel.h"
+
+// Eight lanes, built with -mavx2.
+
+namespace
+{
+struct AVX2Lanes
+{
+    using V = __m256i;
+    static constexpr size_t WIDTH = 8;
+    static constexpr bool HAS_VARIABLE_SHIFTS = true;
+
+    static V Load(const uint32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void Store(uint32_t* p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static V Set(uint32_t value) { return _mm256_set1_epi32(static_cast<int>(value)); }
+
+    static V Add(V a, V b) { return _mm256_add_epi32(a, b); }
+    static V Sub(V a, V b) { return _mm256_sub_epi32(a, b); }
+    static V And(V a, V b) { return _mm256_and_si256(a, b); }
+    static V Or(V a, V b) { return _mm256_or_si256(a, b); }
+    static V Xor(V a, V b) { return _mm256_xor_si256(a, b); }
+
+    static V CmpEq(V a, V b) { return _mm256_cmpeq_epi32(a, b); }
+    static V CmpGt(V a, V b) { return _mm256_cmpgt_epi32(a, b); }
+    static V Select(V mask, V t, V f) { return _mm256_blendv_epi8(f, t, mask); }
+
+    static V ShiftLeft(V v, int amount) { return _mm256_slli_epi32(v, amount); }
+    static V ShiftRightLogical(V v, int amount) { return _mm256_srli_epi32(v, amount); }
+    static V ShiftRightArithmetic(V v, int amount) { return _mm256_srai_epi32(v, amount); }
+
+    // Amounts of 32 or more give 0 (or the sign, for arithmetic shifts).
+    static V ShiftLeftVariable(V v, V amount) { return _mm256_sllv_epi32(v, amount); }
+    static V ShiftRightLogicalVariable(V v, V amount) { return _mm256_srlv_epi32(v, amount); }
+    static V ShiftRightArithmeticVariable(V v, V amount) { return _mm256_srav_epi32(v, amount); }
+
+    static V MulLo(V a, V b) { return _mm256_mullo_epi32(a, b); }
+
+    // Same as the SSE4.1 version.
+    static V MulHiSigned(V a, V b)
+    {
+        const V even = _mm256_mul_epi32(a, b);
+        const V odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+        return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    }
+
+    static V MulHiUnsigned(V a, V b)
+    {
+        const V even = _mm256_mul_epu32(a, b);
+        const V odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+        return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    }
+};
+} // Anonymous namespace
+
+size_t ModelIntegerBatchAVX2(const ModelInstruction& inst, const IntegerBatch& batch, size_t count)
+{
+    return IntegerBatchKernel::Evaluate<AVX2Lanes>(inst, batch, count);
+}
+#endif
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include "IntegerBatch.h"
+
+// The vector versions of the integer model, written once against a set of lane operations.
+// Each instruction set provides a Lanes type (see IntegerBatchSSE4.cpp) with:
+//
+//   V                           The vector type
+//   WIDTH                       Lanes per vector
+//   HAS_VARIABLE_SHIFTS         Whether ShiftLeftVariable and the like exist
+//   Load, Store, Set            Unaligned loads and stores, and broadcasting a value
+//   Add, Sub, And, Or, Xor      Lane-wise arithmetic
+//   CmpEq, CmpGt                All ones where true (CmpGt is signed)
+//   Select(mask, t, f)          t where mask is all ones, f elsewhere
+//   ShiftLeft, ShiftRightLogical, ShiftRightArithmetic (by an immediate amount)
+//   MulLo, MulHiSigned, MulHiUnsigned
+//
+// Lane masks are all ones or all zeros, and are combined with And and Or. Everything here
+// mirrors PPCModel.cpp, which remains the reference.
+
+namespace IntegerBatchKernel
+{
+// Per-lane results of an instruction, before XER and CR are updated. This takes the Lanes
+// type rather than the vector type, which loses its attributes as a template argument.
+template <typename L>
+struct LaneResult
+{
+    typename L::V rD;
+    typename L::V carry;    // Mask, if the instruction writes CA
+    typename L::V overflow; // Mask, if the instruction can overflow
+};
+
+// What an instruction writes besides rD, which is the same in every lane.
+struct Writes
+{
+    bool carry;
+    bool compare; // Compares rA with the second operand, which is returned as rD, into cr0
+    bool compare_unsigned;
+};
+
+template <typename L>
+struct Lanes
+{
+    using V = typename L::V;
+
+    static V Ones() { return L::Set(0xFFFFFFFF); }
+    static V Not(V v) { return L::Xor(v, Ones()); }
+    static V SignMask(V v) { return L::ShiftRightArithmetic(v, 31); }
+
+    static V SignExtend16(V v) { return L::ShiftRightArithmetic(L::ShiftLeft(v, 16), 16); }
+    static V SignExtend8(V v) { return L::ShiftRightArithmetic(L::ShiftLeft(v, 24), 24); }
+
+    static V LessUnsigned(V a, V b)
+    {
+        const V bias = L::Set(0x80000000);
+        return L::CmpGt(L::Xor(b, bias), L::Xor(a, bias));
+    }
+
+    static V AddOverflows(V a, V b, V result)
+    {
+        return SignMask(L::And(L::Xor(a, result), L::Xor(b, result)));
+    }
+
+    // a + b + carry_in (0 or 1 per lane), with the carry out.
+    static LaneResult<L> AddWithCarry(V a, V b, V carry_in)
+    {
+        const V sum = L::Add(a, b);
+        const V result = L::Add(sum, carry_in);
+        return {result, L::Or(LessUnsigned(sum, a), LessUnsigned(result, sum)), AddOverflows(a, b, result)};
+    }
+
+    // Counts leading zeros with a binary search, since there's no lane instruction for it.
+    static V CountLeadingZeros(V value)
+    {
+        V count = L::Set(0);
+        for (const int shift : {16, 8, 4, 2, 1})
+        {
+            const V empty = L::CmpEq(L::ShiftRightLogical(value, 32 - shift), L::Set(0));
+            count = L::Add(count, L::And(empty, L::Set(shift)));
+            value = L::Select(empty, L::ShiftLeft(value, shift), value);
+        }
+
+        // Only a zero value has its top bit still clear.
+        return L::Add(count, L::And(L::CmpEq(value, L::Set(0)), L::Set(1)));
+    }
+};
+
+// Evaluates the largest multiple of the lane width. op computes a LaneResult from rA, rB and CA.
+template <typename L, typename Op>
+size_t Run(const ModelInstruction& inst, const IntegerBatch& batch, size_t count, Writes writes, Op op)
+{
+    using V = typename L::V;
+
+    const size_t end = count - count % L::WIDTH;
+    for (size_t i = 0; i < end; i += L::WIDTH)
+    {
+        const V a = L::Load(batch.rA + i);
+        const V b = L::Load(batch.rB + i);
+        V xer = L::Load(batch.xer + i);
+        const V ca = L::And(L::ShiftRightLogical(xer, 29), L::Set(1));
+
+        const LaneResult<L> result = op(a, b, ca);
+
+        V lt, gt, eq;
+        if (writes.compare)
+        {
+            const V bias = L::Set(writes.compare_unsigned ? 0x80000000 : 0);
+            const V biased_a = L::Xor(a, bias);
+            const V biased_b = L::Xor(result.rD, bias); // The (possibly extended) second operand
+            lt = L::CmpGt(biased_b, biased_a);
+            gt = L::CmpGt(biased_a, biased_b);
+            eq = L::CmpEq(a, result.rD);
+        }
+        else
+        {
+            if (writes.carry)
+                xer = L::Or(L::And(xer, L::Set(~XER_CA)), L::And(result.carry, L::Set(XER_CA)));
+            if (inst.oe)
+                xer = L::Or(L::And(xer, L::Set(~XER_OV)), L::And(result.overflow, L::Set(XER_OV | XER_SO)));
+
+            lt = L::CmpGt(L::Set(0), result.rD);
+            gt = L::CmpGt(result.rD, L::Set(0));
+            eq = L::CmpEq(result.rD, L::Set(0));
+        }
+
+        V cr = L::Set(0);
+        if (writes.compare || inst.rc)
+        {
+            cr = L::Or(L::Or(L::And(lt, L::Set(0x80000000)), L::And(gt, L::Set(0x40000000))),
+                       L::Or(L::And(eq, L::Set(0x20000000)), L::And(L::ShiftRightLogical(xer, 3), L::Set(0x10000000))));
+        }
+
+        L::Store(batch.rD + i, writes.compare ? L::Set(batch.rD_in) : result.rD);
+        L::Store(batch.xer_out + i, xer);
+        L::Store(batch.cr + i, cr);
+    }
+
+    return end;
+}
+
+template <typename L>
+size_t Evaluate(const ModelInstruction& inst, const IntegerBatch& batch, size_t count)
+{
+    using V = typename L::V;
+    using H = Lanes<L>;
+    using R = LaneResult<L>;
+
+    constexpr Writes NONE = {false, false, false};
+    constexpr Writes CARRY = {true, false, false};
+    constexpr Writes SIGNED_COMPARE = {false, true, false};
+    constexpr Writes UNSIGNED_COMPARE = {false, true, true};
+
+    const V zero = L::Set(0);
+
+    switch (inst.op)
+    {
+    case ModelOp::Add:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Add(a, b); return R{r, r, H::AddOverflows(a, b, r)}; });
+    case ModelOp::Addc:
+        return Run<L>(inst, batch, count, CARRY, [zero](V a, V b, V) { return H::AddWithCarry(a, b, zero); });
+    case ModelOp::Adde:
+        return Run<L>(inst, batch, count, CARRY, [](V a, V b, V ca) { return H::AddWithCarry(a, b, ca); });
+    case ModelOp::Addi:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Add(a, H::SignExtend16(b)); return R{r, r, r}; });
+    case ModelOp::Addic:
+        return Run<L>(inst, batch, count, CARRY, [zero](V a, V b, V) { return H::AddWithCarry(a, H::SignExtend16(b), zero); });
+    case ModelOp::Addis:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Add(a, L::ShiftLeft(b, 16)); return R{r, r, r}; });
+    case ModelOp::Addme:
+        return Run<L>(inst, batch, count, CARRY, [](V a, V, V ca) { return H::AddWithCarry(a, H::Ones(), ca); });
+    case ModelOp::Addze:
+        return Run<L>(inst, batch, count, CARRY, [zero](V a, V, V ca) { return H::AddWithCarry(a, zero, ca); });
+
+    case ModelOp::And:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::And(a, b); return R{r, r, r}; });
+    case ModelOp::Andc:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::And(a, H::Not(b)); return R{r, r, r}; });
+    case ModelOp::Andi:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::And(a, L::And(b, L::Set(0xFFFF))); return R{r, r, r}; });
+    case ModelOp::Andis:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::And(a, L::ShiftLeft(b, 16)); return R{r, r, r}; });
+
+    // Compares pass their second operand through rD.
+    case ModelOp::Cmp:
+        return Run<L>(inst, batch, count, SIGNED_COMPARE, [](V, V b, V) { return R{b, b, b}; });
+    case ModelOp::Cmpi:
+        return Run<L>(inst, batch, count, SIGNED_COMPARE, [](V, V b, V) { const V r = H::SignExtend16(b); return R{r, r, r}; });
+    case ModelOp::Cmpl:
+        return Run<L>(inst, batch, count, UNSIGNED_COMPARE, [](V, V b, V) { return R{b, b, b}; });
+    case ModelOp::Cmpli:
+        return Run<L>(inst, batch, count, UNSIGNED_COMPARE, [](V, V b, V) { const V r = L::And(b, L::Set(0xFFFF)); return R{r, r, r}; });
+
+    case ModelOp::Cntlzw:
+        return Run<L>(inst, batch, count, NONE, [](V a, V, V) { const V r = H::CountLeadingZeros(a); return R{r, r, r}; });
+
+    case ModelOp::Eqv:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = H::Not(L::Xor(a, b)); return R{r, r, r}; });
+    case ModelOp::Extsb:
+        return Run<L>(inst, batch, count, NONE, [](V a, V, V) { const V r = H::SignExtend8(a); return R{r, r, r}; });
+    case ModelOp::Extsh:
+        return Run<L>(inst, batch, count, NONE, [](V a, V, V) { const V r = H::SignExtend16(a); return R{r, r, r}; });
+
+    case ModelOp::Mulhw:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::MulHiSigned(a, b); return R{r, r, r}; });
+    case ModelOp::Mulhwu:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::MulHiUnsigned(a, b); return R{r, r, r}; });
+    case ModelOp::Mulli:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::MulLo(a, H::SignExtend16(b)); return R{r, r, r}; });
+    case ModelOp::Mullw:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) {
+            const V r = L::MulLo(a, b);
+            return R{r, r, H::Not(L::CmpEq(L::MulHiSigned(a, b), H::SignMask(r)))};
+        });
+
+    case ModelOp::Nand:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = H::Not(L::And(a, b)); return R{r, r, r}; });
+    case ModelOp::Neg:
+        return Run<L>(inst, batch, count, NONE, [zero](V a, V, V) {
+            const V r = L::Sub(zero, a);
+            return R{r, r, L::CmpEq(a, L::Set(0x80000000))};
+        });
+    case ModelOp::Nor:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = H::Not(L::Or(a, b)); return R{r, r, r}; });
+    case ModelOp::Or:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Or(a, b); return R{r, r, r}; });
+    case ModelOp::Orc:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Or(a, H::Not(b)); return R{r, r, r}; });
+    case ModelOp::Ori:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Or(a, L::And(b, L::Set(0xFFFF))); return R{r, r, r}; });
+    case ModelOp::Oris:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Or(a, L::ShiftLeft(b, 16)); return R{r, r, r}; });
+
+    case ModelOp::Subf:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Sub(b, a); return R{r, r, H::AddOverflows(H::Not(a), b, r)}; });
+    case ModelOp::Subfc:
+        return Run<L>(inst, batch, count, CARRY, [](V a, V b, V) { return H::AddWithCarry(H::Not(a), b, L::Set(1)); });
+    case ModelOp::Subfe:
+        return Run<L>(inst, batch, count, CARRY, [](V a, V b, V ca) { return H::AddWithCarry(H::Not(a), b, ca); });
+    case ModelOp::Subfic:
+        return Run<L>(inst, batch, count, CARRY, [](V a, V b, V) { return H::AddWithCarry(H::Not(a), H::SignExtend16(b), L::Set(1)); });
+    case ModelOp::Subfme:
+        return Run<L>(inst, batch, count, CARRY, [](V a, V, V ca) { return H::AddWithCarry(H::Not(a), H::Ones(), ca); });
+    case ModelOp::Subfze:
+        return Run<L>(inst, batch, count, CARRY, [zero](V a, V, V ca) { return H::AddWithCarry(H::Not(a), zero, ca); });
+
+    case ModelOp::Xor:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Xor(a, b); return R{r, r, r}; });
+    case ModelOp::Xori:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Xor(a, L::And(b, L::Set(0xFFFF))); return R{r, r, r}; });
+    case ModelOp::Xoris:
+        return Run<L>(inst, batch, count, NONE, [](V a, V b, V) { const V r = L::Xor(a, L::ShiftLeft(b, 16)); return R{r, r, r}; });
+
+    default:
+        break;
+    }
+
+    if constexpr (L::HAS_VARIABLE_SHIFTS)
+    {
+        switch (inst.op)
+        {
+        // Shift amounts of 32 to 63 shift everything out, as the lane shifts do.
+        case ModelOp::Slw:
+            return Run<L>(inst, batch, count, NONE, [](V a, V b, V) {
+                const V r = L::ShiftLeftVariable(a, L::And(b, L::Set(0x3F)));
+                return R{r, r, r};
+            });
+        case ModelOp::Srw:
+            return Run<L>(inst, batch, count, NONE, [](V a, V b, V) {
+                const V r = L::ShiftRightLogicalVariable(a, L::And(b, L::Set(0x3F)));
+                return R{r, r, r};
+            });
+
+        // CA is set when a negative value has any ones shifted out.
+        case ModelOp::Sraw:
+        case ModelOp::Srawi:
+        {
+            const uint32_t amount_mask = inst.op == ModelOp::Srawi ? 31 : 0x3F;
+            return Run<L>(inst, batch, count, CARRY, [amount_mask](V a, V b, V) {
+                const V amount = L::And(b, L::Set(amount_mask));
+                const V r = L::ShiftRightArithmeticVariable(a, amount);
+                const V lost = L::And(a, H::Not(L::ShiftLeftVariable(H::Ones(), amount)));
+                return R{r, L::And(H::SignMask(a), H::Not(L::CmpEq(lost, L::Set(0)))), r};
+            });
+        }
+
+        default:
+            break;
+        }
+    }
+
+    // Division and rotates are left to ModelInteger.
+    return 0;
+}
+} // namespace IntegerBatchKernel
@@ -0,0 +1,59 @@
+#if defined(__x86_64__) || defined(__i386__)
+#include <smmintrin.h>
+
+#include "IntegerBatchKernel.h"
+
+// Four lanes, built with -msse4.1. SSE has no per-lane shift amounts, so the shifts by
+// register are left to ModelInteger.
+
+namespace
+{
+struct SSE4Lanes
+{
+    using V = __m128i;
+    static constexpr size_t WIDTH = 4;
+    static constexpr bool HAS_VARIABLE_SHIFTS = false;
+
+    static V Load(const uint32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void Store(uint32_t* p, V v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static V Set(uint32_t value) { return _mm_set1_epi32(static_cast<int>(value)); }
+
+    static V Add(V a, V b) { return _mm_add_epi32(a, b); }
+    static V Sub(V a, V b) { return _mm_sub_epi32(a, b); }
+    static V And(V a, V b) { return _mm_and_si128(a, b); }
+    static V Or(V a, V b) { return _mm_or_si128(a, b); }
+    static V Xor(V a, V b) { return _mm_xor_si128(a, b); }
+
+    static V CmpEq(V a, V b) { return _mm_cmpeq_epi32(a, b); }
+    static V CmpGt(V a, V b) { return _mm_cmpgt_epi32(a, b); }
+    static V Select(V mask, V t, V f) { return _mm_blendv_epi8(f, t, mask); }
+
+    static V ShiftLeft(V v, int amount) { return _mm_slli_epi32(v, amount); }
+    static V ShiftRightLogical(V v, int amount) { return _mm_srli_epi32(v, amount); }
+    static V ShiftRightArithmetic(V v, int amount) { return _mm_srai_epi32(v, amount); }
+
+    static V MulLo(V a, V b) { return _mm_mullo_epi32(a, b); }
+
+    // The 64-bit multiplies only take the even lanes, so the odd ones are shifted down
+    // into them, and the high halves of both are blended back together.
+    static V MulHiSigned(V a, V b)
+    {
+        const V even = _mm_mul_epi32(a, b);
+        const V odd = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC);
+    }
+
+    static V MulHiUnsigned(V a, V b)
+    {
+        const V even = _mm_mul_epu32(a, b);
+        const V odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC);
+    }
+};
+} // Anonymous namespace
+
+size_t ModelIntegerBatchSSE4(const ModelInstruction& inst, const IntegerBatch& batch, size_t count)
+{
+    return IntegerBatchKernel::Evaluate<SSE4Lanes>(inst, batch, count);
+}
+#endif
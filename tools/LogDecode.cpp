@@ -0,0 +1,90 @@
+// Converts a binary result log (instruction_tests.bin) back into the
+// text output the tests produce when built without BINARY_LOG.
+//
+// Usage: logdecode <instruction_tests.bin> [output.txt]
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "LogRecord.h"
+
+static bool Decode(FILE* in, FILE* out)
+{
+    std::vector<char> text;
+    LogRecord record;
+
+    while (fread(&record, sizeof(record), 1, in) == 1)
+    {
+        record = SwapLogRecord(record);
+
+        if (record.type == LogRecordType::Text)
+        {
+            const size_t padded = (record.result + LOG_RECORD_SIZE - 1) / LOG_RECORD_SIZE * LOG_RECORD_SIZE;
+            text.resize(padded);
+
+            if (fread(text.data(), 1, padded, in) != padded)
+            {
+                fprintf(stderr, "Truncated text record\n");
+                return false;
+            }
+
+            fwrite(text.data(), 1, record.result, out);
+        }
+        else if (record.type == LogRecordType::Result)
+        {
+            char buffer[256];
+            const int length = FormatLogRecord(record, buffer, sizeof(buffer));
+            if (length < 0 || static_cast<size_t>(length) >= sizeof(buffer))
+            {
+                fprintf(stderr, "Unable to format record for %.8s\n", record.inst);
+                return false;
+            }
+
+            fwrite(buffer, 1, length, out);
+        }
+        else
+        {
+            fprintf(stderr, "Unknown record type %u\n", static_cast<unsigned>(record.type));
+            return false;
+        }
+    }
+
+    return feof(in) != 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        fprintf(stderr, "Usage: %s <instruction_tests.bin> [output.txt]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = fopen(argv[1], "rb");
+    if (in == nullptr)
+    {
+        fprintf(stderr, "Unable to open: %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (argc == 3)
+    {
+        out = fopen(argv[2], "w");
+        if (out == nullptr)
+        {
+            fprintf(stderr, "Unable to open: %s\n", argv[2]);
+            fclose(in);
+            return 1;
+        }
+    }
+
+    const bool success = Decode(in, out);
+
+    fclose(in);
+    if (out != stdout)
+        fclose(out);
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,1247 @@
+// Compares two logs result by result, and reports the results that differ grouped by
+// instruction and by what differs (the result register, XER, FPSCR, CR or the operands).
+//
+// Either log can be text or binary (instruction_tests.bin). Both are streamed, and results
+// are paired up by their section, instruction, mode and operands rather than by position, so
+// a test that only one log has is reported as just that, instead of shifting every result
+// after it. Only a limited window of results waiting for their counterpart is kept, so memory
+// use doesn't depend on the size of the logs or how far they drift apart. Once one log ends,
+// the rest of the other is reported as only being in it as it's read.
+//
+// Usage: logdiff <expected> <actual>
+//
+// Either log can be "-" to read it from stdin, e.g. from sdextract.
+//
+// Exits with 0 if the logs are the same, 1 if they differ, and 2 on errors.
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "LogRecord.h"
+
+namespace
+{
+//
+// Mismatch index
+//
+
+// What differs between two results. A mismatch can have several of these.
+enum DiffKind : uint32_t
+{
+    DIFF_RESULT   = 1 << 0, // rD, frD or a digest
+    DIFF_XER      = 1 << 1,
+    DIFF_FPSCR    = 1 << 2,
+    DIFF_CR       = 1 << 3,
+    DIFF_OPERANDS = 1 << 4, // The logs aren't running the same test here.
+    DIFF_TEXT     = 1 << 5, // Output that isn't a result.
+    DIFF_TIMING   = 1 << 6, // Benchmark latency or throughput
+};
+
+constexpr const char* diff_kind_names[] = {"rD", "XER", "FPSCR", "CR", "operands", "text", "timing"};
+constexpr size_t DIFF_KIND_COUNT = sizeof(diff_kind_names) / sizeof(diff_kind_names[0]);
+
+std::string DescribeDiff(uint32_t diff)
+{
+    std::string description;
+    for (size_t i = 0; i < DIFF_KIND_COUNT; i++)
+    {
+        if ((diff & (1U << i)) == 0)
+            continue;
+        if (!description.empty())
+            description += ' ';
+        description += diff_kind_names[i];
+    }
+    return description;
+}
+
+struct InstructionEntry
+{
+    std::string inst;
+    uint64_t total = 0;
+    uint64_t mismatched = 0;
+    uint64_t by_kind[DIFF_KIND_COUNT] = {};
+    uint64_t first_mismatch = 0;
+};
+
+// Per-instruction counts of results and mismatches, which are bounded by the number of
+// distinct mnemonics.
+class MismatchIndex
+{
+public:
+    explicit MismatchIndex(const char* location) : m_location(location) {}
+
+    void Match(std::string_view inst)
+    {
+        Lookup(inst).total++;
+    }
+
+    // expected and actual are only formatted when the mismatch is reported.
+    template <typename Formatter>
+    void Mismatch(std::string_view inst, uint32_t diff, uint64_t location, Formatter format)
+    {
+        InstructionEntry& entry = Lookup(inst);
+        entry.total++;
+        if (entry.mismatched++ == 0)
+            entry.first_mismatch = location;
+        for (size_t i = 0; i < DIFF_KIND_COUNT; i++)
+        {
+            if (diff & (1U << i))
+                entry.by_kind[i]++;
+        }
+
+        m_mismatches++;
+        if (m_reported++ < MAX_REPORTED_MISMATCHES)
+        {
+            std::string expected, actual;
+            format(&expected, &actual);
+            std::printf("MISMATCH %s %" PRIu64 " (%.*s: %s)\n", m_location, location,
+                        static_cast<int>(inst.size()), inst.data(), DescribeDiff(diff).c_str());
+            std::printf("  expected: %s\n", expected.c_str());
+            std::printf("  actual:   %s\n", actual.c_str());
+        }
+    }
+
+    // A result (or line of text) that only one of the logs has. location is where it is in that
+    // log, which is a line or record number as location_name says.
+    void Unmatched(bool in_expected, const char* location_name, std::string_view inst, uint64_t location, const std::string& text)
+    {
+        (in_expected ? m_only_expected : m_only_actual)++;
+
+        if (m_reported++ < MAX_REPORTED_MISMATCHES)
+        {
+            std::printf("ONLY IN %s %s %" PRIu64 " (%.*s)\n", in_expected ? "expected" : "actual", location_name, location,
+                        static_cast<int>(inst.size()), inst.data());
+            std::printf("  %s\n", text.c_str());
+        }
+    }
+
+    // Remembers the results behind the first mismatching group digest (see DIGEST_LOG).
+    void DigestGroupMismatch(uint64_t first, uint64_t last)
+    {
+        if (m_expand_first <= m_expand_last)
+            return;
+
+        m_expand_first = first;
+        m_expand_last = last;
+    }
+
+    int Summarize() const
+    {
+        uint64_t total = 0;
+        uint64_t totals_by_kind[DIFF_KIND_COUNT] = {};
+        for (const InstructionEntry& entry : m_entries)
+        {
+            total += entry.total;
+            for (size_t i = 0; i < DIFF_KIND_COUNT; i++)
+                totals_by_kind[i] += entry.by_kind[i];
+        }
+
+        if (m_mismatches != 0)
+        {
+            std::printf("\n%-10s %12s %12s", "inst", "results", "mismatched");
+            for (const char* name : diff_kind_names)
+                std::printf(" %10s", name);
+            std::printf("  first %s\n", m_location);
+
+            for (const InstructionEntry& entry : m_entries)
+            {
+                if (entry.mismatched == 0)
+                    continue;
+
+                std::printf("%-10s %12" PRIu64 " %12" PRIu64, entry.inst.c_str(), entry.total, entry.mismatched);
+                for (const uint64_t count : entry.by_kind)
+                    std::printf(" %10" PRIu64, count);
+                std::printf("  %" PRIu64 "\n", entry.first_mismatch);
+            }
+
+            std::printf("%-10s %12" PRIu64 " %12" PRIu64, "total", total, m_mismatches);
+            for (const uint64_t count : totals_by_kind)
+                std::printf(" %10" PRIu64, count);
+            std::printf("\n\n");
+        }
+
+        if (m_only_expected != 0)
+            std::printf("%" PRIu64 " entries are only in the expected log\n", m_only_expected);
+        if (m_only_actual != 0)
+            std::printf("%" PRIu64 " entries are only in the actual log\n", m_only_actual);
+
+        std::printf("%" PRIu64 "/%" PRIu64 " results matched across %zu instructions\n",
+                    total - m_mismatches, total, m_entries.size());
+
+        if (m_expand_first <= m_expand_last)
+        {
+            std::printf("To find the first result that differs, rebuild both logs with "
+                        "DIGEST_LOG=1 DIGEST_EXPAND=%" PRIu64 "-%" PRIu64 "\n", m_expand_first, m_expand_last);
+        }
+
+        return m_mismatches == 0 && m_only_expected == 0 && m_only_actual == 0 ? 0 : 1;
+    }
+
+private:
+    static constexpr uint64_t MAX_REPORTED_MISMATCHES = 50;
+
+    InstructionEntry& Lookup(std::string_view inst)
+    {
+        // Results come grouped by instruction, so this is almost always the last one used.
+        if (m_last < m_entries.size() && m_entries[m_last].inst == inst)
+            return m_entries[m_last];
+
+        for (m_last = 0; m_last < m_entries.size(); m_last++)
+        {
+            if (m_entries[m_last].inst == inst)
+                return m_entries[m_last];
+        }
+
+        m_entries.emplace_back();
+        m_entries.back().inst = std::string(inst);
+        return m_entries.back();
+    }
+
+    const char* m_location;
+    std::vector<InstructionEntry> m_entries;
+    size_t m_last = 0;
+    uint64_t m_mismatches = 0;
+    uint64_t m_only_expected = 0;
+    uint64_t m_only_actual = 0;
+    uint64_t m_reported = 0;
+    uint64_t m_expand_first = 1;
+    uint64_t m_expand_last = 0;
+};
+
+//
+// Pairing up results
+//
+
+// Entries from one log that haven't been paired up with an entry from the other yet, by the
+// key they're paired up by. Both logs are read in step, so an entry normally only waits here
+// until the other log gets to it. Entry needs a location, which is its place in its log.
+//
+// The window is limited, so memory use doesn't grow with how far apart the logs drift. An
+// entry that's waited for MAX_ENTRIES others is given up on, and reported as only being in
+// its log.
+template <typename Entry>
+class PendingEntries
+{
+public:
+    // Enough for a few sections' worth of results that only one log has.
+    static constexpr size_t MAX_ENTRIES = 1 << 16;
+
+    // Adds an entry. If the window is full, the oldest entry is pushed out into evicted.
+    // Returns whether one was.
+    bool Add(std::string key, Entry entry, Entry* evicted)
+    {
+        const uint64_t sequence = m_next_sequence++;
+        m_order.emplace_back(sequence, key);
+        m_entries[std::move(key)].emplace_back(sequence, std::move(entry));
+        m_count++;
+
+        // Entries that were taken stay in the order until they reach the front.
+        if (m_order.size() > 2 * MAX_ENTRIES)
+            CompactOrder();
+
+        if (m_count <= MAX_ENTRIES)
+            return false;
+
+        for (;;)
+        {
+            const auto [oldest, oldest_key] = std::move(m_order.front());
+            m_order.pop_front();
+
+            // Entries with the same key are kept in the order they were added, so a live entry
+            // is always the first of its key.
+            const auto found = m_entries.find(oldest_key);
+            if (found == m_entries.end() || found->second.front().first != oldest)
+                continue;
+
+            *evicted = std::move(found->second.front().second);
+            Pop(found);
+            return true;
+        }
+    }
+
+    // Takes the oldest entry with the key. Returns false if there isn't one.
+    bool Take(const std::string& key, Entry* entry)
+    {
+        const auto found = m_entries.find(key);
+        if (found == m_entries.end())
+            return false;
+
+        *entry = std::move(found->second.front().second);
+        Pop(found);
+        return true;
+    }
+
+    // The entries that were never paired up, in the order they were logged.
+    std::vector<Entry> Drain()
+    {
+        std::vector<std::pair<uint64_t, Entry>> sequenced;
+        for (auto& [key, queue] : m_entries)
+        {
+            for (auto& entry : queue)
+                sequenced.push_back(std::move(entry));
+        }
+        m_entries.clear();
+        m_order.clear();
+        m_count = 0;
+
+        std::sort(sequenced.begin(), sequenced.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::vector<Entry> entries;
+        entries.reserve(sequenced.size());
+        for (auto& entry : sequenced)
+            entries.push_back(std::move(entry.second));
+        return entries;
+    }
+
+private:
+    using Queue = std::deque<std::pair<uint64_t, Entry>>;
+
+    void Pop(typename std::unordered_map<std::string, Queue>::iterator found)
+    {
+        found->second.pop_front();
+        if (found->second.empty())
+            m_entries.erase(found);
+        m_count--;
+    }
+
+    // Rebuilds the order from the entries still waiting.
+    void CompactOrder()
+    {
+        m_order.clear();
+        for (const auto& [key, queue] : m_entries)
+        {
+            for (const auto& entry : queue)
+                m_order.emplace_back(entry.first, key);
+        }
+
+        std::sort(m_order.begin(), m_order.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+
+    std::unordered_map<std::string, Queue> m_entries;
+    std::deque<std::pair<uint64_t, std::string>> m_order; // By sequence, including taken entries
+    uint64_t m_next_sequence = 0;
+    size_t m_count = 0;
+};
+
+//
+// Input
+//
+
+class InputFile
+{
+public:
+    explicit InputFile(FILE* file) : m_file(file) {}
+    ~InputFile()
+    {
+        std::fclose(m_file);
+    }
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+
+    // Fills as much of the buffer as possible. Returns the number of bytes read.
+    size_t Read(void* buffer, size_t size)
+    {
+        return std::fread(buffer, 1, size, m_file);
+    }
+
+    bool Failed() const
+    {
+        return std::ferror(m_file) != 0;
+    }
+
+private:
+    FILE* m_file;
+};
+
+// Reads a binary log one record at a time, along with the text that follows text records.
+class RecordReader
+{
+public:
+    explicit RecordReader(InputFile& file) : m_file(file), m_buffer(BUFFER_SIZE) {}
+
+    // Returns false at the end of the log, or if it's truncated (see Truncated).
+    bool Next(LogRecord* record, std::string* text)
+    {
+        if (!ReadBytes(record, sizeof(*record)))
+            return false;
+
+        *record = SwapLogRecord(*record);
+        m_record_number++;
+
+        if (record->type != LogRecordType::Text)
+            return true;
+
+        const size_t padded = (record->result + LOG_RECORD_SIZE - 1) / LOG_RECORD_SIZE * LOG_RECORD_SIZE;
+        text->resize(padded);
+        if (!ReadBytes(&(*text)[0], padded))
+        {
+            m_truncated |= padded != 0;
+            return false;
+        }
+
+        text->resize(record->result);
+        m_record_number += padded / LOG_RECORD_SIZE;
+        return true;
+    }
+
+    // The number of the last record read, counting the records that text takes up.
+    uint64_t RecordNumber() const
+    {
+        return m_record_number;
+    }
+
+    bool Truncated() const
+    {
+        return m_truncated;
+    }
+
+private:
+    // Large enough that reads happen at disk bandwidth.
+    static constexpr size_t BUFFER_SIZE = 4 * 1024 * 1024;
+
+    bool ReadBytes(void* out, size_t size)
+    {
+        auto* bytes = static_cast<uint8_t*>(out);
+        while (size != 0)
+        {
+            if (m_position == m_size)
+            {
+                m_size = m_file.Read(m_buffer.data(), m_buffer.size());
+                m_position = 0;
+                if (m_size == 0)
+                {
+                    // Running out partway through is only expected between records.
+                    m_truncated |= bytes != out;
+                    return false;
+                }
+            }
+
+            const size_t chunk = std::min(size, m_size - m_position);
+            std::memcpy(bytes, &m_buffer[m_position], chunk);
+            m_position += chunk;
+            bytes += chunk;
+            size -= chunk;
+        }
+
+        return true;
+    }
+
+    InputFile& m_file;
+    std::vector<uint8_t> m_buffer;
+    size_t m_position = 0;
+    size_t m_size = 0;
+    uint64_t m_record_number = 0;
+    bool m_truncated = false;
+};
+
+// Reads a log as lines of text output. Binary logs are formatted as they're read.
+// Blank lines are skipped, since they carry no results.
+class LineReader
+{
+public:
+    virtual ~LineReader() = default;
+
+    // The line stays valid until the next call. It doesn't include the newline.
+    virtual bool Next(std::string_view* line) = 0;
+
+    // The line or record number of the last line read.
+    virtual uint64_t Location() const = 0;
+    virtual const char* LocationName() const = 0;
+};
+
+class TextLineReader final : public LineReader
+{
+public:
+    explicit TextLineReader(InputFile& file) : m_file(file), m_buffer(BUFFER_SIZE) {}
+
+    bool Next(std::string_view* line) override
+    {
+        for (;;)
+        {
+            const char* const start = m_buffer.data() + m_position;
+            const char* const end = m_buffer.data() + m_size;
+            const auto* newline = static_cast<const char*>(std::memchr(start, '\n', end - start));
+
+            if (newline == nullptr && !m_end_of_file)
+            {
+                // Move the partial line to the front of the buffer and read more.
+                const size_t partial = m_size - m_position;
+                if (partial == m_buffer.size())
+                {
+                    std::fprintf(stderr, "Line %" PRIu64 " is too long\n", m_line_number + 1);
+                    return false;
+                }
+
+                std::memmove(m_buffer.data(), start, partial);
+                m_position = 0;
+                m_size = partial;
+
+                const size_t read = m_file.Read(m_buffer.data() + m_size, m_buffer.size() - m_size);
+                m_size += read;
+                m_end_of_file = read == 0;
+                continue;
+            }
+
+            // The last line doesn't need to end with a newline.
+            if (newline == nullptr && start == end)
+                return false;
+
+            const char* const line_end = newline != nullptr ? newline : end;
+            m_position = static_cast<size_t>(line_end - m_buffer.data()) + (newline != nullptr ? 1 : 0);
+            m_line_number++;
+
+            size_t length = static_cast<size_t>(line_end - start);
+            if (length != 0 && start[length - 1] == '\r')
+                length--;
+            if (length == 0)
+                continue;
+
+            *line = std::string_view(start, length);
+            return true;
+        }
+    }
+
+    uint64_t Location() const override
+    {
+        return m_line_number;
+    }
+
+    const char* LocationName() const override
+    {
+        return "line";
+    }
+
+private:
+    static constexpr size_t BUFFER_SIZE = 4 * 1024 * 1024;
+
+    InputFile& m_file;
+    std::vector<char> m_buffer;
+    size_t m_position = 0;
+    size_t m_size = 0;
+    uint64_t m_line_number = 0;
+    bool m_end_of_file = false;
+};
+
+class BinaryLineReader final : public LineReader
+{
+public:
+    explicit BinaryLineReader(InputFile& file) : m_reader(file) {}
+
+    bool Next(std::string_view* line) override
+    {
+        for (;;)
+        {
+            // Hand out whatever text is left from the last text record first.
+            const size_t newline = m_text.find('\n', m_text_position);
+            if (newline != std::string::npos)
+            {
+                const size_t start = m_text_position;
+                m_text_position = newline + 1;
+                if (newline == start)
+                    continue;
+
+                *line = std::string_view(m_text).substr(start, newline - start);
+                return true;
+            }
+
+            m_text.erase(0, m_text_position);
+            m_text_position = 0;
+
+            LogRecord record;
+            if (!m_reader.Next(&record, &m_record_text))
+            {
+                // Text that doesn't end with a newline is still a line.
+                if (m_text.empty())
+                    return false;
+
+                m_text += '\n';
+                continue;
+            }
+
+            m_location = m_reader.RecordNumber();
+
+            if (record.type == LogRecordType::Text)
+            {
+                m_text += m_record_text;
+                continue;
+            }
+
+            // A partial line printed before this result ends up on its own line.
+            if (!m_text.empty())
+                m_text += '\n';
+
+            char buffer[256];
+            const int length = FormatLogRecord(record, buffer, sizeof(buffer));
+            if (length <= 0 || static_cast<size_t>(length) >= sizeof(buffer))
+            {
+                std::fprintf(stderr, "Unable to format record %" PRIu64 "\n", m_location);
+                return false;
+            }
+
+            m_text.append(buffer, length);
+        }
+    }
+
+    uint64_t Location() const override
+    {
+        return m_location;
+    }
+
+    const char* LocationName() const override
+    {
+        return "record";
+    }
+
+private:
+    RecordReader m_reader;
+    std::string m_record_text;
+    std::string m_text;
+    size_t m_text_position = 0;
+    uint64_t m_location = 0;
+};
+
+//
+// Comparing text output
+//
+
+constexpr std::string_view RESULT_SEPARATOR = " :: ";
+constexpr std::string_view FIELD_SEPARATOR = " | ";
+constexpr std::string_view XER_TEST_SEPARATOR = ": Resulting XER: ";
+
+// Finds the instruction a line is a result of. Returns false for lines that aren't results.
+// header is the last line that wasn't a result, which names the instruction of CR bit tests.
+bool ParseLineInstruction(std::string_view line, std::string_view header, std::string_view* inst)
+{
+    // "addo: Resulting XER: 0x..."
+    const size_t xer_test = line.find(XER_TEST_SEPARATOR);
+    if (xer_test != std::string_view::npos)
+    {
+        *inst = line.substr(0, xer_test);
+        return true;
+    }
+
+    if (line.find(RESULT_SEPARATOR) == std::string_view::npos)
+        return false;
+
+    // "     Bit n ::  crA ..."
+    if (line[0] == ' ')
+    {
+        *inst = header.substr(0, header.find(' '));
+        return true;
+    }
+
+    // "INST (MODE) :: ..." or "INST :: ..."
+    *inst = line.substr(0, line.find_first_of(" :"));
+    return true;
+}
+
+uint32_t DiffKindOfLabel(std::string_view label)
+{
+    if (label == "rD" || label == "frD" || label == "digest" || label == "stored" || label == "before" || label == "after" ||
+        label == "update" || label == "base" || label == "dec" || label == "mismatched" || label == "SRR0" || label == "SRR1")
+        return DIFF_RESULT;
+    if (label == "XER")
+        return DIFF_XER;
+    if (label == "FPSCR")
+        return DIFF_FPSCR;
+    if (label == "CR")
+        return DIFF_CR;
+    if (label == "latency" || label == "throughput" || label == "read" || label == "write")
+        return DIFF_TIMING;
+    return DIFF_OPERANDS;
+}
+
+// Splits "label value" (or "label: value") at the last space.
+void SplitField(std::string_view field, std::string_view* label, std::string_view* value)
+{
+    while (!field.empty() && field.front() == ' ')
+        field.remove_prefix(1);
+
+    const size_t space = field.rfind(' ');
+    if (space == std::string_view::npos)
+    {
+        *label = {};
+        *value = field;
+        return;
+    }
+
+    *label = field.substr(0, space);
+    *value = field.substr(space + 1);
+    if (!label->empty() && label->back() == ':')
+        label->remove_suffix(1);
+}
+
+// Works out what differs between two result lines.
+uint32_t DiffLines(std::string_view expected, std::string_view actual)
+{
+    const size_t expected_xer = expected.find(XER_TEST_SEPARATOR);
+    const size_t actual_xer = actual.find(XER_TEST_SEPARATOR);
+    if (expected_xer != std::string_view::npos || actual_xer != std::string_view::npos)
+        return expected_xer == actual_xer && expected.substr(0, expected_xer) == actual.substr(0, actual_xer) ? DIFF_XER : DIFF_OPERANDS;
+
+    const size_t expected_prefix = expected.find(RESULT_SEPARATOR);
+    const size_t actual_prefix = actual.find(RESULT_SEPARATOR);
+    if (actual_prefix == std::string_view::npos || expected.substr(0, expected_prefix) != actual.substr(0, actual_prefix))
+        return DIFF_OPERANDS;
+
+    expected.remove_prefix(expected_prefix + RESULT_SEPARATOR.size());
+    actual.remove_prefix(actual_prefix + RESULT_SEPARATOR.size());
+
+    uint32_t diff = 0;
+    while (!expected.empty() || !actual.empty())
+    {
+        // Different numbers of fields mean different tests.
+        if (expected.empty() || actual.empty())
+            return diff | DIFF_OPERANDS;
+
+        const size_t expected_end = expected.find(FIELD_SEPARATOR);
+        const size_t actual_end = actual.find(FIELD_SEPARATOR);
+
+        std::string_view expected_label, expected_value, actual_label, actual_value;
+        SplitField(expected.substr(0, expected_end), &expected_label, &expected_value);
+        SplitField(actual.substr(0, actual_end), &actual_label, &actual_value);
+
+        if (expected_label != actual_label)
+            diff |= DIFF_OPERANDS;
+        else if (expected_value != actual_value)
+            diff |= DiffKindOfLabel(expected_label);
+
+        expected.remove_prefix(expected_end == std::string_view::npos ? expected.size() : expected_end + FIELD_SEPARATOR.size());
+        actual.remove_prefix(actual_end == std::string_view::npos ? actual.size() : actual_end + FIELD_SEPARATOR.size());
+    }
+
+    return diff;
+}
+
+// The key a line is paired up by. Results are keyed on their section (the last line that
+// wasn't a result), everything before " :: " (the instruction and mode, or the bit of CR bit
+// tests) and their operand fields, leaving out the outputs, so results that differ still pair
+// up. Other lines are keyed on their text.
+std::string LineKey(std::string_view line, std::string_view header, bool is_result)
+{
+    std::string key;
+    if (!is_result)
+    {
+        key += '\n';
+        key += line;
+        return key;
+    }
+
+    key += header;
+    key += '\n';
+
+    const size_t xer_test = line.find(XER_TEST_SEPARATOR);
+    if (xer_test != std::string_view::npos)
+    {
+        key += line.substr(0, xer_test);
+        return key;
+    }
+
+    const size_t prefix = line.find(RESULT_SEPARATOR);
+    key += line.substr(0, prefix);
+
+    std::string_view fields = line.substr(prefix + RESULT_SEPARATOR.size());
+    while (!fields.empty())
+    {
+        const size_t end = fields.find(FIELD_SEPARATOR);
+
+        std::string_view label, value;
+        SplitField(fields.substr(0, end), &label, &value);
+        if (DiffKindOfLabel(label) == DIFF_OPERANDS)
+        {
+            key += FIELD_SEPARATOR;
+            key += label;
+            key += ' ';
+            key += value;
+        }
+
+        fields.remove_prefix(end == std::string_view::npos ? fields.size() : end + FIELD_SEPARATOR.size());
+    }
+
+    return key;
+}
+
+struct PendingLine
+{
+    uint64_t location = 0;
+    std::string inst; // "(text)" for lines that aren't results
+    std::string line;
+    bool is_result = false;
+};
+
+void DiffLinePair(MismatchIndex& index, const PendingLine& expected, const PendingLine& actual)
+{
+    if (expected.line == actual.line)
+    {
+        if (expected.is_result)
+            index.Match(expected.inst);
+        return;
+    }
+
+    // Lines that aren't results are keyed on their text, so only results get here.
+    const uint32_t diff = DiffLines(expected.line, actual.line);
+    if (diff == DIFF_RESULT)
+    {
+        // "ADD      :: results 0-6 | digest 0x..."
+        const size_t range = expected.line.find(":: results ");
+        if (range != std::string::npos)
+        {
+            const char* const text = expected.line.c_str() + range + 11;
+            char* end = nullptr;
+            const uint64_t first = std::strtoull(text, &end, 10);
+            if (*end == '-')
+                index.DigestGroupMismatch(first, std::strtoull(end + 1, nullptr, 10));
+        }
+    }
+
+    index.Mismatch(expected.inst, diff, expected.location, [&](std::string* expected_text, std::string* actual_text) {
+        *expected_text = expected.line;
+        *actual_text = actual.line;
+    });
+}
+
+int DiffLogLines(LineReader& expected, LineReader& actual)
+{
+    MismatchIndex index(expected.LocationName());
+    LineReader* const readers[2] = {&expected, &actual};
+    PendingEntries<PendingLine> pending[2];
+    std::string headers[2];
+    std::string_view lines[2];
+    bool more[2];
+
+    const auto unmatched = [&](size_t log, const PendingLine& entry) {
+        index.Unmatched(log == 0, readers[log]->LocationName(), entry.inst, entry.location, entry.line);
+    };
+
+    // Pairs a line from one log (0 for expected, 1 for actual) with the other log's, or leaves
+    // it to wait for it.
+    const auto add_line = [&](size_t log, std::string_view line) {
+        PendingLine entry;
+        std::string_view inst;
+        entry.is_result = ParseLineInstruction(line, headers[log], &inst);
+        entry.inst = entry.is_result ? std::string(inst) : std::string("(text)");
+        entry.line = std::string(line);
+        entry.location = readers[log]->Location();
+
+        std::string key = LineKey(line, headers[log], entry.is_result);
+        if (!entry.is_result)
+            headers[log] = entry.line;
+
+        PendingLine other;
+        if (pending[log ^ 1].Take(key, &other))
+        {
+            if (log == 0)
+                DiffLinePair(index, entry, other);
+            else
+                DiffLinePair(index, other, entry);
+        }
+        else if (!more[log ^ 1])
+        {
+            // The other log has ended, so there's nothing to wait for.
+            unmatched(log, entry);
+        }
+        else if (pending[log].Add(std::move(key), std::move(entry), &other))
+        {
+            unmatched(log, other);
+        }
+    };
+
+    for (size_t log = 0; log < 2; log++)
+        more[log] = readers[log]->Next(&lines[log]);
+
+    while (more[0] || more[1])
+    {
+        // While the logs are in step, lines that are the same don't need a key.
+        if (more[0] && more[1] && lines[0] == lines[1] && headers[0] == headers[1])
+        {
+            std::string_view inst;
+            if (ParseLineInstruction(lines[0], headers[0], &inst))
+            {
+                index.Match(inst);
+            }
+            else
+            {
+                headers[0] = std::string(lines[0]);
+                headers[1] = headers[0];
+            }
+        }
+        else
+        {
+            for (size_t log = 0; log < 2; log++)
+            {
+                if (more[log])
+                    add_line(log, lines[log]);
+            }
+        }
+
+        for (size_t log = 0; log < 2; log++)
+        {
+            if (!more[log] || (more[log] = readers[log]->Next(&lines[log])))
+                continue;
+
+            // Nothing the other log has waiting can be paired up now.
+            for (const PendingLine& entry : pending[log ^ 1].Drain())
+                unmatched(log ^ 1, entry);
+        }
+    }
+
+    // What's left was waiting for lines in a log that ended first.
+    for (size_t log = 0; log < 2; log++)
+    {
+        for (const PendingLine& entry : pending[log].Drain())
+            unmatched(log, entry);
+    }
+
+    return index.Summarize();
+}
+
+//
+// Comparing binary logs
+//
+
+// Which bits of each of a record's operands are inputs. The rest are part of the result.
+void GetInputMasks(LogForm form, uint64_t (&masks)[4])
+{
+    for (uint64_t& mask : masks)
+        mask = ~uint64_t{0};
+
+    switch (form)
+    {
+    // Loads log how far rA moved as the last operand. So do estimate table entries, with the
+    // steps their interpolation misses.
+    case LogForm::Load:
+    case LogForm::EstimateTableEntry:
+        masks[3] = 0;
+        break;
+    // Stores pack it in with EA and the size, followed by the memory around EA.
+    case LogForm::Store:
+        masks[1] = STORE_ACCESS_INPUTS;
+        masks[2] = masks[3] = 0;
+        break;
+    // Exceptions log whether they were delivered and the SRRs.
+    case LogForm::Exception:
+        masks[0] = masks[1] = masks[2] = masks[3] = 0;
+        break;
+    // Benchmark results only have the instructions per run or buffer size as an input.
+    case LogForm::InstructionTiming:
+    case LogForm::MemoryBandwidth:
+        masks[0] = masks[2] = masks[3] = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+// The key a record is paired up by (see LineKey). Text records are keyed on their text.
+std::string RecordKey(const LogRecord& record, const std::string& text, const std::string& header)
+{
+    std::string key;
+    if (record.type == LogRecordType::Text)
+    {
+        key += '\n';
+        key += text;
+        return key;
+    }
+
+    key += header;
+    key += '\n';
+    key += static_cast<char>(record.form);
+    key += static_cast<char>(record.mode);
+    key.append(record.inst, sizeof(record.inst));
+
+    uint64_t masks[4];
+    GetInputMasks(record.form, masks);
+    for (size_t i = 0; i < 4; i++)
+    {
+        const uint64_t input = record.operands[i] & masks[i];
+        key.append(reinterpret_cast<const char*>(&input), sizeof(input));
+    }
+    return key;
+}
+
+// Works out what differs between two result records.
+uint32_t DiffRecords(const LogRecord& expected, const LogRecord& actual)
+{
+    uint64_t masks[4];
+    GetInputMasks(expected.form, masks);
+
+    if (expected.form != actual.form || expected.mode != actual.mode ||
+        std::memcmp(expected.inst, actual.inst, sizeof(expected.inst)) != 0)
+    {
+        return DIFF_OPERANDS;
+    }
+
+    bool outputs_differ = expected.result != actual.result;
+    for (size_t i = 0; i < 4; i++)
+    {
+        if ((expected.operands[i] ^ actual.operands[i]) & masks[i])
+            return DIFF_OPERANDS;
+        outputs_differ |= ((expected.operands[i] ^ actual.operands[i]) & ~masks[i]) != 0;
+    }
+
+    // Benchmark results keep their timings in the result and first operand.
+    if (expected.form == LogForm::InstructionTiming || expected.form == LogForm::MemoryBandwidth)
+        return outputs_differ ? uint32_t{DIFF_TIMING} : 0U;
+
+    uint32_t diff = 0;
+    if (outputs_differ)
+        diff |= DIFF_RESULT;
+    if (expected.xer != actual.xer)
+        diff |= DIFF_XER;
+    if (expected.fpscr != actual.fpscr)
+        diff |= DIFF_FPSCR;
+    if (expected.cr != actual.cr)
+        diff |= DIFF_CR;
+    return diff;
+}
+
+std::string DescribeEntry(const LogRecord& record, const std::string& text)
+{
+    std::string description;
+    if (record.type == LogRecordType::Text)
+    {
+        description = text;
+    }
+    else
+    {
+        char buffer[256];
+        const int length = FormatLogRecord(record, buffer, sizeof(buffer));
+        if (length > 0 && static_cast<size_t>(length) < sizeof(buffer))
+            description.assign(buffer, length);
+    }
+
+    while (!description.empty() && description.back() == '\n')
+        description.pop_back();
+    return description;
+}
+
+// Some tests print their results as text (e.g. the XER tests), so count those too.
+void MatchTextResults(MismatchIndex& index, std::string_view text)
+{
+    while (!text.empty())
+    {
+        const size_t newline = text.find('\n');
+        const std::string_view line = text.substr(0, newline);
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+
+        std::string_view inst;
+        if (!line.empty() && line[0] != ' ' && ParseLineInstruction(line, {}, &inst))
+            index.Match(inst);
+    }
+}
+
+struct PendingRecord
+{
+    uint64_t location = 0;
+    LogRecord record;
+    std::string text;
+};
+
+void DiffRecordPair(MismatchIndex& index, const PendingRecord& expected, const PendingRecord& actual)
+{
+    // Text records are keyed on their text, so they always match.
+    if (expected.record.type == LogRecordType::Text)
+    {
+        MatchTextResults(index, expected.text);
+        return;
+    }
+
+    const std::string_view inst(expected.record.inst, strnlen(expected.record.inst, sizeof(expected.record.inst)));
+    const uint32_t diff = DiffRecords(expected.record, actual.record);
+    if (diff == 0)
+    {
+        index.Match(inst);
+        return;
+    }
+
+    if (diff == DIFF_RESULT && expected.record.form == LogForm::GroupDigest)
+        index.DigestGroupMismatch(expected.record.operands[0], expected.record.operands[1]);
+
+    index.Mismatch(inst, diff, expected.location, [&](std::string* expected_description, std::string* actual_description) {
+        *expected_description = DescribeEntry(expected.record, expected.text);
+        *actual_description = DescribeEntry(actual.record, actual.text);
+    });
+}
+
+// Two binary logs are compared record by record, without formatting anything that matches.
+int DiffLogRecords(RecordReader& expected, RecordReader& actual)
+{
+    MismatchIndex index("record");
+    RecordReader* const readers[2] = {&expected, &actual};
+    PendingEntries<PendingRecord> pending[2];
+    std::string headers[2];
+
+    PendingRecord entries[2];
+    bool more[2];
+
+    const auto unmatched = [&](size_t log, const PendingRecord& entry) {
+        const bool is_text = entry.record.type == LogRecordType::Text;
+        const std::string_view inst(entry.record.inst, strnlen(entry.record.inst, sizeof(entry.record.inst)));
+        index.Unmatched(log == 0, "record", is_text ? std::string_view("(text)") : inst, entry.location,
+                        DescribeEntry(entry.record, entry.text));
+    };
+
+    for (size_t log = 0; log < 2; log++)
+        more[log] = readers[log]->Next(&entries[log].record, &entries[log].text);
+
+    while (more[0] || more[1])
+    {
+        const bool is_text = entries[0].record.type == LogRecordType::Text;
+
+        // While the logs are in step, records that are the same don't need a key.
+        if (more[0] && more[1] && std::memcmp(&entries[0].record, &entries[1].record, sizeof(LogRecord)) == 0 &&
+            (!is_text || entries[0].text == entries[1].text) && headers[0] == headers[1])
+        {
+            if (is_text)
+            {
+                MatchTextResults(index, entries[0].text);
+                headers[0] = entries[0].text;
+                headers[1] = headers[0];
+            }
+            else
+            {
+                index.Match(std::string_view(entries[0].record.inst, strnlen(entries[0].record.inst, sizeof(entries[0].record.inst))));
+            }
+        }
+        else
+        {
+            for (size_t log = 0; log < 2; log++)
+            {
+                if (!more[log])
+                    continue;
+
+                PendingRecord& entry = entries[log];
+                entry.location = readers[log]->RecordNumber();
+
+                std::string key = RecordKey(entry.record, entry.text, headers[log]);
+                if (entry.record.type == LogRecordType::Text)
+                    headers[log] = entry.text;
+
+                PendingRecord other;
+                if (pending[log ^ 1].Take(key, &other))
+                {
+                    if (log == 0)
+                        DiffRecordPair(index, entry, other);
+                    else
+                        DiffRecordPair(index, other, entry);
+                }
+                else if (!more[log ^ 1])
+                {
+                    // The other log has ended, so there's nothing to wait for.
+                    unmatched(log, entry);
+                }
+                else if (pending[log].Add(std::move(key), entry, &other))
+                {
+                    unmatched(log, other);
+                }
+            }
+        }
+
+        for (size_t log = 0; log < 2; log++)
+        {
+            if (!more[log] || (more[log] = readers[log]->Next(&entries[log].record, &entries[log].text)))
+                continue;
+
+            // Nothing the other log has waiting can be paired up now.
+            for (const PendingRecord& entry : pending[log ^ 1].Drain())
+                unmatched(log ^ 1, entry);
+        }
+    }
+
+    // What's left was waiting for records in a log that ended first.
+    for (size_t log = 0; log < 2; log++)
+    {
+        for (const PendingRecord& entry : pending[log].Drain())
+            unmatched(log, entry);
+    }
+
+    const int result = index.Summarize();
+    if (expected.Truncated() || actual.Truncated())
+    {
+        std::fprintf(stderr, "The %s log is truncated\n", expected.Truncated() ? "expected" : "actual");
+        return 2;
+    }
+    return result;
+}
+
+//
+// Driver
+//
+
+std::unique_ptr<InputFile> OpenLog(const char* path, bool* binary)
+{
+    FILE* file = std::strcmp(path, "-") == 0 ? stdin : std::fopen(path, "rb");
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "Unable to open: %s\n", path);
+        return nullptr;
+    }
+
+    // Binary logs start with a record type, which text output never contains.
+    // It's put back rather than rewound, since stdin may be a pipe.
+    const int first = std::fgetc(file);
+    std::ungetc(first, file);
+    *binary = first == static_cast<int>(LogRecordType::Text) || first == static_cast<int>(LogRecordType::Result);
+
+    return std::make_unique<InputFile>(file);
+}
+
+std::unique_ptr<LineReader> MakeLineReader(InputFile& file, bool binary)
+{
+    if (binary)
+        return std::make_unique<BinaryLineReader>(file);
+    return std::make_unique<TextLineReader>(file);
+}
+} // Anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "Usage: %s <expected> <actual>\n", argv[0]);
+        return 2;
+    }
+
+    bool expected_binary = false, actual_binary = false;
+    const std::unique_ptr<InputFile> expected = OpenLog(argv[1], &expected_binary);
+    const std::unique_ptr<InputFile> actual = OpenLog(argv[2], &actual_binary);
+    if (expected == nullptr || actual == nullptr)
+        return 2;
+
+    int result;
+    if (expected_binary && actual_binary)
+    {
+        RecordReader expected_reader(*expected);
+        RecordReader actual_reader(*actual);
+        result = DiffLogRecords(expected_reader, actual_reader);
+    }
+    else
+    {
+        // Compare as text when either log is text, since text loses the exact operands.
+        const std::unique_ptr<LineReader> expected_reader = MakeLineReader(*expected, expected_binary);
+        const std::unique_ptr<LineReader> actual_reader = MakeLineReader(*actual, actual_binary);
+        result = DiffLogLines(*expected_reader, *actual_reader);
+    }
+
+    if (expected->Failed() || actual->Failed())
+    {
+        std::fprintf(stderr, "Unable to read the logs\n");
+        return 2;
+    }
+
+    return result;
+}
@@ -0,0 +1,1439 @@
+// Validates the host reference model against a log from real hardware (or checks
+// a log against the model), and measures how fast the model can check vectors.
+//
+// Both text logs and binary logs (instruction_tests.bin) are accepted. Results in
+// binary logs are checked on every core, which is what makes checking the output
+// of the exhaustive tests practical.
+//
+// Usage:
+//   modelcheck <instruction_tests.txt|instruction_tests.bin> [threads]
+//   modelcheck --bench [seconds per model] [threads]
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BlockFuzz.h"
+#include "Digest.h"
+#include "EstimateTable.h"
+#include "FloatClasses.h"
+#include "IntegerBatch.h"
+#include "IntegerChain.h"
+#include "LogRecord.h"
+#include "PPCModel.h"
+#include "Random.h"
+
+namespace
+{
+//
+// Golden log parsing
+//
+
+// Finds "<label> 0x" or "<label>: 0x" in a line and parses the hex value that follows.
+bool ParseHexField(const char* line, const char* label, uint64_t* out)
+{
+    const size_t length = std::strlen(label);
+    for (const char* p = std::strstr(line, label); p != nullptr; p = std::strstr(p + 1, label))
+    {
+        // Make sure this is a whole label (e.g. "rA" and not the end of "crA").
+        if (p != line && p[-1] != ' ')
+            continue;
+
+        const char* value = p + length;
+        if (*value == ':')
+            value++;
+        if (std::strncmp(value, " 0x", 3) != 0)
+            continue;
+
+        *out = std::strtoull(value + 3, nullptr, 16);
+        return true;
+    }
+
+    return false;
+}
+
+// Extracts the text printed for a floating-point operand with %e.
+bool ParseFloatField(const char* line, const char* label, std::string* out)
+{
+    const std::string needle = std::string("| ") + label + " ";
+    const char* p = std::strstr(line, needle.c_str());
+    if (p == nullptr)
+    {
+        // The first operand isn't preceded by a separator.
+        const std::string first = std::string(":: ") + label + " ";
+        p = std::strstr(line, first.c_str());
+        if (p == nullptr)
+            return false;
+    }
+
+    p = std::strchr(p, ' ') + 1;
+    p = std::strchr(p, ' ') + 1;
+    const char* end = std::strchr(p, ' ');
+    *out = end != nullptr ? std::string(p, end) : std::string(p);
+    return true;
+}
+
+// Operands are printed with %e, which loses precision, so a printed operand is
+// matched back to every value in the operand tables that prints the same way.
+// NaNs print as "nan" regardless of whether they're quiet or signaling.
+//
+// Keep this in sync with the operand tables in source/FloatingPoint.cpp.
+const double known_operands[] = {
+    0.0, 0.25, 0.35, 0.5, 1.0, 2.0, 3.5, 5.0, 5.5, 10.0, 36.0, 50.0, 69.0, 100.0, 420.0,
+    1.54143e-044, 2.10195e-044, 2.45208e-029, 2.66247e-044, 3.08286e-044, 3.92364e-044, 6.30584e-044,
+    2.4679999352, 2.999999984523, 4.9359998704, 5.6519082319399, 6.888239210233, 7.3233339282,
+    7.9999999234, 100.986352178, 21321.94923489023, 52324.23123123212,
+    DBL_MAX, DBL_MIN, FLT_MAX, FLT_MIN,
+    std::numeric_limits<double>::infinity(),
+};
+
+std::vector<uint64_t> CandidateOperands(const std::string& text)
+{
+    std::vector<uint64_t> candidates;
+
+    if (text == "nan" || text == "-nan")
+    {
+        const uint64_t sign = text[0] == '-' ? 0x8000000000000000 : 0;
+        candidates.push_back(sign | 0x7FF8000000000000);
+        candidates.push_back(sign | 0x7FF4000000000000);
+        return candidates;
+    }
+
+    // Some vectors were written as float literals, so also try each value rounded to single precision.
+    char buffer[64];
+    for (const double known : known_operands)
+    {
+        const double single = static_cast<float>(known);
+        for (const double value : {known, -known, single, -single})
+        {
+            std::snprintf(buffer, sizeof(buffer), "%e", value);
+            const uint64_t bits = DoubleToBits(value);
+            if (text == buffer && std::find(candidates.begin(), candidates.end(), bits) == candidates.end())
+                candidates.push_back(bits);
+        }
+    }
+
+    // Fall back to the printed value itself.
+    if (candidates.empty())
+        candidates.push_back(DoubleToBits(std::strtod(text.c_str(), nullptr)));
+
+    return candidates;
+}
+
+//
+// Results
+//
+
+struct InstructionStats
+{
+    std::string inst;
+    uint64_t matched = 0;
+    uint64_t total = 0;
+};
+
+class Checker
+{
+public:
+    // location names what line_number counts in mismatch reports.
+    explicit Checker(const char* location = "line") : m_location(location) {}
+
+    void Record(const std::string& inst, bool matched, size_t line_number, const char* line, const std::string& model = {})
+    {
+        // Results come grouped by instruction, so the last one used is almost always the right one.
+        InstructionStats* stats = !m_stats.empty() && m_stats.back().inst == inst ? &m_stats.back() : nullptr;
+        for (size_t i = 0; i < m_stats.size() && stats == nullptr; i++)
+        {
+            if (m_stats[i].inst == inst)
+                stats = &m_stats[i];
+        }
+        if (stats == nullptr)
+        {
+            m_stats.push_back({inst, 0, 0});
+            stats = &m_stats.back();
+        }
+
+        stats->total++;
+        if (matched)
+        {
+            stats->matched++;
+            return;
+        }
+
+        if (m_mismatches++ < MAX_REPORTED_MISMATCHES)
+        {
+            std::printf("MISMATCH %s %zu: %s\n", m_location, line_number, line);
+            if (!model.empty())
+                std::printf("   model: %s\n", model.c_str());
+        }
+    }
+
+    // Counts a result the model can't check.
+    void Skip()
+    {
+        m_skipped++;
+    }
+
+    int Summarize() const
+    {
+        uint64_t matched = 0;
+        uint64_t total = 0;
+        for (const InstructionStats& entry : m_stats)
+        {
+            if (entry.matched != entry.total)
+                std::printf("%-10s %" PRIu64 "/%" PRIu64 "\n", entry.inst.c_str(), entry.matched, entry.total);
+            matched += entry.matched;
+            total += entry.total;
+        }
+
+        std::printf("%" PRIu64 "/%" PRIu64 " results matched across %zu instructions\n", matched, total, m_stats.size());
+        if (m_skipped != 0)
+            std::printf("%" PRIu64 " results couldn't be checked\n", m_skipped);
+        return matched == total ? 0 : 1;
+    }
+
+private:
+    static constexpr uint64_t MAX_REPORTED_MISMATCHES = 50;
+
+    const char* m_location;
+    std::vector<InstructionStats> m_stats;
+    uint64_t m_mismatches = 0;
+    uint64_t m_skipped = 0;
+};
+
+struct GoldenLine
+{
+    size_t number;
+    std::string text;
+};
+
+std::string ParseMnemonic(const char* line)
+{
+    const char* end = line;
+    while (*end != '\0' && *end != ' ' && *end != ':')
+        end++;
+    return std::string(line, end);
+}
+
+// Parses the mode a result was printed with, e.g. "(RTZ)".
+LogMode ParseLogMode(const char* line)
+{
+    for (uint32_t i = static_cast<uint32_t>(LogMode::RoundToNearest); i <= static_cast<uint32_t>(LogMode::StickyExceptionsEnabled); i++)
+    {
+        const auto mode = static_cast<LogMode>(i);
+        if (std::strstr(line, GetLogModeString(mode)) != nullptr)
+            return mode;
+    }
+
+    return LogMode::None;
+}
+
+//
+// Integer
+//
+
+bool CheckIntegerLine(const ModelInstruction& inst, const char* line)
+{
+    uint64_t rD = 0, rA = 0, rB = 0, xer = 0, cr = 0;
+    const bool has_rD = ParseHexField(line, "rD", &rD);
+    ParseHexField(line, "rA", &rA);
+    if (!ParseHexField(line, "rB", &rB))
+        ParseHexField(line, "imm", &rB);
+    ParseHexField(line, "XER", &xer);
+    ParseHexField(line, "CR", &cr);
+
+    // The fuzz tests also log the initial XER: "XER in 0x...", and the state tests the initial CR: "CR in 0x..."
+    uint64_t initial_xer = 0, initial_cr = 0;
+    ParseHexField(line, "XER in", &initial_xer);
+    ParseHexField(line, "CR in", &initial_cr);
+
+    ModelState state{};
+    state.xer = static_cast<uint32_t>(initial_xer);
+    state.cr = static_cast<uint32_t>(initial_cr);
+    const uint32_t result = ModelInteger(inst, 0, {static_cast<uint32_t>(rA), static_cast<uint32_t>(rB), 0, 0}, state);
+
+    return (!has_rD || result == rD) && state.xer == xer && state.cr == cr;
+}
+
+// SRAWI, RLWIMI and RLWINM take their shift and mask fields as immediates. The tests that
+// produced the golden log passed them through registers, so the assembler encoded register
+// numbers rather than the printed values. Those numbers are fixed per call site, so lines
+// are grouped by call site and each group is checked against every possible encoding.
+template <typename Predicate>
+void CheckEncodedGroups(Checker& checker, const std::string& inst_name, const std::vector<GoldenLine>& lines,
+                        size_t period, uint32_t encodings, Predicate matches)
+{
+    for (size_t site = 0; site < period; site++)
+    {
+        bool found = false;
+        for (uint32_t encoding = 0; encoding < encodings && !found; encoding++)
+        {
+            found = true;
+            for (size_t i = site; i < lines.size() && found; i += period)
+                found = matches(lines[i], i, encoding);
+        }
+
+        for (size_t i = site; i < lines.size(); i += period)
+            checker.Record(inst_name, found, lines[i].number, lines[i].text.c_str());
+    }
+}
+
+void CheckShiftImmediate(Checker& checker, const std::string& inst_name, const ModelInstruction& inst,
+                         const std::vector<GoldenLine>& lines)
+{
+    CheckEncodedGroups(checker, inst_name, lines, 4, 32, [&](const GoldenLine& line, size_t, uint32_t sh) {
+        uint64_t rD = 0, rA = 0, xer = 0, cr = 0;
+        ParseHexField(line.text.c_str(), "rD", &rD);
+        ParseHexField(line.text.c_str(), "rA", &rA);
+        ParseHexField(line.text.c_str(), "XER", &xer);
+        ParseHexField(line.text.c_str(), "CR", &cr);
+
+        ModelState state{};
+        const uint32_t result = ModelInteger(inst, 0, {static_cast<uint32_t>(rA), sh, 0, 0}, state);
+        return result == rD && state.xer == xer && state.cr == cr;
+    });
+}
+
+void CheckRotate(Checker& checker, const std::string& inst_name, const ModelInstruction& inst,
+                 const std::vector<GoldenLine>& lines)
+{
+    // Each loop iteration runs nine call sites. The destination is initialized to
+    // one of three values in turn, which RLWIMI merges into its result.
+    static constexpr uint32_t initial_rD[] = {0x7FFFFFFF, 0x80000000, 0xFFFFFFFF};
+
+    CheckEncodedGroups(checker, inst_name, lines, 9, 32 * 32 * 32, [&](const GoldenLine& line, size_t index, uint32_t encoding) {
+        uint64_t rD = 0, rS = 0, xer = 0, cr = 0;
+        ParseHexField(line.text.c_str(), "rD", &rD);
+        ParseHexField(line.text.c_str(), "rS", &rS);
+        ParseHexField(line.text.c_str(), "XER", &xer);
+        ParseHexField(line.text.c_str(), "CR", &cr);
+
+        const uint32_t operands[4] = {static_cast<uint32_t>(rS), encoding & 31, (encoding >> 5) & 31, encoding >> 10};
+        ModelState state{};
+        const uint32_t result = ModelInteger(inst, initial_rD[index % 3], operands, state);
+        return result == rD && state.xer == xer && state.cr == cr;
+    });
+}
+
+//
+// Floating-point
+//
+
+// On a mismatch, describes the model's result for the first candidate operands in *model.
+bool CheckFloatLine(const ModelInstruction& inst, const char* line, uint32_t initial_fpscr, std::string* model)
+{
+    const uint32_t fpscr = initial_fpscr | GetInitialFPSCR(ParseLogMode(line));
+
+    uint64_t frD = 0, expected_fpscr = 0, expected_cr = 0;
+    const bool has_frD = ParseHexField(line, "frD", &frD);
+    ParseHexField(line, "FPSCR", &expected_fpscr);
+    ParseHexField(line, "CR", &expected_cr);
+
+    // Operands in the model's (assembly) order. The log prints frA, frC, frB for
+    // three-operand forms, which matches.
+    std::vector<std::vector<uint64_t>> candidates;
+    for (const char* label : {"frA", "frC", "frB"})
+    {
+        std::string text;
+        if (ParseFloatField(line, label, &text))
+            candidates.push_back(CandidateOperands(text));
+    }
+
+    // Compares print frA and frB, and so do the two-operand arithmetic forms.
+    // FMUL's second operand is frC, but it's printed as frB.
+    while (candidates.size() < 3)
+        candidates.push_back({0});
+
+    // The FP tests don't clear the compiler's own CR fields, so only cr1 is meaningful.
+    const uint32_t cr_mask = 0x0F000000;
+
+    // FSEL never cleared its state, so only its result is meaningful.
+    const bool result_only = inst.op == ModelOp::Fsel;
+
+    for (const uint64_t a : candidates[0])
+    {
+        for (const uint64_t b : candidates[1])
+        {
+            for (const uint64_t c : candidates[2])
+            {
+                ModelState state{};
+                state.fpscr = fpscr;
+
+                // Use the logged result as the prior destination, so a write suppressed
+                // by an enabled exception (leaving whatever was in the register) matches.
+                const uint64_t result = ModelFloat(inst, frD, {a, b, c}, 1, state);
+                if (model->empty())
+                {
+                    char buffer[96];
+                    std::snprintf(buffer, sizeof(buffer), "frD 0x%016" PRIX64 " | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32,
+                                  result, state.fpscr, state.cr);
+                    *model = buffer;
+                }
+
+                if (has_frD && result != frD)
+                    continue;
+                if (result_only)
+                    return true;
+                if (state.fpscr == expected_fpscr && (state.cr & cr_mask) == (expected_cr & cr_mask))
+                    return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+//
+// Binary records
+//
+
+enum class Verdict
+{
+    Matched,
+    Mismatched,
+    Unchecked,
+};
+
+// Digests a sweep of an integer instruction over one operand (rA, or rB if sweep_rB) with the
+// other fixed, running the vectors through the batch evaluator a block at a time. digest_vector
+// adds each result in order, given the swept operand's value.
+template <typename DigestVector>
+uint64_t DigestIntegerSweep(const ModelInstruction& inst, bool sweep_rB, uint64_t first, uint64_t last, uint32_t fixed,
+                            uint32_t xer, uint32_t rD_in, DigestVector digest_vector, BatchLevel level = GetBestBatchLevel())
+{
+    static constexpr size_t BLOCK_SIZE = 1024;
+    uint32_t swept[BLOCK_SIZE];
+    uint32_t fixed_values[BLOCK_SIZE];
+    uint32_t xer_in[BLOCK_SIZE];
+    uint32_t rD[BLOCK_SIZE];
+    uint32_t xer_out[BLOCK_SIZE];
+    uint32_t cr[BLOCK_SIZE];
+    std::fill(std::begin(fixed_values), std::end(fixed_values), fixed);
+    std::fill(std::begin(xer_in), std::end(xer_in), xer);
+
+    const IntegerBatch batch{sweep_rB ? fixed_values : swept, sweep_rB ? swept : fixed_values, xer_in, rD_in, rD, xer_out, cr};
+    ResultDigest digest;
+    for (uint64_t begin = first; begin <= last; begin += BLOCK_SIZE)
+    {
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(BLOCK_SIZE, last - begin + 1));
+        for (size_t i = 0; i < count; i++)
+            swept[i] = static_cast<uint32_t>(begin + i);
+
+        ModelIntegerBatch(inst, batch, count, level);
+        for (size_t i = 0; i < count; i++)
+            digest_vector(digest, swept[i], rD[i], xer_out[i], cr[i]);
+    }
+
+    return digest.Finish();
+}
+
+// Runs a chain's steps through the model one after another, from the logged initial XER.
+Verdict VerifyIntegerChain(const LogRecord& record, std::string* model)
+{
+    const std::string name(record.inst, strnlen(record.inst, sizeof(record.inst)));
+    const IntegerChain* chain = FindIntegerChain(name.c_str());
+    ModelState state{0, static_cast<uint32_t>(record.operands[2]), 0};
+    uint64_t result = 0;
+    if (chain == nullptr || !ModelIntegerChain(*chain, record.operands[0], record.operands[1], state, &result))
+        return Verdict::Mismatched;
+
+    if (result == record.result && state.xer == record.xer && state.cr == record.cr)
+        return Verdict::Matched;
+
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "rD 0x%016" PRIX64 " | XER: 0x%08" PRIX32 " | CR: 0x%08" PRIX32, result, state.xer, state.cr);
+    *model = buffer;
+    return Verdict::Mismatched;
+}
+
+// Generates a fuzzed block and its initial state from the logged seed, as the tests did, and
+// checks the hash of the state the model ends up in.
+Verdict VerifyInstructionBlock(const LogRecord& record, std::string* model)
+{
+    const uint64_t count = record.operands[1];
+    if (count == 0 || count > BLOCK_MAX_INSTRUCTIONS)
+        return Verdict::Mismatched;
+
+    Random random(record.operands[0]);
+    BlockState state;
+    GenerateBlockState(random, state);
+
+    BlockInstruction block[BLOCK_MAX_INSTRUCTIONS];
+    GenerateBlock(random, block, count);
+    ModelBlock(block, count, state);
+
+    const uint64_t hash = HashBlockState(state);
+    if (hash == record.result)
+        return Verdict::Matched;
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "digest 0x%016" PRIX64, hash);
+    *model = buffer;
+    return Verdict::Mismatched;
+}
+
+// Checks a result record (in native byte order) against the model. Unlike text lines,
+// records hold the exact operands, so no candidate search is needed. On a mismatch,
+// describes the model's result in *model.
+Verdict VerifyRecord(const LogRecord& record, std::string* model)
+{
+    // Paired singles, memory accesses and exceptions aren't modeled, so they can only be compared against another log
+    // (see logdiff). Benchmark results aren't checked at all, and some aren't named after an instruction.
+    switch (record.form)
+    {
+    case LogForm::Exception:
+    case LogForm::InstructionTiming:
+    case LogForm::MemoryBandwidth:
+    case LogForm::PairedSingleUnary:
+    case LogForm::PairedSingleBinary:
+    case LogForm::PairedSingleCompare:
+    case LogForm::PairedSingleTernary:
+    case LogForm::QuantizedLoad:
+    case LogForm::QuantizedStore:
+    case LogForm::Load:
+    case LogForm::Store:
+        return Verdict::Unchecked;
+    case LogForm::IntegerChain:
+        return VerifyIntegerChain(record, model);
+    case LogForm::InstructionBlock:
+        return VerifyInstructionBlock(record, model);
+    default:
+        break;
+    }
+
+    const std::string name(record.inst, strnlen(record.inst, sizeof(record.inst)));
+    ModelInstruction inst{};
+    if (!DecodeModelMnemonic(name.c_str(), &inst))
+        return Verdict::Mismatched;
+
+    const uint64_t* const op = record.operands;
+    ModelState state{};
+    char buffer[96];
+
+    switch (record.form)
+    {
+    case LogForm::ConditionRegisterBit:
+        // Same layout as the "Bit n" text lines.
+        state.cr = static_cast<uint32_t>((op[1] << 24) | (op[2] << 20));
+        ModelConditionRegister(inst, 0, 4 + static_cast<uint32_t>(op[0]), 8 + static_cast<uint32_t>(op[0]), state);
+        break;
+
+    case LogForm::ConditionRegisterSweep:
+        state.cr = static_cast<uint32_t>(op[3]);
+        ModelConditionRegister(inst, static_cast<uint32_t>(op[0]), static_cast<uint32_t>(op[1]), static_cast<uint32_t>(op[2]), state);
+        break;
+
+    // The vectors behind these aren't logged, so they can only be compared against another log (see logdiff).
+    case LogForm::GroupDigest:
+        return Verdict::Unchecked;
+
+    case LogForm::IntegerUnaryDigest:
+    case LogForm::IntegerBinaryDigest:
+    {
+        // Unary digests are binary digests with rB and the initial XER both 0.
+        const bool binary = record.form == LogForm::IntegerBinaryDigest;
+        const uint64_t digest = DigestIntegerSweep(inst, false, binary ? op[2] : op[0], binary ? op[3] : op[1],
+                                                   binary ? static_cast<uint32_t>(op[0]) : 0,
+                                                   binary ? static_cast<uint32_t>(op[1]) : 0, 0, DigestIntegerUnary);
+        if (digest == record.result)
+            return Verdict::Matched;
+
+        std::snprintf(buffer, sizeof(buffer), "digest 0x%016" PRIX64, digest);
+        *model = buffer;
+        return Verdict::Mismatched;
+    }
+
+    case LogForm::IntegerUnary:
+    case LogForm::IntegerBinary:
+    case LogForm::IntegerImmediate:
+    case LogForm::IntegerCompare:
+    case LogForm::IntegerCompareImmediate:
+    case LogForm::IntegerRotate:
+    case LogForm::IntegerBinaryState:
+    case LogForm::IntegerState:
+    {
+        // The logged shift and mask operands of these aren't what was encoded (see CheckEncodedGroups).
+        if (record.form == LogForm::IntegerRotate || inst.op == ModelOp::Srawi)
+            return Verdict::Unchecked;
+
+        if (record.form == LogForm::IntegerBinaryState || record.form == LogForm::IntegerState)
+            state.xer = static_cast<uint32_t>(op[2]);
+        if (record.form == LogForm::IntegerState)
+            state.cr = static_cast<uint32_t>(op[3]);
+
+        const bool has_rD = record.form != LogForm::IntegerCompare && record.form != LogForm::IntegerCompareImmediate;
+        const uint32_t result = ModelInteger(inst, 0, {static_cast<uint32_t>(op[0]), static_cast<uint32_t>(op[1]), 0, 0}, state);
+        if ((!has_rD || result == static_cast<uint32_t>(record.result)) && state.xer == record.xer && state.cr == record.cr)
+            return Verdict::Matched;
+
+        std::snprintf(buffer, sizeof(buffer), "rD 0x%08" PRIX32 " | XER: 0x%08" PRIX32 " | CR: 0x%08" PRIX32,
+                      result, state.xer, state.cr);
+        *model = buffer;
+        return Verdict::Mismatched;
+    }
+
+    case LogForm::IntegerFieldDigest:
+    {
+        const uint32_t source = static_cast<uint32_t>(op[0]);
+        const uint32_t rD_in = static_cast<uint32_t>(op[1]);
+        const auto digest_vector = [](ResultDigest& digest, uint32_t field, uint32_t rD, uint32_t xer, uint32_t cr) {
+            DigestIntegerUnary(digest, field, rD, xer, cr & 0xF0000000);
+        };
+
+        // Everything but the rotates takes its field as rB, so it can go through the batch evaluator.
+        uint64_t result;
+        if (inst.op != ModelOp::Rlwimi && inst.op != ModelOp::Rlwinm)
+        {
+            result = DigestIntegerSweep(inst, true, op[2], op[3], source, 0, rD_in, digest_vector);
+        }
+        else
+        {
+            ResultDigest digest;
+            for (uint64_t field = op[2]; field <= op[3]; field++)
+            {
+                const uint32_t value = static_cast<uint32_t>(field);
+                ModelState vector_state{};
+                const uint32_t rD = ModelInteger(inst, rD_in, {source, value >> 10, (value >> 5) & 31, value & 31}, vector_state);
+                digest_vector(digest, value, rD, vector_state.xer, vector_state.cr);
+            }
+            result = digest.Finish();
+        }
+
+        if (result == record.result)
+            return Verdict::Matched;
+
+        std::snprintf(buffer, sizeof(buffer), "digest 0x%016" PRIX64, result);
+        *model = buffer;
+        return Verdict::Mismatched;
+    }
+
+    case LogForm::FloatSweepDigest:
+    {
+        Random random(op[0]);
+        ResultDigest digest;
+        for (uint64_t i = 0; i < op[1]; i++)
+        {
+            uint64_t operands[3];
+            GenerateFloatVector(random, inst, operands);
+
+            ModelState vector_state{};
+            vector_state.fpscr = GetInitialFPSCR(record.mode);
+            const uint64_t result = ModelFloat(inst, 0, operands, 1, vector_state);
+            DigestFloat(digest, operands, ModelWriteSuppressed(vector_state.fpscr) ? 0 : result,
+                        vector_state.fpscr, vector_state.cr & 0x0F000000);
+        }
+
+        if (digest.Finish() == record.result)
+            return Verdict::Matched;
+
+        std::snprintf(buffer, sizeof(buffer), "digest 0x%016" PRIX64, digest.Finish());
+        *model = buffer;
+        return Verdict::Mismatched;
+    }
+
+    case LogForm::FloatSingleDigest:
+    {
+        ResultDigest digest;
+        for (uint64_t single = op[0]; single <= op[1]; single++)
+        {
+            const uint64_t operands[3] = {SingleToDoubleBits(static_cast<uint32_t>(single)), 0, 0};
+            ModelState vector_state{};
+            const uint64_t result = ModelFloat(inst, 0, operands, 1, vector_state);
+            DigestFloat(digest, operands, result, vector_state.fpscr, vector_state.cr & 0x0F000000);
+        }
+
+        if (digest.Finish() == record.result)
+            return Verdict::Matched;
+
+        std::snprintf(buffer, sizeof(buffer), "digest 0x%016" PRIX64, digest.Finish());
+        *model = buffer;
+        return Verdict::Mismatched;
+    }
+
+    case LogForm::EstimateTableEntry:
+    {
+        if (inst.op != ModelOp::Fres && inst.op != ModelOp::Frsqrte)
+            return Verdict::Mismatched;
+
+        const EstimateTable table = inst.op == ModelOp::Fres ? EstimateTable::Reciprocal : EstimateTable::ReciprocalSqrt;
+        const EstimateEntry entry = RecoverEstimateEntry(table, static_cast<uint32_t>(op[0]), [&](uint64_t input) {
+            ModelState vector_state{};
+            const uint64_t result = ModelFloat(inst, 0, {input, 0, 0}, 1, vector_state);
+            return EstimateResult{result, vector_state.fpscr};
+        });
+
+        if (record.result == ((static_cast<uint64_t>(entry.base) << 32) | entry.dec) && op[3] == entry.mismatched)
+            return Verdict::Matched;
+
+        std::snprintf(buffer, sizeof(buffer), "base 0x%07" PRIX32 " | dec 0x%03" PRIX32 " | mismatched %" PRIu32,
+                      entry.base, entry.dec, entry.mismatched);
+        *model = buffer;
+        return Verdict::Mismatched;
+    }
+
+    case LogForm::FloatUnary:
+    case LogForm::FloatBinary:
+    case LogForm::FloatCompare:
+    case LogForm::FloatTernary:
+    {
+        state.fpscr = GetInitialFPSCR(record.mode);
+
+        // Same caveats as CheckFloatLine: only cr1 is meaningful, and only the result of FSEL.
+        const uint64_t result = ModelFloat(inst, record.result, {op[0], op[1], op[2]}, 1, state);
+        const bool result_matched = result == record.result;
+        if (inst.op == ModelOp::Fsel ? result_matched
+                                     : result_matched && state.fpscr == record.fpscr &&
+                                           (state.cr & 0x0F000000) == (record.cr & 0x0F000000))
+        {
+            return Verdict::Matched;
+        }
+
+        std::snprintf(buffer, sizeof(buffer), "frD 0x%016" PRIX64 " | FPSCR: 0x%08" PRIX32 " | CR: 0x%08" PRIX32,
+                      result, state.fpscr, state.cr);
+        *model = buffer;
+        return Verdict::Mismatched;
+    }
+
+    default:
+        return Verdict::Mismatched;
+    }
+
+    // CR logical instructions
+    if (state.cr == record.cr)
+        return Verdict::Matched;
+
+    std::snprintf(buffer, sizeof(buffer), "CR: 0x%08" PRIX32, state.cr);
+    *model = buffer;
+    return Verdict::Mismatched;
+}
+
+//
+// Driver
+//
+
+class LogChecker
+{
+public:
+    LogChecker(const char* location, unsigned thread_count) : m_checker(location), m_thread_count(thread_count) {}
+
+    // Checks one line of text output. Lines are expected in the order they were printed.
+    void CheckLine(size_t line_number, const char* line);
+
+    // Queues a result record to be checked. Records are checked in batches across all threads.
+    void CheckRecord(size_t record_number, const LogRecord& record);
+
+    int Finish();
+
+private:
+    // Records checked per thread in each batch.
+    static constexpr size_t RECORDS_PER_THREAD = 64 * 1024;
+
+    void FlushRecords();
+
+    Checker m_checker;
+    unsigned m_thread_count;
+
+    std::string m_header;
+    std::vector<std::pair<std::string, std::vector<GoldenLine>>> m_encoded_groups;
+
+    std::vector<std::pair<size_t, LogRecord>> m_records;
+};
+
+void LogChecker::CheckLine(size_t line_number, const char* line)
+{
+    // Digests of exhaustive tests: "CNTLZW   :: rA 0x00000000-0x00FFFFFF | digest 0x..."
+    // These take long enough to check that they're queued like binary records.
+    if (const char* digest = std::strstr(line, " | digest 0x"))
+    {
+        const std::string name = ParseMnemonic(line);
+
+        // Group digests (DIGEST_LOG): "ADD      :: results 0-6 | digest 0x..."
+        if (std::strstr(line, ":: results ") != nullptr)
+        {
+            FlushRecords();
+            m_checker.Skip();
+            return;
+        }
+
+        // Floating-point fuzz digests: "FADD      (RTN) :: seed 0x... | vectors 65536 | digest 0x..."
+        // and fuzzed blocks: "BLOCK    :: seed 0x... | instructions 16 | digest 0x..."
+        if (const char* seed = std::strstr(line, ":: seed 0x"))
+        {
+            const char* vectors = std::strstr(seed, "| vectors ");
+            const char* instructions = std::strstr(seed, "| instructions ");
+            if ((vectors == nullptr && instructions == nullptr) || name.size() > sizeof(LogRecord::inst))
+            {
+                FlushRecords();
+                m_checker.Record(name, false, line_number, line);
+                return;
+            }
+
+            LogRecord record = instructions != nullptr ? MakeLogRecord(LogForm::InstructionBlock, name.c_str())
+                                                       : MakeLogRecord(LogForm::FloatSweepDigest, name.c_str(), ParseLogMode(line));
+            record.operands[0] = std::strtoull(seed + 10, nullptr, 16);
+            record.operands[1] = instructions != nullptr ? std::strtoull(instructions + 15, nullptr, 10)
+                                                         : std::strtoull(vectors + 10, nullptr, 10);
+            record.result = std::strtoull(digest + 12, nullptr, 16);
+            CheckRecord(line_number, record);
+            return;
+        }
+
+        // Immediate field sweeps: "ADDI     :: source 0x... | rD in 0x... | fields 0x0000-0xFFFF | digest 0x..."
+        if (std::strstr(line, ":: source 0x") != nullptr)
+        {
+            const char* fields = std::strstr(line, "| fields 0x");
+            const char* last_field = fields != nullptr ? std::strstr(fields, "-0x") : nullptr;
+            uint64_t source = 0, rD = 0;
+            if (last_field == nullptr || !ParseHexField(line, "source", &source) || !ParseHexField(line, "in", &rD) ||
+                name.size() > sizeof(LogRecord::inst))
+            {
+                FlushRecords();
+                m_checker.Record(name, false, line_number, line);
+                return;
+            }
+
+            LogRecord record = MakeLogRecord(LogForm::IntegerFieldDigest, name.c_str());
+            record.operands[0] = source;
+            record.operands[1] = rD;
+            record.operands[2] = std::strtoull(fields + 11, nullptr, 16);
+            record.operands[3] = std::strtoull(last_field + 3, nullptr, 16);
+            record.result = std::strtoull(digest + 12, nullptr, 16);
+            CheckRecord(line_number, record);
+            return;
+        }
+
+        // Single-precision sweeps: "FRES.    :: single 0x00000000-0x007FFFFF | digest 0x..."
+        if (const char* range = std::strstr(line, ":: single 0x"))
+        {
+            const char* last = std::strstr(range, "-0x");
+            if (last == nullptr || name.size() > sizeof(LogRecord::inst))
+            {
+                FlushRecords();
+                m_checker.Record(name, false, line_number, line);
+                return;
+            }
+
+            LogRecord record = MakeLogRecord(LogForm::FloatSingleDigest, name.c_str());
+            record.operands[0] = std::strtoull(range + 12, nullptr, 16);
+            record.operands[1] = std::strtoull(last + 3, nullptr, 16);
+            record.result = std::strtoull(digest + 12, nullptr, 16);
+            CheckRecord(line_number, record);
+            return;
+        }
+
+        // Binary sweeps: "ADDEO.   :: rB 0x... | XER in 0x... | rA 0x00000000-0x00FFFFFF | digest 0x..."
+        if (std::strstr(line, ":: rB 0x") != nullptr)
+        {
+            const char* range = std::strstr(line, "| rA 0x");
+            const char* last = range != nullptr ? std::strstr(range, "-0x") : nullptr;
+            uint64_t rB = 0, xer = 0;
+            if (last == nullptr || !ParseHexField(line, "rB", &rB) || !ParseHexField(line, "in", &xer) ||
+                name.size() > sizeof(LogRecord::inst))
+            {
+                FlushRecords();
+                m_checker.Record(name, false, line_number, line);
+                return;
+            }
+
+            LogRecord record = MakeLogRecord(LogForm::IntegerBinaryDigest, name.c_str());
+            record.operands[0] = rB;
+            record.operands[1] = xer;
+            record.operands[2] = std::strtoull(range + 7, nullptr, 16);
+            record.operands[3] = std::strtoull(last + 3, nullptr, 16);
+            record.result = std::strtoull(digest + 12, nullptr, 16);
+            CheckRecord(line_number, record);
+            return;
+        }
+
+        const char* range = std::strstr(line, ":: rA 0x");
+        const char* last = range != nullptr ? std::strstr(range, "-0x") : nullptr;
+        if (last == nullptr || name.size() > sizeof(LogRecord::inst))
+        {
+            FlushRecords();
+            m_checker.Record(name, false, line_number, line);
+            return;
+        }
+
+        LogRecord record = MakeLogRecord(LogForm::IntegerUnaryDigest, name.c_str());
+        record.operands[0] = std::strtoull(range + 8, nullptr, 16);
+        record.operands[1] = std::strtoull(last + 3, nullptr, 16);
+        record.result = std::strtoull(digest + 12, nullptr, 16);
+        CheckRecord(line_number, record);
+        return;
+    }
+
+    // Queued records were logged before this line, so keep the reports in order.
+    FlushRecords();
+
+    // Benchmark results (BENCHMARK=1): "ADD      :: latency 1.00 | throughput 1.00"
+    // and "MEM1     :: read 1.00 | write 1.00 | size 1048576"
+    if (std::strstr(line, ":: latency ") != nullptr || std::strstr(line, ":: read ") != nullptr)
+    {
+        m_checker.Skip();
+        return;
+    }
+
+    // Condition register bit tests: "     Bit n ::  crA i | crB j | CR: x"
+    if (std::strncmp(line, "     Bit ", 9) == 0)
+    {
+        ModelInstruction inst{};
+        if (!DecodeModelMnemonic(m_header.c_str(), &inst))
+            return;
+
+        uint64_t crA = 0, crB = 0, cr = 0;
+        const uint32_t bit = static_cast<uint32_t>(std::strtoul(line + 9, nullptr, 10));
+        ParseHexField(line, "crA", &crA);
+        ParseHexField(line, "crB", &crB);
+        ParseHexField(line, "CR", &cr);
+
+        // The tests place crA in cr1 and crB in cr2, and combine bit n of each into the LT bit of cr0.
+        ModelState state{};
+        state.cr = static_cast<uint32_t>((crA << 24) | (crB << 20));
+        ModelConditionRegister(inst, 0, 4 + bit, 8 + bit, state);
+        m_checker.Record(m_header, state.cr == cr, line_number, line);
+        return;
+    }
+
+    // XER overflow clear test: "addo: Resulting XER: 0x..."
+    if (const char* xer_text = std::strstr(line, ": Resulting XER: "))
+    {
+        const std::string name(line, xer_text);
+        ModelInstruction inst{};
+        if (!DecodeModelMnemonic(name.c_str(), &inst))
+            return;
+
+        // Every bit of XER is set beforehand, and both operands are 2.
+        ModelState state{};
+        state.xer = XER_MASK;
+        ModelInteger(inst, 0, {2, 2, 0, 0}, state);
+
+        m_checker.Record(name + " (XER)", state.xer == std::strtoul(xer_text + 17, nullptr, 16), line_number, line);
+        return;
+    }
+
+    if (std::strstr(line, " :: ") == nullptr)
+    {
+        m_header = line;
+        return;
+    }
+
+    // Paired-single results, under "PS_ADD Variants" and the like, loads and stores ("... | EA +0x0100 | ..."),
+    // and exceptions ("TRAP     :: SRR0: site+0x0 | ...").
+    if (m_header.compare(0, 2, "PS") == 0 || std::strstr(line, " | EA +") != nullptr || std::strstr(line, ":: SRR0: ") != nullptr)
+    {
+        m_checker.Skip();
+        return;
+    }
+
+    const std::string name = ParseMnemonic(line);
+
+    // Carry chains: "ADD64    :: rD 0x... | rA 0x... | rB 0x... | XER in 0x... | XER: 0x... | CR: 0x..."
+    if (FindIntegerChain(name.c_str()) != nullptr)
+    {
+        LogRecord record = MakeLogRecord(LogForm::IntegerChain, name.c_str());
+        uint64_t xer = 0, cr = 0;
+        if (!ParseHexField(line, "rD", &record.result) || !ParseHexField(line, "rA", &record.operands[0]) ||
+            !ParseHexField(line, "rB", &record.operands[1]) || !ParseHexField(line, "in", &record.operands[2]) ||
+            !ParseHexField(line, "XER", &xer) || !ParseHexField(line, "CR", &cr))
+        {
+            m_checker.Record(name, false, line_number, line);
+            return;
+        }
+        record.xer = static_cast<uint32_t>(xer);
+        record.cr = static_cast<uint32_t>(cr);
+
+        std::string model;
+        m_checker.Record(name, VerifyRecord(record, &model) == Verdict::Matched, line_number, line, model);
+        return;
+    }
+
+    ModelInstruction inst{};
+    if (!DecodeModelMnemonic(name.c_str(), &inst))
+    {
+        m_checker.Record(name, false, line_number, line);
+        return;
+    }
+
+    // The state tests run SRAWI from other initial states, which its encoded groups don't account for.
+    if (inst.op == ModelOp::Srawi && std::strstr(line, " | CR in ") != nullptr)
+    {
+        m_checker.Skip();
+        return;
+    }
+
+    if (inst.op == ModelOp::Srawi || inst.op == ModelOp::Rlwimi || inst.op == ModelOp::Rlwinm)
+    {
+        if (m_encoded_groups.empty() || m_encoded_groups.back().first != name)
+            m_encoded_groups.push_back({name, {}});
+        m_encoded_groups.back().second.push_back({line_number, line});
+        return;
+    }
+
+    // Exhaustive CR tests: "CRAND    :: crbD  n | crbA  n | crbB  n | CR in 0x... | CR: 0x..."
+    if (inst.cls == ModelClass::ConditionRegister)
+    {
+        const char* crbD = std::strstr(line, "crbD ");
+        const char* crbA = std::strstr(line, "crbA ");
+        const char* crbB = std::strstr(line, "crbB ");
+        uint64_t input = 0, cr = 0;
+        if (crbD == nullptr || crbA == nullptr || crbB == nullptr || !ParseHexField(line, "in", &input))
+        {
+            m_checker.Record(name, false, line_number, line);
+            return;
+        }
+        ParseHexField(line, "CR", &cr);
+
+        ModelState state{};
+        state.cr = static_cast<uint32_t>(input);
+        ModelConditionRegister(inst, static_cast<uint32_t>(std::strtoul(crbD + 5, nullptr, 10)),
+                               static_cast<uint32_t>(std::strtoul(crbA + 5, nullptr, 10)),
+                               static_cast<uint32_t>(std::strtoul(crbB + 5, nullptr, 10)), state);
+        m_checker.Record(name, state.cr == cr, line_number, line);
+        return;
+    }
+
+    // Estimate tables: "FRES     :: entry  0 | base 0x07FF800 | dec 0x3E1 | mismatched 0"
+    if (const char* entry = std::strstr(line, ":: entry "))
+    {
+        const char* mismatched = std::strstr(line, "| mismatched ");
+        uint64_t base = 0, dec = 0;
+        if (mismatched == nullptr || !ParseHexField(line, "base", &base) || !ParseHexField(line, "dec", &dec))
+        {
+            m_checker.Record(name, false, line_number, line);
+            return;
+        }
+
+        LogRecord record = MakeLogRecord(LogForm::EstimateTableEntry, name.c_str());
+        record.result = (base << 32) | dec;
+        record.operands[0] = std::strtoull(entry + 9, nullptr, 10);
+        record.operands[3] = std::strtoull(mismatched + 13, nullptr, 10);
+
+        std::string model;
+        m_checker.Record(name, VerifyRecord(record, &model) == Verdict::Matched, line_number, line, model);
+        return;
+    }
+
+    if (inst.cls == ModelClass::Integer)
+    {
+        m_checker.Record(name, CheckIntegerLine(inst, line), line_number, line);
+        return;
+    }
+
+    // The FPRF preservation tests set the class bit before comparing, and print
+    // without padding the mnemonic.
+    const bool fprf_test = std::strncmp(line + name.size(), " :: ", 4) == 0;
+    std::string model;
+    const bool matched = CheckFloatLine(inst, line, fprf_test ? FPSCR_C : 0, &model);
+    m_checker.Record(name, matched, line_number, line, model);
+}
+
+void LogChecker::CheckRecord(size_t record_number, const LogRecord& record)
+{
+    m_records.emplace_back(record_number, record);
+    if (m_records.size() == RECORDS_PER_THREAD * m_thread_count)
+        FlushRecords();
+}
+
+void LogChecker::FlushRecords()
+{
+    if (m_records.empty())
+        return;
+
+    // Threads take records in small blocks, since some (digests) take far longer to check
+    // than others. A flush can be nothing but the 256 digests of one exhaustive sweep, so
+    // the blocks shrink until there are enough of them to keep every thread busy.
+    // Mismatches are reported afterwards, in log order.
+    const size_t block_size = std::clamp<size_t>(m_records.size() / (m_thread_count * 64), 1, 64);
+
+    std::vector<Verdict> verdicts(m_records.size());
+    std::vector<std::string> models(m_records.size());
+    std::atomic<size_t> next_block{0};
+
+    const auto worker = [&] {
+        for (;;)
+        {
+            const size_t begin = next_block.fetch_add(block_size);
+            if (begin >= m_records.size())
+                return;
+
+            const size_t end = std::min(begin + block_size, m_records.size());
+            for (size_t i = begin; i < end; i++)
+                verdicts[i] = VerifyRecord(m_records[i].second, &models[i]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < m_thread_count; i++)
+        threads.emplace_back(worker);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < m_records.size(); i++)
+    {
+        const LogRecord& record = m_records[i].second;
+        if (verdicts[i] == Verdict::Unchecked)
+        {
+            m_checker.Skip();
+            continue;
+        }
+
+        const std::string name(record.inst, strnlen(record.inst, sizeof(record.inst)));
+        if (verdicts[i] == Verdict::Matched)
+        {
+            m_checker.Record(name, true, m_records[i].first, "");
+            continue;
+        }
+
+        char text[256];
+        const int length = FormatLogRecord(record, text, sizeof(text));
+        if (length > 0 && text[length - 1] == '\n')
+            text[length - 1] = '\0';
+        m_checker.Record(name, false, m_records[i].first, text, models[i]);
+    }
+
+    m_records.clear();
+}
+
+int LogChecker::Finish()
+{
+    FlushRecords();
+
+    for (const auto& group : m_encoded_groups)
+    {
+        ModelInstruction inst{};
+        DecodeModelMnemonic(group.first.c_str(), &inst);
+        if (inst.op == ModelOp::Srawi)
+            CheckShiftImmediate(m_checker, group.first, inst, group.second);
+        else
+            CheckRotate(m_checker, group.first, inst, group.second);
+    }
+
+    return m_checker.Summarize();
+}
+
+int CheckTextLog(FILE* file, unsigned thread_count)
+{
+    LogChecker checker("line", thread_count);
+
+    char buffer[512];
+    size_t line_number = 0;
+    while (std::fgets(buffer, sizeof(buffer), file) != nullptr)
+    {
+        line_number++;
+        buffer[std::strcspn(buffer, "\r\n")] = '\0';
+        checker.CheckLine(line_number, buffer);
+    }
+
+    return checker.Finish();
+}
+
+int CheckBinaryLog(FILE* file, unsigned thread_count)
+{
+    LogChecker checker("record", thread_count);
+
+    // Text can be split across records, so lines are only checked once they're complete.
+    std::string text;
+    std::vector<char> padded_text;
+    size_t record_number = 0;
+
+    LogRecord record;
+    while (std::fread(&record, sizeof(record), 1, file) == 1)
+    {
+        record_number++;
+        record = SwapLogRecord(record);
+
+        if (record.type == LogRecordType::Result)
+        {
+            checker.CheckRecord(record_number, record);
+            continue;
+        }
+
+        if (record.type != LogRecordType::Text)
+        {
+            std::fprintf(stderr, "Unknown record type %u at record %zu\n", static_cast<unsigned>(record.type), record_number);
+            return 1;
+        }
+
+        const size_t padded = (record.result + LOG_RECORD_SIZE - 1) / LOG_RECORD_SIZE * LOG_RECORD_SIZE;
+        padded_text.resize(padded);
+        if (std::fread(padded_text.data(), 1, padded, file) != padded)
+        {
+            std::fprintf(stderr, "Truncated text record at record %zu\n", record_number);
+            return 1;
+        }
+        const size_t text_record = record_number;
+        record_number += padded / LOG_RECORD_SIZE;
+
+        text.append(padded_text.data(), record.result);
+        size_t line_start = 0;
+        for (size_t newline; (newline = text.find('\n', line_start)) != std::string::npos; line_start = newline + 1)
+        {
+            text[newline] = '\0';
+            checker.CheckLine(text_record, text.c_str() + line_start);
+        }
+        text.erase(0, line_start);
+    }
+
+    return checker.Finish();
+}
+
+int CheckLog(const char* path, unsigned thread_count)
+{
+    FILE* file = std::fopen(path, "rb");
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "Unable to open %s\n", path);
+        return 1;
+    }
+
+    // Binary logs start with a record type, which text output never contains.
+    const int first = std::fgetc(file);
+    std::rewind(file);
+
+    const bool binary = first == static_cast<int>(LogRecordType::Text) || first == static_cast<int>(LogRecordType::Result);
+    const int result = binary ? CheckBinaryLog(file, thread_count) : CheckTextLog(file, thread_count);
+    std::fclose(file);
+    return result;
+}
+
+//
+// Throughput benchmark
+//
+
+// Measures the batch evaluator at every level the host supports, as the rate it checks
+// a binary sweep at across every thread.
+void BenchmarkBatch(unsigned thread_count)
+{
+    static const char* const sweep_ops[] = {"ADDEO.", "SUBFEO.", "MULHW."};
+    static constexpr uint64_t VECTORS_PER_THREAD = 1U << 22;
+
+    for (int level = 0; level <= static_cast<int>(GetBestBatchLevel()); level++)
+    {
+        for (const char* name : sweep_ops)
+        {
+            ModelInstruction inst{};
+            DecodeModelMnemonic(name, &inst);
+
+            std::atomic<uint64_t> checksum{0};
+            const auto worker = [&](unsigned index) {
+                const uint64_t first = index * VECTORS_PER_THREAD;
+                checksum += DigestIntegerSweep(inst, false, first, first + VECTORS_PER_THREAD - 1, 0x9E3779B9, XER_CA, 0,
+                                               DigestIntegerUnary, static_cast<BatchLevel>(level));
+            };
+
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (unsigned i = 0; i < thread_count; i++)
+                threads.emplace_back(worker, i);
+            for (std::thread& thread : threads)
+                thread.join();
+
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const double rate = VECTORS_PER_THREAD * thread_count / elapsed;
+            std::printf("%-6s %-8s vectors/s: %.0f (every rA in %.1fs)\n", GetBatchLevelName(static_cast<BatchLevel>(level)),
+                        name, rate, 4294967296.0 / rate);
+        }
+    }
+}
+
+// Runs random vectors of every integer instruction through the batch evaluator at every level,
+// and counts the results that differ from ModelInteger. Returns the number of mismatches.
+uint64_t CheckBatchLevels()
+{
+    static const char* const integer_ops[] = {
+        "ADD.", "ADDO.", "ADDC.", "ADDCO.", "ADDE.", "ADDEO.", "ADDI", "ADDIC", "ADDIC.", "ADDIS", "ADDME.", "ADDMEO.",
+        "ADDZE.", "ADDZEO.", "AND.", "ANDC.", "ANDI.", "ANDIS.", "CMP", "CMPI", "CMPL", "CMPLI", "CNTLZW.", "DIVW.",
+        "DIVWO.", "DIVWU.", "DIVWUO.", "EQV.", "EXTSB.", "EXTSH.", "MULHW.", "MULHWU.", "MULLI", "MULLW.", "MULLWO.",
+        "NAND.", "NEG.", "NEGO.", "NOR.", "OR.", "ORC.", "ORI", "ORIS", "SLW.", "SRAW.", "SRAWI.", "SRW.", "SUBF.",
+        "SUBFO.", "SUBFC.", "SUBFCO.", "SUBFE.", "SUBFEO.", "SUBFIC", "SUBFME.", "SUBFMEO.", "SUBFZE.", "SUBFZEO.",
+        "XOR.", "XORI", "XORIS",
+    };
+    static constexpr size_t VECTORS = 1U << 16;
+
+    // Boundary values are more likely to expose a difference than uniform ones.
+    static constexpr uint32_t boundaries[] = {
+        0x00000000, 0x00000001, 0x0000001F, 0x00000020, 0x0000003F, 0x00007FFF, 0x00008000, 0x0000FFFF,
+        0x7FFFFFFF, 0x80000000, 0x80000001, 0xFFFF8000, 0xFFFFFFFE, 0xFFFFFFFF,
+    };
+
+    Random random(0x5DEECE66DULL);
+    std::vector<uint32_t> rA(VECTORS), rB(VECTORS), xer(VECTORS);
+    for (size_t i = 0; i < VECTORS; i++)
+    {
+        const uint64_t r = random.Next();
+        rA[i] = i % 4 == 0 ? boundaries[r % std::size(boundaries)] : static_cast<uint32_t>(r);
+        rB[i] = i % 3 == 0 ? boundaries[(r >> 8) % std::size(boundaries)] : static_cast<uint32_t>(r >> 32);
+        if (i % 5 == 0)
+            rB[i] &= 63; // Shift amounts, either side of 32
+        xer[i] = static_cast<uint32_t>(random.Next()) & XER_MASK;
+    }
+
+    std::vector<uint32_t> expected(3 * VECTORS), actual(3 * VECTORS);
+    uint64_t mismatches = 0;
+    for (const char* name : integer_ops)
+    {
+        ModelInstruction inst{};
+        DecodeModelMnemonic(name, &inst);
+
+        const auto run = [&](std::vector<uint32_t>& out, BatchLevel level) {
+            const IntegerBatch batch{rA.data(), rB.data(), xer.data(), 0xA5A5A5A5,
+                                     &out[0], &out[VECTORS], &out[2 * VECTORS]};
+            ModelIntegerBatch(inst, batch, VECTORS, level);
+        };
+
+        run(expected, BatchLevel::Scalar);
+        for (int level = 1; level <= static_cast<int>(GetBestBatchLevel()); level++)
+        {
+            run(actual, static_cast<BatchLevel>(level));
+            for (size_t i = 0; i < VECTORS; i++)
+            {
+                if (actual[i] == expected[i] && actual[VECTORS + i] == expected[VECTORS + i] &&
+                    actual[2 * VECTORS + i] == expected[2 * VECTORS + i])
+                {
+                    continue;
+                }
+
+                if (mismatches++ < 10)
+                {
+                    std::printf("%s (%s): rA 0x%08" PRIX32 " | rB 0x%08" PRIX32 " | XER in 0x%08" PRIX32 " differs from the scalar model\n",
+                                name, GetBatchLevelName(static_cast<BatchLevel>(level)), rA[i], rB[i], xer[i]);
+                }
+            }
+        }
+    }
+
+    std::printf("batch mismatches:   %" PRIu64 " (%zu instructions, %zu vectors each)\n", mismatches, std::size(integer_ops), VECTORS);
+    return mismatches;
+}
+
+// Runs vector (which takes the thread's generator and a checksum to add to) on every thread for
+// the given time, and returns the number of vectors run per second.
+template <typename Vector>
+double MeasureRate(double seconds, unsigned thread_count, uint64_t* checksum, Vector vector)
+{
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum_total{0};
+
+    const auto worker = [&](unsigned index) {
+        Random random(0x9E3779B97F4A7C15ULL * (index + 1));
+        uint64_t count = 0;
+        uint64_t sum = 0;
+
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            // Work in batches so the stop flag isn't polled per vector.
+            for (int i = 0; i < 4096; i++)
+                vector(random, sum);
+            count += 4096;
+        }
+
+        total += count;
+        sum_total += sum;
+    };
+
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < thread_count; i++)
+        threads.emplace_back(worker, i);
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (std::thread& thread : threads)
+        thread.join();
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    *checksum += sum_total;
+    return total / elapsed;
+}
+
+int Benchmark(double seconds, unsigned thread_count)
+{
+    static const char* const integer_ops[] = {
+        "ADDO.", "ADDCO.", "ADDEO.", "DIVWO.", "DIVWUO.", "MULLWO.", "SUBFCO.", "SUBFEO.",
+        "SRAW.", "SLW.", "RLWINM.", "RLWIMI.", "CNTLZW.", "NEGO.", "MULHW.", "CMP",
+    };
+    static const char* const float_ops[] = {
+        "FADD.", "FADDS.", "FSUB.", "FMUL.", "FMULS.", "FDIV.", "FDIVS.", "FMADD.",
+        "FNMSUBS.", "FRSP.", "FCTIW.", "FCTIWZ.", "FRES.", "FRSQRTE.", "FCMPO", "FSEL.",
+    };
+
+    std::vector<ModelInstruction> integer_insts;
+    std::vector<ModelInstruction> float_insts;
+    for (const char* name : integer_ops)
+    {
+        integer_insts.emplace_back();
+        DecodeModelMnemonic(name, &integer_insts.back());
+    }
+    for (const char* name : float_ops)
+    {
+        float_insts.emplace_back();
+        DecodeModelMnemonic(name, &float_insts.back());
+    }
+
+    // Each model gets its own phase, timed on its own, so the slower float model doesn't
+    // hold back the integer rate.
+    uint64_t checksum = 0;
+    const double integer_rate = MeasureRate(seconds, thread_count, &checksum, [&](Random& random, uint64_t& sum) {
+        const uint64_t r0 = random.Next();
+        const uint64_t r1 = random.Next();
+        const uint64_t r2 = random.Next();
+
+        const ModelInstruction& inst = integer_insts[r2 % integer_insts.size()];
+        ModelState state{0, static_cast<uint32_t>(r2 >> 32) & XER_MASK, 0};
+        sum += ModelInteger(inst, static_cast<uint32_t>(r2),
+                            {static_cast<uint32_t>(r0), static_cast<uint32_t>(r0 >> 32),
+                             static_cast<uint32_t>(r1) & 31, static_cast<uint32_t>(r1 >> 32) & 31},
+                            state);
+        sum += state.xer + state.cr;
+    });
+    const double float_rate = MeasureRate(seconds, thread_count, &checksum, [&](Random& random, uint64_t& sum) {
+        const uint64_t r0 = random.Next();
+        const uint64_t r1 = random.Next();
+        const uint64_t r2 = random.Next();
+
+        const ModelInstruction& inst = float_insts[(r2 >> 8) % float_insts.size()];
+        ModelState state{0, 0, static_cast<uint32_t>(r2 >> 16) & (FPSCR_RN | FPSCR_VE)};
+        sum += ModelFloat(inst, 0, {r0, r1, r2}, 1, state);
+        sum += state.fpscr + state.cr;
+    });
+
+    std::printf("threads:            %u\n", thread_count);
+    std::printf("integer vectors/s:  %.0f (%.2f billion/hour)\n", integer_rate, integer_rate * 3600 / 1e9);
+    std::printf("float vectors/s:    %.0f (%.2f billion/hour)\n", float_rate, float_rate * 3600 / 1e9);
+    std::printf("checksum:           %016" PRIX64 "\n", checksum);
+
+    BenchmarkBatch(thread_count);
+    return CheckBatchLevels() == 0 ? 0 : 1;
+}
+} // Anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const bool bench = argc >= 2 && std::strcmp(argv[1], "--bench") == 0;
+    if (argc < 2 || (!bench && argc > 3))
+    {
+        std::fprintf(stderr, "Usage: %s <instruction_tests.txt|instruction_tests.bin> [threads]\n"
+                             "       %s --bench [seconds] [threads]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    const int threads_arg = bench ? 3 : 2;
+    unsigned threads = argc > threads_arg ? static_cast<unsigned>(std::atoi(argv[threads_arg])) : std::thread::hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+
+    if (bench)
+        return Benchmark(argc >= 3 ? std::atof(argv[2]) : 5.0, threads);
+
+    return CheckLog(argv[1], threads);
+}
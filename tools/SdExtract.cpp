@@ -0,0 +1,432 @@
+// Copies a file out of an SD card image, such as the sd.raw Dolphin gives the emulated Wii,
+// so a run's log can be compared without mounting the image or reaching for a Windows tool.
+//
+// The image is memory-mapped and the file is written straight from the mapping, one run of
+// contiguous clusters at a time. Images with a partition table (the first partition is used)
+// and bare FAT16/FAT32 volumes are both understood. Paths are matched case-insensitively
+// against long and short names, with '/' between directories.
+//
+// Usage: sdextract <sd.raw> [path in image] [output]
+//
+// The path defaults to instruction_tests.txt and the output to stdout, so an emulator run can
+// go straight into logdiff:
+//
+//     sdextract sd.raw | logdiff binary/instruction_tests_console.txt -
+
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr uint8_t ATTRIBUTE_DIRECTORY = 0x10;
+constexpr uint8_t ATTRIBUTE_VOLUME_ID = 0x08;
+constexpr uint8_t ATTRIBUTE_LONG_NAME = 0x0F;
+constexpr size_t DIRECTORY_ENTRY_SIZE = 32;
+
+uint16_t Read16(const uint8_t* data)
+{
+    return static_cast<uint16_t>(data[0] | data[1] << 8);
+}
+
+uint32_t Read32(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0] | data[1] << 8 | data[2] << 16) | static_cast<uint32_t>(data[3]) << 24;
+}
+
+bool EqualsIgnoringCase(const std::string& a, const std::string& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+            return false;
+    }
+
+    return true;
+}
+
+struct DirectoryEntry
+{
+    std::string long_name;
+    std::string short_name; // "NAME.EXT"
+    uint8_t attributes;
+    uint32_t first_cluster;
+    uint32_t size;
+};
+
+// A run of clusters that are next to each other in the image.
+struct ClusterRun
+{
+    uint64_t offset;
+    uint64_t size;
+};
+
+class FatVolume
+{
+public:
+    FatVolume(const uint8_t* image, uint64_t image_size) : m_image(image), m_image_size(image_size) {}
+
+    // Finds the volume (the image itself, or its first partition) and reads its boot sector.
+    bool Open()
+    {
+        uint64_t volume = 0;
+        if (!IsBootSector(0))
+        {
+            // MBR partition table: the first entry's starting LBA.
+            if (m_image_size < 512 || Read16(&m_image[510]) != 0xAA55)
+                return Fail("No boot sector or partition table");
+            volume = uint64_t{Read32(&m_image[0x1C6])} * 512;
+            if (!IsBootSector(volume))
+                return Fail("The first partition isn't FAT");
+        }
+
+        const uint8_t* const boot = &m_image[volume];
+        m_sector_size = Read16(&boot[0x0B]);
+        m_cluster_size = uint32_t{m_sector_size} * boot[0x0D];
+
+        const uint32_t reserved_sectors = Read16(&boot[0x0E]);
+        const uint32_t fat_count = boot[0x10];
+        const uint32_t root_entries = Read16(&boot[0x11]);
+        const uint32_t total_sectors = Read16(&boot[0x13]) != 0 ? Read16(&boot[0x13]) : Read32(&boot[0x20]);
+        const uint32_t fat_sectors = Read16(&boot[0x16]) != 0 ? Read16(&boot[0x16]) : Read32(&boot[0x24]);
+        const uint32_t root_sectors = (root_entries * DIRECTORY_ENTRY_SIZE + m_sector_size - 1) / m_sector_size;
+        const uint32_t data_start = reserved_sectors + fat_count * fat_sectors + root_sectors;
+        if (fat_count == 0 || fat_sectors == 0 || data_start >= total_sectors)
+            return Fail("Bad FAT geometry");
+
+        m_cluster_count = (total_sectors - data_start) / boot[0x0D];
+        if (m_cluster_count < 4085)
+            return Fail("FAT12 volumes aren't supported");
+
+        m_fat32 = m_cluster_count >= 65525;
+        m_fat_offset = volume + uint64_t{reserved_sectors} * m_sector_size;
+        m_fat_size = uint64_t{fat_sectors} * m_sector_size;
+        m_data_offset = volume + uint64_t{data_start} * m_sector_size;
+        m_root_offset = m_fat_offset + fat_count * m_fat_size;
+        m_root_size = uint64_t{root_entries} * DIRECTORY_ENTRY_SIZE;
+        m_root_cluster = m_fat32 ? Read32(&boot[0x2C]) : 0;
+
+        if (m_fat_offset + m_fat_size > m_image_size)
+            return Fail("The image is truncated");
+
+        return true;
+    }
+
+    // Finds a file by its path from the root directory.
+    bool Find(const std::string& path, DirectoryEntry* found)
+    {
+        DirectoryEntry directory{};
+        directory.attributes = ATTRIBUTE_DIRECTORY;
+        directory.first_cluster = m_root_cluster;
+
+        size_t begin = 0;
+        while (begin <= path.size())
+        {
+            size_t end = path.find('/', begin);
+            if (end == std::string::npos)
+                end = path.size();
+
+            const std::string name = path.substr(begin, end - begin);
+            begin = end + 1;
+            if (name.empty())
+                continue;
+
+            if ((directory.attributes & ATTRIBUTE_DIRECTORY) == 0)
+                return Fail("Not a directory in " + path);
+
+            std::vector<DirectoryEntry> entries;
+            if (!ReadDirectory(directory, &entries))
+                return false;
+
+            bool matched = false;
+            for (const DirectoryEntry& entry : entries)
+            {
+                if (EqualsIgnoringCase(entry.long_name, name) || EqualsIgnoringCase(entry.short_name, name))
+                {
+                    directory = entry;
+                    matched = true;
+                    break;
+                }
+            }
+
+            if (!matched)
+                return Fail("Not found: " + path);
+        }
+
+        if (directory.attributes & ATTRIBUTE_DIRECTORY)
+            return Fail("Not a file: " + path);
+
+        *found = directory;
+        return true;
+    }
+
+    // The runs of clusters that hold the first size bytes of a chain, in order.
+    bool GetClusterRuns(uint32_t cluster, uint64_t size, std::vector<ClusterRun>* runs)
+    {
+        // A chain can't visit more clusters than there are without going round in a loop.
+        for (uint32_t visited = 0; size != 0; visited++)
+        {
+            if (cluster < 2 || cluster - 2 >= m_cluster_count || visited == m_cluster_count)
+                return Fail("Bad cluster chain");
+
+            const uint64_t offset = m_data_offset + uint64_t{cluster - 2} * m_cluster_size;
+            const uint64_t length = size < m_cluster_size ? size : m_cluster_size;
+            if (offset + length > m_image_size)
+                return Fail("The image is truncated");
+
+            if (!runs->empty() && runs->back().offset + runs->back().size == offset)
+                runs->back().size += length;
+            else
+                runs->push_back({offset, length});
+
+            size -= length;
+            if (size != 0)
+                cluster = NextCluster(cluster);
+        }
+
+        return true;
+    }
+
+    const std::string& GetError() const { return m_error; }
+
+private:
+    bool IsBootSector(uint64_t offset) const
+    {
+        if (offset + 512 > m_image_size)
+            return false;
+
+        const uint8_t* const sector = &m_image[offset];
+        const uint16_t sector_size = Read16(&sector[0x0B]);
+        const uint8_t sectors_per_cluster = sector[0x0D];
+        return (sector[0] == 0xEB || sector[0] == 0xE9) && Read16(&sector[510]) == 0xAA55 &&
+               sector_size >= 512 && sector_size <= 4096 && (sector_size & (sector_size - 1)) == 0 &&
+               sectors_per_cluster != 0 && (sectors_per_cluster & (sectors_per_cluster - 1)) == 0;
+    }
+
+    uint32_t NextCluster(uint32_t cluster) const
+    {
+        const uint64_t entry_size = m_fat32 ? 4 : 2;
+        const uint64_t entry = uint64_t{cluster} * entry_size;
+        if (entry + entry_size > m_fat_size)
+            return 0;
+
+        const uint8_t* const fat = &m_image[m_fat_offset + entry];
+        return m_fat32 ? Read32(fat) & 0x0FFFFFFF : Read16(fat);
+    }
+
+    bool ReadDirectory(const DirectoryEntry& directory, std::vector<DirectoryEntry>* entries)
+    {
+        // The FAT16 root directory has a fixed place and size. Every other directory is a
+        // chain of clusters, which ends at an end-of-chain marker rather than at a size.
+        std::vector<ClusterRun> runs;
+        if (directory.first_cluster == 0)
+        {
+            if (m_root_offset + m_root_size > m_image_size)
+                return Fail("The image is truncated");
+            runs.push_back({m_root_offset, m_root_size});
+        }
+        else
+        {
+            const uint32_t end_of_chain = m_fat32 ? 0x0FFFFFF8 : 0xFFF8;
+            uint32_t cluster = directory.first_cluster;
+            uint64_t size = 0;
+            for (uint32_t visited = 0; cluster >= 2 && cluster < end_of_chain && visited < m_cluster_count; visited++)
+            {
+                size += m_cluster_size;
+                cluster = NextCluster(cluster);
+            }
+
+            if (!GetClusterRuns(directory.first_cluster, size, &runs))
+                return false;
+        }
+
+        std::u16string long_name;
+        for (const ClusterRun& run : runs)
+        {
+            for (uint64_t offset = 0; offset + DIRECTORY_ENTRY_SIZE <= run.size; offset += DIRECTORY_ENTRY_SIZE)
+            {
+                const uint8_t* const entry = &m_image[run.offset + offset];
+                if (entry[0] == 0x00)
+                    return true;
+                if (entry[0] == 0xE5)
+                {
+                    long_name.clear();
+                    continue;
+                }
+
+                const uint8_t attributes = entry[0x0B];
+                if (attributes == ATTRIBUTE_LONG_NAME)
+                {
+                    // Long name entries come last part first, each with 13 UTF-16 characters.
+                    static const size_t character_offsets[] = {1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30};
+                    std::u16string part;
+                    for (size_t character : character_offsets)
+                    {
+                        const char16_t c = Read16(&entry[character]);
+                        if (c == 0x0000 || c == 0xFFFF)
+                            break;
+                        part += c;
+                    }
+
+                    if (entry[0] & 0x40)
+                        long_name.clear();
+                    long_name.insert(0, part);
+                    continue;
+                }
+
+                if (attributes & ATTRIBUTE_VOLUME_ID)
+                {
+                    long_name.clear();
+                    continue;
+                }
+
+                DirectoryEntry found;
+                found.long_name = ToNarrow(long_name);
+                found.short_name = ShortName(entry);
+                found.attributes = attributes;
+                found.first_cluster = uint32_t{Read16(&entry[0x1A])} | (m_fat32 ? uint32_t{Read16(&entry[0x14])} << 16 : 0);
+                found.size = Read32(&entry[0x1C]);
+                entries->push_back(found);
+                long_name.clear();
+            }
+        }
+
+        return true;
+    }
+
+    // Names are only compared, so anything outside of ASCII just has to not match by accident.
+    static std::string ToNarrow(const std::u16string& name)
+    {
+        std::string narrow;
+        for (char16_t c : name)
+            narrow += c < 0x80 ? static_cast<char>(c) : '?';
+        return narrow;
+    }
+
+    static std::string ShortName(const uint8_t* entry)
+    {
+        std::string name(reinterpret_cast<const char*>(entry), 8);
+        std::string extension(reinterpret_cast<const char*>(&entry[8]), 3);
+        if (name[0] == 0x05)
+            name[0] = static_cast<char>(0xE5);
+
+        name.erase(name.find_last_not_of(' ') + 1);
+        extension.erase(extension.find_last_not_of(' ') + 1);
+        return extension.empty() ? name : name + "." + extension;
+    }
+
+    bool Fail(const std::string& error)
+    {
+        m_error = error;
+        return false;
+    }
+
+    const uint8_t* m_image;
+    uint64_t m_image_size;
+
+    bool m_fat32 = false;
+    uint32_t m_sector_size = 0;
+    uint32_t m_cluster_size = 0;
+    uint32_t m_cluster_count = 0;
+    uint32_t m_root_cluster = 0;
+    uint64_t m_fat_offset = 0;
+    uint64_t m_fat_size = 0;
+    uint64_t m_root_offset = 0;
+    uint64_t m_root_size = 0;
+    uint64_t m_data_offset = 0;
+    std::string m_error;
+};
+
+bool WriteAll(int fd, const uint8_t* data, uint64_t size)
+{
+    while (size != 0)
+    {
+        const ssize_t written = write(fd, data, size < (1U << 30) ? size : (1U << 30));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+
+        data += written;
+        size -= static_cast<uint64_t>(written);
+    }
+
+    return true;
+}
+} // Anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 4)
+    {
+        std::fprintf(stderr, "Usage: %s <sd.raw> [path in image] [output]\n", argv[0]);
+        return 1;
+    }
+
+    const std::string path = argc > 2 ? argv[2] : "instruction_tests.txt";
+    const char* const output = argc > 3 ? argv[3] : "-";
+
+    const int image_fd = open(argv[1], O_RDONLY);
+    struct stat image_stat;
+    if (image_fd < 0 || fstat(image_fd, &image_stat) != 0)
+    {
+        std::fprintf(stderr, "Unable to open: %s\n", argv[1]);
+        return 1;
+    }
+
+    const uint64_t image_size = static_cast<uint64_t>(image_stat.st_size);
+    void* const mapping = image_size != 0 ? mmap(nullptr, image_size, PROT_READ, MAP_SHARED, image_fd, 0) : MAP_FAILED;
+    close(image_fd);
+    if (mapping == MAP_FAILED)
+    {
+        std::fprintf(stderr, "Unable to map: %s\n", argv[1]);
+        return 1;
+    }
+
+    const uint8_t* const image = static_cast<const uint8_t*>(mapping);
+    FatVolume volume(image, image_size);
+    DirectoryEntry entry;
+    std::vector<ClusterRun> runs;
+    if (!volume.Open() || !volume.Find(path, &entry) || !volume.GetClusterRuns(entry.first_cluster, entry.size, &runs))
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[1], volume.GetError().c_str());
+        return 1;
+    }
+
+    const bool to_stdout = std::strcmp(output, "-") == 0;
+    const int out_fd = to_stdout ? STDOUT_FILENO : open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0)
+    {
+        std::fprintf(stderr, "Unable to open: %s\n", output);
+        return 1;
+    }
+
+    bool written = true;
+    for (const ClusterRun& run : runs)
+        written = written && WriteAll(out_fd, &image[run.offset], run.size);
+
+    if (!to_stdout && close(out_fd) != 0)
+        written = false;
+    if (!written)
+    {
+        std::fprintf(stderr, "Unable to write: %s\n", output);
+        return 1;
+    }
+
+    munmap(mapping, image_size);
+    return 0;
+}